@@ -4,20 +4,34 @@
 
 #pragma once
 
-#include <array>
-
 #include "hebench/api_bridge/cpp/hebench.hpp"
 
 class ExampleEngine;
 
+// Workload parameters supported by this benchmark: same as the standard
+// MatrixMultiply schema, but restricted to matrices of 100 x 100.
+struct ExampleWorkloadSchema
+{
+    enum : std::size_t
+    {
+        RowsM0,
+        ColsM0,
+        ColsM1
+    };
+    static constexpr hebench::cpp::WorkloadParamSpec Params[] = { hebench::cpp::WorkloadParamSpec::UInt64("rows_M0", 100, 100),
+                                                                  hebench::cpp::WorkloadParamSpec::UInt64("cols_M0", 100, 100),
+                                                                  hebench::cpp::WorkloadParamSpec::UInt64("cols_M1", 100, 100) };
+};
+
 class ExampleBenchmarkDescription : public hebench::cpp::BenchmarkDescription
 {
 public:
     HEBERROR_DECLARE_CLASS_NAME(ExampleBenchmarkDescription)
 
 public:
+    typedef hebench::cpp::WorkloadSchema<ExampleWorkloadSchema> ParamsSchema;
     // This workload (MatrixMultiply) requires only 3 configurable parameters
-    static constexpr std::uint64_t NumWorkloadParams = 3;
+    static constexpr std::uint64_t NumWorkloadParams = ParamsSchema::ParamCount;
     // This workload has 2 operands.
     static constexpr std::uint64_t NumOperands = 2;
     // This workload result has only 1 component (the resulting matrix).
@@ -70,8 +84,10 @@ private:
     static constexpr std::int64_t tagStoreOutput   = 0x200;
     static constexpr std::int64_t tagOperateOutput = 0x400;
 
-    struct Matrix
+    // 100x100 row-major matrix of doubles in an aligned buffer
+    struct Matrix : public hebench::cpp::Tensor<double, 2>
     {
-        std::array<std::array<double, 100>, 100> rows;
+        Matrix() :
+            hebench::cpp::Tensor<double, 2>(Shape{ 100, 100 }) {}
     };
 };
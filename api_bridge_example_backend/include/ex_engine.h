@@ -15,13 +15,13 @@ public:
     HEBERROR_DECLARE_CLASS_NAME(ExampleEngine)
 
 public:
-    static ExampleEngine *create();
+    static ExampleEngine *create(const hebench::cpp::EngineConfig &config);
     static void destroy(ExampleEngine *p);
 
     ~ExampleEngine() override;
 
 protected:
-    ExampleEngine();
+    ExampleEngine(const hebench::cpp::EngineConfig &config);
 
     void init() override;
 };
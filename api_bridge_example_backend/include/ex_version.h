@@ -0,0 +1,14 @@
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+
+//============
+// Versioning
+//============
+
+#define HEBENCH_API_VERSION_NEEDED_MAJOR 0
+#define HEBENCH_API_VERSION_NEEDED_MINOR 9
+#define HEBENCH_API_VERSION_NEEDED_REVISION 0
+#define HEBENCH_API_VERSION_NEEDED_BUILD "beta"
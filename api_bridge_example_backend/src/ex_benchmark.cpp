@@ -12,6 +12,8 @@
 #include "../include/ex_benchmark.h"
 #include "../include/ex_engine.h"
 
+constexpr hebench::cpp::WorkloadParamSpec ExampleWorkloadSchema::Params[];
+
 //-----------------------------------
 // class ExampleBenchmarkDescription
 //-----------------------------------
@@ -36,11 +38,7 @@ ExampleBenchmarkDescription::ExampleBenchmarkDescription()
 
     // specify default arguments for this workload:
     // this benchmark will only support matrices of 100x100
-    hebench::cpp::WorkloadParams::MatrixMultiply default_workload_params;
-    default_workload_params.rows_M0() = 100;
-    default_workload_params.cols_M0() = 100;
-    default_workload_params.cols_M1() = 100;
-    this->addDefaultParameters(default_workload_params);
+    this->addDefaultParameters(ParamsSchema::makeDefault(100, 100, 100));
 }
 
 ExampleBenchmarkDescription::~ExampleBenchmarkDescription()
@@ -91,22 +89,11 @@ ExampleBenchmark::ExampleBenchmark(ExampleEngine &engine,
                                    const hebench::APIBridge::WorkloadParams &bench_params) :
     hebench::cpp::BaseBenchmark(engine, bench_desc, bench_params)
 {
-    // validate workload parameters
-
-    // number of workload parameters (3 for matmul: rows of M0, cols of M0, cols of M1)
-    if (bench_params.count < ExampleBenchmarkDescription::NumWorkloadParams)
-        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload parameters. This workload requires " + std::to_string(ExampleBenchmarkDescription::NumWorkloadParams) + " parameters."),
-                                         HEBENCH_ECODE_INVALID_ARGS);
-
-    // check values of the workload parameters and make sure they are supported by benchmark:
+    // validate workload parameters: number of parameters (3 for matmul: rows of M0,
+    // cols of M0, cols of M1), their types and values are checked against the schema,
+    // which only supports matrices of dimensions 100 x 100
 
-    hebench::cpp::WorkloadParams::MatrixMultiply w_params(bench_params);
-
-    if (w_params.rows_M0() != 100
-        || w_params.cols_M0() != 100
-        || w_params.cols_M1() != 100)
-        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid workload parameters. This workload only supports matrices of dimensions 100 x 100."),
-                                         HEBENCH_ECODE_INVALID_ARGS);
+    ExampleBenchmarkDescription::ParamsSchema::validate(bench_params);
 
     // workload-parameter-based initialization would go here, but for this example is
     // not necessary because this example supports only matrices that are 100 x 100
@@ -138,31 +125,41 @@ hebench::APIBridge::Handle ExampleBenchmark::encode(const hebench::APIBridge::Da
 
     std::vector<Matrix> params(p_parameters->pack_count);
 
+    // typed view of the parameters: the lookup table from parameter position to
+    // data pack is computed once here, instead of searching for every parameter
+    hebench::cpp::DataPackCollectionView<const double> parameters(*p_parameters);
+
     // encode the packed parameters into our internal version
     for (std::uint64_t param_i = 0; param_i < p_parameters->pack_count; ++param_i)
     {
         // find the parameter data pack inside the parameters pack that corresponds
         // to this parameter position:
         // param_i == p_parameters->p_data_packs[i].param_position
-        const hebench::APIBridge::DataPack &parameter = ExampleBenchmark::findDataPack(*p_parameters, param_i);
+        hebench::cpp::DataPackView<const double> parameter = parameters.find(param_i);
+        if (!parameter.valid())
+            throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("DataPack for component " + std::to_string(param_i) + " not found."),
+                                             HEBENCH_ECODE_INVALID_ARGS);
         // take first sample from parameter (because latency test has a single sample per parameter)
-        if (!parameter.p_buffers || !parameter.p_buffers[0].p)
+        if (parameter.sampleCount() == 0 || !parameter.pack().p_buffers || !parameter.sample(0).data())
             throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid empty samples detected in parameter pack."),
                                              HEBENCH_ECODE_INVALID_ARGS);
-        const hebench::APIBridge::NativeDataBuffer &sample = parameter.p_buffers[0];
-        // convert the native data to pointer to double as per specification of workload
-        const double *p_row = reinterpret_cast<const double *>(sample.p);
+        // view the native data as a matrix of doubles as per specification of workload
+        // (the view reinterprets the buffer without copying it)
+        const Matrix &mat = params[param_i]; // alias for clarity
+        if (parameter.sample(0).size() < mat.size())
+            throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid sample size detected in parameter pack."),
+                                             HEBENCH_ECODE_INVALID_ARGS);
+        hebench::cpp::MatrixView<const double> sample = parameter.matrix(0, mat.extent(0), mat.extent(1));
 
         // copy every 100 doubles (full row) to each row of the matrix representation
 
         // We cannot just simply maintain pointers to the parameter data because, as per specification,
         // the resulting handle must be valid regardless whether the native data is valid after
         // this method completes. Thus, deep copy is needed.
-        for (std::size_t row_i = 0; row_i < params[param_i].rows.size(); ++row_i)
+        for (std::size_t row_i = 0; row_i < params[param_i].extent(0); ++row_i)
         {
-            std::copy(p_row, p_row + params[param_i].rows[row_i].size(),
-                      params[param_i].rows[row_i].data());
-            p_row += params[param_i].rows[row_i].size();
+            hebench::cpp::SampleView<const double> row = sample.row(row_i);
+            std::copy(row.begin(), row.end(), params[param_i].slice(row_i).data());
         } // end for
     } // end for
 
@@ -199,34 +196,30 @@ void ExampleBenchmark::decode(hebench::APIBridge::Handle encoded_data, hebench::
                                              static_cast<std::uint64_t>(local_encoded_data.size()));
     for (std::size_t param_i = 0; param_i < min_param_count; ++param_i)
     {
-        hebench::APIBridge::DataPack *p_native_param = &p_native->p_data_packs[param_i];
+        hebench::cpp::DataPackView<double> native_param(p_native->p_data_packs[param_i]);
 
-        if (p_native_param && p_native_param->buffer_count > 0)
+        if (native_param.sampleCount() > 0 && native_param.pack().p_buffers)
         {
             // for latency, we have only one sample, so, decode the sample into the first buffer
-            hebench::APIBridge::NativeDataBuffer &native_sample = p_native_param->p_buffers[0];
+            // (viewed as an array of doubles without copying)
+            hebench::cpp::SampleView<double> native_sample = native_param.sample(0);
 
             // copy each row for the current parameter matrix into the corresponding
             // decoded buffer
 
             const Matrix &mat = local_encoded_data[param_i]; // alias for clarity
 
-            std::uint64_t sample_elem_count = // number of doubles in decoded buffer
-                native_sample.size / sizeof(double);
             std::uint64_t offset = 0;
             for (std::size_t row_i = 0;
-                 offset < sample_elem_count
-                 && row_i < mat.rows.size();
+                 offset < native_sample.size()
+                 && row_i < mat.extent(0);
                  ++row_i)
             {
-                // point to next row in target
-                double *p_decoded_row = reinterpret_cast<double *>(native_sample.p) + offset;
-
                 // copy as much as we can into the row
-                std::uint64_t num_elems_to_copy =
-                    std::min(mat.rows[row_i].size(), sample_elem_count - offset);
-                std::copy(mat.rows[row_i].data(), mat.rows[row_i].data() + num_elems_to_copy,
-                          p_decoded_row);
+                hebench::cpp::SampleView<const double> row = mat.slice(row_i);
+                std::uint64_t num_elems_to_copy             = std::min(row.size(), native_sample.size() - offset);
+                std::copy(row.begin(), row.begin() + num_elems_to_copy,
+                          native_sample.begin() + offset);
 
                 offset += num_elems_to_copy; // advance the target row pointer
             } // end for
@@ -236,40 +229,28 @@ void ExampleBenchmark::decode(hebench::APIBridge::Handle encoded_data, hebench::
 
 hebench::APIBridge::Handle ExampleBenchmark::encrypt(hebench::APIBridge::Handle encoded_data)
 {
-    // we only do plain text in this example, so, just return a copy of our internal data
-    const std::vector<Matrix> &local_encoded_data =
-        this->getEngine().template retrieveFromHandle<std::vector<Matrix>>(encoded_data,
-                                                                           tagEncodeOutput); // expected input tag
-
-    // Deep copy is performed for illustrative purposes only. A shallow copy is faster
-    // using Engine::duplicateHandle() as in load() and store(), but encryption
-    // usually takes longer than a shallow copy, so, deep copy shows a better example
-    // here.
+    // we only do plain text in this example, so, encryption is the identity
 
-    std::vector<Matrix> encrypted_data = local_encoded_data;
+    // A shallow copy using Engine::duplicateHandle() shares our internal data with
+    // the encoded handle without copying it. A backend that transforms the data in
+    // place would then obtain it with Engine::retrieveMutableFromHandle() on the
+    // new handle: the data is cloned only if the encoded handle is still alive
+    // (thus, shared) and transformed in place otherwise.
 
-    return this->getEngine().template createHandle<decltype(encrypted_data)>(sizeof(Matrix) * encrypted_data.size(),
-                                                                             tagEncryptOutput,
-                                                                             std::move(encrypted_data));
+    return this->getEngine().duplicateHandle(encoded_data,
+                                             tagEncryptOutput, // output tag
+                                             tagEncodeOutput); // expected input tag
 }
 
 hebench::APIBridge::Handle ExampleBenchmark::decrypt(hebench::APIBridge::Handle encrypted_data)
 {
-    // we only do plain text in this example, so, just return a copy of our internal data
-    const std::vector<Matrix> &local_encrypted_data =
-        this->getEngine().template retrieveFromHandle<std::vector<Matrix>>(encrypted_data,
-                                                                           tagStoreOutput); // expected input tag
-
-    // Deep copy is performed for illustrative purposes only. A shallow copy is faster
-    // using Engine::duplicateHandle() as in load() and store(), but decryption
-    // usually takes longer than a shallow copy, so, deep copy shows a better example
-    // here.
+    // we only do plain text in this example, so, decryption is the identity
 
-    std::vector<Matrix> decrypted_data = local_encrypted_data;
+    // Shallow copy as in encrypt(): the result from the operation is shared, not copied.
 
-    return this->getEngine().template createHandle<decltype(decrypted_data)>(sizeof(Matrix) * decrypted_data.size(),
-                                                                             tagDecryptOutput,
-                                                                             std::move(decrypted_data));
+    return this->getEngine().duplicateHandle(encrypted_data,
+                                             tagDecryptOutput, // output tag
+                                             tagStoreOutput); // expected input tag
 }
 
 hebench::APIBridge::Handle ExampleBenchmark::load(const hebench::APIBridge::Handle *p_local_data, uint64_t count)
@@ -350,19 +331,19 @@ hebench::APIBridge::Handle ExampleBenchmark::operate(hebench::APIBridge::Handle
 
     // perform the actual operation
     Matrix &result = result_vector.front(); // alias the component for clarity
-    for (std::size_t row_0_i = 0; row_0_i < params[0].rows.size(); ++row_0_i)
+    for (std::size_t row_0_i = 0; row_0_i < params[0].extent(0); ++row_0_i)
     {
-        for (std::size_t col_0_i = 0; col_0_i < params[0].rows[row_0_i].size(); ++col_0_i)
+        for (std::size_t col_0_i = 0; col_0_i < params[0].extent(1); ++col_0_i)
         {
             double val = 0;
             for (int i = 0; i < 100; i++)
-                val += params[0].rows[row_0_i][i] * params[1].rows[i][col_0_i];
-            result.rows[row_0_i][col_0_i] = val;
+                val += params[0](row_0_i, i) * params[1](i, col_0_i);
+            result(row_0_i, col_0_i) = val;
         } // end for
     } // end for
 
     // send our internal result across the boundary of the API Bridge as a handle
-    return this->getEngine().template createHandle<decltype(result_vector)>(sizeof(Matrix) * result_vector.size(),
+    return this->getEngine().template createHandle<decltype(result_vector)>(sizeof(double) * result.size() * result_vector.size(),
                                                                             tagOperateOutput,
                                                                             std::move(result_vector));
 }
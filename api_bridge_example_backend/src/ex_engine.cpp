@@ -18,9 +18,6 @@ namespace cpp {
 
 BaseEngine *createEngine(const std::int8_t *p_buffer, std::uint64_t size)
 {
-    (void)p_buffer; // not used in this example
-    (void)size;
-
     if (HEBENCH_API_VERSION_MAJOR != HEBENCH_API_VERSION_NEEDED_MAJOR
         || HEBENCH_API_VERSION_MINOR != HEBENCH_API_VERSION_NEEDED_MINOR
         || HEBENCH_API_VERSION_REVISION < HEBENCH_API_VERSION_NEEDED_REVISION
@@ -29,7 +26,8 @@ BaseEngine *createEngine(const std::int8_t *p_buffer, std::uint64_t size)
         throw HEBenchError(HEBERROR_MSG("Critical: Invalid HEBench API version detected."),
                            HEBENCH_ECODE_CRITICAL_ERROR);
 
-    return ExampleEngine::create();
+    // the engine is constructed with its configuration, available during init()
+    return ExampleEngine::create(EngineConfig::parse(p_buffer, size));
 }
 
 void destroyEngine(BaseEngine *p)
@@ -45,9 +43,9 @@ void destroyEngine(BaseEngine *p)
 // class ExampleEngine
 //---------------------
 
-ExampleEngine *ExampleEngine::create()
+ExampleEngine *ExampleEngine::create(const hebench::cpp::EngineConfig &config)
 {
-    ExampleEngine *p_retval = new ExampleEngine();
+    ExampleEngine *p_retval = new ExampleEngine(config);
     p_retval->init();
     return p_retval;
 }
@@ -58,7 +56,8 @@ void ExampleEngine::destroy(ExampleEngine *p)
         delete p;
 }
 
-ExampleEngine::ExampleEngine()
+ExampleEngine::ExampleEngine(const hebench::cpp::EngineConfig &config) :
+    hebench::cpp::BaseEngine(config)
 {
 }
 
@@ -80,6 +79,7 @@ void ExampleEngine::init()
 
     addSecurityName(HEBENCH_HE_SECURITY_NONE, "None");
 
-    // add the all benchmark descriptors
-    addBenchmarkDescription(std::make_shared<ExampleBenchmarkDescription>());
+    // add the all benchmark descriptors:
+    // descriptions are created only when Test Harness first requests them
+    addBenchmarkDescription([]() { return std::make_shared<ExampleBenchmarkDescription>(); });
 }
@@ -96,6 +96,12 @@ public:
                                                    char *p_description, std::uint64_t size);
     static std::uint64_t getErrorDescription(Handle h_engine, ErrorCode code, char *p_description, std::uint64_t size);
     static std::uint64_t getLastErrorDescription(Handle h_engine, char *p_description, std::uint64_t size);
+    /**
+     * @brief Forwards to the loaded backend, if supported.
+     * @return Error code. Returns `HEBENCH_ECODE_INVALID_ARGS` if the loaded backend does
+     * not export this function (backends built against older API Bridge versions).
+     */
+    static ErrorCode getHandleStats(Handle h_engine, HandleStats *p_stats);
 
 private:
     /**
@@ -110,6 +116,11 @@ private:
      */
     DynamicLibLoad() {}
     static void *loadSymbol(void *handle, const std::string &name);
+    /**
+     * @brief Same as loadSymbol(), but returns null instead of throwing if the
+     * symbol is not found.
+     */
+    static void *loadOptionalSymbol(void *handle, const std::string &name);
 };
 } // namespace APIBridge
 } // namespace hebench
@@ -84,6 +84,8 @@ typedef std::uint64_t (*GetErrorDescription)(Handle h_engine, ErrorCode code, ch
 
 typedef std::uint64_t (*GetLastErrorDescription)(Handle h_engine, char *p_description, std::uint64_t size);
 
+typedef ErrorCode (*GetHandleStats)(Handle h_engine, HandleStats *p_stats);
+
 /**
  * @brief Holds function pointers to each method in the API Bridge with external linkage
  * @details Each data member contains the function pointer that one would expect based on
@@ -112,6 +114,7 @@ struct ExternFunctions
     GetBenchmarkDescriptionEx getBenchmarkDescriptionEx;
     GetErrorDescription getErrorDescription;
     GetLastErrorDescription getLastErrorDescription;
+    GetHandleStats getHandleStats; // optional: null if not exported by backend
 };
 
 struct DynamicLib
@@ -164,6 +167,7 @@ void DynamicLibLoad::loadLibrary(const std::string &path)
     m_functions.getBenchmarkDescriptionEx = (GetBenchmarkDescriptionEx)loadSymbol(m_lib->handle, "getBenchmarkDescriptionEx");
     m_functions.getErrorDescription       = (GetErrorDescription)loadSymbol(m_lib->handle, "getErrorDescription");
     m_functions.getLastErrorDescription   = (GetLastErrorDescription)loadSymbol(m_lib->handle, "getLastErrorDescription");
+    m_functions.getHandleStats            = (GetHandleStats)loadOptionalSymbol(m_lib->handle, "getHandleStats");
     std::cout << "[    DONE ] " << std::endl;
 }
 
@@ -185,6 +189,13 @@ void *DynamicLibLoad::loadSymbol(void *handle, const std::string &name)
     return fptr;
 }
 
+void *DynamicLibLoad::loadOptionalSymbol(void *handle, const std::string &name)
+{
+    void *fptr = dlsym(handle, name.c_str());
+    dlerror(); // reset
+    return fptr;
+}
+
 ErrorCode DynamicLibLoad::destroyHandle(Handle h)
 {
     return m_functions.destroyHandle(h);
@@ -302,6 +313,13 @@ std::uint64_t DynamicLibLoad::getLastErrorDescription(Handle h_engine, char *p_d
     return m_functions.getLastErrorDescription(h_engine, p_description, size);
 }
 
+ErrorCode DynamicLibLoad::getHandleStats(Handle h_engine, HandleStats *p_stats)
+{
+    if (!m_functions.getHandleStats)
+        return HEBENCH_ECODE_INVALID_ARGS;
+    return m_functions.getHandleStats(h_engine, p_stats);
+}
+
 } // namespace APIBridge
 } // namespace hebench
 
@@ -333,6 +351,7 @@ int compiler_test()
     f.getBenchmarkDescriptionEx = ::hebench::APIBridge::getBenchmarkDescriptionEx;
     f.getErrorDescription       = ::hebench::APIBridge::getErrorDescription;
     f.getLastErrorDescription   = ::hebench::APIBridge::getLastErrorDescription;
+    f.getHandleStats            = ::hebench::APIBridge::getHandleStats;
     (void)f;
 
     return 0;
@@ -122,5 +122,10 @@ std::uint64_t getLastErrorDescription(Handle h_engine, char *p_description, std:
     return DynamicLibLoad::getLastErrorDescription(h_engine, p_description, size);
 }
 
+ErrorCode getHandleStats(Handle h_engine, HandleStats *p_stats)
+{
+    return DynamicLibLoad::getHandleStats(h_engine, p_stats);
+}
+
 } // namespace APIBridge
 } // namespace hebench
@@ -628,6 +628,20 @@ extern "C" std::uint64_t getErrorDescription(Handle h_engine, ErrorCode code, ch
  */
 extern "C" std::uint64_t getLastErrorDescription(Handle h_engine, char *p_description, std::uint64_t size);
 
+/**
+ * @brief Retrieves accounting of the handles to backend data currently alive
+ * in the engine.
+ * @param[in] h_engine Handle to the backend engine.
+ * @param[out] p_stats Points to the structure to receive the statistics. Cannot be null.
+ * @return Error code.
+ * @details This function is for diagnostics only. Test Harness can use it to
+ * monitor memory requirements and detect leaked handles during long runs.
+ *
+ * Peaks are tracked from engine initialization, or from the last time the backend
+ * reset them, for example, to measure the peaks of each phase of a run.
+ */
+extern "C" ErrorCode getHandleStats(Handle h_engine, HandleStats *p_stats);
+
 } // namespace APIBridge
 } // namespace hebench
 
@@ -0,0 +1,154 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_AlignedAllocator_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_AlignedAllocator_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace hebench {
+namespace cpp {
+
+/**
+ * @brief Default alignment, in bytes, for buffers meant for SIMD kernels.
+ * @details Matches the size of a cache line and of the widest vector registers.
+ */
+constexpr std::size_t DefaultAlignment = 64;
+
+/**
+ * @brief Allocates uninitialized memory with the specified alignment.
+ * @param[in] size Number of bytes to allocate.
+ * @param[in] alignment Alignment in bytes. Must be a power of 2 and a multiple
+ * of `sizeof(void *)`.
+ * @return Pointer to the allocated memory. Must be released with freeAligned().
+ * @throws std::bad_alloc if allocation failed.
+ */
+void *allocateAligned(std::size_t size, std::size_t alignment = DefaultAlignment);
+
+/**
+ * @brief Size, in bytes, of the huge pages requested by allocateHugePages().
+ */
+constexpr std::size_t HugePageSize = std::size_t(2) << 20;
+
+/**
+ * @brief Allocates uninitialized memory backed by huge pages, if possible.
+ * @param[in] size Number of bytes to allocate.
+ * @param[in] alignment Minimum alignment in bytes, as in allocateAligned().
+ * @return Pointer to the allocated memory. Must be released with freeAligned().
+ * @throws std::bad_alloc if allocation failed.
+ * @details Allocations of, at least, HugePageSize bytes are rounded up to whole huge
+ * pages, aligned to HugePageSize, and advised to the kernel as huge page candidates
+ * (`MADV_HUGEPAGE`), which reduces TLB misses when traversing large buffers. The
+ * advice has no effect on systems without transparent huge pages. Smaller
+ * allocations behave as allocateAligned().
+ */
+void *allocateHugePages(std::size_t size, std::size_t alignment = DefaultAlignment);
+/**
+ * @brief Releases memory allocated by allocateAligned() or allocateHugePages().
+ */
+void freeAligned(void *p) noexcept;
+
+template <class T, std::size_t Alignment = DefaultAlignment>
+/**
+ * @brief Standard-compliant allocator returning memory aligned to `Alignment` bytes.
+ * @details Use with standard containers to obtain buffers that can be fed to SIMD
+ * kernels directly. See AlignedVector.
+ */
+class AlignedAllocator
+{
+public:
+    static_assert(Alignment >= alignof(T), "Alignment must not be less than the alignment of T.");
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2.");
+
+    typedef T value_type;
+    template <class U>
+    struct rebind
+    {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <class U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+        return static_cast<T *>(allocateAligned(n * sizeof(T), Alignment < sizeof(void *) ? sizeof(void *) : Alignment));
+    }
+    void deallocate(T *p, std::size_t) noexcept { freeAligned(p); }
+
+    template <class U>
+    bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept
+    {
+        return true;
+    }
+    template <class U>
+    bool operator!=(const AlignedAllocator<U, Alignment> &) const noexcept
+    {
+        return false;
+    }
+};
+
+template <class T, std::size_t Alignment = DefaultAlignment>
+/**
+ * @brief Standard-compliant allocator returning memory aligned to `Alignment` bytes
+ * and backed by huge pages when large enough.
+ * @sa allocateHugePages()
+ */
+class HugePageAllocator
+{
+public:
+    static_assert(Alignment >= alignof(T), "Alignment must not be less than the alignment of T.");
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2.");
+
+    typedef T value_type;
+    template <class U>
+    struct rebind
+    {
+        typedef HugePageAllocator<U, Alignment> other;
+    };
+
+    HugePageAllocator() noexcept = default;
+    template <class U>
+    HugePageAllocator(const HugePageAllocator<U, Alignment> &) noexcept
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+        return static_cast<T *>(allocateHugePages(n * sizeof(T), Alignment < sizeof(void *) ? sizeof(void *) : Alignment));
+    }
+    void deallocate(T *p, std::size_t) noexcept { freeAligned(p); }
+
+    template <class U>
+    bool operator==(const HugePageAllocator<U, Alignment> &) const noexcept
+    {
+        return true;
+    }
+    template <class U>
+    bool operator!=(const HugePageAllocator<U, Alignment> &) const noexcept
+    {
+        return false;
+    }
+};
+
+template <class T>
+/**
+ * @brief Vector whose elements start at a DefaultAlignment boundary.
+ */
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_AlignedAllocator_H_7e5fa8c2415240ea93eff148ed73539b
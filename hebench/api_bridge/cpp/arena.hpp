@@ -0,0 +1,213 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_Arena_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_Arena_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "error_handling.hpp"
+
+namespace hebench {
+namespace cpp {
+
+class BaseEngine;
+
+/**
+ * @brief Region allocator that releases all of its memory at once.
+ * @details Allocations are served by bumping a pointer inside large chunks of
+ * memory, and individual allocations are never released. All memory is reclaimed
+ * when the arena is destroyed.
+ *
+ * Objects created with create() that are not trivially destructible have their
+ * destructors registered and called, in reverse order of creation, when the arena
+ * is destroyed. Objects created with createUntracked() are never destroyed.
+ * Teardown is therefore O(n) on the number of chunks plus the number of registered
+ * destructors. Handles created in an arena register the destructor of their payload
+ * unless it is trivially destructible, so destroying an arena runs one destructor
+ * per such handle ever created in it: the arena saves a heap allocation and release
+ * per handle, not the destruction of the payloads.
+ *
+ * Allocation is thread safe.
+ * @sa BaseBenchmark::enableArena(), BaseEngine::createHandle(Arena &, std::uint64_t, std::int64_t, Args &&...)
+ */
+class Arena
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(Arena)
+
+public:
+    /**
+     * @brief Default size, in bytes, of the chunks of memory reserved by the arena.
+     */
+    static constexpr std::size_t DefaultChunkSize = 1 << 20;
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * @brief Creates an empty arena.
+     * @param[in] chunk_size Size, in bytes, of the chunks of memory to reserve.
+     * Allocations larger than half this size get a chunk of their own.
+     */
+    explicit Arena(std::size_t chunk_size = DefaultChunkSize);
+    /**
+     * @brief Calls registered destructors and releases all memory.
+     * @details O(n) on the number of registered destructors and chunks.
+     */
+    ~Arena();
+
+    /**
+     * @brief Allocates uninitialized memory from the arena.
+     * @param[in] size Number of bytes to allocate.
+     * @param[in] alignment Alignment in bytes. Must be a power of 2.
+     * @return Pointer to the allocated memory, valid until the arena is destroyed.
+     * @throws std::bad_alloc if allocation failed.
+     */
+    void *allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    template <class T, typename... Args>
+    /**
+     * @brief Constructs an object of type `T` in the arena.
+     * @return Pointer to the new object, valid until the arena is destroyed.
+     * @details The destructor of the object is called when the arena is destroyed,
+     * unless `T` is trivially destructible.
+     */
+    T *create(Args &&... args);
+    template <class T, typename... Args>
+    /**
+     * @brief Constructs an object of type `T` in the arena that is never destroyed.
+     * @details The memory of the object is reclaimed with the arena, but its destructor
+     * is never called. Only use for objects that do not own other resources.
+     */
+    T *createUntracked(Args &&... args);
+
+    /**
+     * @brief Destroys all objects and releases all memory, leaving the arena empty.
+     * @details All pointers to memory in the arena are invalidated. Not safe to call
+     * while other threads allocate from the arena.
+     */
+    void release();
+
+    /**
+     * @brief Number of bytes reserved from the system by this arena.
+     */
+    std::size_t capacity() const;
+    /**
+     * @brief Number of bytes served by this arena, including alignment padding.
+     */
+    std::size_t used() const;
+
+private:
+    friend class BaseEngine;
+
+    struct DestructorNode
+    {
+        void (*destroy)(void *);
+        void *p_obj;
+        DestructorNode *p_next;
+    };
+
+    template <class T>
+    static void destroyObject(void *p)
+    {
+        static_cast<T *>(p)->~T();
+    }
+    void registerDestructor(DestructorNode *p_node);
+    void *allocateChunk(std::size_t size);
+
+    std::size_t m_chunk_size;
+    mutable std::mutex m_mutex;
+    std::vector<void *> m_chunks;
+    char *m_p_current;
+    char *m_p_end;
+    std::size_t m_capacity;
+    std::size_t m_used;
+    DestructorNode *m_p_destructors;
+
+    // accounting of engine handles in this arena, maintained by BaseEngine
+    std::atomic<std::uint64_t> m_live_handles;
+    std::atomic<std::uint64_t> m_live_handles_size;
+};
+
+template <class T, typename... Args>
+T *Arena::createUntracked(Args &&... args)
+{
+    void *p = allocate(sizeof(T), alignof(T));
+    return new (p) T(std::forward<Args>(args)...);
+}
+
+template <class T, typename... Args>
+T *Arena::create(Args &&... args)
+{
+    if (std::is_trivially_destructible<T>::value)
+        return createUntracked<T>(std::forward<Args>(args)...);
+
+    void *p_node = allocate(sizeof(DestructorNode), alignof(DestructorNode));
+    T *retval    = createUntracked<T>(std::forward<Args>(args)...);
+    registerDestructor(new (p_node) DestructorNode{ &Arena::destroyObject<T>, retval, nullptr });
+    return retval;
+}
+
+template <class T>
+/**
+ * @brief Standard-compliant allocator that allocates from an Arena.
+ * @details Deallocation is a no-op: memory is reclaimed when the arena is destroyed.
+ */
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+    template <class U>
+    struct rebind
+    {
+        typedef ArenaAllocator<U> other;
+    };
+
+    explicit ArenaAllocator(Arena &arena) noexcept :
+        m_p_arena(&arena)
+    {
+    }
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U> &src) noexcept :
+        m_p_arena(&src.arena())
+    {
+    }
+
+    Arena &arena() const noexcept { return *m_p_arena; }
+
+    T *allocate(std::size_t n)
+    {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T))
+            throw std::bad_alloc();
+        return static_cast<T *>(m_p_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T *, std::size_t) noexcept {}
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U> &other) const noexcept
+    {
+        return m_p_arena == &other.arena();
+    }
+    template <class U>
+    bool operator!=(const ArenaAllocator<U> &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    Arena *m_p_arena;
+};
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_Arena_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,83 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_AsyncBenchmark_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_AsyncBenchmark_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstdint>
+
+#include "benchmark.hpp"
+#include "hebench/api_bridge/types.h"
+#include "task.hpp"
+
+namespace hebench {
+namespace cpp {
+
+/**
+ * @brief Base class for benchmarks whose remote operations are asynchronous.
+ * @details Backends that offload to accelerators or remote services implement
+ * loadAsync(), storeAsync() and operateAsync() as coroutines returning Task, and
+ * await the completion of their requests instead of blocking a thread on each of
+ * them. This class adapts the coroutines to the synchronous API Bridge entry
+ * points by running them to completion with syncWait().
+ *
+ * Pointer arguments remain valid until the returned task completes.
+ *
+ * Requires C++20: link against target `hebench_cpp_async`, enabled with CMake
+ * option `HEBENCH_CPP_ASYNC`.
+ */
+class AsyncBenchmark : public BaseBenchmark
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(AsyncBenchmark)
+
+public:
+    AsyncBenchmark(BaseEngine &engine,
+                   const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                   const hebench::APIBridge::WorkloadParams &bench_params) :
+        BaseBenchmark(engine, bench_desc, bench_params)
+    {
+    }
+    AsyncBenchmark(BaseEngine &engine,
+                   const hebench::APIBridge::BenchmarkDescriptor &bench_desc) :
+        BaseBenchmark(engine, bench_desc)
+    {
+    }
+    ~AsyncBenchmark() override = default;
+
+    hebench::APIBridge::Handle load(const hebench::APIBridge::Handle *p_local_data, std::uint64_t count) final
+    {
+        return syncWait(loadAsync(p_local_data, count));
+    }
+    void store(hebench::APIBridge::Handle remote_data, hebench::APIBridge::Handle *p_local_data, std::uint64_t count) final
+    {
+        syncWait(storeAsync(remote_data, p_local_data, count));
+    }
+    hebench::APIBridge::Handle operate(hebench::APIBridge::Handle h_remote_packed,
+                                       const hebench::APIBridge::ParameterIndexer *p_param_indexers,
+                                       std::uint64_t indexers_count) final
+    {
+        return syncWait(operateAsync(h_remote_packed, p_param_indexers, indexers_count));
+    }
+
+    /**
+     * @brief Asynchronous counterpart of load().
+     */
+    virtual Task<hebench::APIBridge::Handle> loadAsync(const hebench::APIBridge::Handle *p_local_data, std::uint64_t count) = 0;
+    /**
+     * @brief Asynchronous counterpart of store().
+     */
+    virtual Task<> storeAsync(hebench::APIBridge::Handle remote_data, hebench::APIBridge::Handle *p_local_data, std::uint64_t count) = 0;
+    /**
+     * @brief Asynchronous counterpart of operate().
+     */
+    virtual Task<hebench::APIBridge::Handle> operateAsync(hebench::APIBridge::Handle h_remote_packed,
+                                                          const hebench::APIBridge::ParameterIndexer *p_param_indexers,
+                                                          std::uint64_t indexers_count) = 0;
+};
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_AsyncBenchmark_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,236 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_Autotuner_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_Autotuner_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+
+namespace hebench {
+namespace cpp {
+
+//----------------------
+// class TuningDatabase
+//----------------------
+
+/**
+ * @brief Persistent store of the configurations selected by the Autotuner.
+ * @details Maps a tuning key to the name of the fastest configuration found and its
+ * time per run. The store is a text file with one entry per line,
+ * `key<TAB>choice<TAB>nanoseconds`, loaded on first use. Entries are written to
+ * the file as soon as they are stored: the file is read again and merged before
+ * being replaced, so that several processes can share the same database. On Linux,
+ * an advisory lock on the sidecar file `<filename>.lock` serializes writers across
+ * processes, so that concurrent stores do not drop each other's entries, and the new
+ * file is synced to storage before it replaces the previous one.
+ *
+ * All methods are thread-safe.
+ */
+class TuningDatabase
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(TuningDatabase)
+
+public:
+    struct Entry
+    {
+        /**
+         * @brief Name of the selected configuration.
+         */
+        std::string choice;
+        /**
+         * @brief Time of one run of the selected configuration, in nanoseconds.
+         */
+        std::uint64_t time_ns;
+    };
+
+    /**
+     * @brief Model of the CPU of the host, as reported by the operating system,
+     * or `"unknown"` if not available.
+     */
+    static const std::string &cpuModel();
+    /**
+     * @brief File named by environment variable `HEBENCH_TUNING_DB`, or empty if
+     * not set.
+     * @details An empty filename keeps the database in memory only: a persistent
+     * location must be chosen explicitly, through this variable or the `tuning_db`
+     * engine configuration key, instead of writing to the working directory.
+     */
+    static std::string defaultFilename();
+
+    /**
+     * @brief Creates a database backed by the specified file.
+     * @param[in] filename File of the database. The file is created when the first
+     * entry is stored. If empty, the database is kept in memory only.
+     */
+    explicit TuningDatabase(std::string filename = defaultFilename());
+
+    const std::string &filename() const { return m_filename; }
+    /**
+     * @brief Retrieves the entry for the specified key.
+     * @return `true` if an entry exists, `false` otherwise.
+     */
+    bool find(const std::string &key, Entry &entry) const;
+    /**
+     * @brief Adds or replaces the entry for the specified key and writes it to the file.
+     * @throws HEBenchError if the file could not be written. The entry is stored in
+     * memory regardless.
+     * @details Tabs and line breaks in \p key and in the choice are replaced by spaces.
+     */
+    void store(const std::string &key, const Entry &entry);
+    /**
+     * @brief Number of entries in the database.
+     */
+    std::size_t size() const;
+
+private:
+    void loadIfNeeded() const;
+    static void readFile(const std::string &filename, std::unordered_map<std::string, Entry> &entries);
+
+    std::string m_filename;
+    mutable std::mutex m_mutex;
+    mutable bool m_b_loaded;
+    mutable std::unordered_map<std::string, Entry> m_entries;
+};
+
+//-----------------
+// class Autotuner
+//-----------------
+
+/**
+ * @brief Selects the fastest among candidate configurations of a kernel.
+ * @details Candidates are named configurations, such as tile sizes, thread counts
+ * or algorithm choices. tune() times a trial run of each candidate, usually on
+ * synthetic data generated with DatasetGenerator, and returns the fastest. The
+ * choice is stored in a TuningDatabase under the tuning key and the model of the
+ * host CPU, so later runs on the same kind of host return it without timing.
+ *
+ * Benchmarks usually tune during `initialize()` through BaseBenchmark::autotune(),
+ * which builds the tuning key from the benchmark descriptor and workload parameters
+ * and uses the database of the engine.
+ */
+class Autotuner
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(Autotuner)
+
+public:
+    struct Options
+    {
+        /**
+         * @brief Untimed runs of each candidate before timing.
+         */
+        std::uint64_t warmup_iterations = 1;
+        /**
+         * @brief Minimum number of timed runs of each candidate.
+         */
+        std::uint64_t min_iterations = 3;
+        /**
+         * @brief Minimum time spent in timed runs of each candidate, in milliseconds.
+         */
+        std::uint64_t min_time_ms = 20;
+        /**
+         * @brief Maximum number of timed runs of each candidate.
+         */
+        std::uint64_t max_iterations = 1000;
+    };
+
+    /**
+     * @brief Creates a tuner with default timing options.
+     * @param[in] p_db Database where to look up and store choices. If null, every
+     * call to tune() times the candidates.
+     */
+    explicit Autotuner(TuningDatabase *p_db = nullptr);
+    /**
+     * @brief Creates a tuner.
+     * @param[in] p_db Database where to look up and store choices. If null, every
+     * call to tune() times the candidates.
+     * @param[in] options Timing options.
+     */
+    Autotuner(TuningDatabase *p_db, const Options &options);
+
+    /**
+     * @brief Builds a tuning key for a kernel of a benchmark.
+     * @param[in] kernel Name of the tuned kernel, unique in the backend.
+     * @param[in] bench_desc Descriptor of the benchmark.
+     * @param[in] w_params Workload parameters of the benchmark.
+     */
+    static std::string makeKey(const std::string &kernel,
+                               const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                               const std::vector<hebench::APIBridge::WorkloadParam> &w_params);
+
+    template <class Config, class Trial>
+    /**
+     * @brief Selects the fastest candidate configuration.
+     * @param[in] key Tuning key of the problem. See makeKey().
+     * @param[in] candidates Non-empty list of configurations, each with a unique name.
+     * @param[in] trial Functor called as `trial(const Config &)` to run the kernel once
+     * with a configuration.
+     * @return Reference to the fastest configuration in \p candidates.
+     * @throws HEBenchError if \p candidates is empty. If every trial throws, the
+     * exception of the first trial is rethrown.
+     * @details Candidates whose trial throws are discarded. The choice stored in the
+     * database is returned without running any trial if it names a candidate.
+     * Failing to write the database does not fail tuning.
+     */
+    const Config &tune(const std::string &key,
+                       const std::vector<std::pair<std::string, Config>> &candidates,
+                       const Trial &trial);
+    /**
+     * @brief Selects the fastest candidate configuration, by index.
+     * @param[in] key Tuning key of the problem.
+     * @param[in] names Non-empty list of unique names of the candidates.
+     * @param[in] trial Function that runs the kernel once with the candidate at the
+     * specified index.
+     * @return Index of the fastest candidate in \p names.
+     * @sa tune(const std::string &, const std::vector<std::pair<std::string, Config>> &, const Trial &)
+     */
+    std::size_t tune(const std::string &key,
+                     const std::vector<std::string> &names,
+                     const std::function<void(std::size_t)> &trial);
+
+    /**
+     * @brief Whether the last call to tune() took its choice from the database.
+     */
+    bool lastFromDatabase() const { return m_b_last_from_db; }
+    /**
+     * @brief Time of one run of the last choice, in nanoseconds.
+     */
+    std::uint64_t lastTime() const { return m_last_time_ns; }
+
+private:
+    std::uint64_t timeTrial(std::size_t index, const std::function<void(std::size_t)> &trial) const;
+
+    TuningDatabase *m_p_db;
+    Options m_options;
+    bool m_b_last_from_db;
+    std::uint64_t m_last_time_ns;
+};
+
+template <class Config, class Trial>
+const Config &Autotuner::tune(const std::string &key,
+                              const std::vector<std::pair<std::string, Config>> &candidates,
+                              const Trial &trial)
+{
+    std::vector<std::string> names;
+    names.reserve(candidates.size());
+    for (const auto &candidate : candidates)
+        names.push_back(candidate.first);
+    std::size_t choice = tune(key, names, [&candidates, &trial](std::size_t index) { trial(candidates[index].second); });
+    return candidates[choice].second;
+}
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_Autotuner_H_7e5fa8c2415240ea93eff148ed73539b
@@ -7,11 +7,18 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "arena.hpp"
+#include "autotuner.hpp"
+#include "constant_operand_cache.hpp"
+#include "engine.hpp"
 #include "engine_object.hpp"
 #include "error_handling.hpp"
 #include "hebench/api_bridge/types.h"
+#include "parameter_sweep.hpp"
 #include "workload_params.hpp"
 
 namespace hebench {
@@ -60,8 +67,28 @@ public:
      * @brief Retrieves the sets of default arguments supported by this benchmark's workload.
      * @return A collection of sets of default arguments supported by this benchmark's workload.
      * The collection is empty if this workload does not have parameters.
+     * @details Deprecated: builds, and returns by value, the full cartesian product of
+     * every sweep added with addDefaultParameters(). This allocates one vector per set,
+     * which may be millions for large sweeps. Use getWorkloadDefaultParametersCount()
+     * and getWorkloadDefaultParameters(std::uint64_t, hebench::APIBridge::WorkloadParam *)
+     * to retrieve one set at a time instead.
      */
-    const std::vector<std::vector<hebench::APIBridge::WorkloadParam>> &getWorkloadDefaultParameters() const { return m_default_params; }
+    [[deprecated("Expands every sweep: use getWorkloadDefaultParametersCount() and getWorkloadDefaultParameters(set_index, p_params).")]]
+    std::vector<std::vector<hebench::APIBridge::WorkloadParam>> getWorkloadDefaultParameters() const;
+    /**
+     * @brief Retrieves the number of sets of default arguments supported by this
+     * benchmark's workload, including every set in the sweeps added.
+     */
+    std::uint64_t getWorkloadDefaultParametersCount() const;
+    /**
+     * @brief Retrieves a single set of default arguments supported by this benchmark's workload.
+     * @param[in] set_index Index of the set, in range `[0, getWorkloadDefaultParametersCount())`.
+     * Sets are ordered as they were added, with sets of a sweep in sweep order.
+     * @param[out] p_params Array of getWorkloadParameterCount() elements where to store the set.
+     * @throws std::out_of_range if \p set_index is out of range.
+     * @details Sets in sweeps are computed on demand.
+     */
+    void getWorkloadDefaultParameters(std::uint64_t set_index, hebench::APIBridge::WorkloadParam *p_params) const;
     /**
      * @brief Retrieves human-readable description specific to the represented benchmark.
      * @return A string containing the human-readable description for the benchmark as
@@ -129,9 +156,28 @@ protected:
      * the same as any other existing default parameter sets.
      */
     void addDefaultParameters(const std::vector<hebench::APIBridge::WorkloadParam> &default_params_set);
+    /**
+     * @brief Adds every set of arguments in a sweep as default arguments for the
+     * parameters for this benchmark's workload.
+     * @param[in] default_params_sweep Sweep of sets of default values for the parameters
+     * of this workload. Sets are not expanded until requested.
+     * @throws std::invalid_argument if the number of parameters in \p default_params_sweep
+     * is invalid. See details.
+     * @details Sets in \p default_params_sweep must have the same amount of parameters
+     * as any other existing default parameter sets.
+     *
+     * Sweeps declare scaling studies, such as ranges or geometric progressions of sizes,
+     * without enumerating every set:
+     * @code
+     * typedef WorkloadSchema<WorkloadSchemas::VectorSize> Params;
+     * addDefaultParameters(WorkloadSweep(Params::makeDefault(1)).vary(Params::N, ParameterSweep::geometric(1024, 1 << 20)));
+     * @endcode
+     * @sa WorkloadSweep
+     */
+    void addDefaultParameters(const WorkloadSweep &default_params_sweep);
 
 private:
-    std::vector<std::vector<hebench::APIBridge::WorkloadParam>> m_default_params;
+    std::vector<WorkloadSweep> m_default_params;
 };
 
 /**
@@ -181,6 +227,25 @@ public:
      * to add different behavior.
      */
     virtual void initialize(const hebench::APIBridge::BenchmarkDescriptor &bench_desc_concrete);
+    /**
+     * @brief Called when the benchmark is released to the benchmark pool of the engine
+     * to restore it for reuse.
+     * @return `true` if the benchmark was restored and can be reused, `false` if it
+     * must be destroyed.
+     * @details When benchmark pooling is enabled (see BaseEngine::setBenchmarkPoolSize()),
+     * a destroyed benchmark is kept and returned again by a later creation with the same
+     * description and workload parameters, instead of constructing a new one.
+     *
+     * Overrides should release the state of the last run, such as handles and results,
+     * while keeping expensive precomputation that depends only on the description and
+     * workload parameters. `initialize()` is called again before the benchmark is reused.
+     * When this method is called, handles created in the arena of the benchmark (see
+     * enableArena()) are already invalid, and the arena is emptied afterwards.
+     *
+     * Default implementation returns `false`: benchmarks are not reused unless they
+     * opt in.
+     */
+    virtual bool reset();
     virtual hebench::APIBridge::Handle encode(const hebench::APIBridge::DataPackCollection *p_parameters)          = 0;
     virtual void decode(hebench::APIBridge::Handle encoded_data, hebench::APIBridge::DataPackCollection *p_native) = 0;
     virtual hebench::APIBridge::Handle encrypt(hebench::APIBridge::Handle encoded_data)                            = 0;
@@ -193,11 +258,63 @@ public:
                                                const hebench::APIBridge::ParameterIndexer *p_param_indexers,
                                                std::uint64_t indexers_count) = 0;
 
+    /**
+     * @brief Non-throwing variants of the benchmark operations.
+     * @details These are the methods called by the C++ wrapper implementation of
+     * the API Bridge. On success, they return `HEBENCH_ECODE_SUCCESS` and store the
+     * result in the output argument. On failure, they return the error code after
+     * setting the last error, and no exception must escape them.
+     *
+     * Default implementations call the corresponding throwing method (for example,
+     * tryEncode() calls encode()) and translate any exception into an error code.
+     * Default tryEncode() and tryEncrypt() also serve operands marked constant from
+     * the cache (see markConstantOperand()); overrides bypass the cache.
+     *
+     * Derived classes with error-heavy validation, or that are called in tight
+     * loops, can override these to report errors without the cost of exception
+     * unwinding or message formatting:
+     * @code
+     * if (!p_parameters->pack_count)
+     *     return BaseEngine::reportError(HEBERROR_RECORD_CLASS("Invalid empty parameters.",
+     *                                                          HEBENCH_ECODE_INVALID_ARGS));
+     * @endcode
+     * @sa BaseEngine::reportError(), ErrorRecord
+     */
+    virtual hebench::APIBridge::ErrorCode tryInitialize(const hebench::APIBridge::BenchmarkDescriptor &bench_desc_concrete);
+    virtual hebench::APIBridge::ErrorCode tryEncode(const hebench::APIBridge::DataPackCollection *p_parameters,
+                                                    hebench::APIBridge::Handle *p_h_encoded);
+    virtual hebench::APIBridge::ErrorCode tryDecode(hebench::APIBridge::Handle encoded_data,
+                                                    hebench::APIBridge::DataPackCollection *p_native);
+    virtual hebench::APIBridge::ErrorCode tryEncrypt(hebench::APIBridge::Handle encoded_data,
+                                                     hebench::APIBridge::Handle *p_h_encrypted);
+    virtual hebench::APIBridge::ErrorCode tryDecrypt(hebench::APIBridge::Handle encrypted_data,
+                                                     hebench::APIBridge::Handle *p_h_decrypted);
+    virtual hebench::APIBridge::ErrorCode tryLoad(const hebench::APIBridge::Handle *p_local_data, std::uint64_t count,
+                                                  hebench::APIBridge::Handle *p_h_remote);
+    virtual hebench::APIBridge::ErrorCode tryStore(hebench::APIBridge::Handle remote_data,
+                                                   hebench::APIBridge::Handle *p_local_data, std::uint64_t count);
+    virtual hebench::APIBridge::ErrorCode tryOperate(hebench::APIBridge::Handle h_remote_packed,
+                                                     const hebench::APIBridge::ParameterIndexer *p_param_indexers,
+                                                     std::uint64_t indexers_count,
+                                                     hebench::APIBridge::Handle *p_h_result);
+
     BaseEngine &getEngine() { return m_engine; }
     const BaseEngine &getEngine() const { return m_engine; }
 
     std::int64_t classTag() const override { return BaseBenchmark::tag; }
 
+    /**
+     * @brief Arena owned by this benchmark, or null if not enabled.
+     * @sa enableArena()
+     */
+    Arena *arena() const { return m_p_arena.get(); }
+    /**
+     * @brief Cache of constant operands of this benchmark, or null if no operand
+     * is marked constant.
+     * @sa markConstantOperand()
+     */
+    ConstantOperandCache *constantOperandCache() const { return m_p_constant_cache.get(); }
+
     const hebench::APIBridge::BenchmarkDescriptor &getDescriptor() const { return m_bench_description; }
     const std::vector<hebench::APIBridge::WorkloadParam> &getWorkloadParameters() const { return m_bench_params; }
 
@@ -236,12 +353,100 @@ protected:
                                                       std::uint64_t param_position);
     void setDescriptor(const hebench::APIBridge::BenchmarkDescriptor &value) { m_bench_description = value; }
 
+    /**
+     * @brief Enables an arena owned by this benchmark where to allocate handles.
+     * @param[in] chunk_size Size, in bytes, of the chunks of memory reserved by the arena.
+     * @throws std::logic_error if the arena is already enabled.
+     * @details Once enabled, handles created with createHandle() are allocated in
+     * the arena: destroying them only updates accounting, and their objects are
+     * destroyed and their memory reclaimed when the benchmark is destroyed. Teardown
+     * runs the destructor of every payload ever created in the arena (see Arena). This
+     * suits benchmarks that create many short-lived handles, but keeps memory of
+     * destroyed handles reserved until the benchmark is destroyed.
+     *
+     * Handles created in the arena must not be used, nor destroyed, after the benchmark
+     * is destroyed. Call from the constructor of the derived class.
+     */
+    void enableArena(std::size_t chunk_size = Arena::DefaultChunkSize);
+    /**
+     * @brief Marks the operand in the specified parameter position as constant.
+     * @details Operands that do not change across calls, such as the weights of a
+     * model, are encoded and encrypted once per distinct content: repeated calls to
+     * `hebench::APIBridge::encode()` with the same data for constant operands return
+     * a duplicate of the handle previously encoded, and `hebench::APIBridge::encrypt()`
+     * of that handle returns a duplicate of the handle previously encrypted. See
+     * ConstantOperandCache for details.
+     *
+     * Only calls whose DataPackCollection contains exclusively constant operands are
+     * cached. Call from the constructor of the derived class.
+     */
+    void markConstantOperand(std::uint64_t param_position);
+    template <class T, typename... Args>
+    /**
+     * @brief Encapsulates an object of type T in an opaque HEBench handle, allocated
+     * in the arena of this benchmark, if enabled.
+     * @details Equivalent to BaseEngine::createHandle() on the arena of this benchmark,
+     * or on the heap if the arena is not enabled.
+     * @sa enableArena()
+     */
+    hebench::APIBridge::Handle createHandle(std::uint64_t size, std::int64_t extra_tags,
+                                            Args &&... args) const;
+    template <class Config, class Trial>
+    /**
+     * @brief Selects the fastest configuration of a kernel for this benchmark on
+     * this host.
+     * @param[in] kernel Name of the tuned kernel, unique in the backend.
+     * @param[in] candidates Non-empty list of named configurations.
+     * @param[in] trial Functor called as `trial(const Config &)` to run the kernel once
+     * with a configuration, usually on synthetic data.
+     * @param[in] options Timing options.
+     * @return Reference to the fastest configuration in \p candidates.
+     * @details Tunes with an Autotuner on the tuningDatabase() of the engine, with a
+     * tuning key made of \p kernel, the descriptor and workload parameters of this
+     * benchmark, and the number of threads of the engine pool. Only the first run on
+     * a CPU model times the candidates: later runs read the choice from the database.
+     * Call from initialize() or from the constructor of the derived class:
+     * @code
+     * std::vector<std::pair<std::string, std::uint64_t>> tiles = { { "tile32", 32 }, { "tile64", 64 }, { "tile128", 128 } };
+     * GeneratedDataset data = DatasetGenerator(0).generate(getDescriptor(), w_params, &getEngine().threadPool());
+     * m_tile = autotune("matmul_tile", tiles, [&](std::uint64_t tile) { multiply(data, tile); });
+     * @endcode
+     * @sa Autotuner::tune()
+     */
+    const Config &autotune(const std::string &kernel,
+                           const std::vector<std::pair<std::string, Config>> &candidates,
+                           const Trial &trial,
+                           const Autotuner::Options &options = Autotuner::Options()) const;
+
 private:
     BaseEngine &m_engine;
     hebench::APIBridge::BenchmarkDescriptor m_bench_description;
     std::vector<hebench::APIBridge::WorkloadParam> m_bench_params;
+    std::unique_ptr<Arena> m_p_arena;
+    std::unique_ptr<ConstantOperandCache> m_p_constant_cache; // may hold handles in arena
 };
 
+template <class T, typename... Args>
+hebench::APIBridge::Handle BaseBenchmark::createHandle(std::uint64_t size, std::int64_t extra_tags,
+                                                       Args &&... args) const
+{
+    return m_p_arena ?
+               m_engine.template createHandle<T>(*m_p_arena, size, extra_tags, std::forward<Args>(args)...) :
+               m_engine.template createHandle<T>(size, extra_tags, std::forward<Args>(args)...);
+}
+
+template <class Config, class Trial>
+const Config &BaseBenchmark::autotune(const std::string &kernel,
+                                      const std::vector<std::pair<std::string, Config>> &candidates,
+                                      const Trial &trial,
+                                      const Autotuner::Options &options) const
+{
+    Autotuner tuner(&m_engine.tuningDatabase(), options);
+    std::string key = Autotuner::makeKey(kernel, m_bench_description, m_bench_params)
+                      + ";threads=" + std::to_string(m_engine.threadPool().threadCount());
+    return tuner.tune(key, candidates, trial);
+}
+
 } // namespace cpp
 } // namespace hebench
 
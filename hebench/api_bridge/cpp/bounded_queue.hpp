@@ -0,0 +1,176 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_BoundedQueue_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_BoundedQueue_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "error_handling.hpp"
+
+namespace hebench {
+namespace cpp {
+
+template <class T>
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue.
+ * @details Fixed capacity ring buffer where each cell carries a sequence number
+ * (D. Vyukov's bounded MPMC queue). Push and pop cost one compare-and-swap in the
+ * absence of contention, and never block nor allocate: they fail when the queue
+ * is full or empty, respectively.
+ *
+ * Type `T` must be default constructible and nothrow move assignable.
+ */
+class BoundedQueue
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(BoundedQueue)
+
+public:
+    BoundedQueue(const BoundedQueue &) = delete;
+    BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+    /**
+     * @brief Creates an empty queue.
+     * @param[in] capacity Maximum number of elements in the queue. Rounded up to
+     * the next power of 2, and to at least 2.
+     * @throws std::invalid_argument if \p capacity is 0 or cannot be rounded up to a
+     * power of 2 in `std::size_t`.
+     */
+    explicit BoundedQueue(std::size_t capacity);
+
+    /**
+     * @brief Maximum number of elements in the queue.
+     */
+    std::size_t capacity() const { return m_mask + 1; }
+
+    /**
+     * @brief Attempts to enqueue an element.
+     * @param[in,out] value Element to enqueue. Moved from only on success.
+     * @return `true` on success, `false` if the queue is full.
+     */
+    bool tryPush(T &value);
+    /**
+     * @brief Attempts to dequeue an element.
+     * @param[out] value Receives the dequeued element on success.
+     * @return `true` on success, `false` if the queue is empty.
+     */
+    bool tryPop(T &value);
+    /**
+     * @brief Tests whether the queue is empty.
+     * @details Result is only a hint when other threads access the queue.
+     */
+    bool empty() const;
+
+private:
+    static constexpr std::size_t CacheLineSize = 64;
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    std::size_t m_mask;
+    // producers and consumers update different cache lines
+    char m_padding0[CacheLineSize];
+    std::atomic<std::size_t> m_enqueue_pos;
+    char m_padding1[CacheLineSize - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> m_dequeue_pos;
+    char m_padding2[CacheLineSize - sizeof(std::atomic<std::size_t>)];
+};
+
+template <class T>
+constexpr std::size_t BoundedQueue<T>::CacheLineSize;
+
+template <class T>
+BoundedQueue<T>::BoundedQueue(std::size_t capacity) :
+    m_enqueue_pos(0),
+    m_dequeue_pos(0)
+{
+    if (capacity == 0)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid zero capacity."));
+    if (capacity > (std::numeric_limits<std::size_t>::max() >> 1) + 1)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid capacity " + std::to_string(capacity) + ": exceeds the largest power of 2."));
+
+    // a single cell cannot tell a full queue from an empty one
+    std::size_t rounded = 2;
+    while (rounded < capacity)
+        rounded <<= 1;
+    m_cells.reset(new Cell[rounded]);
+    m_mask = rounded - 1;
+    for (std::size_t i = 0; i < rounded; ++i)
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <class T>
+bool BoundedQueue<T>::tryPush(T &value)
+{
+    Cell *p_cell;
+    std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        p_cell            = &m_cells[pos & m_mask];
+        std::size_t seq   = p_cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t df = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (df == 0)
+        {
+            if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } // end if
+        else if (df < 0)
+            return false; // full
+        else
+            pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    } // end while
+
+    p_cell->value = std::move(value);
+    p_cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <class T>
+bool BoundedQueue<T>::tryPop(T &value)
+{
+    Cell *p_cell;
+    std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        p_cell            = &m_cells[pos & m_mask];
+        std::size_t seq   = p_cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t df = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+        if (df == 0)
+        {
+            if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } // end if
+        else if (df < 0)
+            return false; // empty
+        else
+            pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    } // end while
+
+    value = std::move(p_cell->value);
+    p_cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+}
+
+template <class T>
+bool BoundedQueue<T>::empty() const
+{
+    std::size_t pos = m_dequeue_pos.load(std::memory_order_acquire);
+    return m_cells[pos & m_mask].sequence.load(std::memory_order_acquire) != pos + 1;
+}
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_BoundedQueue_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,231 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_CartesianProduct_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_CartesianProduct_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+#include "thread_pool.hpp"
+
+namespace hebench {
+namespace cpp {
+
+/**
+ * @brief Enumerates the cartesian product of operand samples requested in a call
+ * to `operate()` and executes a kernel for each tuple, in parallel.
+ * @details For an operation with `N` operands, the `ParameterIndexer` for operand
+ * `d` selects samples `[value_index, value_index + batch_size)` of that operand.
+ * The operation must be computed for every tuple in the cartesian product of these
+ * ranges, and the results are expected in row-major order: the result index of a
+ * tuple with sample offsets `(i_0, i_1, ..., i_{N-1})` relative to each `value_index` is
+ * `((i_0 * batch_size_1 + i_1) * batch_size_2 + i_2) ...`
+ * (see \ref results_order ).
+ *
+ * The product is partitioned into N-dimensional tiles, each one covering a block of
+ * consecutive samples per operand, so that the samples touched by a tile fit in
+ * cache and are reused across the tuples of the tile. Tiles are executed in parallel
+ * in a ThreadPool, and each tuple is visited exactly once.
+ *
+ * Example for an offline `operate()`:
+ * @code
+ * CartesianProduct product(p_param_indexers, indexers_count);
+ * std::vector<Result> results(product.size());
+ * product.transform(getEngine().threadPool(), results.data(),
+ *                   [&](const std::uint64_t *sample_indices) {
+ *                       return compute(a[sample_indices[0]], b[sample_indices[1]]);
+ *                   });
+ * @endcode
+ */
+class CartesianProduct
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(CartesianProduct)
+
+public:
+    /**
+     * @brief Default number of tuples in a tile when the sizes of samples are unknown.
+     */
+    static constexpr std::uint64_t DefaultTileVolume = 1024;
+    /**
+     * @brief Default cache budget, in bytes, used by fitTileToCache().
+     */
+    static constexpr std::uint64_t DefaultCacheBytes = 256 * 1024;
+
+    /**
+     * @brief Creates the product for the specified indexers.
+     * @param[in] p_param_indexers Indexers as received by `operate()`, one per operand.
+     * @param[in] indexers_count Number of operands.
+     * @throws std::invalid_argument if there are no operands, the number of tuples
+     * does not fit in 64 bits, or `value_index + batch_size` of any indexer does not.
+     */
+    CartesianProduct(const hebench::APIBridge::ParameterIndexer *p_param_indexers,
+                     std::uint64_t indexers_count);
+
+    /**
+     * @brief Number of operands in the product.
+     */
+    std::size_t operandCount() const { return m_indexers.size(); }
+    /**
+     * @brief Total number of tuples in the product, which is the number of results.
+     */
+    std::uint64_t size() const { return m_size; }
+    /**
+     * @brief Indexer for the specified operand.
+     */
+    const hebench::APIBridge::ParameterIndexer &indexer(std::size_t operand) const { return m_indexers[operand]; }
+    /**
+     * @brief Number of samples in each dimension of a tile.
+     */
+    const std::vector<std::uint64_t> &tileExtents() const { return m_tile_extents; }
+
+    /**
+     * @brief Sets the number of samples per operand in each tile.
+     * @param[in] p_extents Array of operandCount() extents. Zeros are replaced by 1,
+     * and extents larger than the batch size of their operand are clipped.
+     */
+    void setTileExtents(const std::uint64_t *p_extents);
+    /**
+     * @brief Sets tile extents such that the samples touched by a tile fit in the
+     * specified cache budget.
+     * @param[in] p_sample_bytes Array of operandCount() elements with the size, in bytes,
+     * of a sample of each operand.
+     * @param[in] cache_bytes Cache budget in bytes.
+     * @details Extents are kept as balanced as possible among operands to maximize
+     * reuse of each sample within a tile.
+     */
+    void fitTileToCache(const std::uint64_t *p_sample_bytes, std::uint64_t cache_bytes = DefaultCacheBytes);
+
+    /**
+     * @brief Computes the sample indices for a result index.
+     * @param[in] result_index Row-major index of the tuple, in range `[0, size())`.
+     * @param[out] p_sample_indices Array of operandCount() elements where to store the
+     * index of the sample of each operand in its DataPack (`value_index` included).
+     */
+    void sampleIndices(std::uint64_t result_index, std::uint64_t *p_sample_indices) const;
+
+    template <class Kernel>
+    /**
+     * @brief Executes a kernel for every tuple in the product.
+     * @param[in] pool Pool where to execute tiles in parallel.
+     * @param[in] kernel Functor called as
+     * `kernel(const std::uint64_t *sample_indices, std::uint64_t result_index)`, where
+     * `sample_indices` contains operandCount() indices of samples in their DataPack
+     * (`value_index` included), and `result_index` is the row-major index of the tuple.
+     * @details Calls to \p kernel occur concurrently for different tuples. If any
+     * call throws, the first exception is rethrown after all tiles complete.
+     */
+    void forEach(ThreadPool &pool, const Kernel &kernel) const;
+    template <class Kernel>
+    /**
+     * @brief Executes a kernel for every tuple in the product in the calling thread.
+     * @sa forEach(ThreadPool &, const Kernel &)
+     */
+    void forEach(const Kernel &kernel) const;
+    template <class R, class Kernel>
+    /**
+     * @brief Executes a kernel for every tuple in the product and stores its result.
+     * @param[in] pool Pool where to execute tiles in parallel.
+     * @param[out] p_results Preallocated array of size() elements where to store the
+     * results in row-major order.
+     * @param[in] kernel Functor called as `kernel(const std::uint64_t *sample_indices)`
+     * returning a value assignable to `R`.
+     */
+    void transform(ThreadPool &pool, R *p_results, const Kernel &kernel) const;
+
+private:
+    std::uint64_t tileCount() const;
+    template <class Kernel>
+    void runTile(std::uint64_t tile_index, const Kernel &kernel) const;
+
+    std::vector<hebench::APIBridge::ParameterIndexer> m_indexers;
+    std::vector<std::uint64_t> m_strides; // row-major strides of result indices
+    std::vector<std::uint64_t> m_tile_extents;
+    std::vector<std::uint64_t> m_tile_grid; // number of tiles per operand
+    std::uint64_t m_size;
+};
+
+template <class Kernel>
+void CartesianProduct::runTile(std::uint64_t tile_index, const Kernel &kernel) const
+{
+    const std::size_t n = m_indexers.size();
+    std::vector<std::uint64_t> begin(n);
+    std::vector<std::uint64_t> end(n);
+    std::vector<std::uint64_t> sample_indices(n);
+
+    // tile coordinates from row-major tile index
+    for (std::size_t d = n; d-- > 0;)
+    {
+        std::uint64_t coord = tile_index % m_tile_grid[d];
+        tile_index /= m_tile_grid[d];
+        begin[d]          = coord * m_tile_extents[d];
+        end[d]            = std::min(begin[d] + m_tile_extents[d], m_indexers[d].batch_size);
+        sample_indices[d] = m_indexers[d].value_index + begin[d];
+    } // end for
+
+    std::uint64_t result_index = 0;
+    for (std::size_t d = 0; d < n; ++d)
+        result_index += begin[d] * m_strides[d];
+
+    // odometer over the tile, last operand varying fastest
+    while (true)
+    {
+        kernel(sample_indices.data(), result_index);
+
+        std::size_t d = n;
+        while (d-- > 0)
+        {
+            ++sample_indices[d];
+            result_index += m_strides[d];
+            if (sample_indices[d] < m_indexers[d].value_index + end[d])
+                break;
+            std::uint64_t extent = end[d] - begin[d];
+            sample_indices[d] -= extent;
+            result_index -= extent * m_strides[d];
+        } // end while
+        if (d >= n) // every dimension wrapped around
+            break;
+    } // end while
+}
+
+template <class Kernel>
+void CartesianProduct::forEach(ThreadPool &pool, const Kernel &kernel) const
+{
+    if (m_size > 0)
+        pool.parallelFor(
+            0, tileCount(),
+            [this, &kernel](std::size_t tile_index) { runTile(tile_index, kernel); },
+            1);
+}
+
+template <class Kernel>
+void CartesianProduct::forEach(const Kernel &kernel) const
+{
+    if (m_size > 0)
+    {
+        std::uint64_t tile_count = tileCount();
+        for (std::uint64_t tile_index = 0; tile_index < tile_count; ++tile_index)
+            runTile(tile_index, kernel);
+    } // end if
+}
+
+template <class R, class Kernel>
+void CartesianProduct::transform(ThreadPool &pool, R *p_results, const Kernel &kernel) const
+{
+    if (m_size > 0 && !p_results)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid null results array 'p_results'."));
+    forEach(pool, [p_results, &kernel](const std::uint64_t *sample_indices, std::uint64_t result_index) {
+        p_results[result_index] = kernel(sample_indices);
+    });
+}
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_CartesianProduct_H_7e5fa8c2415240ea93eff148ed73539b
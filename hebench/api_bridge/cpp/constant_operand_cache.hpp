@@ -0,0 +1,193 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_ConstantOperandCache_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_ConstantOperandCache_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+
+namespace hebench {
+namespace cpp {
+
+class BaseEngine;
+
+/**
+ * @brief Caches the encoded and encrypted forms of operands that remain constant
+ * across calls, such as the weights and bias of a logistic regression.
+ * @details Operands are marked constant by parameter position. When `encode()` is
+ * requested for a DataPackCollection containing only constant operands, the content
+ * of its buffers is hashed, and, if the same content was encoded before, a duplicate
+ * of the cached handle is returned instead of encoding again. Likewise, `encrypt()`
+ * of a handle sharing its object with a cached encoded handle returns a duplicate of
+ * the cached encrypted handle.
+ *
+ * Content is looked up by a 64-bit hash (see Utilities::hash64()) of the data and
+ * the layout of the collection. The cache keeps a copy of the content of each entry,
+ * and a hash hit is only served after comparing that copy byte by byte, so hash
+ * collisions never return the encoding of different data. This copy doubles the
+ * memory used by constant operands in their native form.
+ *
+ * Only handles created by BaseEngine::createHandle() are cached, since caching relies
+ * on BaseEngine::duplicateHandle(). Cached handles stay alive until evicted or until
+ * the cache is cleared or destroyed.
+ *
+ * Benchmarks use this cache through BaseBenchmark::markConstantOperand().
+ *
+ * encode(), encrypt(), clear() and size() are thread safe. Operands must be marked
+ * constant before any other call.
+ */
+class ConstantOperandCache
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(ConstantOperandCache)
+
+public:
+    /**
+     * @brief Default maximum number of operand contents cached.
+     */
+    static constexpr std::size_t DefaultCapacity = 16;
+
+    ConstantOperandCache(const ConstantOperandCache &) = delete;
+    ConstantOperandCache &operator=(const ConstantOperandCache &) = delete;
+
+    explicit ConstantOperandCache(const BaseEngine &engine, std::size_t capacity = DefaultCapacity);
+    /**
+     * @brief Destroys all cached handles.
+     */
+    ~ConstantOperandCache();
+
+    /**
+     * @brief Marks operands in the specified parameter position as constant.
+     */
+    void markConstant(std::uint64_t param_position);
+    bool isConstant(std::uint64_t param_position) const;
+    /**
+     * @brief Tests whether a collection only contains constant operands.
+     */
+    bool isConstant(const hebench::APIBridge::DataPackCollection &parameters) const;
+
+    template <class EncodeFn>
+    /**
+     * @brief Encodes the specified parameters, or returns the cached encoding.
+     * @param[in] parameters Parameters as received by `encode()`.
+     * @param[in] encode_fn Functor called as `encode_fn()` returning the handle with
+     * the encoded parameters when not cached.
+     * @return Handle to the encoded parameters. Owned by the caller.
+     */
+    hebench::APIBridge::Handle encode(const hebench::APIBridge::DataPackCollection &parameters,
+                                      const EncodeFn &encode_fn);
+    template <class EncryptFn>
+    /**
+     * @brief Encrypts the specified encoded handle, or returns the cached encryption.
+     * @param[in] encoded_data Handle as received by `encrypt()`.
+     * @param[in] encrypt_fn Functor called as `encrypt_fn()` returning the handle with
+     * the encrypted data when not cached.
+     * @return Handle to the encrypted data. Owned by the caller.
+     */
+    hebench::APIBridge::Handle encrypt(hebench::APIBridge::Handle encoded_data,
+                                       const EncryptFn &encrypt_fn);
+
+    /**
+     * @brief Destroys all cached handles.
+     */
+    void clear();
+    /**
+     * @brief Number of operand contents cached.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Computes the hash of the content and layout of a DataPackCollection.
+     */
+    static std::uint64_t hash(const hebench::APIBridge::DataPackCollection &parameters);
+
+private:
+    struct Entry
+    {
+        std::uint64_t content_hash;
+        std::vector<std::uint8_t> content; // copy of the hashed content
+        hebench::APIBridge::Handle h_encoded;
+        hebench::APIBridge::Handle h_encrypted; // null if not cached
+    };
+
+    /**
+     * @brief Retrieves a duplicate of the cached encoded handle for the specified content.
+     * @return `true` if found.
+     */
+    bool findEncoded(const hebench::APIBridge::DataPackCollection &parameters,
+                     std::uint64_t content_hash, hebench::APIBridge::Handle &h_encoded);
+    /**
+     * @brief Caches a duplicate of an encoded handle, and a copy of its content.
+     * @details Caching is best effort: failures are ignored.
+     */
+    void storeEncoded(const hebench::APIBridge::DataPackCollection &parameters,
+                      std::uint64_t content_hash, hebench::APIBridge::Handle h_encoded) noexcept;
+    /**
+     * @brief Retrieves a duplicate of the cached encrypted handle for the entry whose
+     * encoded handle shares its object with the specified handle.
+     * @return `true` if found.
+     */
+    bool findEncrypted(hebench::APIBridge::Handle h_encoded, hebench::APIBridge::Handle &h_encrypted);
+    /**
+     * @brief Caches a duplicate of an encrypted handle in the entry whose encoded
+     * handle shares its object with \p h_encoded, if any.
+     * @details Caching is best effort: failures are ignored.
+     */
+    void storeEncrypted(hebench::APIBridge::Handle h_encoded, hebench::APIBridge::Handle h_encrypted) noexcept;
+    /**
+     * @brief Retrieves the entry whose encoded handle shares its object with the
+     * specified handle. Must be called with the cache locked.
+     */
+    Entry *findEntry(hebench::APIBridge::Handle h_encoded);
+    hebench::APIBridge::Handle duplicate(hebench::APIBridge::Handle h) const;
+    void destroy(hebench::APIBridge::Handle h) const;
+    void destroy(const std::vector<Entry> &entries) const;
+    static bool isCacheable(hebench::APIBridge::Handle h);
+
+    const BaseEngine &m_engine;
+    std::size_t m_capacity;
+    std::vector<std::uint64_t> m_constant_positions;
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_entries; // least recently used first
+};
+
+template <class EncodeFn>
+hebench::APIBridge::Handle ConstantOperandCache::encode(const hebench::APIBridge::DataPackCollection &parameters,
+                                                        const EncodeFn &encode_fn)
+{
+    if (!isConstant(parameters))
+        return encode_fn();
+
+    hebench::APIBridge::Handle retval;
+    std::uint64_t content_hash = hash(parameters);
+    if (!findEncoded(parameters, content_hash, retval))
+    {
+        retval = encode_fn();
+        storeEncoded(parameters, content_hash, retval);
+    } // end if
+    return retval;
+}
+
+template <class EncryptFn>
+hebench::APIBridge::Handle ConstantOperandCache::encrypt(hebench::APIBridge::Handle encoded_data,
+                                                         const EncryptFn &encrypt_fn)
+{
+    hebench::APIBridge::Handle retval;
+    if (!findEncrypted(encoded_data, retval))
+    {
+        retval = encrypt_fn();
+        storeEncrypted(encoded_data, retval);
+    } // end if
+    return retval;
+}
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_ConstantOperandCache_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,243 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_ContextCache_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_ContextCache_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "engine_object.hpp"
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+
+namespace hebench {
+namespace cpp {
+
+/**
+ * @brief Cache of expensive cryptographic objects, such as HE contexts and keys,
+ * shared among benchmarks of an engine.
+ * @details Objects are cached by Key, which identifies the parameters that
+ * determine the object cryptographically, and by their C++ type. Thus, different
+ * types of objects, for example, a context and its keys, can be cached under the
+ * same Key.
+ *
+ * Cached objects are shared: lookups return `std::shared_ptr`, and evicting an
+ * object from the cache only releases the reference held by the cache. When the
+ * cache is full, the least recently used object is evicted.
+ *
+ * Example, in `BaseBenchmark::initialize()`:
+ * @code
+ * ContextCache::Key key(bench_desc_concrete);
+ * key.add(poly_modulus_degree).add(coeff_mod_bits);
+ * m_p_context = getEngine().contextCache().getOrCreate<Context>(key, [&]() {
+ *     return std::make_shared<Context>(poly_modulus_degree, coeff_mod_bits);
+ * });
+ * @endcode
+ *
+ * All methods are thread safe.
+ * @sa BaseEngine::contextCache()
+ */
+class ContextCache
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(ContextCache)
+
+public:
+    /**
+     * @brief Identifies the parameters that determine a cached object.
+     * @details A key is formed by scheme, security and the `other` field of a
+     * benchmark descriptor, plus any values added by the backend, such as the
+     * workload parameters that affect the cryptographic parameters. Workload
+     * parameters that do not, for example, batch sizes, should not be added, so
+     * that benchmarks differing only on those share cached objects.
+     */
+    class Key
+    {
+    public:
+        Key(hebench::APIBridge::Scheme scheme, hebench::APIBridge::Security security, std::int64_t other);
+        /**
+         * @brief Creates a key from the scheme, security and `other` fields of a
+         * benchmark descriptor.
+         */
+        explicit Key(const hebench::APIBridge::BenchmarkDescriptor &desc);
+
+        /**
+         * @brief Adds the type and value of a workload parameter to the key.
+         * @details The name of the parameter is ignored.
+         */
+        Key &add(const hebench::APIBridge::WorkloadParam &param);
+        /**
+         * @brief Adds a backend specific value to the key.
+         */
+        Key &add(std::uint64_t value);
+
+        bool operator==(const Key &other) const;
+        bool operator!=(const Key &other) const { return !(*this == other); }
+        std::size_t hash() const;
+
+    private:
+        friend class ContextCache;
+
+        hebench::APIBridge::Scheme m_scheme;
+        hebench::APIBridge::Security m_security;
+        std::int64_t m_other;
+        TypeID m_type_id; // set by the cache
+        std::vector<std::uint64_t> m_values;
+    };
+
+    /**
+     * @brief Default maximum number of objects in the cache.
+     */
+    static constexpr std::size_t DefaultCapacity = 8;
+
+    ContextCache(const ContextCache &) = delete;
+    ContextCache &operator=(const ContextCache &) = delete;
+
+    /**
+     * @brief Creates an empty cache.
+     * @param[in] capacity Maximum number of objects in the cache. If 0, caching
+     * is disabled.
+     */
+    explicit ContextCache(std::size_t capacity = DefaultCapacity);
+
+    template <class T, class Factory>
+    /**
+     * @brief Retrieves the object of type `T` cached for the specified key, creating
+     * it if not found.
+     * @param[in] key Key identifying the object.
+     * @param[in] factory Functor called as `factory()`, returning a `std::shared_ptr<T>`
+     * with a new object for \p key. It is called without locking the cache.
+     * @return The cached object, or the object created by \p factory.
+     * @details If the object is created concurrently by several threads, all of them
+     * receive the first one inserted in the cache. A null object returned by \p factory
+     * is returned, but not cached.
+     */
+    std::shared_ptr<T> getOrCreate(const Key &key, Factory &&factory);
+    template <class T>
+    /**
+     * @brief Retrieves the object of type `T` cached for the specified key.
+     * @return The cached object, or null if not found.
+     */
+    std::shared_ptr<T> find(const Key &key);
+    template <class T>
+    /**
+     * @brief Caches an object of type `T` for the specified key, replacing any
+     * previous object of the same type for the key.
+     */
+    void insert(const Key &key, std::shared_ptr<T> p_obj);
+    template <class T>
+    /**
+     * @brief Removes the object of type `T` cached for the specified key, if any.
+     * @return `true` if an object was removed.
+     */
+    bool erase(const Key &key);
+    /**
+     * @brief Removes all objects from the cache.
+     */
+    void clear();
+
+    /**
+     * @brief Number of objects in the cache.
+     */
+    std::size_t size() const;
+    std::size_t capacity() const;
+    /**
+     * @brief Sets the maximum number of objects in the cache, evicting objects
+     * if needed.
+     * @param[in] capacity Maximum number of objects in the cache. If 0, caching
+     * is disabled.
+     */
+    void setCapacity(std::size_t capacity);
+
+    /**
+     * @brief Number of lookups that found an object in the cache.
+     */
+    std::uint64_t hits() const;
+    /**
+     * @brief Number of lookups that did not find an object in the cache.
+     */
+    std::uint64_t misses() const;
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const { return key.hash(); }
+    };
+    struct Entry
+    {
+        Key key;
+        std::shared_ptr<void> p_obj;
+    };
+    typedef std::list<Entry> EntryList;
+
+    static Key typedKey(const Key &key, TypeID type_id);
+    std::shared_ptr<void> findEntry(const Key &typed_key);
+    /**
+     * @brief Inserts an object, unless one exists for the key.
+     * @return The object cached for the key after the call.
+     */
+    std::shared_ptr<void> insertEntry(const Key &typed_key, std::shared_ptr<void> p_obj, bool b_replace);
+    bool eraseEntry(const Key &typed_key);
+    /**
+     * @brief Moves least recently used entries into \p evicted until the cache
+     * fits its capacity.
+     * @details Must be called with the cache locked. Callers release \p evicted after
+     * unlocking, so that destructors of evicted objects do not run under the lock.
+     */
+    void evictExcess(EntryList &evicted);
+
+    mutable std::mutex m_mutex;
+    EntryList m_entries; // most recently used first
+    std::unordered_map<Key, EntryList::iterator, KeyHash> m_index;
+    std::size_t m_capacity;
+    std::uint64_t m_hits;
+    std::uint64_t m_misses;
+};
+
+template <class T, class Factory>
+std::shared_ptr<T> ContextCache::getOrCreate(const Key &key, Factory &&factory)
+{
+    Key typed_key               = typedKey(key, hebench::cpp::typeID<T>());
+    std::shared_ptr<void> p_obj = findEntry(typed_key);
+    if (!p_obj)
+    {
+        std::shared_ptr<T> p_new = factory();
+        if (!p_new)
+            return p_new;
+        p_obj = insertEntry(typed_key, p_new, false);
+    } // end if
+    return std::static_pointer_cast<T>(p_obj);
+}
+
+template <class T>
+std::shared_ptr<T> ContextCache::find(const Key &key)
+{
+    return std::static_pointer_cast<T>(findEntry(typedKey(key, hebench::cpp::typeID<T>())));
+}
+
+template <class T>
+void ContextCache::insert(const Key &key, std::shared_ptr<T> p_obj)
+{
+    if (!p_obj)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid null pointer: p_obj"));
+    insertEntry(typedKey(key, hebench::cpp::typeID<T>()), std::move(p_obj), true);
+}
+
+template <class T>
+bool ContextCache::erase(const Key &key)
+{
+    return eraseEntry(typedKey(key, hebench::cpp::typeID<T>()));
+}
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_ContextCache_H_7e5fa8c2415240ea93eff148ed73539b
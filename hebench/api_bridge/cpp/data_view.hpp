@@ -0,0 +1,262 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_DataView_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_DataView_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "hebench/api_bridge/types.h"
+
+namespace hebench {
+namespace cpp {
+
+template <class T>
+/**
+ * @brief Non-owning view of a contiguous array of elements of type `T`.
+ * @details Views are cheap to copy and do not allocate. The viewed memory must
+ * outlive the view. Element access is only bounds-checked in debug builds.
+ *
+ * A view of `T` converts implicitly into a view of `const T`.
+ */
+class SampleView
+{
+public:
+    typedef T value_type;
+    typedef T *iterator;
+
+    SampleView() noexcept :
+        m_p_data(nullptr), m_size(0)
+    {
+    }
+    SampleView(T *p_data, std::uint64_t size) noexcept :
+        m_p_data(p_data), m_size(size)
+    {
+    }
+    template <class U,
+              typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value, int>::type = 0>
+    SampleView(const SampleView<U> &src) noexcept :
+        m_p_data(src.data()), m_size(src.size())
+    {
+    }
+
+    T *data() const noexcept { return m_p_data; }
+    /**
+     * @brief Number of elements in the view.
+     */
+    std::uint64_t size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    T &operator[](std::uint64_t index) const noexcept
+    {
+        assert(index < m_size);
+        return m_p_data[index];
+    }
+
+    iterator begin() const noexcept { return m_p_data; }
+    iterator end() const noexcept { return m_p_data + m_size; }
+
+private:
+    T *m_p_data;
+    std::uint64_t m_size;
+};
+
+template <class T>
+/**
+ * @brief Non-owning row-major view of a matrix of elements of type `T`.
+ * @details Rows are contiguous in memory. Element access is only bounds-checked
+ * in debug builds.
+ */
+class MatrixView
+{
+public:
+    MatrixView() noexcept :
+        m_p_data(nullptr), m_rows(0), m_cols(0)
+    {
+    }
+    MatrixView(T *p_data, std::uint64_t rows, std::uint64_t cols) noexcept :
+        m_p_data(p_data), m_rows(rows), m_cols(cols)
+    {
+    }
+    /**
+     * @brief Views the elements of a sample as a matrix.
+     * @details \p sample must contain, at least, `rows * cols` elements.
+     */
+    MatrixView(const SampleView<T> &sample, std::uint64_t rows, std::uint64_t cols) noexcept :
+        m_p_data(sample.data()), m_rows(rows), m_cols(cols)
+    {
+        assert(rows * cols <= sample.size());
+    }
+
+    T *data() const noexcept { return m_p_data; }
+    std::uint64_t rows() const noexcept { return m_rows; }
+    std::uint64_t cols() const noexcept { return m_cols; }
+    /**
+     * @brief Number of elements in the matrix.
+     */
+    std::uint64_t size() const noexcept { return m_rows * m_cols; }
+
+    SampleView<T> row(std::uint64_t row_i) const noexcept
+    {
+        assert(row_i < m_rows);
+        return SampleView<T>(m_p_data + row_i * m_cols, m_cols);
+    }
+    T &operator()(std::uint64_t row_i, std::uint64_t col_i) const noexcept
+    {
+        assert(row_i < m_rows && col_i < m_cols);
+        return m_p_data[row_i * m_cols + col_i];
+    }
+    /**
+     * @brief View of all elements in row-major order.
+     */
+    SampleView<T> elements() const noexcept { return SampleView<T>(m_p_data, size()); }
+
+private:
+    T *m_p_data;
+    std::uint64_t m_rows;
+    std::uint64_t m_cols;
+};
+
+template <class T>
+/**
+ * @brief Typed non-owning view of the samples in a `hebench::APIBridge::DataPack`.
+ * @details Each sample is viewed as a contiguous array of elements of type `T`
+ * covering the whole buffer (`size / sizeof(T)` elements). Use `const` element
+ * types to view input data. Sample access is only bounds-checked in debug builds.
+ */
+class DataPackView
+{
+public:
+    DataPackView() noexcept :
+        m_p_pack(nullptr)
+    {
+    }
+    explicit DataPackView(const hebench::APIBridge::DataPack &pack) noexcept :
+        m_p_pack(&pack)
+    {
+    }
+
+    /**
+     * @brief Tests whether this view refers to a DataPack.
+     */
+    bool valid() const noexcept { return m_p_pack != nullptr; }
+    const hebench::APIBridge::DataPack &pack() const noexcept
+    {
+        assert(m_p_pack);
+        return *m_p_pack;
+    }
+    std::uint64_t paramPosition() const noexcept { return pack().param_position; }
+    std::uint64_t sampleCount() const noexcept { return pack().buffer_count; }
+
+    SampleView<T> sample(std::uint64_t sample_i) const noexcept
+    {
+        assert(sample_i < sampleCount() && pack().p_buffers);
+        const hebench::APIBridge::NativeDataBuffer &buffer = pack().p_buffers[sample_i];
+        return SampleView<T>(reinterpret_cast<T *>(buffer.p), buffer.size / sizeof(T));
+    }
+    SampleView<T> operator[](std::uint64_t sample_i) const noexcept { return sample(sample_i); }
+    /**
+     * @brief Views a sample as a row-major matrix.
+     */
+    MatrixView<T> matrix(std::uint64_t sample_i, std::uint64_t rows, std::uint64_t cols) const noexcept
+    {
+        return MatrixView<T>(sample(sample_i), rows, cols);
+    }
+
+private:
+    const hebench::APIBridge::DataPack *m_p_pack;
+};
+
+template <class T>
+/**
+ * @brief Typed non-owning view of a `hebench::APIBridge::DataPackCollection`
+ * indexed by parameter position.
+ * @details The table from parameter position to DataPack is computed once on
+ * construction, so that lookups are constant time, as opposed to
+ * BaseBenchmark::findDataPackIndex(), which searches the collection. Only
+ * unexpectedly large positions, which do not fit in the table, are searched.
+ */
+class DataPackCollectionView
+{
+public:
+    DataPackCollectionView() :
+        m_p_collection(nullptr)
+    {
+    }
+    explicit DataPackCollectionView(const hebench::APIBridge::DataPackCollection &collection) :
+        m_p_collection(&collection)
+    {
+        if (collection.p_data_packs)
+        {
+            // bound the table: positions come from the caller
+            std::uint64_t max_positions = collection.pack_count < MinTableSize ? MinTableSize : collection.pack_count;
+            for (std::uint64_t i = 0; i < collection.pack_count; ++i)
+            {
+                const hebench::APIBridge::DataPack &pack = collection.p_data_packs[i];
+                if (pack.param_position < max_positions)
+                {
+                    if (pack.param_position >= m_positions.size())
+                        m_positions.resize(pack.param_position + 1, nullptr);
+                    if (!m_positions[pack.param_position]) // first match wins, as with findDataPackIndex()
+                        m_positions[pack.param_position] = &pack;
+                } // end if
+            } // end for
+        } // end if
+    }
+
+    /**
+     * @brief Tests whether the collection contains a DataPack for the specified position.
+     */
+    bool contains(std::uint64_t param_position) const noexcept { return lookup(param_position) != nullptr; }
+    /**
+     * @brief Retrieves a view of the DataPack for the specified position.
+     * @details Returned view is invalid (see DataPackView::valid()) if the collection
+     * does not contain the specified position.
+     */
+    DataPackView<T> find(std::uint64_t param_position) const noexcept
+    {
+        const hebench::APIBridge::DataPack *p_pack = lookup(param_position);
+        return p_pack ? DataPackView<T>(*p_pack) : DataPackView<T>();
+    }
+    /**
+     * @brief Retrieves a view of the DataPack for the specified position.
+     * @details The collection must contain the specified position. This is only
+     * checked in debug builds.
+     */
+    DataPackView<T> operator[](std::uint64_t param_position) const noexcept
+    {
+        const hebench::APIBridge::DataPack *p_pack = lookup(param_position);
+        assert(p_pack);
+        return DataPackView<T>(*p_pack);
+    }
+
+private:
+    static constexpr std::uint64_t MinTableSize = 16;
+
+    const hebench::APIBridge::DataPack *lookup(std::uint64_t param_position) const noexcept
+    {
+        if (param_position < m_positions.size())
+            return m_positions[param_position];
+        if (m_p_collection && m_p_collection->p_data_packs
+            && param_position >= (m_p_collection->pack_count < MinTableSize ? MinTableSize : m_p_collection->pack_count))
+            for (std::uint64_t i = 0; i < m_p_collection->pack_count; ++i)
+                if (m_p_collection->p_data_packs[i].param_position == param_position)
+                    return &m_p_collection->p_data_packs[i];
+        return nullptr;
+    }
+
+    const hebench::APIBridge::DataPackCollection *m_p_collection;
+    std::vector<const hebench::APIBridge::DataPack *> m_positions;
+};
+
+template <class T>
+constexpr std::uint64_t DataPackCollectionView<T>::MinTableSize;
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_DataView_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,240 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_DatasetGenerator_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_DatasetGenerator_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "data_view.hpp"
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+#include "random.hpp"
+#include "thread_pool.hpp"
+
+namespace hebench {
+namespace cpp {
+
+/**
+ * @brief Randomly generated operands of a benchmark, laid out as a DataPackCollection.
+ * @details Holds one DataPack per operation parameter, in parameter position order.
+ * The samples of each parameter are stored contiguously in a single aligned buffer,
+ * backed by huge pages when large. The collection returned by parameters() is valid
+ * for the lifetime of this object, including after moving it.
+ */
+class GeneratedDataset
+{
+public:
+    GeneratedDataset(const GeneratedDataset &) = delete;
+    GeneratedDataset &operator=(const GeneratedDataset &) = delete;
+    GeneratedDataset(GeneratedDataset &&) = default;
+    GeneratedDataset &operator=(GeneratedDataset &&) = default;
+
+    hebench::APIBridge::DataType dataType() const { return m_data_type; }
+    std::uint64_t parameterCount() const { return m_packs.size(); }
+    /**
+     * @brief Number of samples of the parameter in the specified position.
+     */
+    std::uint64_t sampleCount(std::uint64_t param_position) const { return m_packs.at(param_position).buffer_count; }
+    /**
+     * @brief Number of elements in each sample of the parameter in the specified position.
+     */
+    std::uint64_t sampleSize(std::uint64_t param_position) const { return m_sample_sizes.at(param_position); }
+
+    /**
+     * @brief Generated operands, ready to be passed to `encode()`.
+     */
+    const hebench::APIBridge::DataPackCollection &parameters() const { return m_collection; }
+    template <class T>
+    /**
+     * @brief Typed view of the generated operands.
+     * @details `T` must match dataType().
+     */
+    DataPackCollectionView<const T> view() const
+    {
+        return DataPackCollectionView<const T>(m_collection);
+    }
+
+private:
+    friend class DatasetGenerator;
+
+    struct BufferDeleter
+    {
+        void operator()(void *p) const noexcept { freeAligned(p); }
+    };
+
+    GeneratedDataset() = default;
+
+    hebench::APIBridge::DataType m_data_type;
+    std::vector<std::uint64_t> m_sample_sizes;
+    std::vector<std::unique_ptr<void, BufferDeleter>> m_storage;
+    std::vector<std::vector<hebench::APIBridge::NativeDataBuffer>> m_buffers;
+    std::vector<hebench::APIBridge::DataPack> m_packs;
+    hebench::APIBridge::DataPackCollection m_collection;
+};
+
+/**
+ * @brief Generates large, reproducible random operands for benchmarks.
+ * @details Values are drawn from xoshiro256** streams: each parameter position is
+ * an independent stream, split into chunks of ChunkElements elements, each filled
+ * with a Xoshiro256x4 taken from the stream with jump-ahead. Chunks are therefore
+ * independent and are filled in parallel when a ThreadPool is provided. The values
+ * generated depend only on the seed, the data type, the value range and the layout
+ * requested, not on the number of threads.
+ *
+ * Values are uniformly distributed in `[min, max)` for floating point types, and in
+ * `[min, max]` for integer types, with the bounds rounded towards zero. The default
+ * range is `[-1, 1)` for floating point types and `[-100, 100]` for integer types.
+ *
+ * @code
+ * DatasetGenerator generator(seed);
+ * GeneratedDataset dataset = generator.generate(descriptor, w_params, &getEngine().threadPool());
+ * Handle h_encoded;
+ * encode(h_benchmark, &dataset.parameters(), &h_encoded);
+ * @endcode
+ */
+class DatasetGenerator
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(DatasetGenerator)
+
+public:
+    /**
+     * @brief Number of consecutive elements filled from the same generator.
+     */
+    static constexpr std::uint64_t ChunkElements = 1 << 16;
+
+    explicit DatasetGenerator(std::uint64_t seed);
+
+    std::uint64_t seed() const { return m_seed; }
+    /**
+     * @brief Sets the range of the generated values for all data types.
+     * @throws HEBenchError if \p min or \p max are not finite, or `min > max`.
+     * @details Generating data of a type that cannot represent the range, for
+     * example, `Int32` with `max = 1e10`, throws HEBenchError.
+     */
+    void setValueRange(double min, double max);
+    /**
+     * @brief Restores the default range of the generated values for each data type.
+     */
+    void resetValueRange() { m_b_custom_range = false; }
+
+    /**
+     * @brief Number of elements in one sample of each input parameter of a workload.
+     * @param[in] workload Workload of the operation.
+     * @param[in] w_params Workload parameters, as received by the benchmark.
+     * @return Number of elements per sample, in parameter position order.
+     * @throws HEBenchError if the workload is not supported or the parameters are invalid.
+     */
+    static std::vector<std::uint64_t> operandSizes(hebench::APIBridge::Workload workload,
+                                                   const hebench::APIBridge::WorkloadParams &w_params);
+
+    /**
+     * @brief Generates the operands of a benchmark.
+     * @param[in] bench_desc Benchmark descriptor: defines workload, data type and category.
+     * @param[in] w_params Workload parameters: define the size of the operands.
+     * @param[in] p_pool Pool used to generate in parallel, or null to use the calling thread.
+     * @return Dataset with one sample per parameter for Category::Latency, or
+     * `cat_params.offline.data_count[i]` samples for parameter `i` for
+     * Category::Offline.
+     * @throws HEBenchError if the layout cannot be determined, for example, for an
+     * offline benchmark that leaves a sample count unspecified.
+     */
+    GeneratedDataset generate(const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                              const hebench::APIBridge::WorkloadParams &w_params,
+                              ThreadPool *p_pool = nullptr) const;
+    /**
+     * @brief Generates operands with an explicit layout.
+     * @param[in] data_type Type of the elements.
+     * @param[in] sample_sizes Number of elements per sample of each parameter.
+     * @param[in] sample_counts Number of samples of each parameter. Must have the
+     * same number of elements as \p sample_sizes.
+     * @param[in] p_pool Pool used to generate in parallel, or null to use the calling thread.
+     * @throws HEBenchError if \p sample_sizes and \p sample_counts differ in size.
+     */
+    GeneratedDataset generate(hebench::APIBridge::DataType data_type,
+                              const std::vector<std::uint64_t> &sample_sizes,
+                              const std::vector<std::uint64_t> &sample_counts,
+                              ThreadPool *p_pool = nullptr) const;
+
+    template <class T>
+    /**
+     * @brief Fills an array with the values of the specified stream.
+     * @param[out] p_data Array to fill.
+     * @param[in] count Number of elements in \p p_data.
+     * @param[in] stream Stream to draw the values from. generate() uses the parameter
+     * position as stream.
+     * @param[in] p_pool Pool used to fill in parallel, or null to use the calling thread.
+     */
+    void fill(T *p_data, std::uint64_t count, std::uint64_t stream = 0, ThreadPool *p_pool = nullptr) const;
+
+private:
+    template <class T>
+    UniformDistribution<T> distribution() const;
+
+    std::uint64_t m_seed;
+    bool m_b_custom_range;
+    double m_min;
+    double m_max;
+};
+
+template <class T>
+UniformDistribution<T> DatasetGenerator::distribution() const
+{
+    if (m_b_custom_range)
+    {
+        // converting a double out of the range of T is undefined
+        double lowest = std::is_floating_point<T>::value ?
+                            -static_cast<double>(std::numeric_limits<T>::max()) :
+                            static_cast<double>(std::numeric_limits<T>::lowest()); // 0 or -2^digits: exact
+        bool b_in_range = m_min >= lowest
+                          && (std::is_floating_point<T>::value ?
+                                  m_max <= static_cast<double>(std::numeric_limits<T>::max()) :
+                                  m_max < std::ldexp(1.0, std::numeric_limits<T>::digits)); // max + 1: exact
+        if (!b_in_range)
+            throw HEBenchError(HEBERROR_MSG_CLASS("Range of values [" + std::to_string(m_min) + ", " + std::to_string(m_max)
+                                                  + "] cannot be represented by the requested data type."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+        return UniformDistribution<T>(static_cast<T>(m_min), static_cast<T>(m_max));
+    } // end if
+    return std::is_floating_point<T>::value ? UniformDistribution<T>(T(-1), T(1)) : UniformDistribution<T>(T(-100), T(100));
+}
+
+template <class T>
+void DatasetGenerator::fill(T *p_data, std::uint64_t count, std::uint64_t stream, ThreadPool *p_pool) const
+{
+    UniformDistribution<T> dist = distribution<T>();
+
+    // streams are 2^192 outputs apart; chunks take 4 consecutive 2^128 jumps each
+    Xoshiro256 streams(m_seed);
+    for (std::uint64_t i = 0; i < stream; ++i)
+        streams.longJump();
+    std::uint64_t chunk_count = (count + ChunkElements - 1) / ChunkElements;
+    std::vector<Xoshiro256x4> generators;
+    generators.reserve(chunk_count);
+    for (std::uint64_t chunk_i = 0; chunk_i < chunk_count; ++chunk_i)
+        generators.emplace_back(streams);
+
+    auto fill_chunk = [&](std::size_t chunk_i) {
+        std::uint64_t first = chunk_i * ChunkElements;
+        fillUniform(generators[chunk_i], p_data + first, count - first < ChunkElements ? count - first : ChunkElements, dist);
+    };
+    if (p_pool && chunk_count > 1)
+        p_pool->parallelFor(0, chunk_count, fill_chunk, 1);
+    else
+        for (std::uint64_t chunk_i = 0; chunk_i < chunk_count; ++chunk_i)
+            fill_chunk(chunk_i);
+}
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_DatasetGenerator_H_7e5fa8c2415240ea93eff148ed73539b
@@ -5,14 +5,25 @@
 #ifndef _HEBench_API_Bridge_Base_Engine_H_7e5fa8c2415240ea93eff148ed73539b
 #define _HEBench_API_Bridge_Base_Engine_H_7e5fa8c2415240ea93eff148ed73539b
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "arena.hpp"
+#include "autotuner.hpp"
+#include "context_cache.hpp"
+#include "engine_config.hpp"
 #include "engine_object.hpp"
 #include "hebench/api_bridge/types.h"
+#include "spill_store.hpp"
+#include "thread_pool.hpp"
+#include "validation.hpp"
 
 namespace hebench {
 namespace cpp {
@@ -48,6 +59,11 @@ struct BenchmarkHandle
  * configuration files. Test Harness will forward this information to backend
  * using this buffer. Utilization of this information is backend specific, and backends
  * can ignore it.
+ *
+ * Backends that need the configuration during BaseEngine::init() pass
+ * `EngineConfig::parse(p_buffer, size)` to the BaseEngine(const EngineConfig &)
+ * constructor. Otherwise, the C++ wrapper applies the configuration to the returned
+ * engine.
  */
 BaseEngine *createEngine(const std::int8_t *p_buffer, std::uint64_t size); // implement this
 /**
@@ -84,8 +100,18 @@ public:
      * @sa ITaggedObject
      */
     static constexpr std::int64_t tag = 0x8000000000000000; // bit 63
+
+    /**
+     * @brief Functor creating a benchmark description on demand.
+     * @sa addBenchmarkDescription(BenchmarkDescriptionFactory)
+     */
+    typedef std::function<std::shared_ptr<BenchmarkDescription>()> BenchmarkDescriptionFactory;
 public:
-    ~BaseEngine() override {}
+    /**
+     * @brief Destroys the engine and any benchmark left in the benchmark pool.
+     * @sa clearBenchmarkPool()
+     */
+    ~BaseEngine() override;
 
     std::int64_t classTag() const override { return tag; }
 
@@ -107,7 +133,7 @@ public:
      * @brief Retrieves the description of the last error that occurred as
      * set by setLastError().
      */
-    static const std::string &getLastErrorDesc() { return m_s_last_error_description; }
+    static const std::string &getLastErrorDesc();
     /**
      * @brief Sets the last error code that occurred.
      * @param[in] value Error code.
@@ -124,6 +150,176 @@ public:
      */
     static void setLastError(hebench::APIBridge::ErrorCode value,
                              const std::string &err_desc);
+    /**
+     * @brief Sets the last error that occurred from an error record.
+     * @param[in] record Error record describing the error.
+     * @details The record is stored as is and its description is only formatted
+     * on the first call to getLastErrorDesc() after this. If the record has no
+     * message, the description of its error code is used instead.
+     *
+     * This is the cheap path to report errors from non-throwing methods, such as
+     * BaseBenchmark::tryEncode(). Strings referenced by \p record must outlive it.
+     */
+    static void setLastError(const ErrorRecord &record);
+    /**
+     * @brief Sets the last error from an error record and returns its error code.
+     * @details Convenience for non-throwing methods:
+     * @code
+     * return BaseEngine::reportError(HEBERROR_RECORD_CLASS("Invalid input.", HEBENCH_ECODE_INVALID_ARGS));
+     * @endcode
+     * @sa setLastError(const ErrorRecord &)
+     */
+    static hebench::APIBridge::ErrorCode reportError(const ErrorRecord &record)
+    {
+        setLastError(record);
+        return record.getErrorCode();
+    }
+
+    /**
+     * @brief Retrieves the thread pool shared by all benchmarks of this engine.
+     * @details The pool is created on first use with the size set by setThreadPoolSize().
+     * Benchmarks should use this pool, for example, through ThreadPool::parallelFor()
+     * or TaskGroup, for parallel work inside their methods, so that benchmarks created
+     * by the same engine share the cores without oversubscription.
+     */
+    ThreadPool &threadPool() const;
+    /**
+     * @brief Sets the number of worker threads for threadPool().
+     * @param[in] thread_count Number of worker threads. If 0, the number of hardware
+     * threads is used.
+     * @details If the pool already exists with a different size, it is recreated.
+     * Thus, this method must not be called while tasks are executing in the pool.
+     *
+     * The C++ wrapper calls this method during engine initialization if the
+     * configuration buffer passed to `hebench::APIBridge::initEngine()` specifies
+     * `threads=<count>`.
+     */
+    void setThreadPoolSize(std::size_t thread_count);
+    /**
+     * @brief Sets whether worker threads of threadPool() are pinned to CPUs.
+     * @details If the pool already exists with a different setting, it is recreated.
+     * Thus, this method must not be called while tasks are executing in the pool.
+     *
+     * The C++ wrapper calls this method during engine initialization if the
+     * configuration buffer specifies `pin_threads=<bool>`.
+     * @sa ThreadPool::ThreadPool()
+     */
+    void setThreadPinning(bool b_pin_threads);
+    /**
+     * @brief Amount of memory, in bytes, that benchmarks of this engine should keep
+     * their data under, or 0 if unlimited.
+     * @details Set by setMemoryBudget(), or during engine initialization if the
+     * configuration buffer specifies `memory_budget=<bytes>`. spillStore() keeps
+     * its resident payloads under this budget; otherwise, the budget is advisory:
+     * backends decide how to honor it.
+     */
+    std::uint64_t memoryBudget() const { return m_memory_budget; }
+    void setMemoryBudget(std::uint64_t bytes);
+    /**
+     * @brief Retrieves the store for payloads that may not fit in memory, shared by
+     * all benchmarks of this engine.
+     * @details The store is created on first use in the directory set by
+     * setSpillDirectory(), or SpillStore::defaultDirectory() if not set, and keeps
+     * its resident payloads under memoryBudget(). Benchmarks of offline categories
+     * with datasets larger than physical memory should keep the payloads of their
+     * handles in SpilledBuffer objects from this store, and pin them only while in
+     * use, so that payloads not touched by `operate()` are paged out.
+     *
+     * Handles with spilled payloads must be destroyed before the engine. Payloads
+     * kept in contextCache() or in pooled benchmarks are released before the store.
+     */
+    SpillStore &spillStore() const;
+    /**
+     * @brief Sets the directory of spillStore().
+     * @throws HEBenchError if \p directory does not exist or is not writable (see
+     * SpillStore::validateDirectory()), or if spillStore() has already been created
+     * in a different directory.
+     * @details The C++ wrapper calls this method during engine initialization if the
+     * configuration buffer specifies `spill_dir=<path>`.
+     */
+    void setSpillDirectory(const std::string &directory);
+    /**
+     * @brief Retrieves the cache of cryptographic objects shared by all benchmarks
+     * of this engine.
+     * @details Benchmarks should obtain expensive objects, such as contexts and keys,
+     * through this cache during initialization, so that benchmarks with the same
+     * cryptographic parameters, created one after another by Test Harness, reuse
+     * them instead of generating them again.
+     *
+     * The C++ wrapper sets the capacity of the cache during engine initialization if
+     * the configuration buffer passed to `hebench::APIBridge::initEngine()` specifies
+     * `context_cache_size=<count>`.
+     */
+    ContextCache &contextCache() const { return m_context_cache; }
+    /**
+     * @brief Retrieves the database of tuning choices shared by all benchmarks of
+     * this engine.
+     * @details The database is opened on first use from the file set by
+     * setTuningDatabaseFilename(), or TuningDatabase::defaultFilename() if not set,
+     * which keeps the database in memory only unless `HEBENCH_TUNING_DB` is set.
+     * @sa BaseBenchmark::autotune()
+     */
+    TuningDatabase &tuningDatabase() const;
+    /**
+     * @brief Sets the file of tuningDatabase().
+     * @param[in] filename File of the database. If empty, tuning choices are kept
+     * in memory only and every run of the backend tunes again.
+     * @details If the database is already open from a different file, it is reopened
+     * on next use. Thus, this method must not be called while benchmarks are tuning.
+     */
+    void setTuningDatabaseFilename(const std::string &filename);
+    /**
+     * @brief Configuration received by the engine during initialization.
+     * @details Backends retrieve their own options from it, with the typed getters
+     * of EngineConfig. It is available during init() for engines constructed with
+     * BaseEngine(const EngineConfig &).
+     */
+    const EngineConfig &configuration() const { return m_config; }
+    /**
+     * @brief Parses the configuration buffer and applies it.
+     * @param[in] p_buffer Configuration buffer as received by createEngine().
+     * @param[in] size Number of bytes pointed by \p p_buffer .
+     * @throws HEBenchError if the buffer is malformed or a standard key has an
+     * invalid value.
+     * @details See EngineConfig for the accepted formats. The C++ wrapper applies the
+     * configuration received by the engine during initialization: backends only need
+     * this method to reconfigure an engine.
+     * @sa applyConfiguration(const EngineConfig &)
+     */
+    void applyConfiguration(const std::int8_t *p_buffer, std::uint64_t size);
+    /**
+     * @brief Applies the standard engine options of a configuration and keeps it as
+     * the configuration() of the engine.
+     * @throws HEBenchError if a standard key has an invalid value. No option is
+     * applied in that case.
+     * @details Unknown keys are kept for the backend. Standard keys:
+     * - EngineConfig::KeyThreads (`threads`): see setThreadPoolSize().
+     * - EngineConfig::KeyPinThreads (`pin_threads`): see setThreadPinning().
+     * - EngineConfig::KeyMemoryBudget (`memory_budget`): see setMemoryBudget().
+     * - EngineConfig::KeyContextCacheSize (`context_cache_size`): capacity of contextCache().
+     * - EngineConfig::KeyBenchmarkPoolSize (`benchmark_pool_size`): see setBenchmarkPoolSize().
+     * - EngineConfig::KeyTuningDatabase (`tuning_db`): see setTuningDatabaseFilename().
+     * - EngineConfig::KeySpillDirectory (`spill_dir`): see setSpillDirectory().
+     */
+    void applyConfiguration(const EngineConfig &config);
+
+    /**
+     * @brief Retrieves accounting of the handles to `EngineObject` instances
+     * currently alive in this engine.
+     * @details Handles created through createHandle(), createEngineObj() and
+     * duplicateHandle() are counted until destroyed, or until the arena where they
+     * were created is released. Sizes are accounted using the `size` field of each
+     * handle, or `sizeof(T)` for objects created through createEngineObj(), which have
+     * no handle size. Peaks are tracked since engine creation or the last call to
+     * resetHandleStatsPeaks().
+     * @sa hebench::APIBridge::getHandleStats()
+     */
+    hebench::APIBridge::HandleStats getHandleStats() const;
+    /**
+     * @brief Sets the peaks reported by getHandleStats() to the current live values.
+     * @details Use this to measure peaks per phase of a run.
+     */
+    void resetHandleStatsPeaks();
 
     /**
      * @brief Retrieves backend specific text description for a benchmark descriptor.
@@ -183,9 +379,36 @@ public:
      * @brief Destroys and cleans up a benchmark created by createBenchmark().
      * @param[in] h_bench Handle to benchmark to destroy.
      * @throws HEBenchError on invalid handle with error code HEBENCH_ECODE_CRITICAL_ERROR.
+     * @details If benchmark pooling is enabled, the benchmark is kept for reuse
+     * when BaseBenchmark::reset() succeeds, instead of being destroyed.
+     * @sa setBenchmarkPoolSize()
      */
     void destroyBenchmark(hebench::APIBridge::Handle h_bench);
 
+    /**
+     * @brief Sets the maximum number of released benchmarks kept for reuse.
+     * @param[in] pool_size Maximum number of pooled benchmarks. If 0, pooling is
+     * disabled. Default is 0.
+     * @details With pooling enabled, destroyBenchmark() resets benchmarks (see
+     * BaseBenchmark::reset()) and keeps the ones that can be reused. A later call to
+     * createBenchmark() with the same description and workload parameters returns
+     * a pooled benchmark instead of constructing a new one, so that expensive
+     * precomputation survives across repeated runs. When the pool is full, the
+     * benchmark released first is destroyed.
+     *
+     * The C++ wrapper calls this method during engine initialization if the
+     * configuration buffer passed to `hebench::APIBridge::initEngine()` specifies
+     * `benchmark_pool_size=<count>`.
+     */
+    void setBenchmarkPoolSize(std::size_t pool_size);
+    std::size_t benchmarkPoolSize() const;
+    /**
+     * @brief Destroys all benchmarks in the benchmark pool.
+     * @details The C++ wrapper calls this method before destroying the engine, so
+     * that pooled benchmarks are destroyed while the derived engine is still alive.
+     */
+    void clearBenchmarkPool();
+
     template <class T, typename... Args>
     /**
      * @brief Encapsulates an object of type T in an opaque HEBench handle.
@@ -203,6 +426,30 @@ public:
      */
     hebench::APIBridge::Handle createHandle(std::uint64_t size, std::int64_t extra_tags,
                                             Args &&... args) const;
+    template <class T, typename... Args>
+    /**
+     * @brief Encapsulates an object of type T, allocated in an arena, in an opaque
+     * HEBench handle.
+     * @param[in] arena Arena where to allocate the object and its wrapper.
+     * @param[in] size Value to use as the `size` filed for the handle.
+     * @param[in] extra_tags Value to use as the `tag` filed for the handle.
+     * @param[in] args Constructor arguments to construct the object of type T.
+     * @return A handle that can cross the boundary of the API bridge.
+     * @throws hebench::cpp::HEBenchError if any of the most significant 8 bits
+     * of `extra_tags` is set.
+     * @details Behaves as createHandle(std::uint64_t, std::int64_t, Args &&...), except
+     * that memory is taken from \p arena. Destroying the handle, or its duplicates,
+     * only updates the accounting of handles: the memory, and the encapsulated
+     * object, are released when the arena is destroyed, which calls the destructor
+     * of every object of type T created this way. Handles must not be used, nor destroyed,
+     * after their arena is destroyed.
+     *
+     * Use BaseBenchmark::createHandle() to create handles in the arena of a
+     * benchmark, if enabled.
+     * @sa BaseBenchmark::enableArena()
+     */
+    hebench::APIBridge::Handle createHandle(Arena &arena, std::uint64_t size, std::int64_t extra_tags,
+                                            Args &&... args) const;
     /**
      * @brief Duplicates a handle created by `createhandle()`.
      * @param[in] h Handle to duplicate.
@@ -252,18 +499,59 @@ public:
      * @param[in] extra_tags Value to check against the `tag` for the handle.
      * @return A reference to the object of type T encapsulated in the handle.
      * @throws hebench::cpp::HEBenchError if any of the most significant 8 bits
-     * of `extra_tags` is set, or
+     * of `extra_tags` is set, if
      * @code
      * handle.tag & EngineObject::tag != EngineObject::tag
      * || handle.tag & extra_tags != extra_tags
      * @endcode
-     * @details Note that once extracted, the object will be statically casted to type T.
-     * Due to the nature of the opaque handles, this cast is <b>unsafe</b>, and thus,
-     * it is user's responsibility to make sure that the encapsulated object is of the
-     * right type (such as using the `tag` field in the handle for extra information).
-     * @sa createHandle(), EngineObject::tag
+     * or if the encapsulated object is not of type T. Tags, null handles and the type
+     * of the object are checked with validation level `HEBENCH_VALIDATION_CHEAP` or
+     * higher; \p extra_tags, only with `HEBENCH_VALIDATION_FULL`.
+     * @details Handles created by createHandle() record the TypeID of the encapsulated
+     * object, so, retrieving it as the wrong type is detected with a single integer
+     * comparison instead of resulting in undefined behavior. Tags are still useful to
+     * distinguish between objects of the same type that represent different stages
+     * of the workflow.
+     *
+     * The encapsulated object may be shared among handle duplicates (see duplicateHandle()),
+     * and changes made through the returned reference are visible to all of them.
+     * Use retrieveConstFromHandle() for read-only access, or retrieveMutableFromHandle()
+     * to modify the object of this handle only.
+     * @sa createHandle(), retrieveConstFromHandle(), retrieveMutableFromHandle(),
+     * EngineObject::tag, EngineObject::get()
      */
     T &retrieveFromHandle(hebench::APIBridge::Handle h, std::int64_t extra_tags = 0) const;
+    template <class T>
+    /**
+     * @brief Retrieves the object of type T encapsulated in an opaque HEBench handle
+     * by method createHandle() for reading.
+     * @param[in] h Handle containing the object.
+     * @param[in] extra_tags Value to check against the `tag` for the handle.
+     * @return A read-only reference to the object of type T encapsulated in the handle.
+     * @throws hebench::cpp::HEBenchError under the same conditions as retrieveFromHandle().
+     * @details Preferred over retrieveFromHandle() when the object is not modified,
+     * since the object may be shared among handle duplicates.
+     * @sa retrieveFromHandle(), retrieveMutableFromHandle()
+     */
+    const T &retrieveConstFromHandle(hebench::APIBridge::Handle h, std::int64_t extra_tags = 0) const;
+    template <class T>
+    /**
+     * @brief Retrieves the object of type T encapsulated in an opaque HEBench handle
+     * by method createHandle() for modification.
+     * @param[in] h Handle containing the object.
+     * @param[in] extra_tags Value to check against the `tag` for the handle.
+     * @return A reference to the object of type T encapsulated in the handle that
+     * can be safely modified.
+     * @throws hebench::cpp::HEBenchError under the same conditions as retrieveFromHandle().
+     * @details The object is retrieved using copy-on-write semantics: if the object
+     * is shared with other handles, created by duplicateHandle(), the handle \p h is
+     * detached to encapsulate a copy of the object before returning it. Otherwise,
+     * no copy is performed and the object can be transformed in place.
+     *
+     * The `size` and `tag` fields of handle \p h remain valid after this call.
+     * @sa retrieveFromHandle(), EngineObject::getMutable()
+     */
+    T &retrieveMutableFromHandle(hebench::APIBridge::Handle h, std::int64_t extra_tags = 0) const;
 
     template <class T, typename... Args>
     /**
@@ -274,6 +562,8 @@ public:
      * @details Pointers to `EngineObject` instances make easier to wrap
      * backend internal objects that need to cross the boundary of the API bridge. For
      * easier use, see method createHandle().
+     *
+     * The object is accounted by getHandleStats() with size `sizeof(T)`.
      * @sa createHandle(), retrieveFromHandle()
      */
     EngineObject *createEngineObj(Args &&... args) const;
@@ -292,16 +582,46 @@ public:
      */
     std::shared_ptr<T> createRAII(Args &&... args) const;
     template <class T, typename... Args>
+    /**
+     * @brief Creates a smart pointer to an object of the specified template type
+     * allocated in an arena.
+     * @param[in] arena Arena where to allocate the object and the reference count.
+     * @param args Arguments for constructor of object of specified type to be created.
+     * @return std::shared_ptr of the specified template type.
+     * @details The object is destroyed when the arena is destroyed, regardless of
+     * the reference count of the smart pointer.
+     */
+    std::shared_ptr<T> createArenaRAII(Arena &arena, Args &&... args) const;
+    template <class T, typename... Args>
     T *createObj(Args &&... args) const;
     template <class T>
     void destroyObj(T *p) const
     {
         if (p)
-            delete p;
+        {
+            onObjDestroyed(p);
+            if (!releaseArenaObj(p))
+                delete p;
+        } // end if
     }
 
 protected:
+    /**
+     * @brief Constructs an engine with an empty configuration.
+     * @details `hebench::APIBridge::initEngine()` applies the configuration
+     * received by the engine after createEngine() returns, thus, after init().
+     */
     BaseEngine();
+    /**
+     * @brief Constructs an engine and applies a configuration to it.
+     * @param[in] config Configuration received by the engine, usually
+     * `EngineConfig::parse(p_buffer, size)` from the arguments of createEngine().
+     * @throws HEBenchError if a standard key has an invalid value.
+     * @details Derived classes use this constructor to have the configuration applied,
+     * and available through configuration(), during init().
+     * @sa applyConfiguration(const EngineConfig &)
+     */
+    explicit BaseEngine(const EngineConfig &config);
     /**
      * @brief Initializes the backend engine and populates the backend description.
      * @details
@@ -311,6 +631,9 @@ protected:
      * the descriptions for the benchmarks that this backend will perform; and add
      * error descriptions, scheme and security names for this backend.
      *
+     * For engines constructed with BaseEngine(const EngineConfig &), the configuration
+     * received by the engine is already applied and available through configuration().
+     *
      * @sa addBenchmarkDescription(), addErrorCode(), addSchemeName(), addSecurityName()
      */
     virtual void init() = 0;
@@ -332,6 +655,19 @@ protected:
      * @sa init()
      */
     void addBenchmarkDescription(std::shared_ptr<BenchmarkDescription> p_desc);
+    /**
+     * @brief Adds a new benchmark to the list of benchmarks to register by this
+     * backend, deferring the creation of its description.
+     * @param[in] factory Functor returning the object describing the new benchmark.
+     * @details The description is created by \p factory the first time it is needed
+     * through matchBenchmark(), and kept afterwards. Backends registering many
+     * benchmarks use this to keep engine initialization cheap, since Test Harness
+     * only inspects the benchmarks it is going to run.
+     *
+     * This method is to be called during engine initialization.
+     * @sa init()
+     */
+    void addBenchmarkDescription(BenchmarkDescriptionFactory factory);
     /**
      * @brief Adds a new supported scheme and name pair to the list of schemes
      * supported by this backend.
@@ -362,17 +698,104 @@ protected:
     static void addErrorCode(hebench::APIBridge::ErrorCode code, const std::string &description);
 
 private:
+    struct DescriptionEntry
+    {
+        BenchmarkDescriptionFactory factory; // empty once materialized
+        std::shared_ptr<BenchmarkDescription> p_description;
+    };
+
+    struct PooledBenchmark
+    {
+        BenchmarkDescription *p_bench_description;
+        BaseBenchmark *p_benchmark;
+    };
+
+    /**
+     * @brief Removes from the pool a benchmark matching the description and parameters.
+     * @return The pooled benchmark, or null if none matches.
+     */
+    BaseBenchmark *acquirePooledBenchmark(BenchmarkDescription &bench_desc,
+                                          const hebench::APIBridge::WorkloadParams *p_params);
+    /**
+     * @brief Resets a released benchmark and adds it to the pool.
+     * @return `true` if the benchmark was pooled, `false` if it must be destroyed.
+     */
+    bool releaseToPool(BenchmarkDescription &bench_desc, BaseBenchmark *p_bench);
     void checkHandleTags(hebench::APIBridge::Handle h, std::int64_t check_tags) const;
     hebench::APIBridge::Handle duplicateHandleInternal(hebench::APIBridge::Handle h, std::int64_t new_tag) const;
+    /**
+     * @brief Accounts for a newly created `EngineObject` that will be wrapped in a
+     * handle of the specified size.
+     */
+    void onEngineObjCreated(EngineObject &obj, std::uint64_t handle_size) const;
+    void onObjDestroyed(const EngineObject *p) const;
+    template <class T>
+    void onObjDestroyed(const T *) const
+    {
+    }
+    /**
+     * @brief Destructs an `EngineObject` allocated in an arena without releasing
+     * its memory.
+     * @return `true` if the object was allocated in an arena, `false` otherwise.
+     */
+    static bool releaseArenaObj(EngineObject *p);
+    template <class T>
+    static bool releaseArenaObj(T *)
+    {
+        return false;
+    }
+    /**
+     * @brief Removes the handles still alive in an arena about to be destroyed
+     * from the accounting.
+     */
+    void onArenaReleased(Arena &arena) const;
+    /**
+     * @brief Reports invalid tags passed by the backend to retrieveFromHandle().
+     */
+    [[noreturn]] HEBENCH_COLD static void throwInvalidExtraTags();
+    /**
+     * @brief Reports a handle that failed the checks of retrieveFromHandle().
+     */
+    [[noreturn]] HEBENCH_COLD static void throwInvalidHandle(hebench::APIBridge::Handle h, std::int64_t extra_tags);
 
     static const std::string UnknownErrorMsg;
     static hebench::APIBridge::ErrorCode m_last_error;
     static std::string m_s_last_error_description;
+    static ErrorRecord m_last_error_record;
+    static bool m_b_last_error_pending;
     static std::unordered_map<hebench::APIBridge::ErrorCode, std::string> m_map_error_desc;
 
-    std::vector<std::shared_ptr<BenchmarkDescription>> m_descriptors;
+    mutable std::vector<DescriptionEntry> m_descriptors;
+    mutable std::mutex m_descriptors_mutex;
     std::unordered_map<hebench::APIBridge::Scheme, std::string> m_map_scheme_name;
     std::unordered_map<hebench::APIBridge::Security, std::string> m_map_security_name;
+
+    mutable std::atomic<std::uint64_t> m_live_handles;
+    mutable std::atomic<std::uint64_t> m_live_handles_size;
+    mutable std::atomic<std::uint64_t> m_peak_handles;
+    mutable std::atomic<std::uint64_t> m_peak_handles_size;
+
+    std::size_t m_thread_pool_size;
+    bool m_b_pin_threads;
+    mutable std::unique_ptr<ThreadPool> m_p_thread_pool;
+    mutable std::mutex m_thread_pool_mutex;
+
+    // declared before every owner of payloads, so that it is destroyed after all of them
+    std::string m_spill_directory;
+    mutable std::unique_ptr<SpillStore> m_p_spill_store;
+    mutable std::mutex m_spill_store_mutex;
+
+    mutable ContextCache m_context_cache;
+    EngineConfig m_config;
+    std::uint64_t m_memory_budget;
+
+    std::string m_tuning_db_filename;
+    mutable std::unique_ptr<TuningDatabase> m_p_tuning_db;
+    mutable std::mutex m_tuning_db_mutex;
+
+    std::size_t m_benchmark_pool_size;
+    std::vector<PooledBenchmark> m_benchmark_pool; // oldest first
+    mutable std::mutex m_benchmark_pool_mutex;
 };
 
 template <class T, typename... Args>
@@ -383,7 +806,9 @@ hebench::APIBridge::Handle BaseEngine::createHandle(std::uint64_t size, std::int
         throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid 'extra_tags' detected. Most significant 8 bits of tags are reserved."),
                                          HEBENCH_ECODE_CRITICAL_ERROR);
 
-    hebench::cpp::EngineObject *p_retval = createEngineObj<T>(std::forward<Args>(args)...);
+    std::shared_ptr<T> raii               = createRAII<T>(std::forward<Args>(args)...);
+    hebench::cpp::EngineObject *p_retval = new EngineObject(*this, raii);
+    onEngineObjCreated(*p_retval, size);
 
     hebench::APIBridge::Handle retval;
     retval.p    = p_retval;
@@ -394,32 +819,67 @@ hebench::APIBridge::Handle BaseEngine::createHandle(std::uint64_t size, std::int
 }
 
 template <class T, typename... Args>
-T &BaseEngine::retrieveFromHandle(hebench::APIBridge::Handle h, std::int64_t extra_tags) const
+hebench::APIBridge::Handle BaseEngine::createHandle(Arena &arena, std::uint64_t size, std::int64_t extra_tags,
+                                                    Args &&... args) const
 {
     if ((extra_tags & ITaggedObject::MaskReservedBits) != 0)
         throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid 'extra_tags' detected. Most significant 8 bits of tags are reserved."),
                                          HEBENCH_ECODE_CRITICAL_ERROR);
-    if ((h.tag & hebench::cpp::EngineObject::tag) != hebench::cpp::EngineObject::tag)
-        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected. Expected EngineObject::tag."),
-                                         HEBENCH_ECODE_CRITICAL_ERROR);
-    if ((h.tag & extra_tags) != extra_tags)
-        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected. Expected " + std::to_string(extra_tags) + "."),
-                                         HEBENCH_ECODE_CRITICAL_ERROR);
 
-    if (!h.p)
-        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid null handle."),
-                                         HEBENCH_ECODE_CRITICAL_ERROR);
+    std::shared_ptr<T> raii               = createArenaRAII<T>(arena, std::forward<Args>(args)...);
+    hebench::cpp::EngineObject *p_retval = arena.createUntracked<EngineObject>(*this, raii);
+    p_retval->m_p_arena                  = &arena;
+    onEngineObjCreated(*p_retval, size);
+
+    hebench::APIBridge::Handle retval;
+    retval.p    = p_retval;
+    retval.size = size;
+    retval.tag  = p_retval->classTag() | extra_tags;
+
+    return retval;
+}
+
+template <class T, typename... Args>
+T &BaseEngine::retrieveFromHandle(hebench::APIBridge::Handle h, std::int64_t extra_tags) const
+{
+    // validate handle
+    retrieveConstFromHandle<T>(h, extra_tags);
 
-    // retrieve our internal format object from the handle
     hebench::cpp::EngineObject *p_obj = reinterpret_cast<hebench::cpp::EngineObject *>(h.p);
     return p_obj->get<T>();
 }
 
+template <class T>
+const T &BaseEngine::retrieveConstFromHandle(hebench::APIBridge::Handle h, std::int64_t extra_tags) const
+{
+    if (HEBENCH_VALIDATE_FULL && (extra_tags & ITaggedObject::MaskReservedBits) != 0)
+        throwInvalidExtraTags();
+    std::int64_t expected_tags = hebench::cpp::EngineObject::tag | extra_tags;
+    if (HEBENCH_VALIDATE_CHEAP && (!h.p || (h.tag & expected_tags) != expected_tags))
+        throwInvalidHandle(h, extra_tags);
+
+    // retrieve our internal format object from the handle
+    const hebench::cpp::EngineObject *p_obj = reinterpret_cast<const hebench::cpp::EngineObject *>(h.p);
+    return p_obj->get<T>();
+}
+
+template <class T>
+T &BaseEngine::retrieveMutableFromHandle(hebench::APIBridge::Handle h, std::int64_t extra_tags) const
+{
+    // validate handle
+    retrieveConstFromHandle<T>(h, extra_tags);
+
+    hebench::cpp::EngineObject *p_obj = reinterpret_cast<hebench::cpp::EngineObject *>(h.p);
+    return p_obj->getMutable<T>();
+}
+
 template <class T, typename... Args>
 EngineObject *BaseEngine::createEngineObj(Args &&... args) const
 {
     std::shared_ptr<T> raii = createRAII<T>(std::forward<Args>(args)...);
     EngineObject *retval    = new EngineObject(*this, raii);
+    // no handle size available: account for the wrapped object itself
+    onEngineObjCreated(*retval, sizeof(T));
     return retval;
 }
 
@@ -433,12 +893,41 @@ std::shared_ptr<T> BaseEngine::createRAII(Args &&... args) const
     return retval;
 }
 
+template <class T, typename... Args>
+std::shared_ptr<T> BaseEngine::createArenaRAII(Arena &arena, Args &&... args) const
+{
+    // the arena owns the object: the deleter is a no-op
+    return std::shared_ptr<T>(arena.template create<T>(std::forward<Args>(args)...),
+                              [](T *) {},
+                              ArenaAllocator<T>(arena));
+}
+
 template <class T, typename... Args>
 T *BaseEngine::createObj(Args &&... args) const
 {
     return new T(std::forward<Args>(args)...);
 }
 
+//--------------------
+// class EngineObject
+//--------------------
+
+template <class T>
+T &EngineObject::getMutable()
+{
+    if (HEBENCH_VALIDATE_CHEAP && !isType<T>())
+        throwTypeMismatch(typeid(T).name());
+    if (isShared())
+    {
+        // detach from other sharing instances by wrapping a copy
+        if (m_p_arena)
+            m_p_obj = m_engine.template createArenaRAII<T>(*m_p_arena, *reinterpret_cast<const T *>(m_p_obj.get()));
+        else
+            m_p_obj = m_engine.template createRAII<T>(*reinterpret_cast<const T *>(m_p_obj.get()));
+    } // end if
+    return *reinterpret_cast<T *>(m_p_obj.get());
+}
+
 } // namespace cpp
 } // namespace hebench
 
@@ -0,0 +1,159 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_EngineConfig_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_EngineConfig_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+
+namespace hebench {
+namespace cpp {
+
+//--------------------
+// class EngineConfig
+//--------------------
+
+/**
+ * @brief Engine configuration received from Test Harness.
+ * @details Parses the configuration buffer passed to `hebench::APIBridge::initEngine()`
+ * into a set of keys with text values, which are converted on access by the typed
+ * getters. Two formats are accepted:
+ * - `key=value` entries separated by white spaces, commas or semicolons. Values
+ * containing separators must be enclosed in double quotes. Entries without `=` are
+ * ignored.
+ * - A JSON object, if the first character that is not a white space is `{`. Values
+ * can be strings, numbers, `true`, `false` or `null`, the latter leaving the key
+ * unset. Members of nested objects are flattened into keys joined by `.`, so that
+ * `{"pool": {"size": 4}}` sets key `pool.size`. Arrays are not supported.
+ *
+ * Engines constructed with BaseEngine::BaseEngine(const EngineConfig &) apply the
+ * standard keys listed in BaseEngine::applyConfiguration() on construction, and
+ * retrieve the rest of their options through BaseEngine::configuration(), already
+ * available in BaseEngine::init(). The C++ wrapper applies the configuration to
+ * other engines once created.
+ *
+ * @code
+ * threads=8 pin_threads=true memory_budget=4GiB tuning_db="/var/tmp/tuning.db"
+ * {"threads": 8, "pin_threads": true, "memory_budget": "4GiB", "tuning_db": "/var/tmp/tuning.db"}
+ * @endcode
+ */
+class EngineConfig
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(EngineConfig)
+
+public:
+    /**
+     * @brief Number of worker threads of BaseEngine::threadPool(). 0 for one thread
+     * per hardware thread.
+     */
+    static constexpr const char *KeyThreads = "threads";
+    /**
+     * @brief Whether worker threads of BaseEngine::threadPool() are pinned to CPUs.
+     */
+    static constexpr const char *KeyPinThreads = "pin_threads";
+    /**
+     * @brief Memory budget of the engine, in bytes. See getBytes() for the format.
+     */
+    static constexpr const char *KeyMemoryBudget = "memory_budget";
+    /**
+     * @brief Capacity of BaseEngine::contextCache().
+     */
+    static constexpr const char *KeyContextCacheSize = "context_cache_size";
+    /**
+     * @brief See BaseEngine::setBenchmarkPoolSize().
+     */
+    static constexpr const char *KeyBenchmarkPoolSize = "benchmark_pool_size";
+    /**
+     * @brief File of BaseEngine::tuningDatabase().
+     */
+    static constexpr const char *KeyTuningDatabase = "tuning_db";
+    /**
+     * @brief Directory of BaseEngine::spillStore().
+     */
+    static constexpr const char *KeySpillDirectory = "spill_dir";
+
+    /**
+     * @brief Parses a configuration from text.
+     * @throws HEBenchError if \p text is a malformed JSON object.
+     */
+    static EngineConfig parse(const std::string &text);
+    /**
+     * @brief Parses a configuration buffer as received by createEngine().
+     * @param[in] p_buffer Configuration buffer. Can be null if \p size is 0.
+     * @param[in] size Number of bytes pointed by \p p_buffer . Trailing null
+     * characters are ignored.
+     * @throws HEBenchError if the buffer is a malformed JSON object.
+     */
+    static EngineConfig parse(const std::int8_t *p_buffer, std::uint64_t size);
+
+    /**
+     * @brief Creates an empty configuration.
+     */
+    EngineConfig() = default;
+
+    bool empty() const { return m_values.empty(); }
+    /**
+     * @brief Whether \p key is set.
+     */
+    bool has(const std::string &key) const { return m_values.count(key) > 0; }
+    /**
+     * @brief Keys set in this configuration, in lexicographic order.
+     */
+    std::vector<std::string> keys() const;
+    /**
+     * @brief Sets the value of \p key , replacing any previous value.
+     */
+    void set(const std::string &key, const std::string &value) { m_values[key] = value; }
+
+    /**
+     * @brief Value of \p key as text, or \p default_value if not set.
+     */
+    std::string getString(const std::string &key, const std::string &default_value = std::string()) const;
+    /**
+     * @brief Value of \p key as a decimal unsigned integer, or \p default_value if not set.
+     * @throws HEBenchError if the value is not a valid unsigned integer.
+     */
+    std::uint64_t getUInt64(const std::string &key, std::uint64_t default_value = 0) const;
+    /**
+     * @brief Value of \p key as a decimal signed integer, or \p default_value if not set.
+     * @throws HEBenchError if the value is not a valid signed integer.
+     */
+    std::int64_t getInt64(const std::string &key, std::int64_t default_value = 0) const;
+    /**
+     * @brief Value of \p key as a floating point number, or \p default_value if not set.
+     * @throws HEBenchError if the value is not a valid number.
+     */
+    double getDouble(const std::string &key, double default_value = 0.0) const;
+    /**
+     * @brief Value of \p key as a boolean, or \p default_value if not set.
+     * @throws HEBenchError if the value is not one of `true`, `false`, `yes`, `no`,
+     * `on`, `off`, `1` or `0`, in any case.
+     */
+    bool getBool(const std::string &key, bool default_value = false) const;
+    /**
+     * @brief Value of \p key as an amount of memory in bytes, or \p default_value if not set.
+     * @throws HEBenchError if the value is not valid or does not fit in 64 bits.
+     * @details The value is an unsigned integer followed by an optional unit: `K`,
+     * `M`, `G` or `T`, optionally followed by `B` or `iB`, in any case. Units are
+     * powers of 1024, so `512M`, `512MB` and `512MiB` are the same amount.
+     */
+    std::uint64_t getBytes(const std::string &key, std::uint64_t default_value = 0) const;
+
+private:
+    [[noreturn]] HEBENCH_COLD void throwInvalidValue(const std::string &key, const std::string &expected) const;
+
+    std::map<std::string, std::string> m_values;
+};
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_EngineConfig_H_7e5fa8c2415240ea93eff148ed73539b
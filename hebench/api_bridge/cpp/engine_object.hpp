@@ -7,14 +7,49 @@
 
 #include <cstdint>
 #include <memory>
+#include <type_traits>
+#include <typeinfo>
 
 #include "error_handling.hpp"
+#include "validation.hpp"
 
 namespace hebench {
 namespace cpp {
 
+class Arena;
 class BaseEngine;
 
+namespace internal {
+
+template <class T>
+struct TypeIDAnchor
+{
+    static constexpr char value = 0;
+};
+template <class T>
+constexpr char TypeIDAnchor<T>::value;
+
+} // namespace internal
+
+/**
+ * @brief Identifier for a C++ type that is computed at compile time.
+ * @details Two identifiers compare equal if and only if they were obtained for
+ * the same type (ignoring top level cv-qualifiers). Comparing identifiers costs
+ * a single integer comparison. A null identifier represents an unknown type.
+ * @sa typeID()
+ */
+typedef const void *TypeID;
+
+template <class T>
+/**
+ * @brief Retrieves the compile-time identifier for type `T`.
+ * @sa TypeID
+ */
+constexpr TypeID typeID()
+{
+    return &internal::TypeIDAnchor<typename std::remove_cv<T>::type>::value;
+}
+
 /**
  * @brief Represents an object with a tag.
  * @details The design philosophy is that objects are tagged using a bit mask.
@@ -76,9 +111,11 @@ public:
  * When using this object directly, instead of the recommended wrappers, users
  * should keep in mind that the method `T &EngineObject::get<T>()` allows the
  * retrieval of a reference to the created object of type `T` by the backend
- * when needed. However, the casting of the internal object by this method is
- * <b>unsafe</b>. Users must ensure that the object contained is of the right
- * type (such as using the `tag` field in the handle for extra information).
+ * when needed. Objects constructed from a typed `std::shared_ptr<T>` (as done
+ * by BaseEngine::createEngineObj()) record the TypeID of `T`, and `get<T>()`
+ * validates the requested type against it with a single integer comparison,
+ * throwing on mismatch. Objects constructed from a `std::shared_ptr<void>` have
+ * no type information and the cast performed by `get<T>()` is <b>unsafe</b>.
  *
  * Implementation of the API Bridge by this C++ wrapper will properly free
  * and destroy pointers to EngineObject instances, and calling the appropriate
@@ -111,15 +148,32 @@ public:
      */
     static constexpr std::int64_t tag = 0x2000000000000000; // bit 61
 
+    /**
+     * @brief Wraps an object of unknown type.
+     * @details Retrieving the wrapped object using `get<T>()` will not be type-checked.
+     */
     EngineObject(const BaseEngine &engine, std::shared_ptr<void> p_obj) :
-        m_engine(engine), m_p_obj(p_obj)
+        m_engine(engine), m_p_obj(p_obj), m_type_id(nullptr), m_type_name(nullptr), m_handle_size(0), m_p_arena(nullptr)
+    {
+        if (!p_obj)
+            throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid null pointer: p_obj"));
+    }
+    template <class T>
+    /**
+     * @brief Wraps an object of type `T`.
+     * @details The TypeID of `T` is recorded to validate later calls to `get<T>()`.
+     */
+    EngineObject(const BaseEngine &engine, std::shared_ptr<T> p_obj) :
+        m_engine(engine), m_p_obj(p_obj), m_type_id(hebench::cpp::typeID<T>()), m_type_name(typeid(T).name()), m_handle_size(0), m_p_arena(nullptr)
     {
         if (!p_obj)
             throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid null pointer: p_obj"));
     }
     EngineObject(const EngineObject &src) :
-        EngineObject(src.engine(), src.m_p_obj)
+        m_engine(src.m_engine), m_p_obj(src.m_p_obj), m_type_id(src.m_type_id), m_type_name(src.m_type_name), m_handle_size(src.m_handle_size), m_p_arena(nullptr)
     {
+        if (!m_p_obj)
+            throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid null pointer: src.m_p_obj"));
     }
     ~EngineObject() override {}
     EngineObject &operator=(const EngineObject &src)
@@ -130,29 +184,113 @@ public:
                 throw std::runtime_error(HEBERROR_MSG_CLASS("Engine mismatch."));
             if (!src.m_p_obj)
                 throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid null pointer: src.m_p_obj"));
-            this->m_p_obj = src.m_p_obj;
+            this->m_p_obj     = src.m_p_obj;
+            this->m_type_id   = src.m_type_id;
+            this->m_type_name = src.m_type_name;
         } // end if
         return *this;
     }
 
     const BaseEngine &engine() const { return m_engine; }
+    /**
+     * @brief Value of the `size` field of the handle wrapping this object, as
+     * accounted for by the engine.
+     * @sa BaseEngine::getHandleStats()
+     */
+    std::uint64_t handleSize() const { return m_handle_size; }
+    /**
+     * @brief Arena where this object and the wrapped object were allocated, or
+     * null if they were allocated on the heap.
+     * @sa BaseEngine::createHandle(Arena &, std::uint64_t, std::int64_t, Args &&...)
+     */
+    Arena *arena() const { return m_p_arena; }
 
+    /**
+     * @brief TypeID of the wrapped object, or null if the type is unknown.
+     */
+    TypeID typeID() const { return m_type_id; }
     template <class T>
+    /**
+     * @brief Tests whether the wrapped object can be retrieved as type `T`.
+     * @returns `true` if the wrapped object is of type `T` or if its type is unknown.
+     */
+    bool isType() const
+    {
+        return !m_type_id || m_type_id == hebench::cpp::typeID<T>();
+    }
+
+    /**
+     * @brief Tests whether the wrapped object is shared with other `EngineObject`
+     * instances, such as those created by BaseEngine::duplicateHandle().
+     */
+    bool isShared() const { return m_p_obj.use_count() > 1; }
+    /**
+     * @brief Tests whether this instance wraps the same object as another.
+     */
+    bool sharesObjectWith(const EngineObject &other) const { return m_p_obj == other.m_p_obj; }
+
+    template <class T>
+    /**
+     * @brief Retrieves the wrapped object.
+     * @throws hebench::cpp::HEBenchError with error code HEBENCH_ECODE_CRITICAL_ERROR
+     * if the wrapped object is known not to be of type `T`. Checked with
+     * validation level `HEBENCH_VALIDATION_CHEAP` or higher.
+     * @details The wrapped object may be shared with other `EngineObject` instances,
+     * and changes made through the returned reference are visible to all of them.
+     * Use getMutable() to obtain a reference that is safe to modify.
+     */
     T &get()
     {
+        if (HEBENCH_VALIDATE_CHEAP && !isType<T>())
+            throwTypeMismatch(typeid(T).name());
         return *reinterpret_cast<T *>(m_p_obj.get());
     }
     template <class T>
+    /**
+     * @brief Retrieves the wrapped object.
+     * @throws hebench::cpp::HEBenchError with error code HEBENCH_ECODE_CRITICAL_ERROR
+     * if the wrapped object is known not to be of type `T`. Checked with
+     * validation level `HEBENCH_VALIDATION_CHEAP` or higher.
+     */
     const T &get() const
     {
+        if (HEBENCH_VALIDATE_CHEAP && !isType<T>())
+            throwTypeMismatch(typeid(T).name());
         return *reinterpret_cast<T *>(m_p_obj.get());
     }
 
+    template <class T>
+    /**
+     * @brief Retrieves the wrapped object for modification using copy-on-write.
+     * @throws hebench::cpp::HEBenchError with error code HEBENCH_ECODE_CRITICAL_ERROR
+     * if the wrapped object is known not to be of type `T`. Checked with
+     * validation level `HEBENCH_VALIDATION_CHEAP` or higher.
+     * @details If the wrapped object is shared with other `EngineObject` instances,
+     * it is first copy-constructed (through the owning engine, in the same arena, if
+     * any) and this instance is detached to wrap the copy. Otherwise, the wrapped object is returned as is,
+     * allowing it to be modified in place without copies.
+     *
+     * Type `T` must be copy constructible.
+     */
+    T &getMutable();
+
     std::int64_t classTag() const override { return EngineObject::tag; }
 
 private:
+    friend class BaseEngine;
+
+    /**
+     * @brief Reports a failed type check.
+     * @details Only debug builds format the names of the types involved.
+     */
+    [[noreturn]] HEBENCH_COLD void throwTypeMismatch(const char *requested_type_name) const;
+
     const BaseEngine &m_engine;
     std::shared_ptr<void> m_p_obj;
+    TypeID m_type_id;
+    const char *m_type_name;
+    std::uint64_t m_handle_size;
+    Arena *m_p_arena;
 };
 
 } // namespace cpp
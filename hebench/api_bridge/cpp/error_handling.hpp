@@ -5,12 +5,20 @@
 #ifndef _HEBench_API_Bridge_Error_H_7e5fa8c2415240ea93eff148ed73539b
 #define _HEBench_API_Bridge_Error_H_7e5fa8c2415240ea93eff148ed73539b
 
+#include <cstdint>
+#include <initializer_list>
 #include <stdexcept>
 #include <string>
 
 namespace hebench {
 namespace cpp {
 
+#if defined(__GNUC__)
+#define HEBENCH_COLD __attribute__((cold, noinline))
+#else
+#define HEBENCH_COLD
+#endif
+
 #define HEBERROR_DECLARE_CLASS_NAME(class_name) static constexpr const char *m_private_class_name = #class_name;
 
 #define HEBERROR_MSG_CLASS(message) hebench::cpp::HEBenchError::generateMessage((message),                      \
@@ -21,6 +29,14 @@ namespace cpp {
                                                                           __func__, std::string(), \
                                                                           __FILE__, __LINE__)
 
+#define HEBERROR_RECORD_CLASS(message, err_code) hebench::cpp::ErrorRecord((err_code), (message),                     \
+                                                                           __func__, m_private_class_name, \
+                                                                           __FILE__, __LINE__)
+
+#define HEBERROR_RECORD(message, err_code) hebench::cpp::ErrorRecord((err_code), (message),         \
+                                                                     __func__, nullptr, \
+                                                                     __FILE__, __LINE__)
+
 class HEBenchError : public std::runtime_error
 {
 public:
@@ -41,6 +57,71 @@ private:
     int m_err_code;
 };
 
+/**
+ * @brief Describes an error without formatting its message.
+ * @details This is the non-throwing counterpart of HEBenchError. Constructing a
+ * record only stores pointers and integers, and the full message is formatted,
+ * in the same format as HEBenchError, only when format() is called.
+ *
+ * The record references, but does not copy, the strings it receives. Thus, these
+ * must outlive the record: use string literals, `__func__` and `__FILE__`, as done
+ * by macros `HEBERROR_RECORD_CLASS()` and `HEBERROR_RECORD()`.
+ */
+class ErrorRecord
+{
+public:
+    ErrorRecord(int err_code         = 0,
+                const char *message   = nullptr,
+                const char *function  = nullptr,
+                const char *container = nullptr,
+                const char *filename  = nullptr,
+                int line_no           = -1) noexcept :
+        m_err_code(err_code),
+        m_message(message),
+        m_function(function),
+        m_container(container),
+        m_filename(filename),
+        m_line_no(line_no)
+    {
+    }
+
+    int getErrorCode() const { return m_err_code; }
+    /**
+     * @brief Message describing the error, or null if none was specified.
+     */
+    const char *getMessage() const { return m_message; }
+    /**
+     * @brief Formats the full error message.
+     * @sa HEBenchError::generateMessage()
+     */
+    std::string format() const;
+    /**
+     * @brief Formats the full error message, replacing each `{}` in the message
+     * by the next of the specified values.
+     */
+    std::string format(std::initializer_list<std::uint64_t> values) const;
+    /**
+     * @brief Throws a HEBenchError with the error code and formatted message of
+     * this record.
+     * @param[in] values Values replacing each `{}` in the message, in order.
+     * @details Out of line and marked cold, so that code checking for errors,
+     * templates in particular, only contains the test and the call:
+     * @code
+     * if (sample.size() < sample_size)
+     *     HEBERROR_RECORD_CLASS("Invalid sample {} for operand {}.", HEBENCH_ECODE_INVALID_ARGS).raise({ sample_i, param_position });
+     * @endcode
+     */
+    [[noreturn]] HEBENCH_COLD void raise(std::initializer_list<std::uint64_t> values = {}) const;
+
+private:
+    int m_err_code;
+    const char *m_message;
+    const char *m_function;
+    const char *m_container;
+    const char *m_filename;
+    int m_line_no;
+};
+
 } // namespace cpp
 } // namespace hebench
 
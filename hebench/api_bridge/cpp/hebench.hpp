@@ -5,11 +5,32 @@
 #ifndef _HEBench_API_Bridge_CPP_H_7e5fa8c2415240ea93eff148ed73539b
 #define _HEBench_API_Bridge_CPP_H_7e5fa8c2415240ea93eff148ed73539b
 
+#include "aligned_allocator.hpp"
+#include "arena.hpp"
+#include "autotuner.hpp"
 #include "benchmark.hpp"
+#include "bounded_queue.hpp"
+#include "cartesian_product.hpp"
+#include "constant_operand_cache.hpp"
+#include "context_cache.hpp"
+#include "data_view.hpp"
+#include "dataset_generator.hpp"
 #include "engine.hpp"
+#include "engine_config.hpp"
 #include "engine_object.hpp"
 #include "error_handling.hpp"
+#include "parameter_sweep.hpp"
+#include "pipeline.hpp"
+#include "random.hpp"
+#include "result_validator.hpp"
+#include "spill_store.hpp"
+#include "tensor.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+#include "typed_benchmark.hpp"
 #include "utilities.hpp"
+#include "validation.hpp"
 #include "workload_params.hpp"
+#include "workload_schema.hpp"
 
 #endif // defined _HEBench_API_Bridge_CPP_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,289 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_ParameterSweep_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_ParameterSweep_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+#include "workload_params.hpp"
+
+namespace hebench {
+namespace cpp {
+
+//----------------------
+// class ParameterSweep
+//----------------------
+
+/**
+ * @brief Sequence of values for a single workload parameter.
+ * @details Values are computed on demand from the declaration of the sequence,
+ * so sweeps cost the same regardless of their length. The type of the values
+ * is deduced from the arguments of the factory methods: floating point types map
+ * to WorkloadParamType::Float64, signed integers to WorkloadParamType::Int64 and
+ * unsigned integers to WorkloadParamType::UInt64. WorkloadSweep converts values
+ * to the type of the parameter they are assigned to, if they fit.
+ */
+class ParameterSweep
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(ParameterSweep)
+
+public:
+    template <class T>
+    /**
+     * @brief Sequence with a single value.
+     */
+    static ParameterSweep value(T v)
+    {
+        return values<T>({ v });
+    }
+    template <class T>
+    /**
+     * @brief Sequence with the specified values, in order.
+     * @throws HEBenchError if \p v is empty.
+     */
+    static ParameterSweep values(const std::vector<T> &v);
+    template <class T>
+    /**
+     * @copydoc values(const std::vector<T> &)
+     */
+    static ParameterSweep values(std::initializer_list<T> v)
+    {
+        return values(std::vector<T>(v));
+    }
+    template <class T>
+    /**
+     * @brief Arithmetic progression `first, first + step, first + 2 * step, ...`
+     * up to \p last inclusive.
+     * @throws HEBenchError if `step <= 0`, `first > last`, or the progression has
+     * more values than fit in a 64-bit count, as `range<std::int64_t>(min, max)`.
+     */
+    static ParameterSweep range(T first, T last, T step = T(1))
+    {
+        return ParameterSweep(Kind::Range, typeOf<T>(), toValue(first), toValue(last), toValue(step));
+    }
+    template <class T>
+    /**
+     * @brief Geometric progression `first, first * ratio, first * ratio^2, ...`
+     * up to \p last inclusive.
+     * @throws HEBenchError if `first <= 0`, `ratio <= 1` or `first > last`.
+     * @details Useful for scaling studies: `geometric(16, 4096, 2)` doubles the
+     * size of the problem on each step.
+     */
+    static ParameterSweep geometric(T first, T last, T ratio = T(2))
+    {
+        return ParameterSweep(Kind::Geometric, typeOf<T>(), toValue(first), toValue(last), toValue(ratio));
+    }
+    /**
+     * @brief Parses a sequence.
+     * @param[in] spec Sequence in one of the formats:
+     * - `first:last` or `first:last:step`: range().
+     * - `first:last:*ratio`: geometric().
+     * - `v0,v1,...`: values().
+     * @param[in] type Type of the values in \p spec.
+     * @throws HEBenchError if \p spec is not valid.
+     */
+    static ParameterSweep parse(const std::string &spec, hebench::APIBridge::WorkloadParamType::WorkloadParamType type);
+
+    hebench::APIBridge::WorkloadParamType::WorkloadParamType type() const { return m_type; }
+    /**
+     * @brief Number of values in the sequence.
+     */
+    std::uint64_t size() const { return m_count; }
+    /**
+     * @brief Sets type and value of a workload parameter to the value at the
+     * specified position of the sequence. The name of the parameter is not modified.
+     */
+    void get(std::uint64_t index, hebench::APIBridge::WorkloadParam &w_param) const;
+    /**
+     * @brief Same sequence with values of the specified type.
+     * @throws HEBenchError if any value does not fit in \p type. Floating point
+     * sequences cannot be converted to integer types.
+     */
+    ParameterSweep as(hebench::APIBridge::WorkloadParamType::WorkloadParamType type) const;
+
+private:
+    enum class Kind
+    {
+        Values,
+        Range,
+        Geometric
+    };
+    union Value
+    {
+        std::int64_t i;
+        std::uint64_t u;
+        double f;
+    };
+
+    template <class T>
+    static hebench::APIBridge::WorkloadParamType::WorkloadParamType typeOf()
+    {
+        static_assert(std::is_arithmetic<T>::value, "Sweep values must be of arithmetic type.");
+        return std::is_floating_point<T>::value ? hebench::APIBridge::WorkloadParamType::Float64 :
+               std::is_signed<T>::value         ? hebench::APIBridge::WorkloadParamType::Int64 :
+                                                  hebench::APIBridge::WorkloadParamType::UInt64;
+    }
+    template <class T>
+    static Value toValue(T v)
+    {
+        Value retval;
+        if (std::is_floating_point<T>::value)
+            retval.f = static_cast<double>(v);
+        else if (std::is_signed<T>::value)
+            retval.i = static_cast<std::int64_t>(v);
+        else
+            retval.u = static_cast<std::uint64_t>(v);
+        return retval;
+    }
+
+    ParameterSweep(hebench::APIBridge::WorkloadParamType::WorkloadParamType type, std::vector<Value> values);
+    ParameterSweep(Kind kind, hebench::APIBridge::WorkloadParamType::WorkloadParamType type,
+                   Value first, Value last, Value step);
+    Value valueAt(std::uint64_t index) const;
+
+    Kind m_kind;
+    hebench::APIBridge::WorkloadParamType::WorkloadParamType m_type;
+    Value m_first;
+    Value m_step; // step for ranges, ratio for geometric progressions
+    std::uint64_t m_count;
+    std::vector<Value> m_values;
+};
+
+template <class T>
+ParameterSweep ParameterSweep::values(const std::vector<T> &v)
+{
+    std::vector<Value> converted;
+    converted.reserve(v.size());
+    for (const T &value : v)
+        converted.push_back(toValue(value));
+    return ParameterSweep(typeOf<T>(), std::move(converted));
+}
+
+//---------------------
+// class WorkloadSweep
+//---------------------
+
+/**
+ * @brief Declares a family of sets of workload parameters.
+ * @details Starts from a base set of workload parameters, which fixes the number,
+ * names and types of the parameters, and the values of parameters not swept. Each
+ * call to vary() adds a dimension to the sweep, which assigns the values of a
+ * ParameterSweep to one or more parameters. Parameters varied together in the same
+ * dimension take the same values at the same time, as for the sizes of square
+ * matrices. The sets in the sweep are the cartesian product of all dimensions, with
+ * the last dimension added varying fastest.
+ *
+ * Sets are computed on demand by at(), so large sweeps occupy the same memory as
+ * the base set.
+ *
+ * @code
+ * // weak scaling of square matrices, and strong scaling over a fixed inner dimension
+ * typedef WorkloadSchema<WorkloadSchemas::MatrixMultiply> MatMul;
+ * addDefaultParameters(WorkloadSweep(MatMul::makeDefault(1, 1, 1))
+ *                          .vary({ MatMul::RowsM0, MatMul::ColsM0, MatMul::ColsM1 }, ParameterSweep::geometric(16, 1024)));
+ * addDefaultParameters(WorkloadSweep(MatMul::makeDefault(1, 4096, 1))
+ *                          .vary(MatMul::RowsM0, ParameterSweep::range(64, 512, 64))
+ *                          .vary(MatMul::ColsM1, ParameterSweep::values({ 1, 16 })));
+ * // same as the last one, from a string that can come from configuration
+ * addDefaultParameters(WorkloadSweep(MatMul::makeDefault(1, 4096, 1)).vary("rows_M0=64:512:64; cols_M1=1,16"));
+ * @endcode
+ */
+class WorkloadSweep
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(WorkloadSweep)
+
+public:
+    /**
+     * @brief Creates a sweep with a single set: \p base_params.
+     */
+    explicit WorkloadSweep(std::vector<hebench::APIBridge::WorkloadParam> base_params);
+    /**
+     * @copydoc WorkloadSweep(std::vector<hebench::APIBridge::WorkloadParam>)
+     */
+    explicit WorkloadSweep(const WorkloadParams::Common &base_params) :
+        WorkloadSweep(base_params.getParams())
+    {
+    }
+
+    /**
+     * @brief Adds a dimension that assigns the values of \p sweep to a parameter.
+     * @throws HEBenchError if \p param_index is out of range or already varied, if
+     * the values of \p sweep do not fit the type of the parameter, or if the number
+     * of sets in the sweep overflows.
+     */
+    WorkloadSweep &vary(std::size_t param_index, const ParameterSweep &sweep)
+    {
+        return vary({ param_index }, sweep);
+    }
+    /**
+     * @brief Adds a dimension that assigns the values of \p sweep to all parameters
+     * in \p param_indices at the same time.
+     * @throws HEBenchError under the same conditions as vary(std::size_t, const ParameterSweep &).
+     */
+    WorkloadSweep &vary(std::initializer_list<std::size_t> param_indices, const ParameterSweep &sweep)
+    {
+        return vary(std::vector<std::size_t>(param_indices), sweep);
+    }
+    /**
+     * @copydoc vary(std::initializer_list<std::size_t>, const ParameterSweep &)
+     */
+    WorkloadSweep &vary(const std::vector<std::size_t> &param_indices, const ParameterSweep &sweep);
+    /**
+     * @brief Adds the dimensions declared in a string.
+     * @param[in] spec Dimensions separated by `;`. Each dimension has the format
+     * `name[,name...]=sequence`, where each `name` is the name of a parameter in
+     * the base set, and `sequence` has the format accepted by ParameterSweep::parse(),
+     * with values of the type of the first parameter named.
+     * @throws HEBenchError if \p spec is not valid or names an unknown parameter.
+     */
+    WorkloadSweep &vary(const std::string &spec);
+
+    /**
+     * @brief Number of parameters in each set.
+     */
+    std::size_t parameterCount() const { return m_base_params.size(); }
+    /**
+     * @brief Number of sets in the sweep.
+     */
+    std::uint64_t size() const { return m_size; }
+    /**
+     * @brief Computes the set of workload parameters at the specified position.
+     * @param[in] index Position of the set, in range `[0, size())`.
+     * @param[out] p_params Array of parameterCount() elements where to store the set.
+     * @throws HEBenchError if \p index is out of range.
+     */
+    void at(std::uint64_t index, hebench::APIBridge::WorkloadParam *p_params) const;
+    /**
+     * @copybrief at(std::uint64_t, hebench::APIBridge::WorkloadParam *) const
+     */
+    std::vector<hebench::APIBridge::WorkloadParam> at(std::uint64_t index) const;
+
+private:
+    struct Dimension
+    {
+        std::vector<std::size_t> param_indices;
+        std::vector<ParameterSweep> sweeps; // sweep of each parameter, converted to its type
+    };
+
+    std::size_t findParam(const std::string &name) const;
+
+    std::vector<hebench::APIBridge::WorkloadParam> m_base_params;
+    std::vector<Dimension> m_dimensions;
+    std::uint64_t m_size;
+};
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_ParameterSweep_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,374 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_Pipeline_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_Pipeline_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bounded_queue.hpp"
+#include "error_handling.hpp"
+#include "thread_pool.hpp"
+
+namespace hebench {
+namespace cpp {
+
+template <class T>
+/**
+ * @brief Executes a sequence of stages over a stream of items, overlapping the
+ * processing of different items in different stages.
+ * @details Each stage transforms an item in place and passes it to the next stage
+ * through a BoundedQueue. Stages are driven by tasks in a ThreadPool, so that, for
+ * example, item `N + 1` is encoded while item `N` is encrypted and item `N - 1` is
+ * loaded. By default, a stage processes one item at a time, thus, items go through
+ * it in the order they were pushed; stages with higher concurrency process several
+ * items at once, in no particular order.
+ *
+ * The number of items in flight is bounded: push() waits, executing pending tasks
+ * from the pool, while the pipeline holds as many items as its queues and stages
+ * can take. Stages never wait for each other: when the queue of the next stage is
+ * full, a stage helps draining it if the next stage is below its concurrency, or
+ * otherwise parks the item in an unbounded overflow list of the next stage, which
+ * is drained after its queue, keeping items in order. Waiting there could deadlock
+ * whenever the threads draining the next stage are suspended lower in the stack of
+ * the waiting thread, for example, when a stage calls ThreadPool::parallelFor() and
+ * the pool runs a task of the pipeline while waiting for it.
+ *
+ * The last stage consumes the items: items are destroyed after it. If a stage
+ * throws, the item is discarded, the remaining items are still processed, and the
+ * first exception is rethrown by finish(). Stages must release any resource held
+ * by an item they discard.
+ *
+ * Example, preparing samples for an offline run:
+ * @code
+ * struct Sample { std::uint64_t index; DataPackCollection pack; Handle h; };
+ * Pipeline<Sample> pipeline(engine.threadPool());
+ * pipeline.addStage([&](Sample &s) { s.h = encode(&s.pack); })
+ *         .addStage([&](Sample &s) { Handle h = encrypt(s.h); destroyHandle(s.h); s.h = h; })
+ *         .addStage([&](Sample &s) { results[s.index] = s.h; });
+ * for (std::uint64_t i = 0; i < sample_count; ++i)
+ *     pipeline.push(Sample{ i, packs[i], Handle() });
+ * pipeline.finish();
+ * @endcode
+ *
+ * Type `T` must be default constructible, move constructible and nothrow move assignable.
+ * push() and finish() must be called from the same thread.
+ */
+class Pipeline
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(Pipeline)
+
+public:
+    typedef std::function<void(T &)> Stage;
+
+    /**
+     * @brief Default maximum number of items waiting in front of each stage.
+     */
+    static constexpr std::size_t DefaultQueueCapacity = 64;
+
+    Pipeline(const Pipeline &) = delete;
+    Pipeline &operator=(const Pipeline &) = delete;
+
+    /**
+     * @brief Creates a pipeline without stages.
+     * @param[in] pool Pool where stages are executed.
+     * @param[in] queue_capacity Maximum number of items waiting in front of each stage.
+     */
+    explicit Pipeline(ThreadPool &pool, std::size_t queue_capacity = DefaultQueueCapacity);
+    /**
+     * @brief Waits for all pushed items to be processed. Exceptions are discarded.
+     */
+    ~Pipeline();
+
+    /**
+     * @brief Appends a stage to the pipeline.
+     * @param[in] stage Functor called as `stage(item)` for every item, where `item`
+     * is a `T &`.
+     * @param[in] concurrency Maximum number of items processed concurrently by this
+     * stage. If greater than 1, \p stage must be thread safe.
+     * @return This pipeline, to chain calls.
+     * @throws std::logic_error if items have been pushed already.
+     */
+    Pipeline &addStage(Stage stage, std::size_t concurrency = 1);
+
+    /**
+     * @brief Feeds an item to the first stage.
+     * @details Waits, executing pending tasks from the pool, while the pipeline is
+     * full or the queue of the first stage is full.
+     * @throws std::logic_error if the pipeline has no stages.
+     */
+    void push(T item);
+    /**
+     * @brief Waits for all pushed items to go through all stages.
+     * @throws Rethrows the first exception thrown by a stage, if any.
+     * @details The pipeline can be reused after this call.
+     */
+    void finish();
+
+private:
+    struct StageState
+    {
+        StageState(Stage s, std::size_t c, std::size_t queue_capacity) :
+            stage(std::move(s)), concurrency(c), input(queue_capacity), overflow_count(0), scheduled(0), running(0)
+        {
+        }
+
+        Stage stage;
+        std::size_t concurrency;
+        BoundedQueue<T> input;
+        std::mutex overflow_mutex;
+        std::deque<T> overflow; // items received while the input queue was full
+        std::atomic<std::size_t> overflow_count;
+        std::atomic<std::size_t> scheduled; // tasks submitted that have not started
+        std::atomic<std::size_t> running; // threads draining the input queue
+    };
+
+    /**
+     * @brief Pushes an item into the input queue of a stage.
+     * @details While the queue is full, the calling thread drains the stage itself,
+     * if possible. Otherwise, \p b_wait selects whether to wait for room, executing
+     * pending tasks from the pool, as push() does, or to park the item in the
+     * overflow list of the stage, as threads draining a stage do: these must never
+     * wait, since the threads that would make room may be suspended lower in
+     * their own stack.
+     */
+    void enqueue(std::size_t stage_i, T &item, bool b_wait);
+    /**
+     * @brief Retrieves the next item for a stage: from its input queue, or, once
+     * empty, from its overflow list.
+     */
+    static bool tryPop(StageState &state, T &item);
+    static bool hasInput(const StageState &state);
+    /**
+     * @brief Submits a task to drain the input queue of a stage, unless enough
+     * tasks are pending already.
+     */
+    void schedule(std::size_t stage_i);
+    static bool tryAcquire(std::atomic<std::size_t> &counter, std::size_t limit);
+    /**
+     * @brief Drains the input queue of a stage if the stage is not running at its
+     * maximum concurrency.
+     */
+    void drain(std::size_t stage_i);
+    void onStageError(std::exception_ptr p_ex);
+
+    ThreadPool &m_pool;
+    std::size_t m_queue_capacity;
+    std::vector<std::unique_ptr<StageState>> m_stages;
+    std::size_t m_max_in_flight; // sum of the capacities and concurrencies of all stages
+    std::atomic<std::size_t> m_in_flight; // items pushed and not yet consumed nor discarded
+    bool m_b_started;
+    std::mutex m_error_mutex;
+    std::exception_ptr m_p_exception;
+    TaskGroup m_tasks; // last member: waited on first during destruction
+};
+
+template <class T>
+constexpr std::size_t Pipeline<T>::DefaultQueueCapacity;
+
+template <class T>
+Pipeline<T>::Pipeline(ThreadPool &pool, std::size_t queue_capacity) :
+    m_pool(pool),
+    m_queue_capacity(queue_capacity),
+    m_max_in_flight(0),
+    m_in_flight(0),
+    m_b_started(false),
+    m_tasks(pool)
+{
+    if (queue_capacity == 0)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid zero queue capacity."));
+}
+
+template <class T>
+Pipeline<T>::~Pipeline()
+{
+    try
+    {
+        m_tasks.wait();
+    }
+    catch (...)
+    {
+        // destructors must not throw
+    }
+}
+
+template <class T>
+Pipeline<T> &Pipeline<T>::addStage(Stage stage, std::size_t concurrency)
+{
+    if (m_b_started)
+        throw std::logic_error(HEBERROR_MSG_CLASS("Stages cannot be added after items are pushed."));
+    if (!stage)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid empty stage."));
+    m_stages.emplace_back(new StageState(std::move(stage), concurrency > 0 ? concurrency : 1, m_queue_capacity));
+    m_max_in_flight += m_stages.back()->input.capacity() + m_stages.back()->concurrency;
+    return *this;
+}
+
+template <class T>
+void Pipeline<T>::push(T item)
+{
+    if (m_stages.empty())
+        throw std::logic_error(HEBERROR_MSG_CLASS("Pipeline has no stages."));
+    m_b_started = true;
+    // bound the items in flight: stages never wait, so their overflow lists may grow
+    while (m_in_flight.load(std::memory_order_acquire) >= m_max_in_flight)
+        if (!m_pool.runPendingTask())
+            std::this_thread::yield();
+    m_in_flight.fetch_add(1, std::memory_order_acq_rel);
+    try
+    {
+        enqueue(0, item, true);
+    }
+    catch (...)
+    {
+        m_in_flight.fetch_sub(1, std::memory_order_acq_rel);
+        throw;
+    }
+}
+
+template <class T>
+void Pipeline<T>::finish()
+{
+    m_tasks.wait();
+
+    std::exception_ptr p_ex;
+    {
+        std::lock_guard<std::mutex> lock(m_error_mutex);
+        std::swap(p_ex, m_p_exception);
+    }
+    if (p_ex)
+        std::rethrow_exception(p_ex);
+}
+
+template <class T>
+bool Pipeline<T>::tryAcquire(std::atomic<std::size_t> &counter, std::size_t limit)
+{
+    std::size_t value = counter.load(std::memory_order_acquire);
+    while (value < limit)
+        if (counter.compare_exchange_weak(value, value + 1, std::memory_order_acq_rel))
+            return true;
+    return false;
+}
+
+template <class T>
+void Pipeline<T>::enqueue(std::size_t stage_i, T &item, bool b_wait)
+{
+    StageState &state = *m_stages[stage_i];
+    // once items overflow, later items follow them to keep the order
+    while (state.overflow_count.load(std::memory_order_acquire) > 0 || !state.input.tryPush(item))
+    {
+        // stage is behind: help it, or let the threads draining it progress
+        if (state.running.load(std::memory_order_acquire) < state.concurrency)
+            drain(stage_i);
+        else if (!b_wait)
+        {
+            std::lock_guard<std::mutex> lock(state.overflow_mutex);
+            state.overflow.push_back(std::move(item));
+            state.overflow_count.fetch_add(1, std::memory_order_acq_rel);
+            break;
+        } // end else if
+        else if (!m_pool.runPendingTask())
+            std::this_thread::yield();
+    } // end while
+    schedule(stage_i);
+}
+
+template <class T>
+bool Pipeline<T>::tryPop(StageState &state, T &item)
+{
+    if (state.input.tryPop(item))
+        return true;
+    if (state.overflow_count.load(std::memory_order_acquire) == 0)
+        return false;
+    std::lock_guard<std::mutex> lock(state.overflow_mutex);
+    if (state.overflow.empty())
+        return false;
+    item = std::move(state.overflow.front());
+    state.overflow.pop_front();
+    state.overflow_count.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+template <class T>
+bool Pipeline<T>::hasInput(const StageState &state)
+{
+    return !state.input.empty() || state.overflow_count.load(std::memory_order_acquire) > 0;
+}
+
+template <class T>
+void Pipeline<T>::schedule(std::size_t stage_i)
+{
+    StageState &state = *m_stages[stage_i];
+    if (tryAcquire(state.scheduled, state.concurrency))
+    {
+        try
+        {
+            m_tasks.run([this, stage_i]() {
+                m_stages[stage_i]->scheduled.fetch_sub(1, std::memory_order_acq_rel);
+                drain(stage_i);
+            });
+        }
+        catch (...)
+        {
+            state.scheduled.fetch_sub(1, std::memory_order_acq_rel);
+            throw;
+        }
+    } // end if
+}
+
+template <class T>
+void Pipeline<T>::drain(std::size_t stage_i)
+{
+    StageState &state = *m_stages[stage_i];
+    bool b_last       = stage_i + 1 >= m_stages.size();
+    T item;
+    // an item may be pushed after the queue is found empty, but before this thread
+    // stops counting as running: check again after releasing
+    while (hasInput(state) && tryAcquire(state.running, state.concurrency))
+    {
+        while (tryPop(state, item))
+        {
+            try
+            {
+                state.stage(item);
+                if (b_last)
+                    m_in_flight.fetch_sub(1, std::memory_order_acq_rel);
+                else
+                    enqueue(stage_i + 1, item, false);
+            }
+            catch (...)
+            {
+                // item is discarded
+                m_in_flight.fetch_sub(1, std::memory_order_acq_rel);
+                onStageError(std::current_exception());
+            }
+            item = T();
+        } // end while
+        state.running.fetch_sub(1, std::memory_order_acq_rel);
+    } // end while
+}
+
+template <class T>
+void Pipeline<T>::onStageError(std::exception_ptr p_ex)
+{
+    std::lock_guard<std::mutex> lock(m_error_mutex);
+    if (!m_p_exception)
+        m_p_exception = p_ex;
+}
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_Pipeline_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,276 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_Random_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_Random_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace hebench {
+namespace cpp {
+
+/**
+ * @brief Advances a SplitMix64 state and returns the next output.
+ * @details Used to expand a single 64-bit seed into the state of larger generators.
+ */
+inline std::uint64_t splitMix64(std::uint64_t &state) noexcept
+{
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z               = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z               = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+//------------------
+// class Xoshiro256
+//------------------
+
+/**
+ * @brief xoshiro256** pseudo-random number generator.
+ * @details Fast, small-state generator with a period of 2^256 - 1, and the ability
+ * to jump ahead 2^128 or 2^192 outputs, which splits its sequence into streams that
+ * do not overlap in practice. Meets the requirements of UniformRandomBitGenerator,
+ * so it can be used with the standard distributions. Outputs are identical on every
+ * platform for the same seed.
+ */
+class Xoshiro256
+{
+public:
+    typedef std::uint64_t result_type;
+
+    /**
+     * @brief Initializes the state from \p seed using SplitMix64.
+     */
+    explicit Xoshiro256(std::uint64_t seed = 0) noexcept
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+            m_s[i] = splitMix64(seed);
+    }
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() noexcept
+    {
+        const std::uint64_t retval = rotl(m_s[1] * 5, 7) * 9;
+        const std::uint64_t t      = m_s[1] << 17;
+        m_s[2] ^= m_s[0];
+        m_s[3] ^= m_s[1];
+        m_s[1] ^= m_s[2];
+        m_s[0] ^= m_s[3];
+        m_s[2] ^= t;
+        m_s[3] = rotl(m_s[3], 45);
+        return retval;
+    }
+
+    /**
+     * @brief Advances the generator 2^128 outputs.
+     */
+    void jump() noexcept
+    {
+        static const std::uint64_t polynomial[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                                    0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+        jump(polynomial);
+    }
+    /**
+     * @brief Advances the generator 2^192 outputs.
+     */
+    void longJump() noexcept
+    {
+        static const std::uint64_t polynomial[] = { 0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+                                                    0x77710069854ee241ULL, 0x39109bb02acbe635ULL };
+        jump(polynomial);
+    }
+
+    /**
+     * @brief Word \p i of the 256-bit state.
+     */
+    std::uint64_t state(std::size_t i) const noexcept { return m_s[i]; }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) noexcept { return (x << k) | (x >> (64 - k)); }
+
+    void jump(const std::uint64_t (&polynomial)[4]) noexcept
+    {
+        std::uint64_t s[4] = { 0, 0, 0, 0 };
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            for (int b = 0; b < 64; ++b)
+            {
+                if (polynomial[i] & (std::uint64_t(1) << b))
+                    for (std::size_t j = 0; j < 4; ++j)
+                        s[j] ^= m_s[j];
+                (*this)();
+            } // end for
+        } // end for
+        for (std::size_t j = 0; j < 4; ++j)
+            m_s[j] = s[j];
+    }
+
+    std::uint64_t m_s[4];
+};
+
+//--------------------
+// class Xoshiro256x4
+//--------------------
+
+/**
+ * @brief Four interleaved xoshiro256** generators, stepped together.
+ * @details The state is laid out so that each step is a sequence of independent
+ * operations over the four lanes, which the compiler turns into SIMD instructions.
+ * Lane `i` is a copy of a Xoshiro256 stream jumped `i` times, so the lanes never
+ * overlap.
+ */
+class Xoshiro256x4
+{
+public:
+    static constexpr std::size_t Lanes = 4;
+
+    /**
+     * @brief Takes the next Lanes streams from \p streams.
+     * @details On return, \p streams has been jumped Lanes times, so that it can
+     * initialize the next Xoshiro256x4 with non-overlapping streams.
+     */
+    explicit Xoshiro256x4(Xoshiro256 &streams) noexcept
+    {
+        for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            for (std::size_t i = 0; i < 4; ++i)
+                m_s[i][lane] = streams.state(i);
+            streams.jump();
+        } // end for
+    }
+
+    /**
+     * @brief Writes the next output of every lane into \p out.
+     */
+    void next(std::uint64_t (&out)[Lanes]) noexcept
+    {
+        for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            const std::uint64_t s1 = m_s[1][lane] * 5;
+            out[lane]              = ((s1 << 7) | (s1 >> 57)) * 9;
+        } // end for
+        for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            const std::uint64_t t = m_s[1][lane] << 17;
+            m_s[2][lane] ^= m_s[0][lane];
+            m_s[3][lane] ^= m_s[1][lane];
+            m_s[1][lane] ^= m_s[2][lane];
+            m_s[0][lane] ^= m_s[3][lane];
+            m_s[2][lane] ^= t;
+            m_s[3][lane] = (m_s[3][lane] << 45) | (m_s[3][lane] >> 19);
+        } // end for
+    }
+
+private:
+    std::uint64_t m_s[4][Lanes];
+};
+
+//---------------------------
+// class UniformDistribution
+//---------------------------
+
+template <class T, class Enable = void>
+class UniformDistribution;
+
+template <class T>
+/**
+ * @brief Maps 64 random bits to a value uniformly distributed in `[min, max)`.
+ * @details Unlike the standard distributions, the mapping consumes exactly one
+ * 64-bit output per value and does not branch, so it vectorizes and produces the
+ * same values on every platform.
+ */
+class UniformDistribution<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+public:
+    static_assert(std::numeric_limits<T>::digits < 64, "Floating point type not supported.");
+
+    UniformDistribution(T min, T max) noexcept :
+        m_min(min), m_scale((max - min) * (T(1) / T(std::uint64_t(1) << std::numeric_limits<T>::digits)))
+    {
+    }
+    T operator()(std::uint64_t bits) const noexcept
+    {
+        // top mantissa-sized bits: exactly representable in T
+        return m_min + T(bits >> (64 - std::numeric_limits<T>::digits)) * m_scale;
+    }
+
+private:
+    T m_min;
+    T m_scale;
+};
+
+template <class T>
+/**
+ * @brief Maps 64 random bits to a value uniformly distributed in `[min, max]`.
+ * @details Uses the high half of a 64x64-bit product instead of a modulo, which
+ * has a bias below `(max - min + 1) / 2^64` and consumes exactly one 64-bit output
+ * per value.
+ */
+class UniformDistribution<T, typename std::enable_if<std::is_integral<T>::value>::type>
+{
+public:
+    UniformDistribution(T min, T max) noexcept :
+        m_min(min),
+        m_range(static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min) + 1)
+    {
+    }
+    T operator()(std::uint64_t bits) const noexcept
+    {
+        // a range of 0 stands for the full 2^64 values
+        return m_range == 0 ? static_cast<T>(bits) : static_cast<T>(static_cast<std::uint64_t>(m_min) + mulHigh(bits, m_range));
+    }
+
+private:
+    static std::uint64_t mulHigh(std::uint64_t a, std::uint64_t b) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        return static_cast<std::uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+        const std::uint64_t a_lo = a & 0xffffffffULL, a_hi = a >> 32;
+        const std::uint64_t b_lo = b & 0xffffffffULL, b_hi = b >> 32;
+        const std::uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi;
+        const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffULL) + lo_hi;
+        return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+    }
+
+    T m_min;
+    std::uint64_t m_range;
+};
+
+template <class T>
+/**
+ * @brief Fills an array with uniformly distributed values.
+ * @param[in,out] rng Generator. Advanced by `ceil(count / Lanes)` steps.
+ * @param[out] p_data Array to fill.
+ * @param[in] count Number of elements in \p p_data.
+ * @param[in] dist Distribution of the values.
+ */
+void fillUniform(Xoshiro256x4 &rng, T *p_data, std::uint64_t count, const UniformDistribution<T> &dist) noexcept
+{
+    std::uint64_t bits[Xoshiro256x4::Lanes];
+    std::uint64_t i = 0;
+    for (; i + Xoshiro256x4::Lanes <= count; i += Xoshiro256x4::Lanes)
+    {
+        rng.next(bits);
+        for (std::size_t lane = 0; lane < Xoshiro256x4::Lanes; ++lane)
+            p_data[i + lane] = dist(bits[lane]);
+    } // end for
+    if (i < count)
+    {
+        rng.next(bits);
+        for (std::size_t lane = 0; i < count; ++lane, ++i)
+            p_data[i] = dist(bits[lane]);
+    } // end if
+}
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_Random_H_7e5fa8c2415240ea93eff148ed73539b
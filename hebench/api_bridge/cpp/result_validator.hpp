@@ -0,0 +1,300 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_ResultValidator_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_ResultValidator_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+#include "thread_pool.hpp"
+
+namespace hebench {
+namespace cpp {
+
+/**
+ * @brief Tolerance of the comparison of a result element against its expected value.
+ * @details An element matches if it equals the expected value, or if any of the
+ * enabled criteria holds:
+ * - `|actual - expected| <= absolute`
+ * - `|actual - expected| <= relative * |expected|`
+ * - `actual` and `expected` are, at most, `ulps` representable values apart
+ * (floating point types only).
+ *
+ * NaN never matches. A default constructed tolerance requires exact results.
+ */
+struct Tolerance
+{
+    double relative    = 0.0;
+    double absolute    = 0.0;
+    std::uint64_t ulps = 0;
+
+    /**
+     * @brief Tolerance for exact results.
+     */
+    static Tolerance exact() { return Tolerance(); }
+    /**
+     * @brief Default tolerance for results of the specified data type.
+     * @details Exact for integer types. For floating point types, covers the rounding
+     * differences caused by a different order of operations in the backend. Backends
+     * based on approximate schemes, such as CKKS, must set a tolerance that fits
+     * the precision of their parameters.
+     */
+    static Tolerance defaults(hebench::APIBridge::DataType data_type);
+};
+
+namespace internal {
+
+template <class T, bool = std::is_floating_point<T>::value>
+struct ToleranceCheck;
+
+template <class T>
+struct ToleranceCheck<T, true>
+{
+    typedef typename std::conditional<sizeof(T) == sizeof(std::uint64_t), std::uint64_t, std::uint32_t>::type Bits;
+
+    explicit ToleranceCheck(const Tolerance &tol) :
+        relative(static_cast<T>(tol.relative)),
+        absolute(static_cast<T>(tol.absolute)),
+        ulps(tol.ulps > std::numeric_limits<Bits>::max() ? std::numeric_limits<Bits>::max() : static_cast<Bits>(tol.ulps))
+    {
+    }
+
+    /**
+     * @brief Maps the bits of \p value to an unsigned integer with the same order
+     * as the floating point values, so that consecutive values map to consecutive
+     * integers.
+     */
+    static Bits orderedBits(T value)
+    {
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        Bits sign = bits >> (std::numeric_limits<Bits>::digits - 1);
+        // negative values: flip the magnitude; then flip the sign to order both halves
+        return (bits ^ ((Bits(0) - sign) >> 1)) ^ (Bits(1) << (std::numeric_limits<Bits>::digits - 1));
+    }
+
+    // evaluates every criterion without branches, so that loops calling it vectorize
+    bool operator()(T actual, T expected) const
+    {
+        T diff        = std::abs(actual - expected);
+        Bits ordered0 = orderedBits(actual);
+        Bits ordered1 = orderedBits(expected);
+        Bits ulp_diff = ordered0 > ordered1 ? ordered0 - ordered1 : ordered1 - ordered0;
+        return (actual == expected) | (diff <= absolute) | (diff <= relative * std::abs(expected))
+               | ((actual == actual) & (expected == expected) & (ulp_diff <= ulps));
+    }
+
+    T relative;
+    T absolute;
+    Bits ulps;
+};
+
+template <class T>
+struct ToleranceCheck<T, false>
+{
+    typedef typename std::make_unsigned<T>::type Bits;
+
+    explicit ToleranceCheck(const Tolerance &tol) :
+        relative(tol.relative),
+        absolute(tol.absolute >= static_cast<double>(std::numeric_limits<Bits>::max()) ?
+                     std::numeric_limits<Bits>::max() :
+                     static_cast<Bits>(tol.absolute > 0.0 ? tol.absolute : 0.0))
+    {
+    }
+
+    bool operator()(T actual, T expected) const
+    {
+        Bits diff = actual > expected ? static_cast<Bits>(actual) - static_cast<Bits>(expected) :
+                                        static_cast<Bits>(expected) - static_cast<Bits>(actual);
+        return (diff <= absolute) | (static_cast<double>(diff) <= relative * std::abs(static_cast<double>(expected)));
+    }
+
+    double relative;
+    Bits absolute;
+};
+
+} // namespace internal
+
+template <class T>
+/**
+ * @brief Tests whether a result element matches its expected value.
+ */
+inline bool withinTolerance(T actual, T expected, const Tolerance &tolerance)
+{
+    return internal::ToleranceCheck<T>(tolerance)(actual, expected);
+}
+
+template <class T>
+/**
+ * @brief Counts the elements of a result that do not match their expected values.
+ * @param[in] p_actual Result to check.
+ * @param[in] p_expected Expected values.
+ * @param[in] count Number of elements in \p p_actual and \p p_expected.
+ * @param[in] tolerance Tolerance of the comparison.
+ * @details The loop does not branch on the data, so that the compiler turns it into
+ * SIMD instructions. Matching results, the common case, are checked in a single pass.
+ */
+std::uint64_t countMismatches(const T *p_actual, const T *p_expected, std::uint64_t count, const Tolerance &tolerance)
+{
+    const internal::ToleranceCheck<T> check(tolerance);
+    std::uint64_t retval = 0;
+    for (std::uint64_t i = 0; i < count; ++i)
+        retval += check(p_actual[i], p_expected[i]) ? 0 : 1;
+    return retval;
+}
+
+/**
+ * @brief Outcome of ResultValidator::validate().
+ * @details The first mismatch is the one in the result with lowest index, so that
+ * reports do not depend on the number of threads used to validate.
+ */
+struct ValidationReport
+{
+    /**
+     * @brief Number of results validated: one per tuple of input samples.
+     */
+    std::uint64_t result_count = 0;
+    /**
+     * @brief Number of results with, at least, one mismatching element.
+     */
+    std::uint64_t failed_count = 0;
+    /**
+     * @brief Number of mismatching elements among all results.
+     */
+    std::uint64_t mismatch_count = 0;
+    /**
+     * @brief Index of the first failed result.
+     */
+    std::uint64_t first_result = 0;
+    /**
+     * @brief Result component of the first mismatch.
+     */
+    std::uint64_t first_component = 0;
+    /**
+     * @brief Position of the first mismatch in its result component.
+     */
+    std::uint64_t first_element = 0;
+    double first_actual   = 0.0;
+    double first_expected = 0.0;
+
+    bool passed() const { return failed_count == 0; }
+    /**
+     * @brief Human readable description of the outcome.
+     */
+    std::string summary() const;
+};
+
+/**
+ * @brief Validates decoded results of a benchmark against reference implementations.
+ * @details Computes, for every tuple in the cartesian product of the input samples,
+ * the expected result with a plain reference implementation of the workload, and
+ * compares it against the corresponding result with a Tolerance. Tuples are validated
+ * in parallel, in the same row-major order of results as `operate()` (see
+ * CartesianProduct), so offline benchmarks with large datasets are validated at the
+ * speed of the reference implementations.
+ *
+ * Inputs and results are laid out as received by `encode()` and returned by
+ * `decode()`, respectively: one DataPack per operation parameter and per result
+ * component, in position order.
+ *
+ * Reference implementations are provided for every workload except
+ * Workload::Generic, whose operation is defined by the user: set it with
+ * setReference(). Results of Workload::SimpleSetIntersection are compared as sets:
+ * the order of the items in the result does not matter, and unused items must be
+ * zero.
+ *
+ * @code
+ * GeneratedDataset dataset = DatasetGenerator(seed).generate(bench_desc, w_params, &pool);
+ * // ... encode, operate, decode into `results`
+ * ValidationReport report = ResultValidator(bench_desc, w_params).validate(dataset.parameters(), results, &pool);
+ * if (!report.passed())
+ *     std::cerr << report.summary() << std::endl;
+ * @endcode
+ */
+class ResultValidator
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(ResultValidator)
+
+public:
+    /**
+     * @brief Computes the expected result of a single tuple of input samples.
+     * @details Called as `reference(p_inputs, p_results)`, where `p_inputs` has one
+     * sample per operation parameter and `p_results` has one preallocated sample per
+     * result component, sized as reported by resultSizes(). Called concurrently from
+     * several threads.
+     */
+    typedef std::function<void(const hebench::APIBridge::NativeDataBuffer *, hebench::APIBridge::NativeDataBuffer *)> Reference;
+
+    /**
+     * @brief Number of elements in each result component of a workload.
+     * @throws HEBenchError if the workload is not supported or the parameters are invalid.
+     */
+    static std::vector<std::uint64_t> resultSizes(hebench::APIBridge::Workload workload,
+                                                  const hebench::APIBridge::WorkloadParams &w_params);
+
+    /**
+     * @brief Creates a validator with the default tolerance of the data type.
+     * @throws HEBenchError if the workload or data type are not supported, or the
+     * parameters are invalid.
+     */
+    ResultValidator(const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                    const hebench::APIBridge::WorkloadParams &w_params);
+    /**
+     * @brief Creates a validator.
+     * @throws HEBenchError if the workload or data type are not supported, or the
+     * parameters are invalid.
+     */
+    ResultValidator(const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                    const hebench::APIBridge::WorkloadParams &w_params,
+                    const Tolerance &tolerance);
+
+    const Tolerance &tolerance() const { return m_tolerance; }
+    void setTolerance(const Tolerance &tolerance) { m_tolerance = tolerance; }
+    /**
+     * @brief Replaces the reference implementation of the workload.
+     */
+    void setReference(Reference reference) { m_reference = std::move(reference); }
+    /**
+     * @brief Computes the expected result of a single tuple of input samples.
+     * @throws HEBenchError if there is no reference implementation.
+     * @sa Reference
+     */
+    void computeReference(const hebench::APIBridge::NativeDataBuffer *p_inputs,
+                          hebench::APIBridge::NativeDataBuffer *p_results) const;
+    /**
+     * @brief Validates the results of an operation.
+     * @param[in] inputs Input samples of the operation.
+     * @param[in] results Decoded results, one sample per tuple of input samples.
+     * @param[in] p_pool Pool used to validate in parallel, or null to use the calling thread.
+     * @throws HEBenchError if any sample is missing or smaller than required by the
+     * workload, or if there is no reference implementation.
+     */
+    ValidationReport validate(const hebench::APIBridge::DataPackCollection &inputs,
+                              const hebench::APIBridge::DataPackCollection &results,
+                              ThreadPool *p_pool = nullptr) const;
+
+private:
+    hebench::APIBridge::Workload m_workload;
+    hebench::APIBridge::DataType m_data_type;
+    std::vector<std::uint64_t> m_operand_sizes;
+    std::vector<std::uint64_t> m_result_sizes;
+    std::uint64_t m_set_item_size; // elements per item for results compared as sets, 0 otherwise
+    Tolerance m_tolerance;
+    Reference m_reference;
+};
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_ResultValidator_H_7e5fa8c2415240ea93eff148ed73539b
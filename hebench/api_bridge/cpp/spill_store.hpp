@@ -0,0 +1,287 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_SpillStore_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_SpillStore_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+
+namespace hebench {
+namespace cpp {
+
+class SpillStore;
+
+namespace internal {
+
+struct SpillChunk;
+struct SpillEntry;
+
+} // namespace internal
+
+//---------------------
+// class SpilledBuffer
+//---------------------
+
+/**
+ * @brief Buffer of bytes kept in a SpillStore, which may page it out of memory.
+ * @details The contents of the buffer must only be accessed through a Pin: while
+ * pinned, the buffer is resident and the store does not page it out. Pins are
+ * cheap, so benchmarks should pin buffers for the duration of each method that
+ * touches them, such as `operate()`, rather than for their whole lifetime. The
+ * address of the contents is the same for every pin.
+ *
+ * Buffers are movable, but not copyable, and are meant to be the payload of
+ * handles:
+ * @code
+ * SpilledBuffer buffer = engine.spillStore().allocate(ciphertext_size);
+ * {
+ *     SpilledBuffer::Pin pin = buffer.pin();
+ *     serialize(ciphertext, pin.data());
+ * }
+ * Handle h = engine.createHandle<SpilledBuffer>(buffer.size(), 0, std::move(buffer));
+ * @endcode
+ * The store that allocated a buffer must outlive it.
+ */
+class SpilledBuffer
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(SpilledBuffer)
+
+public:
+    /**
+     * @brief Keeps a SpilledBuffer resident while alive.
+     */
+    class Pin
+    {
+    public:
+        Pin(const Pin &) = delete;
+        Pin &operator=(const Pin &) = delete;
+        Pin(Pin &&src) noexcept;
+        Pin &operator=(Pin &&src) noexcept;
+        ~Pin();
+
+        /**
+         * @brief Contents of the pinned buffer.
+         */
+        void *data() const noexcept { return m_p_data; }
+        template <class T>
+        T *data() const noexcept
+        {
+            return static_cast<T *>(m_p_data);
+        }
+        std::uint64_t size() const noexcept { return m_size; }
+        /**
+         * @brief Unpins the buffer before this object is destroyed.
+         */
+        void release() noexcept;
+
+    private:
+        friend class SpilledBuffer;
+
+        Pin(SpillStore *p_store, internal::SpillEntry *p_entry, void *p_data, std::uint64_t size) noexcept;
+
+        SpillStore *m_p_store;
+        internal::SpillEntry *m_p_entry;
+        void *m_p_data;
+        std::uint64_t m_size;
+    };
+
+    /**
+     * @brief Creates an empty buffer.
+     */
+    SpilledBuffer() noexcept;
+    SpilledBuffer(const SpilledBuffer &) = delete;
+    SpilledBuffer &operator=(const SpilledBuffer &) = delete;
+    SpilledBuffer(SpilledBuffer &&src) noexcept;
+    SpilledBuffer &operator=(SpilledBuffer &&src) noexcept;
+    /**
+     * @brief Releases the space of the buffer in its store.
+     */
+    ~SpilledBuffer();
+
+    bool empty() const noexcept { return !m_p_entry; }
+    /**
+     * @brief Number of bytes in the buffer, as requested on allocation.
+     */
+    std::uint64_t size() const noexcept { return m_size; }
+    /**
+     * @brief Whether the store accounts the buffer as resident in memory.
+     */
+    bool resident() const;
+    /**
+     * @brief Pins the buffer in memory, paging it in if needed.
+     * @throws HEBenchError if the buffer is empty.
+     * @details Pinning is thread safe, and a buffer can be pinned several times at once.
+     * Pinning counts as using the buffer: it becomes the most recently used of the store.
+     */
+    Pin pin() const;
+
+private:
+    friend class SpillStore;
+
+    SpilledBuffer(SpillStore *p_store, internal::SpillEntry *p_entry, std::uint64_t size) noexcept;
+    void reset() noexcept;
+
+    SpillStore *m_p_store;
+    internal::SpillEntry *m_p_entry;
+    std::uint64_t m_size;
+};
+
+//------------------
+// class SpillStore
+//------------------
+
+/**
+ * @brief Out-of-core storage for large payloads, such as encrypted operands of
+ * offline benchmarks, that exceed physical memory.
+ * @details Payloads are SpilledBuffer instances carved from chunks of memory mapped
+ * from unlinked files in a local directory. Since the mappings are backed by files
+ * instead of swap, the operating system can write them back and reclaim their memory
+ * under pressure. On top of that, the store tracks which payloads are resident and
+ * keeps them under a memory budget: when pinning a payload takes the resident bytes
+ * over the budget, the least recently used payloads that are not pinned are written
+ * to their files and dropped from memory, to be paged in again on next pin. Files are
+ * fully reserved on creation, so page outs do not run out of disk space; a payload
+ * that fails to be written stays resident. Writes happen outside the lock of the
+ * store, by the thread whose pin, unpin or setBudget() took the store over budget, and
+ * pinning a payload that is being paged out waits for its write to complete.
+ *
+ * Payloads are page aligned and occupy whole pages, so the store is meant for
+ * payloads of, at least, several pages. Payloads larger than half a chunk get a
+ * chunk of their own. Chunks are released when all of their payloads are destroyed.
+ *
+ * BaseEngine::spillStore() is the store shared by all benchmarks of an engine, with
+ * the engine memory budget. On platforms without memory mapped files, payloads are
+ * kept in memory and never paged out.
+ *
+ * All methods are thread safe.
+ */
+class SpillStore
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(SpillStore)
+
+public:
+    /**
+     * @brief Default size, in bytes, of the chunks of the store.
+     */
+    static constexpr std::uint64_t DefaultChunkSize = std::uint64_t(1) << 28;
+
+    /**
+     * @brief Directory named by environment variable `HEBENCH_SPILL_DIR`, or
+     * `/var/tmp` if not set.
+     * @details The directory should be on a local disk: spilling to a memory backed
+     * file system, such as `tmpfs`, frees no memory.
+     */
+    static std::string defaultDirectory();
+    /**
+     * @brief Checks that a directory can hold the files of a store.
+     * @param[in] directory Directory to check. If empty, defaultDirectory() is checked.
+     * @throws HEBenchError if \p directory does not exist, is not a directory, or the
+     * process cannot create files in it.
+     */
+    static void validateDirectory(const std::string &directory);
+
+    SpillStore(const SpillStore &) = delete;
+    SpillStore &operator=(const SpillStore &) = delete;
+
+    /**
+     * @brief Creates an empty store.
+     * @param[in] directory Directory where to create the files of the store. Files
+     * are unlinked on creation, so they are removed when the store is destroyed or
+     * the process ends. If empty, defaultDirectory() is used.
+     * @param[in] budget Maximum number of resident bytes of payloads. Pinned payloads
+     * are never paged out, so they can take the store over budget. If 0, the store
+     * pages nothing out by itself.
+     * @param[in] chunk_size Size, in bytes, of the chunks of the store.
+     */
+    explicit SpillStore(const std::string &directory = std::string(),
+                        std::uint64_t budget         = 0,
+                        std::uint64_t chunk_size     = DefaultChunkSize);
+    /**
+     * @brief Releases all chunks. Buffers allocated from the store must have been
+     * destroyed.
+     */
+    ~SpillStore();
+
+    const std::string &directory() const { return m_directory; }
+    std::uint64_t budget() const;
+    /**
+     * @brief Sets the memory budget, paging out payloads if needed.
+     */
+    void setBudget(std::uint64_t budget);
+
+    /**
+     * @brief Allocates a buffer in the store.
+     * @param[in] size Number of bytes of the buffer.
+     * @throws HEBenchError if a file of the store could not be created, reserved on
+     * disk or mapped.
+     * @details The contents of a new buffer are zero. New buffers are not resident
+     * until pinned.
+     */
+    SpilledBuffer allocate(std::uint64_t size);
+    /**
+     * @brief Pages out all payloads that are not pinned.
+     * @details Page outs are synchronous: payloads are written to their files before
+     * their memory is released.
+     */
+    void pageOutAll();
+
+    /**
+     * @brief Bytes of all payloads in the store, rounded up to whole pages.
+     */
+    std::uint64_t storedBytes() const;
+    /**
+     * @brief Bytes of payloads accounted as resident, pinned or not.
+     */
+    std::uint64_t residentBytes() const;
+    /**
+     * @brief Number of payloads paged out since the store was created.
+     */
+    std::uint64_t pageOutCount() const;
+
+private:
+    friend class SpilledBuffer;
+
+    void pin(internal::SpillEntry *p_entry);
+    void unpin(internal::SpillEntry *p_entry) noexcept;
+    void release(internal::SpillEntry *p_entry) noexcept;
+    bool isResident(const internal::SpillEntry *p_entry) const;
+
+    // maps a new chunk; called without the lock
+    std::unique_ptr<internal::SpillChunk> createChunk(std::uint64_t size) const;
+    void releaseChunk(internal::SpillChunk *p_chunk) noexcept;
+    // selects payloads to page out and marks them in progress; called with the lock held
+    void selectVictims(bool b_all, std::list<internal::SpillEntry *> &victims) noexcept;
+    // writes back and drops the selected payloads; called without the lock
+    void pageOut(std::list<internal::SpillEntry *> &victims) noexcept;
+
+    std::string m_directory;
+    std::uint64_t m_chunk_size;
+    std::uint64_t m_page_size;
+    mutable std::mutex m_mutex;
+    std::uint64_t m_budget;
+    std::vector<std::unique_ptr<internal::SpillChunk>> m_chunks;
+    internal::SpillChunk *m_p_current; // chunk where small payloads are allocated
+    std::list<internal::SpillEntry *> m_lru; // resident payloads not pinned, most recent first
+    std::uint64_t m_stored_bytes;
+    std::uint64_t m_resident_bytes;
+    std::uint64_t m_paging_out_bytes; // resident bytes of payloads being paged out
+    std::uint64_t m_page_out_count;
+    std::condition_variable m_page_out_done;
+};
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_SpillStore_H_7e5fa8c2415240ea93eff148ed73539b
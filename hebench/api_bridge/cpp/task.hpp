@@ -0,0 +1,391 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_Task_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_Task_H_7e5fa8c2415240ea93eff148ed73539b
+
+#if __cplusplus < 202002L
+#error "Coroutine support requires C++20: link against target hebench_cpp_async."
+#endif
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "error_handling.hpp"
+#include "thread_pool.hpp"
+
+namespace hebench {
+namespace cpp {
+
+template <class T = void>
+class Task;
+
+//-----------------
+// TaskPromiseBase
+//-----------------
+
+/**
+ * @brief Promise state shared by all Task types.
+ * @details Tasks are lazy: a task starts when awaited, and, on completion,
+ * resumes its awaiter through symmetric transfer.
+ */
+class TaskPromiseBase
+{
+public:
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+        template <class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
+        {
+            std::coroutine_handle<> continuation = h.promise().m_continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { m_p_exception = std::current_exception(); }
+
+    void setContinuation(std::coroutine_handle<> continuation) noexcept { m_continuation = continuation; }
+
+protected:
+    void rethrowIfFailed() const
+    {
+        if (m_p_exception)
+            std::rethrow_exception(m_p_exception);
+    }
+
+private:
+    std::coroutine_handle<> m_continuation;
+    std::exception_ptr m_p_exception;
+};
+
+//------------
+// class Task
+//------------
+
+template <class T>
+/**
+ * @brief Coroutine returning a value of type `T` (or nothing, if `T` is `void`).
+ * @details Write asynchronous operations as coroutines returning `Task<T>`, and
+ * `co_await` other tasks and awaitables (such as the completion of a request to
+ * an accelerator) from them. While a coroutine waits, it does not occupy a thread.
+ *
+ * A task starts executing when it is awaited, or when passed to syncWait(), which
+ * blocks the calling thread until the task completes. Exceptions escaping the
+ * coroutine are rethrown to the awaiter.
+ *
+ * @code
+ * Task<Handle> MyBenchmark::operateAsync(Handle h_remote_packed, ...)
+ * {
+ *     Request request = m_device.submit(...);
+ *     co_await request; // thread is free while the device works
+ *     co_return this->getEngine().createHandle<Result>(...);
+ * }
+ * @endcode
+ * @sa syncWait(), resumeOn(), AsyncBenchmark
+ */
+class Task
+{
+public:
+    class promise_type : public TaskPromiseBase
+    {
+    public:
+        Task get_return_object() noexcept { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        template <class U>
+        void return_value(U &&value) { m_result.emplace(std::forward<U>(value)); }
+        T result()
+        {
+            this->rethrowIfFailed();
+            return std::move(*m_result);
+        }
+
+    private:
+        std::optional<T> m_result;
+    };
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    Task(Task &&other) noexcept :
+        m_h(std::exchange(other.m_h, nullptr)) {}
+    Task &operator=(Task &&other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            m_h = std::exchange(other.m_h, nullptr);
+        } // end if
+        return *this;
+    }
+    ~Task() { destroy(); }
+
+    /**
+     * @brief Starts the task and suspends the awaiter until the task completes.
+     * @return The value returned by the task.
+     */
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> h;
+            bool await_ready() const noexcept { return !h || h.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept
+            {
+                h.promise().setContinuation(awaiter);
+                return h;
+            }
+            T await_resume() { return h.promise().result(); }
+        };
+        return Awaiter{ m_h };
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept :
+        m_h(h) {}
+    void destroy() noexcept
+    {
+        if (m_h)
+            m_h.destroy();
+        m_h = nullptr;
+    }
+
+    std::coroutine_handle<promise_type> m_h;
+};
+
+template <>
+/**
+ * @brief Coroutine that does not return a value.
+ */
+class Task<void>
+{
+public:
+    class promise_type : public TaskPromiseBase
+    {
+    public:
+        Task get_return_object() noexcept { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        void return_void() const noexcept {}
+        void result() const { this->rethrowIfFailed(); }
+    };
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    Task(Task &&other) noexcept :
+        m_h(std::exchange(other.m_h, nullptr)) {}
+    Task &operator=(Task &&other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            m_h = std::exchange(other.m_h, nullptr);
+        } // end if
+        return *this;
+    }
+    ~Task() { destroy(); }
+
+    /**
+     * @brief Starts the task and suspends the awaiter until the task completes.
+     */
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> h;
+            bool await_ready() const noexcept { return !h || h.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept
+            {
+                h.promise().setContinuation(awaiter);
+                return h;
+            }
+            void await_resume() const { h.promise().result(); }
+        };
+        return Awaiter{ m_h };
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept :
+        m_h(h) {}
+    void destroy() noexcept
+    {
+        if (m_h)
+            m_h.destroy();
+        m_h = nullptr;
+    }
+
+    std::coroutine_handle<promise_type> m_h;
+};
+
+//----------
+// syncWait
+//----------
+
+/**
+ * @brief Minimal coroutine used by syncWait() to signal a waiting thread.
+ */
+class SyncWaitTask
+{
+public:
+    class Event
+    {
+    public:
+        void set()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_b_set = true;
+            m_cv.notify_all();
+        }
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_b_set; });
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        bool m_b_set = false;
+    };
+
+    class promise_type
+    {
+    public:
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> h) const noexcept { h.promise().p_event->set(); }
+            void await_resume() const noexcept {}
+        };
+
+        SyncWaitTask get_return_object() noexcept { return SyncWaitTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); } // body catches everything
+
+        Event *p_event = nullptr;
+    };
+
+    SyncWaitTask(const SyncWaitTask &) = delete;
+    SyncWaitTask &operator=(const SyncWaitTask &) = delete;
+    ~SyncWaitTask()
+    {
+        if (m_h)
+            m_h.destroy();
+    }
+
+    /**
+     * @brief Runs the coroutine and blocks until it completes.
+     */
+    void run()
+    {
+        Event event;
+        m_h.promise().p_event = &event;
+        m_h.resume();
+        event.wait();
+    }
+
+private:
+    explicit SyncWaitTask(std::coroutine_handle<promise_type> h) noexcept :
+        m_h(h) {}
+
+    std::coroutine_handle<promise_type> m_h;
+};
+
+template <class T>
+SyncWaitTask makeSyncWaitTask(Task<T> &task, std::optional<T> &result, std::exception_ptr &p_ex)
+{
+    try
+    {
+        result.emplace(co_await std::move(task));
+    }
+    catch (...)
+    {
+        p_ex = std::current_exception();
+    }
+}
+
+inline SyncWaitTask makeSyncWaitTask(Task<void> &task, std::exception_ptr &p_ex)
+{
+    try
+    {
+        co_await std::move(task);
+    }
+    catch (...)
+    {
+        p_ex = std::current_exception();
+    }
+}
+
+template <class T>
+/**
+ * @brief Runs a task and blocks the calling thread until it completes.
+ * @return The value returned by the task.
+ * @throws Rethrows any exception escaping the task.
+ * @details This adapts asynchronous code to the synchronous C API. The task may
+ * complete on a different thread. Do not call from a thread that must execute
+ * part of the task itself, such as the only worker of the ThreadPool the task
+ * resumes on.
+ */
+T syncWait(Task<T> task)
+{
+    std::exception_ptr p_ex;
+    if constexpr (std::is_void<T>::value)
+    {
+        makeSyncWaitTask(task, p_ex).run();
+        if (p_ex)
+            std::rethrow_exception(p_ex);
+    } // end if
+    else
+    {
+        std::optional<T> result;
+        makeSyncWaitTask(task, result, p_ex).run();
+        if (p_ex)
+            std::rethrow_exception(p_ex);
+        return std::move(*result);
+    } // end else
+}
+
+//----------
+// resumeOn
+//----------
+
+/**
+ * @brief Awaitable that resumes the awaiting coroutine in a thread of a ThreadPool.
+ * @details Use `co_await resumeOn(pool)` to move CPU-bound continuations off the
+ * thread that completed an asynchronous request.
+ */
+class ThreadPoolAwaiter
+{
+public:
+    explicit ThreadPoolAwaiter(ThreadPool &pool) noexcept :
+        m_pool(pool) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) { m_pool.submit([h]() { h.resume(); }); }
+    void await_resume() const noexcept {}
+
+private:
+    ThreadPool &m_pool;
+};
+
+/**
+ * @brief Suspends the awaiting coroutine and resumes it in a thread of \p pool.
+ */
+inline ThreadPoolAwaiter resumeOn(ThreadPool &pool) noexcept
+{
+    return ThreadPoolAwaiter(pool);
+}
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_Task_H_7e5fa8c2415240ea93eff148ed73539b
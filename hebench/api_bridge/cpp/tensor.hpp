@@ -0,0 +1,228 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_Tensor_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_Tensor_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "data_view.hpp"
+#include "error_handling.hpp"
+
+namespace hebench {
+namespace cpp {
+
+template <class T, std::size_t Rank, class Alloc = AlignedAllocator<T>>
+/**
+ * @brief Owning, row-major, `Rank`-dimensional array of elements of type `T`.
+ * @details Elements are stored contiguously in a single buffer obtained from
+ * `Alloc`. The default allocator aligns the buffer to DefaultAlignment, so that
+ * it can be fed to SIMD kernels directly; use AlignedAllocator with a different
+ * alignment, HugePageAllocator (see HugePageTensor) for large operands, or any
+ * standard-compliant allocator.
+ *
+ * Tensors convert cheaply into the non-owning views of data_view.hpp: elements()
+ * (or an implicit conversion) yields a SampleView of all elements, and matrix()
+ * yields a MatrixView for rank 2 tensors. Views are invalidated by resize().
+ *
+ * @code
+ * Tensor<double, 2> m({ rows, cols });
+ * m(r, c) = 1.0;
+ * MatrixView<const double> view = m.matrix();
+ * @endcode
+ */
+class Tensor
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(Tensor)
+
+public:
+    static_assert(Rank > 0, "Tensor rank must be positive.");
+
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef T *iterator;
+    typedef const T *const_iterator;
+    /**
+     * @brief Number of elements along each dimension.
+     */
+    typedef std::array<std::uint64_t, Rank> Shape;
+
+    /**
+     * @brief Creates an empty tensor with all extents set to 0.
+     */
+    Tensor() :
+        Tensor(Shape{}) {}
+    /**
+     * @brief Creates a tensor with the specified shape and value-initialized elements.
+     * @throws std::length_error if the number of elements cannot be represented.
+     */
+    explicit Tensor(const Shape &shape, const Alloc &alloc = Alloc()) :
+        m_data(alloc)
+    {
+        resize(shape);
+    }
+    /**
+     * @brief Creates a tensor with the specified shape and all elements set to \p value.
+     * @throws std::length_error if the number of elements cannot be represented.
+     */
+    Tensor(const Shape &shape, const T &value, const Alloc &alloc = Alloc()) :
+        m_data(alloc)
+    {
+        resize(shape, value);
+    }
+
+    static constexpr std::size_t rank() noexcept { return Rank; }
+    const Shape &shape() const noexcept { return m_shape; }
+    /**
+     * @brief Number of elements along dimension \p dim.
+     */
+    std::uint64_t extent(std::size_t dim) const noexcept
+    {
+        assert(dim < Rank);
+        return m_shape[dim];
+    }
+    /**
+     * @brief Distance, in elements, between consecutive indices along dimension \p dim.
+     */
+    std::uint64_t stride(std::size_t dim) const noexcept
+    {
+        assert(dim < Rank);
+        return m_strides[dim];
+    }
+    /**
+     * @brief Total number of elements.
+     */
+    std::uint64_t size() const noexcept { return m_data.size(); }
+    bool empty() const noexcept { return m_data.empty(); }
+    allocator_type get_allocator() const { return m_data.get_allocator(); }
+
+    T *data() noexcept { return m_data.data(); }
+    const T *data() const noexcept { return m_data.data(); }
+
+    iterator begin() noexcept { return m_data.data(); }
+    iterator end() noexcept { return m_data.data() + m_data.size(); }
+    const_iterator begin() const noexcept { return m_data.data(); }
+    const_iterator end() const noexcept { return m_data.data() + m_data.size(); }
+
+    template <class... Indices>
+    /**
+     * @brief Element at the specified indices, one per dimension.
+     * @details Indices are only bounds-checked in debug builds.
+     */
+    T &operator()(Indices... indices) noexcept
+    {
+        return m_data[offset(indices...)];
+    }
+    template <class... Indices>
+    const T &operator()(Indices... indices) const noexcept
+    {
+        return m_data[offset(indices...)];
+    }
+
+    /**
+     * @brief Sets all elements to \p value.
+     */
+    void fill(const T &value) { std::fill(m_data.begin(), m_data.end(), value); }
+    /**
+     * @brief Changes the shape of the tensor.
+     * @details Elements are preserved in row-major order up to the new number of
+     * elements, and new elements are set to \p value. The buffer is reallocated only
+     * if the new number of elements exceeds the capacity.
+     * @throws std::length_error if the number of elements cannot be represented.
+     */
+    void resize(const Shape &shape, const T &value = T())
+    {
+        Shape strides;
+        std::uint64_t count = 1;
+        for (std::size_t dim = Rank; dim-- > 0;)
+        {
+            strides[dim] = count;
+            if (shape[dim] > 0 && count > std::numeric_limits<std::size_t>::max() / shape[dim])
+                throw std::length_error(HEBERROR_MSG_CLASS("Number of elements in tensor is too large."));
+            count *= shape[dim];
+        } // end for
+        m_data.resize(count, value);
+        m_shape   = shape;
+        m_strides = strides;
+    }
+
+    /**
+     * @brief View of all elements in row-major order.
+     */
+    SampleView<T> elements() noexcept { return SampleView<T>(m_data.data(), m_data.size()); }
+    SampleView<const T> elements() const noexcept { return SampleView<const T>(m_data.data(), m_data.size()); }
+    operator SampleView<T>() noexcept { return elements(); }
+    operator SampleView<const T>() const noexcept { return elements(); }
+
+    /**
+     * @brief View of the elements whose first index is \p index.
+     * @details For a rank 2 tensor, this is a row; for a rank 3 tensor, a matrix
+     * stored contiguously, and so on.
+     */
+    SampleView<T> slice(std::uint64_t index) noexcept
+    {
+        assert(index < m_shape[0]);
+        return SampleView<T>(m_data.data() + index * m_strides[0], m_strides[0]);
+    }
+    SampleView<const T> slice(std::uint64_t index) const noexcept
+    {
+        assert(index < m_shape[0]);
+        return SampleView<const T>(m_data.data() + index * m_strides[0], m_strides[0]);
+    }
+
+    template <std::size_t R = Rank, typename std::enable_if<R == 2, int>::type = 0>
+    /**
+     * @brief Matrix view of a rank 2 tensor.
+     */
+    MatrixView<T> matrix() noexcept
+    {
+        return MatrixView<T>(m_data.data(), m_shape[0], m_shape[1]);
+    }
+    template <std::size_t R = Rank, typename std::enable_if<R == 2, int>::type = 0>
+    MatrixView<const T> matrix() const noexcept
+    {
+        return MatrixView<const T>(m_data.data(), m_shape[0], m_shape[1]);
+    }
+
+private:
+    template <class... Indices>
+    std::uint64_t offset(Indices... indices) const noexcept
+    {
+        static_assert(sizeof...(Indices) == Rank, "Number of indices must match the tensor rank.");
+        const std::uint64_t idx[] = { static_cast<std::uint64_t>(indices)... };
+        std::uint64_t retval      = 0;
+        for (std::size_t dim = 0; dim < Rank; ++dim)
+        {
+            assert(idx[dim] < m_shape[dim]);
+            retval += idx[dim] * m_strides[dim];
+        } // end for
+        return retval;
+    }
+
+    std::vector<T, Alloc> m_data;
+    Shape m_shape;
+    Shape m_strides;
+};
+
+template <class T, std::size_t Rank>
+/**
+ * @brief Tensor whose buffer is backed by huge pages when large enough.
+ * @details Reduces TLB misses when traversing large operands. See allocateHugePages().
+ */
+using HugePageTensor = Tensor<T, Rank, HugePageAllocator<T>>;
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_Tensor_H_7e5fa8c2415240ea93eff148ed73539b
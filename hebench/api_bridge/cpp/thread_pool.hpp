@@ -0,0 +1,259 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_ThreadPool_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_ThreadPool_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "error_handling.hpp"
+
+namespace hebench {
+namespace cpp {
+
+/**
+ * @brief Work-stealing pool of worker threads.
+ * @details Each worker owns a queue of tasks. Tasks submitted from a worker go to
+ * the back of its own queue and are executed in LIFO order by that worker, while
+ * idle workers steal from the front of the queues of other workers. Tasks submitted
+ * from outside the pool are distributed among worker queues in round-robin.
+ *
+ * Threads waiting for work to complete (see TaskGroup::wait() and parallelFor())
+ * execute pending tasks instead of blocking. Thus, parallel primitives can be nested
+ * without deadlocking or oversubscribing the cores.
+ *
+ * BaseEngine owns a pool shared by all of its benchmarks. Backends should
+ * use BaseEngine::threadPool() instead of creating their own pools or threads.
+ * @sa TaskGroup, BaseEngine::threadPool()
+ */
+class ThreadPool
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(ThreadPool)
+
+public:
+    typedef std::function<void()> Task;
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Creates a new pool.
+     * @param[in] thread_count Number of worker threads. If 0, the number of hardware
+     * threads is used.
+     * @param[in] b_pin_threads If true, each worker thread is pinned to a different
+     * CPU among those available to the process, in round-robin. Pinning keeps the
+     * data of each worker in the caches of its core, but is only supported on Linux:
+     * it is ignored on other platforms or if the operating system refuses it.
+     */
+    explicit ThreadPool(std::size_t thread_count = 0, bool b_pin_threads = false);
+    /**
+     * @brief Completes all pending tasks and joins the worker threads.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Number of worker threads in this pool.
+     */
+    std::size_t threadCount() const { return m_workers.size(); }
+    /**
+     * @brief Whether worker threads were requested to be pinned to CPUs.
+     */
+    bool pinsThreads() const { return m_b_pin_threads; }
+    /**
+     * @brief Tests whether the calling thread is a worker of this pool.
+     */
+    bool isWorkerThread() const;
+
+    /**
+     * @brief Enqueues a task for asynchronous execution.
+     * @param[in] task Task to execute.
+     * @details Exceptions escaping \p task are discarded. Use TaskGroup to wait for
+     * tasks and propagate their exceptions.
+     */
+    void submit(Task task);
+    /**
+     * @brief Executes one pending task in the calling thread, if any.
+     * @return `true` if a task was executed, `false` if no task was pending.
+     * @details Used by threads that wait for work to complete to help progress.
+     */
+    bool runPendingTask();
+
+    template <class F>
+    /**
+     * @brief Executes `body(i)` for every `i` in range `[first, last)`.
+     * @param[in] first First index.
+     * @param[in] last One past the last index.
+     * @param[in] body Functor to execute for each index.
+     * @param[in] grain Number of consecutive indices executed by each task. If 0,
+     * the range is split into a few tasks per worker.
+     * @details Returns when all indices have been processed. The calling thread
+     * takes part in the execution. If any call to \p body throws, the first exception
+     * is rethrown after all tasks complete.
+     */
+    void parallelFor(std::size_t first, std::size_t last, const F &body, std::size_t grain = 0);
+    template <class F>
+    /**
+     * @brief Executes `body(begin, end)` for consecutive blocks covering range `[first, last)`.
+     * @param[in] first First index.
+     * @param[in] last One past the last index.
+     * @param[in] body Functor to execute for each block of indices `[begin, end)`.
+     * @param[in] grain Maximum number of indices in each block. If 0, the range is
+     * split into a few blocks per worker.
+     * @details Same as parallelFor(), but \p body receives whole blocks, allowing
+     * per-block setup to be amortized.
+     */
+    void parallelForBlocked(std::size_t first, std::size_t last, const F &body, std::size_t grain = 0);
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool popTask(std::size_t queue_index, Task &task);
+    bool stealTask(std::size_t thief_index, Task &task);
+    void workerMain(std::size_t worker_index);
+    void pinWorkers();
+    std::size_t defaultGrain(std::size_t count) const;
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<std::size_t> m_queued;
+    std::atomic<std::size_t> m_next_queue;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_sleep_cv;
+    bool m_b_stop;
+    bool m_b_pin_threads;
+};
+
+/**
+ * @brief Group of tasks executed in a ThreadPool that can be waited upon together.
+ * @details
+ * @code
+ * TaskGroup group(engine.threadPool());
+ * group.run([&]() { encodeFirstHalf(); });
+ * group.run([&]() { encodeSecondHalf(); });
+ * group.wait(); // helps executing pending tasks; rethrows first exception
+ * @endcode
+ *
+ * The destructor waits for all tasks in the group, discarding any exception.
+ */
+class TaskGroup
+{
+public:
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    explicit TaskGroup(ThreadPool &pool) :
+        m_pool(pool), m_pending(0)
+    {
+    }
+    ~TaskGroup();
+
+    template <class F>
+    /**
+     * @brief Enqueues a task into the group.
+     * @param[in] f Functor to execute. Must be callable as `f()`.
+     */
+    void run(F &&f);
+    /**
+     * @brief Waits for all tasks in the group to complete.
+     * @throws Rethrows the first exception thrown by a task in the group, if any.
+     * @details The calling thread executes pending tasks from the pool while
+     * waiting.
+     */
+    void wait();
+
+private:
+    void onTaskDone(std::exception_ptr p_ex);
+    void waitAll();
+
+    ThreadPool &m_pool;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::size_t m_pending;
+    std::exception_ptr m_p_exception;
+};
+
+template <class F>
+void TaskGroup::run(F &&f)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pending;
+    }
+    try
+    {
+        m_pool.submit([this, task = std::forward<F>(f)]() mutable {
+            std::exception_ptr p_ex;
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                p_ex = std::current_exception();
+            }
+            onTaskDone(p_ex);
+        });
+    }
+    catch (...)
+    {
+        onTaskDone(nullptr);
+        throw;
+    }
+}
+
+template <class F>
+void ThreadPool::parallelForBlocked(std::size_t first, std::size_t last, const F &body, std::size_t grain)
+{
+    if (first >= last)
+        return;
+
+    std::size_t count = last - first;
+    if (grain == 0)
+        grain = defaultGrain(count);
+    if (count <= grain)
+        body(first, last);
+    else
+    {
+        TaskGroup group(*this);
+        for (std::size_t begin = first; begin < last;)
+        {
+            std::size_t end = begin + std::min(grain, last - begin);
+            group.run([&body, begin, end]() { body(begin, end); });
+            begin = end;
+        } // end for
+        group.wait();
+    } // end else
+}
+
+template <class F>
+void ThreadPool::parallelFor(std::size_t first, std::size_t last, const F &body, std::size_t grain)
+{
+    parallelForBlocked(
+        first, last,
+        [&body](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+                body(i);
+        },
+        grain);
+}
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_ThreadPool_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,251 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_Trace_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_Trace_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+
+namespace hebench {
+namespace cpp {
+
+/**
+ * @brief API Bridge entry points recorded by the Tracer.
+ */
+enum class TraceEvent : std::uint16_t
+{
+    DestroyHandle,
+    InitEngine,
+    SubscribeBenchmarksCount,
+    SubscribeBenchmarks,
+    GetWorkloadParamsDetails,
+    DescribeBenchmark,
+    CreateBenchmark,
+    InitBenchmark,
+    Encode,
+    Decode,
+    Encrypt,
+    Decrypt,
+    Load,
+    Store,
+    Operate,
+    GetSchemeName,
+    GetSchemeSecurityName,
+    GetBenchmarkDescriptionEx,
+    GetErrorDescription,
+    GetLastErrorDescription,
+    GetHandleStats,
+    Count // number of events: not an event
+};
+
+/**
+ * @brief Name of the API Bridge function corresponding to a trace event.
+ */
+const char *traceEventName(TraceEvent event) noexcept;
+
+/**
+ * @brief Entry or exit of an API Bridge function.
+ */
+enum class TracePhase : std::uint8_t
+{
+    Begin,
+    End
+};
+
+/**
+ * @brief Record of a trace event, as stored in the trace rings and trace files.
+ */
+struct TraceRecord
+{
+    /**
+     * @brief Nanoseconds since an arbitrary epoch, from a monotonic clock.
+     */
+    std::uint64_t timestamp;
+    /**
+     * @brief Tag of the input handle on entry, or of the output handle on exit.
+     */
+    std::int64_t tag;
+    /**
+     * @brief Size of the input handle on entry, or of the output handle on exit.
+     */
+    std::uint64_t size;
+    std::uint16_t event; // TraceEvent
+    std::uint8_t phase;  // TracePhase
+    std::uint8_t reserved;
+    /**
+     * @brief Error code returned by the function. Only meaningful on exit.
+     */
+    std::int32_t error_code;
+};
+
+static_assert(sizeof(TraceRecord) == 32, "Unexpected size of TraceRecord.");
+static_assert(std::is_trivially_copyable<TraceRecord>::value, "TraceRecord must be trivially copyable.");
+
+/**
+ * @brief Records the timeline of API Bridge calls with negligible overhead.
+ * @details When enabled, every entry point of the API Bridge records a TraceRecord
+ * on entry and on exit into a ring buffer owned by the calling thread. Recording
+ * is lock-free and formats nothing: it costs reading a clock and writing 32 bytes.
+ * When disabled, recording costs a single relaxed load.
+ *
+ * Each ring keeps the latest RingCapacity records of its thread: older records not
+ * yet drained are overwritten, and counted as dropped. drainToFile() writes the
+ * pending records of all threads to a binary file, which convertToChromeTrace()
+ * converts into the JSON format displayed by `chrome://tracing` and Perfetto.
+ *
+ * Tracing is disabled by default. Call setEnabled() to enable it, or set environment
+ * variable `HEBENCH_TRACE` to the path of a trace file before loading the backend:
+ * this enables tracing from the start and drains the trace to that file every time
+ * an engine is destroyed, without changes to the backend or the Test Harness. The
+ * first drain of the process overwrites the file, and later drains append to it.
+ *
+ * Binary trace files contain a header `{ char magic[8] = "HEBTRACE"; uint32 version;
+ * uint32 record_size; }` followed by one block per thread: `{ uint64 thread_id;
+ * uint64 record_count; uint64 dropped_count; TraceRecord records[record_count]; }`,
+ * all in native byte order.
+ */
+class Tracer
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(Tracer)
+
+public:
+    /**
+     * @brief Number of records kept by the ring of each thread.
+     */
+    static constexpr std::uint64_t RingCapacity = 1 << 14;
+
+    static bool isEnabled() noexcept { return m_b_enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled) noexcept { m_b_enabled.store(enabled, std::memory_order_relaxed); }
+    /**
+     * @brief Trace file named by environment variable `HEBENCH_TRACE`, or empty if not set.
+     */
+    static const std::string &environmentFilename();
+
+    /**
+     * @brief Nanoseconds since an arbitrary epoch, from a monotonic clock.
+     */
+    static std::uint64_t now() noexcept;
+    /**
+     * @brief Records an event in the ring of the calling thread.
+     * @details Does not check whether tracing is enabled.
+     */
+    static void record(const TraceRecord &rec) noexcept;
+
+    /**
+     * @brief Writes the records of all threads not written before to a binary file.
+     * @param[in] filename File to create or overwrite.
+     * @param[in] b_append If `true` and \p filename is not empty, the records are
+     * appended to the existing trace in the file instead.
+     * @return Number of records written.
+     * @throws HEBenchError if the file could not be written.
+     * @details Safe to call while other threads are recording: records being
+     * overwritten during the call are counted as dropped instead of written.
+     */
+    static std::uint64_t drainToFile(const std::string &filename, bool b_append = false);
+    /**
+     * @brief Converts a binary trace file into a Chrome trace event JSON file.
+     * @param[in] trace_filename Binary file written by drainToFile().
+     * @param[in] json_filename JSON file to create or overwrite.
+     * @throws HEBenchError if either file could not be accessed or the trace file
+     * is invalid.
+     */
+    static void convertToChromeTrace(const std::string &trace_filename, const std::string &json_filename);
+
+private:
+    static std::atomic<bool> m_b_enabled;
+};
+
+/**
+ * @brief Records entry into an API Bridge function on construction and exit on destruction.
+ * @details Declare after the variable holding the error code of the function, so
+ * that the scope is destroyed, and records the exit, after the returned value is
+ * final:
+ * @code
+ * ErrorCode encrypt(Handle h_benchmark, Handle h_plaintext, Handle *h_ciphertext)
+ * {
+ *     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+ *     TraceScope trace(TraceEvent::Encrypt, h_plaintext, retval, h_ciphertext);
+ *     ...
+ *     return retval;
+ * }
+ * @endcode
+ */
+class TraceScope
+{
+public:
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+    /**
+     * @brief Records entry into a function.
+     * @param[in] event Function entered.
+     * @param[in] h_in Main input handle of the function.
+     * @param[in] p_error Error code returned by the function, read on exit. If null,
+     * the exit records success.
+     * @param[in] p_h_out Output handle of the function, read on exit if the function
+     * succeeded. Can be null.
+     */
+    TraceScope(TraceEvent event,
+               const hebench::APIBridge::Handle &h_in,
+               const hebench::APIBridge::ErrorCode *p_error = nullptr,
+               const hebench::APIBridge::Handle *p_h_out    = nullptr) noexcept :
+        m_event(event),
+        m_p_error(p_error),
+        m_p_h_out(p_h_out),
+        m_b_enabled(Tracer::isEnabled())
+    {
+        if (m_b_enabled)
+            Tracer::record(makeRecord(TracePhase::Begin, h_in.tag, h_in.size, 0));
+    }
+    TraceScope(TraceEvent event,
+               const hebench::APIBridge::Handle &h_in,
+               const hebench::APIBridge::ErrorCode &error,
+               const hebench::APIBridge::Handle *p_h_out = nullptr) noexcept :
+        TraceScope(event, h_in, &error, p_h_out)
+    {
+    }
+    ~TraceScope()
+    {
+        // record the exit even if tracing was disabled meanwhile, to close the entry
+        if (m_b_enabled)
+        {
+            hebench::APIBridge::ErrorCode error = m_p_error ? *m_p_error : HEBENCH_ECODE_SUCCESS;
+            if (error == HEBENCH_ECODE_SUCCESS && m_p_h_out)
+                Tracer::record(makeRecord(TracePhase::End, m_p_h_out->tag, m_p_h_out->size, error));
+            else
+                Tracer::record(makeRecord(TracePhase::End, 0, 0, error));
+        } // end if
+    }
+
+private:
+    TraceRecord makeRecord(TracePhase phase, std::int64_t tag, std::uint64_t size, std::int32_t error_code) const noexcept
+    {
+        TraceRecord retval;
+        retval.timestamp  = Tracer::now();
+        retval.tag        = tag;
+        retval.size       = size;
+        retval.event      = static_cast<std::uint16_t>(m_event);
+        retval.phase      = static_cast<std::uint8_t>(phase);
+        retval.reserved   = 0;
+        retval.error_code = error_code;
+        return retval;
+    }
+
+    TraceEvent m_event;
+    const hebench::APIBridge::ErrorCode *m_p_error;
+    const hebench::APIBridge::Handle *m_p_h_out;
+    bool m_b_enabled;
+};
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_Trace_H_7e5fa8c2415240ea93eff148ed73539b
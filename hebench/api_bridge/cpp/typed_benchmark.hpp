@@ -0,0 +1,549 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_TypedBenchmark_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_TypedBenchmark_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "aligned_allocator.hpp"
+#include "benchmark.hpp"
+#include "cartesian_product.hpp"
+#include "data_view.hpp"
+#include "engine.hpp"
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+#include "workload_params.hpp"
+
+namespace hebench {
+namespace cpp {
+
+//----------------
+// DataTypeTraits
+//----------------
+
+template <hebench::APIBridge::DataType D>
+/**
+ * @brief Maps an HEBench data type to the C++ type of its elements.
+ */
+struct DataTypeTraits;
+
+template <>
+struct DataTypeTraits<hebench::APIBridge::DataType::Int32>
+{
+    typedef std::int32_t type;
+};
+
+template <>
+struct DataTypeTraits<hebench::APIBridge::DataType::Int64>
+{
+    typedef std::int64_t type;
+};
+
+template <>
+struct DataTypeTraits<hebench::APIBridge::DataType::Float32>
+{
+    typedef float type;
+};
+
+template <>
+struct DataTypeTraits<hebench::APIBridge::DataType::Float64>
+{
+    typedef double type;
+};
+
+//----------------
+// WorkloadTraits
+//----------------
+
+template <hebench::APIBridge::Workload W>
+/**
+ * @brief Describes the shape of the operands and results of a workload.
+ * @details Specializations provide:
+ * - `Params`: wrapper for the workload parameters (see WorkloadParams).
+ * - `operandCount(params)`: number of operands of the operation.
+ * - `resultComponentCount(params)`: number of components of the result.
+ * - `operandSampleSize(params, operand)`: number of elements in a sample of an operand.
+ * - `resultSampleSize(params, component)`: number of elements in a sample of a result component.
+ *
+ * Workloads with results of variable size, such as SimpleSetIntersection, have no traits.
+ */
+struct WorkloadTraits;
+
+template <>
+struct WorkloadTraits<hebench::APIBridge::Workload::MatrixMultiply>
+{
+    typedef WorkloadParams::MatrixMultiply Params;
+
+    static std::size_t operandCount(const Params &) { return 2; }
+    static std::size_t resultComponentCount(const Params &) { return 1; }
+    static std::uint64_t operandSampleSize(const Params &params, std::size_t operand)
+    {
+        return operand == 0 ?
+                   params.rows_M0() * params.cols_M0() :
+                   params.cols_M0() * params.cols_M1();
+    }
+    static std::uint64_t resultSampleSize(const Params &params, std::size_t)
+    {
+        return params.rows_M0() * params.cols_M1();
+    }
+};
+
+/**
+ * @brief Traits shared by element-wise vector workloads.
+ */
+struct EltwiseWorkloadTraits
+{
+    typedef WorkloadParams::VectorSize Params;
+
+    static std::size_t operandCount(const Params &) { return 2; }
+    static std::size_t resultComponentCount(const Params &) { return 1; }
+    static std::uint64_t operandSampleSize(const Params &params, std::size_t) { return params.n(); }
+    static std::uint64_t resultSampleSize(const Params &params, std::size_t) { return params.n(); }
+};
+
+template <>
+struct WorkloadTraits<hebench::APIBridge::Workload::EltwiseAdd> : public EltwiseWorkloadTraits
+{
+};
+
+template <>
+struct WorkloadTraits<hebench::APIBridge::Workload::EltwiseMultiply> : public EltwiseWorkloadTraits
+{
+};
+
+template <>
+struct WorkloadTraits<hebench::APIBridge::Workload::DotProduct>
+{
+    typedef WorkloadParams::DotProduct Params;
+
+    static std::size_t operandCount(const Params &) { return 2; }
+    static std::size_t resultComponentCount(const Params &) { return 1; }
+    static std::uint64_t operandSampleSize(const Params &params, std::size_t) { return params.n(); }
+    static std::uint64_t resultSampleSize(const Params &, std::size_t) { return 1; }
+};
+
+/**
+ * @brief Traits shared by logistic regression workloads: operands are `W`, `b` and `X`.
+ */
+struct LogisticRegressionWorkloadTraits
+{
+    typedef WorkloadParams::LogisticRegression Params;
+
+    static std::size_t operandCount(const Params &) { return 3; }
+    static std::size_t resultComponentCount(const Params &) { return 1; }
+    static std::uint64_t operandSampleSize(const Params &params, std::size_t operand)
+    {
+        return operand == 1 ? 1 : params.n();
+    }
+    static std::uint64_t resultSampleSize(const Params &, std::size_t) { return 1; }
+};
+
+template <>
+struct WorkloadTraits<hebench::APIBridge::Workload::LogisticRegression> : public LogisticRegressionWorkloadTraits
+{
+};
+
+template <>
+struct WorkloadTraits<hebench::APIBridge::Workload::LogisticRegression_PolyD3> : public LogisticRegressionWorkloadTraits
+{
+};
+
+template <>
+struct WorkloadTraits<hebench::APIBridge::Workload::LogisticRegression_PolyD5> : public LogisticRegressionWorkloadTraits
+{
+};
+
+template <>
+struct WorkloadTraits<hebench::APIBridge::Workload::LogisticRegression_PolyD7> : public LogisticRegressionWorkloadTraits
+{
+};
+
+template <>
+struct WorkloadTraits<hebench::APIBridge::Workload::Generic>
+{
+    typedef WorkloadParams::Generic Params;
+
+    static std::size_t operandCount(const Params &params) { return params.n(); }
+    static std::size_t resultComponentCount(const Params &params) { return params.m(); }
+    static std::uint64_t operandSampleSize(const Params &params, std::size_t operand)
+    {
+        return params.length_InputParam(operand);
+    }
+    static std::uint64_t resultSampleSize(const Params &params, std::size_t component)
+    {
+        return params.length_ResultComponent(component);
+    }
+};
+
+//----------------
+// TypedBenchmark
+//----------------
+
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+/**
+ * @brief Benchmark base that implements all the plumbing between the API Bridge
+ * and a typed kernel for workload `W` on data of type `D`.
+ * @details This class template implements encode(), decode(), encrypt(), decrypt(),
+ * load(), store() and operate() for backends that compute on plain data: operands
+ * are copied once into aligned buffers during encoding and shared by reference
+ * afterwards, and operate() computes the cartesian product of the requested samples
+ * in parallel in the engine thread pool (see CartesianProduct).
+ *
+ * Derived classes (using CRTP) implement a single kernel hook that computes one
+ * result for one tuple of operand samples:
+ * @code
+ * class MyBenchmark : public TypedBenchmark<MyBenchmark,
+ *                                           hebench::APIBridge::Workload::EltwiseAdd,
+ *                                           hebench::APIBridge::DataType::Float64>
+ * {
+ * public:
+ *     using TypedBenchmark::TypedBenchmark;
+ *     void compute(const SampleView<const double> *p_operands,
+ *                  const SampleView<double> *p_results) const
+ *     {
+ *         for (std::uint64_t i = 0; i < p_results[0].size(); ++i)
+ *             p_results[0][i] = p_operands[0][i] + p_operands[1][i];
+ *     }
+ * };
+ * @endcode
+ *
+ * `p_operands` points to operandCount() views, one sample per operand in call order,
+ * each of operandSampleSize() elements. `p_results` points to resultComponentCount()
+ * views where to store the result, each of resultSampleSize() elements. Calls to
+ * `compute()` occur concurrently for different tuples and must be thread safe.
+ *
+ * The kernel is bound at compile time, so, no virtual calls occur in the hot path.
+ */
+class TypedBenchmark : public BaseBenchmark
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(TypedBenchmark)
+
+public:
+    typedef typename DataTypeTraits<D>::type ValueType;
+    typedef WorkloadTraits<W> Traits;
+    /**
+     * @brief Storage for a single sample: elements start at a DefaultAlignment boundary.
+     */
+    typedef AlignedVector<ValueType> Sample;
+    /**
+     * @brief Samples for one operand or result component.
+     */
+    struct Operand
+    {
+        std::uint64_t param_position;
+        std::vector<Sample> samples;
+    };
+    /**
+     * @brief Payload of the handles created by this class.
+     * @details Operands are shared among handles to avoid copies.
+     */
+    typedef std::vector<std::shared_ptr<const Operand>> OperandPack;
+
+    /**
+     * @brief Constructs a new benchmark.
+     * @throws hebench::cpp::HEBenchError if the descriptor does not match `W` and `D`,
+     * or if the workload parameters are invalid for `W`.
+     */
+    TypedBenchmark(BaseEngine &engine,
+                   const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                   const hebench::APIBridge::WorkloadParams &bench_params);
+    ~TypedBenchmark() override = default;
+
+    hebench::APIBridge::Handle encode(const hebench::APIBridge::DataPackCollection *p_parameters) final;
+    void decode(hebench::APIBridge::Handle encoded_data, hebench::APIBridge::DataPackCollection *p_native) final;
+    hebench::APIBridge::Handle encrypt(hebench::APIBridge::Handle encoded_data) final;
+    hebench::APIBridge::Handle decrypt(hebench::APIBridge::Handle encrypted_data) final;
+
+    hebench::APIBridge::Handle load(const hebench::APIBridge::Handle *p_local_data, std::uint64_t count) final;
+    void store(hebench::APIBridge::Handle remote_data, hebench::APIBridge::Handle *p_local_data, std::uint64_t count) final;
+
+    hebench::APIBridge::Handle operate(hebench::APIBridge::Handle h_remote_packed,
+                                       const hebench::APIBridge::ParameterIndexer *p_param_indexers,
+                                       std::uint64_t indexers_count) final;
+
+    std::size_t operandCount() const { return m_operand_sample_sizes.size(); }
+    std::size_t resultComponentCount() const { return m_result_sample_sizes.size(); }
+    std::uint64_t operandSampleSize(std::size_t operand) const { return m_operand_sample_sizes.at(operand); }
+    std::uint64_t resultSampleSize(std::size_t component) const { return m_result_sample_sizes.at(component); }
+
+protected:
+    static constexpr std::int64_t tagLocal  = 0x10; // host-side data: encoded, encrypted or decrypted
+    static constexpr std::int64_t tagRemote = 0x20; // loaded operands or results of operate()
+
+    const Derived &derived() const { return static_cast<const Derived &>(*this); }
+
+private:
+    /**
+     * @brief Maximum number of operands and results for which views are kept in the stack.
+     */
+    static constexpr std::size_t MaxLocalViews = 8;
+
+    hebench::APIBridge::Handle createPackHandle(OperandPack &&pack, std::int64_t tag) const;
+
+    std::vector<std::uint64_t> m_operand_sample_sizes;
+    std::vector<std::uint64_t> m_result_sample_sizes;
+};
+
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+constexpr std::int64_t TypedBenchmark<Derived, W, D>::tagLocal;
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+constexpr std::int64_t TypedBenchmark<Derived, W, D>::tagRemote;
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+constexpr std::size_t TypedBenchmark<Derived, W, D>::MaxLocalViews;
+
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+TypedBenchmark<Derived, W, D>::TypedBenchmark(BaseEngine &engine,
+                                              const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                                              const hebench::APIBridge::WorkloadParams &bench_params) :
+    BaseBenchmark(engine, bench_desc, bench_params)
+{
+    if (bench_desc.workload != W || bench_desc.data_type != D)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Benchmark descriptor does not match the workload or data type of this benchmark."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+
+    typename Traits::Params w_params(bench_params);
+    m_operand_sample_sizes.resize(Traits::operandCount(w_params));
+    for (std::size_t i = 0; i < m_operand_sample_sizes.size(); ++i)
+        m_operand_sample_sizes[i] = Traits::operandSampleSize(w_params, i);
+    m_result_sample_sizes.resize(Traits::resultComponentCount(w_params));
+    for (std::size_t i = 0; i < m_result_sample_sizes.size(); ++i)
+        m_result_sample_sizes[i] = Traits::resultSampleSize(w_params, i);
+}
+
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+hebench::APIBridge::Handle TypedBenchmark<Derived, W, D>::createPackHandle(OperandPack &&pack, std::int64_t tag) const
+{
+    std::uint64_t size = 0;
+    for (const auto &p_operand : pack)
+        for (const auto &sample : p_operand->samples)
+            size += sample.size() * sizeof(ValueType);
+    return this->template createHandle<OperandPack>(size, tag, std::move(pack));
+}
+
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+hebench::APIBridge::Handle TypedBenchmark<Derived, W, D>::encode(const hebench::APIBridge::DataPackCollection *p_parameters)
+{
+    OperandPack pack;
+    pack.reserve(p_parameters->pack_count);
+    for (std::uint64_t pack_i = 0; pack_i < p_parameters->pack_count; ++pack_i)
+    {
+        const hebench::APIBridge::DataPack &data_pack = p_parameters->p_data_packs[pack_i];
+        if (HEBENCH_VALIDATE_CHEAP && data_pack.param_position >= operandCount())
+            HEBERROR_RECORD_CLASS("Invalid operand position {} in parameter pack.",
+                                  HEBENCH_ECODE_INVALID_ARGS)
+                .raise({ data_pack.param_position });
+        if (HEBENCH_VALIDATE_CHEAP && data_pack.buffer_count > 0 && !data_pack.p_buffers)
+            HEBERROR_RECORD_CLASS("Invalid empty samples detected in parameter pack.",
+                                  HEBENCH_ECODE_INVALID_ARGS)
+                .raise();
+
+        DataPackView<const ValueType> view(data_pack);
+        std::uint64_t sample_size = operandSampleSize(data_pack.param_position);
+        std::shared_ptr<Operand> p_operand(new Operand());
+        p_operand->param_position = data_pack.param_position;
+        p_operand->samples.resize(view.sampleCount());
+        for (std::uint64_t sample_i = 0; HEBENCH_VALIDATE_FULL && sample_i < view.sampleCount(); ++sample_i)
+        {
+            SampleView<const ValueType> sample = view.sample(sample_i);
+            if (sample.size() < sample_size || (sample_size > 0 && !sample.data()))
+                HEBERROR_RECORD_CLASS("Invalid sample {} for operand {}: buffer too small.",
+                                      HEBENCH_ECODE_INVALID_ARGS)
+                    .raise({ sample_i, data_pack.param_position });
+        } // end for
+
+        // deep copy is required: native data may be released after this call
+        this->getEngine().threadPool().parallelFor(0, view.sampleCount(), [&](std::size_t sample_i) {
+            SampleView<const ValueType> sample = view.sample(sample_i);
+            p_operand->samples[sample_i].assign(sample.begin(), sample.begin() + sample_size);
+        });
+
+        pack.emplace_back(std::move(p_operand));
+    } // end for
+
+    return createPackHandle(std::move(pack), tagLocal);
+}
+
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+void TypedBenchmark<Derived, W, D>::decode(hebench::APIBridge::Handle encoded_data, hebench::APIBridge::DataPackCollection *p_native)
+{
+    if (HEBENCH_VALIDATE_CHEAP && p_native->pack_count > 0 && !p_native->p_data_packs)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Invalid null data packs in \"p_native\"."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+
+    const OperandPack &pack = this->getEngine().template retrieveConstFromHandle<OperandPack>(encoded_data, tagLocal);
+
+    // decode as much data as possible: excess data that does not fit is ignored
+    DataPackCollectionView<ValueType> native(*p_native);
+    for (const auto &p_operand : pack)
+    {
+        DataPackView<ValueType> view = native.find(p_operand->param_position);
+        if (view.valid() && view.pack().p_buffers)
+        {
+            std::uint64_t count = std::min<std::uint64_t>(view.sampleCount(), p_operand->samples.size());
+            for (std::uint64_t sample_i = 0; sample_i < count; ++sample_i)
+            {
+                SampleView<ValueType> target = view.sample(sample_i);
+                const Sample &sample         = p_operand->samples[sample_i];
+                if (target.data())
+                    std::copy(sample.begin(), sample.begin() + std::min<std::uint64_t>(target.size(), sample.size()),
+                              target.begin());
+            } // end for
+        } // end if
+    } // end for
+}
+
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+hebench::APIBridge::Handle TypedBenchmark<Derived, W, D>::encrypt(hebench::APIBridge::Handle encoded_data)
+{
+    // plain data: encryption is the identity
+    return this->getEngine().duplicateHandle(encoded_data, tagLocal, tagLocal);
+}
+
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+hebench::APIBridge::Handle TypedBenchmark<Derived, W, D>::decrypt(hebench::APIBridge::Handle encrypted_data)
+{
+    // plain data: decryption is the identity
+    return this->getEngine().duplicateHandle(encrypted_data, tagLocal, tagLocal);
+}
+
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+hebench::APIBridge::Handle TypedBenchmark<Derived, W, D>::load(const hebench::APIBridge::Handle *p_local_data, std::uint64_t count)
+{
+    if (HEBENCH_VALIDATE_CHEAP && (count == 0 || !p_local_data))
+        throw HEBenchError(HEBERROR_MSG_CLASS("Invalid empty array of handles: \"p_local_data\""),
+                           HEBENCH_ECODE_INVALID_ARGS);
+
+    if (count == 1)
+        return this->getEngine().duplicateHandle(p_local_data[0], tagRemote, tagLocal);
+
+    // merge all local packs into a single remote pack by sharing their operands
+    OperandPack pack;
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        const OperandPack &local = this->getEngine().template retrieveConstFromHandle<OperandPack>(p_local_data[i], tagLocal);
+        pack.insert(pack.end(), local.begin(), local.end());
+    } // end for
+    return createPackHandle(std::move(pack), tagRemote);
+}
+
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+void TypedBenchmark<Derived, W, D>::store(hebench::APIBridge::Handle remote_data,
+                                          hebench::APIBridge::Handle *p_local_data, std::uint64_t count)
+{
+    if (HEBENCH_VALIDATE_CHEAP && count > 0 && !p_local_data)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Invalid null array of handles: \"p_local_data\""),
+                           HEBENCH_ECODE_INVALID_ARGS);
+
+    if (count > 0)
+    {
+        // pad with zeros any remaining local handles as per specifications
+        std::memset(p_local_data, 0, sizeof(hebench::APIBridge::Handle) * count);
+        p_local_data[0] = this->getEngine().duplicateHandle(remote_data, tagLocal, tagRemote);
+    } // end if
+}
+
+template <class Derived, hebench::APIBridge::Workload W, hebench::APIBridge::DataType D>
+hebench::APIBridge::Handle TypedBenchmark<Derived, W, D>::operate(hebench::APIBridge::Handle h_remote_packed,
+                                                                  const hebench::APIBridge::ParameterIndexer *p_param_indexers,
+                                                                  std::uint64_t indexers_count)
+{
+    if (HEBENCH_VALIDATE_CHEAP && indexers_count != operandCount())
+        HEBERROR_RECORD_CLASS("Invalid number of parameter indexers. Expected {}.",
+                              HEBENCH_ECODE_INVALID_ARGS)
+            .raise({ operandCount() });
+
+    const OperandPack &pack = this->getEngine().template retrieveConstFromHandle<OperandPack>(h_remote_packed, tagRemote);
+
+    // table of operands by position, built once per call
+    std::vector<const Operand *> operands(operandCount(), nullptr);
+    for (const auto &p_operand : pack)
+    {
+        if (HEBENCH_VALIDATE_CHEAP && p_operand->param_position >= operands.size())
+            HEBERROR_RECORD_CLASS("Invalid operand position {} in loaded data.",
+                                  HEBENCH_ECODE_INVALID_ARGS)
+                .raise({ p_operand->param_position });
+        if (HEBENCH_VALIDATE_CHEAP && operands[p_operand->param_position])
+            HEBERROR_RECORD_CLASS("Duplicated operand position {} in loaded data.",
+                                  HEBENCH_ECODE_INVALID_ARGS)
+                .raise({ p_operand->param_position });
+        operands[p_operand->param_position] = p_operand.get();
+    } // end for
+    for (std::size_t i = 0; i < operands.size(); ++i)
+    {
+        if (HEBENCH_VALIDATE_CHEAP && !operands[i])
+            HEBERROR_RECORD_CLASS("Missing operand {} in loaded data.",
+                                  HEBENCH_ECODE_INVALID_ARGS)
+                .raise({ i });
+        // compared without adding, so that no indexer overflows
+        const std::uint64_t sample_count = operands[i]->samples.size();
+        if (HEBENCH_VALIDATE_CHEAP
+            && (p_param_indexers[i].value_index > sample_count
+                || p_param_indexers[i].batch_size > sample_count - p_param_indexers[i].value_index))
+            HEBERROR_RECORD_CLASS("Parameter indexer for operand {} is out of range.",
+                                  HEBENCH_ECODE_INVALID_ARGS)
+                .raise({ i });
+    } // end for
+
+    CartesianProduct product(p_param_indexers, indexers_count);
+
+    // allocate results in row-major order of the product
+    std::vector<std::shared_ptr<Operand>> results(resultComponentCount());
+    for (std::size_t component_i = 0; component_i < results.size(); ++component_i)
+    {
+        results[component_i].reset(new Operand());
+        results[component_i]->param_position = component_i;
+        results[component_i]->samples.resize(product.size());
+    } // end for
+
+    const std::size_t operand_count = operandCount();
+    const std::size_t result_count  = resultComponentCount();
+    product.forEach(this->getEngine().threadPool(),
+                    [this, &operands, &results, operand_count, result_count](const std::uint64_t *sample_indices, std::uint64_t result_index) {
+                        SampleView<const ValueType> local_operands[MaxLocalViews];
+                        SampleView<ValueType> local_results[MaxLocalViews];
+                        std::vector<SampleView<const ValueType>> heap_operands;
+                        std::vector<SampleView<ValueType>> heap_results;
+                        SampleView<const ValueType> *p_operands = local_operands;
+                        SampleView<ValueType> *p_results        = local_results;
+                        if (operand_count > MaxLocalViews)
+                        {
+                            heap_operands.resize(operand_count);
+                            p_operands = heap_operands.data();
+                        } // end if
+                        if (result_count > MaxLocalViews)
+                        {
+                            heap_results.resize(result_count);
+                            p_results = heap_results.data();
+                        } // end if
+
+                        for (std::size_t i = 0; i < operand_count; ++i)
+                        {
+                            const Sample &sample = operands[i]->samples[sample_indices[i]];
+                            p_operands[i]        = SampleView<const ValueType>(sample.data(), sample.size());
+                        } // end for
+                        for (std::size_t i = 0; i < result_count; ++i)
+                        {
+                            // each result is written by a single task: allocate in parallel
+                            Sample &sample = results[i]->samples[result_index];
+                            sample.resize(m_result_sample_sizes[i]);
+                            p_results[i] = SampleView<ValueType>(sample.data(), sample.size());
+                        } // end for
+
+                        derived().compute(p_operands, p_results);
+                    });
+
+    OperandPack result_pack(results.begin(), results.end());
+    return createPackHandle(std::move(result_pack), tagRemote);
+}
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_TypedBenchmark_H_7e5fa8c2415240ea93eff148ed73539b
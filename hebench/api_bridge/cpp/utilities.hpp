@@ -24,6 +24,17 @@ namespace Utilities {
  */
 std::uint64_t copyString(char *dst, std::uint64_t size, const std::string &src);
 
+/**
+ * @brief Computes a fast, non-cryptographic, 64-bit hash of a buffer.
+ * @param[in] p Buffer to hash. Can be null if \p size is 0.
+ * @param[in] size Number of bytes in the buffer.
+ * @param[in] seed Initial value. Use the hash of a previous buffer to hash a
+ * sequence of buffers.
+ * @details Processes 8 bytes per step. Suitable to identify content, as in
+ * ConstantOperandCache, but not for security.
+ */
+std::uint64_t hash64(const void *p, std::uint64_t size, std::uint64_t seed = 0);
+
 } // namespace Utilities
 } // namespace cpp
 } // namespace hebench
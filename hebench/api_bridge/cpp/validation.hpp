@@ -0,0 +1,53 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_Validation_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_Validation_H_7e5fa8c2415240ea93eff148ed73539b
+
+/**
+ * @brief Validation levels of the C++ wrapper.
+ * @details The level is selected at build time through macro `HEBENCH_VALIDATION_LEVEL`,
+ * set by CMake option `HEBENCH_CPP_VALIDATION_LEVEL` for `hebench_cpp` and every target
+ * linking to it. Backends must be built with the same level as the wrapper.
+ *
+ * - `HEBENCH_VALIDATION_FULL` (default): all checks. Besides the checks of
+ * `HEBENCH_VALIDATION_CHEAP`, verifies the contents of the arguments (every data pack,
+ * buffer and sample) and the arguments passed by backends to the wrapper.
+ * - `HEBENCH_VALIDATION_CHEAP`: checks of constant cost per call only: null pointers,
+ * handle tags, the type of objects wrapped in handles, counts and positions used as indices.
+ * - `HEBENCH_VALIDATION_NONE`: no argument checks. Test Harness and backend are trusted
+ * to be correct. Meant for production runs of a backend validated with a higher level.
+ *
+ * Errors raised by the backend itself are always reported.
+ */
+#define HEBENCH_VALIDATION_NONE  0
+#define HEBENCH_VALIDATION_CHEAP 1
+#define HEBENCH_VALIDATION_FULL  2
+
+#ifndef HEBENCH_VALIDATION_LEVEL
+#define HEBENCH_VALIDATION_LEVEL HEBENCH_VALIDATION_FULL
+#endif
+
+#if HEBENCH_VALIDATION_LEVEL < HEBENCH_VALIDATION_NONE || HEBENCH_VALIDATION_LEVEL > HEBENCH_VALIDATION_FULL
+#error "Invalid HEBENCH_VALIDATION_LEVEL."
+#endif
+
+/**
+ * @brief Evaluates to `true` if checks of constant cost are enabled.
+ * @details Use as the first operand of the condition of a check, so that disabled
+ * checks are removed by the compiler while still being compiled:
+ * @code
+ * if (HEBENCH_VALIDATE_CHEAP && !p_parameters)
+ *     throw HEBenchError(HEBERROR_MSG_CLASS("Invalid null parameter: p_parameters"),
+ *                        HEBENCH_ECODE_INVALID_ARGS);
+ * @endcode
+ */
+#define HEBENCH_VALIDATE_CHEAP (HEBENCH_VALIDATION_LEVEL >= HEBENCH_VALIDATION_CHEAP)
+/**
+ * @brief Evaluates to `true` if all checks are enabled.
+ * @sa HEBENCH_VALIDATE_CHEAP
+ */
+#define HEBENCH_VALIDATE_FULL (HEBENCH_VALIDATION_LEVEL >= HEBENCH_VALIDATION_FULL)
+
+#endif // defined _HEBench_API_Bridge_Validation_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,415 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_WorkloadSchema_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_WorkloadSchema_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "error_handling.hpp"
+#include "hebench/api_bridge/types.h"
+
+namespace hebench {
+namespace cpp {
+
+/**
+ * @brief Declares a workload parameter: name, type and range of valid values.
+ * @details Built with the constexpr factories UInt64(), Int64() and Float64() to
+ * declare the parameters of a workload schema. Bounds are inclusive and only the
+ * pair matching `data_type` is meaningful.
+ */
+struct WorkloadParamSpec
+{
+    const char *name;
+    hebench::APIBridge::WorkloadParamType::WorkloadParamType data_type;
+    std::int64_t i_min;
+    std::int64_t i_max;
+    std::uint64_t u_min;
+    std::uint64_t u_max;
+    double f_min;
+    double f_max;
+
+    static constexpr WorkloadParamSpec UInt64(const char *name,
+                                              std::uint64_t min = 0,
+                                              std::uint64_t max = std::numeric_limits<std::uint64_t>::max())
+    {
+        return WorkloadParamSpec{ name, hebench::APIBridge::WorkloadParamType::UInt64, 0, 0, min, max, 0.0, 0.0 };
+    }
+    static constexpr WorkloadParamSpec Int64(const char *name,
+                                             std::int64_t min = std::numeric_limits<std::int64_t>::min(),
+                                             std::int64_t max = std::numeric_limits<std::int64_t>::max())
+    {
+        return WorkloadParamSpec{ name, hebench::APIBridge::WorkloadParamType::Int64, min, max, 0, 0, 0.0, 0.0 };
+    }
+    /**
+     * @brief Declares a floating point parameter. NaN is never a valid value.
+     */
+    static constexpr WorkloadParamSpec Float64(const char *name,
+                                               double min = -std::numeric_limits<double>::infinity(),
+                                               double max = std::numeric_limits<double>::infinity())
+    {
+        return WorkloadParamSpec{ name, hebench::APIBridge::WorkloadParamType::Float64, 0, 0, 0, 0, min, max };
+    }
+};
+
+template <hebench::APIBridge::WorkloadParamType::WorkloadParamType>
+/**
+ * @brief Maps a workload parameter type to its C++ type and union member.
+ */
+struct WorkloadParamValue;
+
+template <>
+struct WorkloadParamValue<hebench::APIBridge::WorkloadParamType::Int64>
+{
+    typedef std::int64_t type;
+    static type get(const hebench::APIBridge::WorkloadParam &w_param) noexcept { return w_param.i_param; }
+    static void set(hebench::APIBridge::WorkloadParam &w_param, type value) noexcept { w_param.i_param = value; }
+};
+
+template <>
+struct WorkloadParamValue<hebench::APIBridge::WorkloadParamType::UInt64>
+{
+    typedef std::uint64_t type;
+    static type get(const hebench::APIBridge::WorkloadParam &w_param) noexcept { return w_param.u_param; }
+    static void set(hebench::APIBridge::WorkloadParam &w_param, type value) noexcept { w_param.u_param = value; }
+};
+
+template <>
+struct WorkloadParamValue<hebench::APIBridge::WorkloadParamType::Float64>
+{
+    typedef double type;
+    static type get(const hebench::APIBridge::WorkloadParam &w_param) noexcept { return w_param.f_param; }
+    static void set(hebench::APIBridge::WorkloadParam &w_param, type value) noexcept { w_param.f_param = value; }
+};
+
+namespace internal {
+
+// out of line, so that every schema shares the code and error messages
+void validateWorkloadParams(const WorkloadParamSpec *specs, std::size_t spec_count,
+                            const hebench::APIBridge::WorkloadParam *p_params, std::uint64_t param_count);
+void initializeWorkloadParams(const WorkloadParamSpec *specs, std::size_t spec_count,
+                              hebench::APIBridge::WorkloadParam *p_params);
+std::string describeWorkloadParams(const WorkloadParamSpec *specs, std::size_t spec_count);
+
+constexpr bool isValidSpec(const WorkloadParamSpec &spec)
+{
+    std::size_t length = 0;
+    if (spec.name)
+        while (spec.name[length] != '\0')
+            ++length;
+    return spec.name && length > 0 && length < HEBENCH_MAX_BUFFER_SIZE
+           && (spec.data_type == hebench::APIBridge::WorkloadParamType::Int64 ? spec.i_min <= spec.i_max :
+               spec.data_type == hebench::APIBridge::WorkloadParamType::UInt64 ? spec.u_min <= spec.u_max :
+               spec.data_type == hebench::APIBridge::WorkloadParamType::Float64 ? spec.f_min <= spec.f_max :
+                                                                                  false);
+}
+
+template <std::size_t N>
+constexpr bool isValidSchema(const WorkloadParamSpec (&specs)[N])
+{
+    for (std::size_t i = 0; i < N; ++i)
+        if (!isValidSpec(specs[i]))
+            return false;
+    return true;
+}
+
+} // namespace internal
+
+template <class Schema>
+/**
+ * @brief Workload parameter handling generated from a declarative schema.
+ * @details \p Schema is a struct that declares the workload parameters once, as a
+ * `static constexpr WorkloadParamSpec Params[]` array in parameter order, usually
+ * next to an unnamed enum naming the index of each parameter. As with any static
+ * constexpr member, `Params` must also be defined in exactly one translation unit.
+ *
+ * From the schema, this class generates:
+ * - validate(): checks the number, types and ranges of received parameters once,
+ * and returns a Values view with typed accessors that perform no further checks.
+ * - makeDefault(): builds a set of default parameters, with names and types
+ * filled in from the schema, ready for BenchmarkDescription::addDefaultParameters().
+ * - descriptor(): a serialized description of the schema.
+ *
+ * As in the rest of the workload parameter wrappers, received parameters may
+ * contain more elements than the schema declares: extra parameters are ignored.
+ *
+ * @code
+ * struct MySchema
+ * {
+ *     enum : std::size_t { N, Scale };
+ *     static constexpr WorkloadParamSpec Params[] = { WorkloadParamSpec::UInt64("n", 1, 4096),
+ *                                                     WorkloadParamSpec::Float64("scale", 0.0) };
+ * };
+ * constexpr WorkloadParamSpec MySchema::Params[]; // in a .cpp file
+ * typedef WorkloadSchema<MySchema> MyParams;
+ *
+ * // in the benchmark description constructor
+ * addDefaultParameters(MyParams::makeDefault(1024, 0.5));
+ * // in the benchmark constructor
+ * MyParams::Values w_params = MyParams::validate(bench_params);
+ * std::uint64_t n = w_params.get<MyParams::N>();
+ * @endcode
+ */
+class WorkloadSchema : public Schema
+{
+public:
+    static constexpr std::size_t ParamCount = sizeof(Schema::Params) / sizeof(Schema::Params[0]);
+    static_assert(internal::isValidSchema(Schema::Params),
+                  "Invalid workload schema: parameters require a name shorter than HEBENCH_MAX_BUFFER_SIZE, and `min <= max`.");
+
+    template <std::size_t I>
+    using ValueType = typename WorkloadParamValue<Schema::Params[I].data_type>::type;
+
+    /**
+     * @brief Typed view of workload parameters that passed validation.
+     * @details Does not copy the parameters: it is valid as long as the parameters
+     * used to create it.
+     */
+    class Values
+    {
+    public:
+        template <std::size_t I>
+        /**
+         * @brief Value of the parameter with index \p I in the schema.
+         */
+        ValueType<I> get() const noexcept
+        {
+            static_assert(I < ParamCount, "Workload parameter index out of range.");
+            return WorkloadParamValue<Schema::Params[I].data_type>::get(m_p_params[I]);
+        }
+
+    private:
+        friend class WorkloadSchema;
+        explicit Values(const hebench::APIBridge::WorkloadParam *p_params) noexcept :
+            m_p_params(p_params) {}
+
+        const hebench::APIBridge::WorkloadParam *m_p_params;
+    };
+
+    /**
+     * @brief Checks received parameters against the schema.
+     * @throws HEBenchError with HEBENCH_ECODE_INVALID_ARGS if \p w_params has fewer
+     * parameters than the schema, or any parameter has the wrong type or a value
+     * out of range.
+     */
+    static Values validate(const hebench::APIBridge::WorkloadParams &w_params)
+    {
+        internal::validateWorkloadParams(Schema::Params, ParamCount, w_params.params, w_params.count);
+        return Values(w_params.params);
+    }
+    /**
+     * @copydoc validate(const hebench::APIBridge::WorkloadParams &)
+     */
+    static Values validate(const std::vector<hebench::APIBridge::WorkloadParam> &w_params)
+    {
+        internal::validateWorkloadParams(Schema::Params, ParamCount, w_params.data(), w_params.size());
+        return Values(w_params.data());
+    }
+
+    template <class... Args>
+    /**
+     * @brief Builds a set of workload parameters from their values.
+     * @param[in] values Value of each parameter, in schema order.
+     * @throws HEBenchError with HEBENCH_ECODE_INVALID_ARGS if a value is out of range.
+     */
+    static std::vector<hebench::APIBridge::WorkloadParam> makeDefault(Args... values)
+    {
+        static_assert(sizeof...(Args) == ParamCount, "A value is required for every workload parameter in the schema.");
+        std::vector<hebench::APIBridge::WorkloadParam> retval(ParamCount);
+        internal::initializeWorkloadParams(Schema::Params, ParamCount, retval.data());
+        assign(retval.data(), std::index_sequence_for<Args...>(), values...);
+        internal::validateWorkloadParams(Schema::Params, ParamCount, retval.data(), retval.size());
+        return retval;
+    }
+
+    /**
+     * @brief Serialized description of the schema.
+     * @details One `name:type[min,max]` entry per parameter, in order, separated by
+     * `;`. For example, `n:UInt64[1,4096];scale:Float64[0,inf]`.
+     */
+    static const std::string &descriptor()
+    {
+        static const std::string retval = internal::describeWorkloadParams(Schema::Params, ParamCount);
+        return retval;
+    }
+
+private:
+    template <std::size_t... I, class... Args>
+    static void assign(hebench::APIBridge::WorkloadParam *p_params, std::index_sequence<I...>, Args... values)
+    {
+        using expand = int[];
+        (void)expand{ 0, (WorkloadParamValue<Schema::Params[I].data_type>::set(p_params[I], static_cast<ValueType<I>>(values)), 0)... };
+    }
+};
+
+template <class Schema>
+constexpr std::size_t WorkloadSchema<Schema>::ParamCount;
+
+/**
+ * @brief Schemas of the workload parameters of the standard workloads.
+ * @details Use through WorkloadSchema, for example,
+ * `WorkloadSchema<WorkloadSchemas::MatrixMultiply>`.
+ */
+namespace WorkloadSchemas {
+
+struct MatrixMultiply
+{
+    enum : std::size_t
+    {
+        RowsM0,
+        ColsM0,
+        ColsM1
+    };
+    static constexpr WorkloadParamSpec Params[] = { WorkloadParamSpec::UInt64("rows_M0", 1),
+                                                    WorkloadParamSpec::UInt64("cols_M0", 1),
+                                                    WorkloadParamSpec::UInt64("cols_M1", 1) };
+};
+
+/**
+ * @brief Workloads operating on vectors of `n` elements: element-wise addition and
+ * multiplication, dot product and logistic regression.
+ */
+struct VectorSize
+{
+    enum : std::size_t
+    {
+        N
+    };
+    static constexpr WorkloadParamSpec Params[] = { WorkloadParamSpec::UInt64("n", 1) };
+};
+
+struct SimpleSetIntersection
+{
+    enum : std::size_t
+    {
+        N,
+        M,
+        K
+    };
+    static constexpr WorkloadParamSpec Params[] = { WorkloadParamSpec::UInt64("n", 1),
+                                                    WorkloadParamSpec::UInt64("m", 1),
+                                                    WorkloadParamSpec::UInt64("k", 1) };
+};
+
+/**
+ * @brief Leading parameters of the generic workload: number of inputs `n` and of
+ * result components `m`.
+ * @details These are followed by `n + m` parameters with the number of elements of
+ * each input and result component, so, the number of parameters depends on their
+ * values and cannot be declared by a constexpr array. Use GenericWorkloadSchema,
+ * which validates the whole set on top of this schema.
+ */
+struct Generic
+{
+    enum : std::size_t
+    {
+        N,
+        M
+    };
+    static constexpr WorkloadParamSpec Params[] = { WorkloadParamSpec::UInt64("n", 1),
+                                                    WorkloadParamSpec::UInt64("m", 1) };
+    /**
+     * @brief Declares the length parameters, named after these with the index of
+     * the input or result component appended.
+     */
+    static constexpr WorkloadParamSpec InputLength  = WorkloadParamSpec::UInt64("length_InputParam", 1);
+    static constexpr WorkloadParamSpec ResultLength = WorkloadParamSpec::UInt64("length_ResultComponent", 1);
+};
+
+} // namespace WorkloadSchemas
+
+/**
+ * @brief Workload parameter handling for the generic workload, whose number of
+ * parameters depends on the values of its leading parameters.
+ * @details Counterpart of WorkloadSchema for WorkloadSchemas::Generic: parameters are
+ * `n`, `m`, then the length of each of the `n` inputs and of each of the `m` result
+ * components.
+ * @code
+ * // in the benchmark description constructor: two inputs of 4 elements, one result
+ * addDefaultParameters(GenericWorkloadSchema::makeDefault({ 4, 4 }, { 1 }));
+ * // in the benchmark constructor
+ * GenericWorkloadSchema::Values w_params = GenericWorkloadSchema::validate(bench_params);
+ * std::uint64_t length = w_params.inputLength(1);
+ * @endcode
+ */
+class GenericWorkloadSchema
+{
+public:
+    typedef WorkloadSchemas::Generic Schema;
+
+    /**
+     * @brief Typed view of generic workload parameters that passed validation.
+     * @details Does not copy the parameters: it is valid as long as the parameters
+     * used to create it. Indices are not checked.
+     */
+    class Values
+    {
+    public:
+        std::uint64_t n() const noexcept { return m_p_params[Schema::N].u_param; }
+        std::uint64_t m() const noexcept { return m_p_params[Schema::M].u_param; }
+        /**
+         * @brief Number of elements of input \p index, less than n().
+         */
+        std::uint64_t inputLength(std::uint64_t index) const noexcept { return m_p_params[2 + index].u_param; }
+        /**
+         * @brief Number of elements of result component \p index, less than m().
+         */
+        std::uint64_t resultLength(std::uint64_t index) const noexcept { return m_p_params[2 + n() + index].u_param; }
+
+    private:
+        friend class GenericWorkloadSchema;
+        explicit Values(const hebench::APIBridge::WorkloadParam *p_params) noexcept :
+            m_p_params(p_params) {}
+
+        const hebench::APIBridge::WorkloadParam *m_p_params;
+    };
+
+    /**
+     * @brief Checks received parameters against the generic workload schema.
+     * @throws HEBenchError with HEBENCH_ECODE_INVALID_ARGS if \p w_params has fewer
+     * than `n + m + 2` parameters, or any of them has the wrong type or a value out
+     * of range.
+     */
+    static Values validate(const hebench::APIBridge::WorkloadParams &w_params)
+    {
+        return validate(w_params.params, w_params.count);
+    }
+    /**
+     * @copydoc validate(const hebench::APIBridge::WorkloadParams &)
+     */
+    static Values validate(const std::vector<hebench::APIBridge::WorkloadParam> &w_params)
+    {
+        return validate(w_params.data(), w_params.size());
+    }
+
+    /**
+     * @brief Builds a set of generic workload parameters.
+     * @param[in] input_lengths Number of elements of each input, `n` in total.
+     * @param[in] result_lengths Number of elements of each result component, `m` in total.
+     * @throws HEBenchError with HEBENCH_ECODE_INVALID_ARGS if a value is out of range.
+     */
+    static std::vector<hebench::APIBridge::WorkloadParam> makeDefault(const std::vector<std::uint64_t> &input_lengths,
+                                                                      const std::vector<std::uint64_t> &result_lengths);
+
+    /**
+     * @brief Serialized description of the schema.
+     * @details As WorkloadSchema::descriptor(), with the length parameters described
+     * once each, followed by the parameter that gives their count. For example,
+     * `n:UInt64[1,...];m:UInt64[1,...];length_InputParam[n]:UInt64[1,...];length_ResultComponent[m]:UInt64[1,...]`.
+     */
+    static const std::string &descriptor();
+
+private:
+    static Values validate(const hebench::APIBridge::WorkloadParam *p_params, std::uint64_t param_count);
+};
+
+} // namespace cpp
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_WorkloadSchema_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,49 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "hebench/api_bridge/cpp/aligned_allocator.hpp"
+
+namespace hebench {
+namespace cpp {
+
+void *allocateAligned(std::size_t size, std::size_t alignment)
+{
+    void *retval = nullptr;
+    // posix_memalign() may return null for 0 bytes, which callers treat as failure
+    if (posix_memalign(&retval, alignment, size > 0 ? size : 1) != 0)
+        throw std::bad_alloc();
+    return retval;
+}
+
+void *allocateHugePages(std::size_t size, std::size_t alignment)
+{
+    if (size < HugePageSize)
+        return allocateAligned(size, alignment);
+
+    // whole huge pages, so that the advice covers the entire buffer
+    if (size > std::numeric_limits<std::size_t>::max() - (HugePageSize - 1))
+        throw std::bad_alloc();
+    std::size_t rounded = (size + HugePageSize - 1) / HugePageSize * HugePageSize;
+    void *retval        = allocateAligned(rounded, std::max(alignment, HugePageSize));
+#if defined(MADV_HUGEPAGE)
+    // advisory only: failure leaves regular pages, which still work
+    madvise(retval, rounded, MADV_HUGEPAGE);
+#endif
+    return retval;
+}
+
+void freeAligned(void *p) noexcept
+{
+    std::free(p);
+}
+
+} // namespace cpp
+} // namespace hebench
@@ -0,0 +1,132 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "hebench/api_bridge/cpp/aligned_allocator.hpp"
+#include "hebench/api_bridge/cpp/arena.hpp"
+
+namespace hebench {
+namespace cpp {
+
+//-------------
+// class Arena
+//-------------
+
+constexpr std::size_t Arena::DefaultChunkSize;
+
+Arena::Arena(std::size_t chunk_size) :
+    m_chunk_size(std::max<std::size_t>(chunk_size, DefaultAlignment)),
+    m_p_current(nullptr),
+    m_p_end(nullptr),
+    m_capacity(0),
+    m_used(0),
+    m_p_destructors(nullptr),
+    m_live_handles(0),
+    m_live_handles_size(0)
+{
+}
+
+Arena::~Arena()
+{
+    release();
+}
+
+void Arena::release()
+{
+    // objects may refer to objects created before them
+    for (DestructorNode *p_node = m_p_destructors; p_node; p_node = p_node->p_next)
+        p_node->destroy(p_node->p_obj);
+    for (void *p_chunk : m_chunks)
+        freeAligned(p_chunk);
+
+    m_chunks.clear();
+    m_p_current     = nullptr;
+    m_p_end         = nullptr;
+    m_capacity      = 0;
+    m_used          = 0;
+    m_p_destructors = nullptr;
+    m_live_handles.store(0, std::memory_order_relaxed);
+    m_live_handles_size.store(0, std::memory_order_relaxed);
+}
+
+std::size_t Arena::capacity() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+std::size_t Arena::used() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_used;
+}
+
+void *Arena::allocateChunk(std::size_t size)
+{
+    m_chunks.reserve(m_chunks.size() + 1); // do not leak the chunk if this throws
+    void *retval = allocateAligned(size, DefaultAlignment);
+    m_chunks.push_back(retval);
+    m_capacity += size;
+    return retval;
+}
+
+void *Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Alignment must be a power of 2."));
+    if (size == 0)
+        size = 1;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (size > m_chunk_size / 2 || alignment > DefaultAlignment)
+    {
+        // large or over-aligned requests get their own chunk so that the current
+        // chunk is not wasted
+        std::size_t padded = std::max(alignment, DefaultAlignment);
+        if (size > static_cast<std::size_t>(-1) - padded)
+            throw std::bad_alloc();
+        padded = (size + padded - 1) / padded * padded;
+        void *retval = allocateAligned(padded, std::max(alignment, DefaultAlignment));
+        try
+        {
+            m_chunks.push_back(retval);
+        }
+        catch (...)
+        {
+            freeAligned(retval);
+            throw;
+        }
+        m_capacity += padded;
+        m_used += padded;
+        return retval;
+    } // end if
+
+    std::uintptr_t current = reinterpret_cast<std::uintptr_t>(m_p_current);
+    std::uintptr_t aligned = (current + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    if (!m_p_current || aligned + size > reinterpret_cast<std::uintptr_t>(m_p_end))
+    {
+        m_p_current = static_cast<char *>(allocateChunk(m_chunk_size));
+        m_p_end     = m_p_current + m_chunk_size;
+        current     = reinterpret_cast<std::uintptr_t>(m_p_current);
+        aligned     = current; // chunks are aligned to DefaultAlignment
+    } // end if
+
+    char *retval = m_p_current + (aligned - current);
+    m_used += (aligned - current) + size;
+    m_p_current = retval + size;
+    return retval;
+}
+
+void Arena::registerDestructor(DestructorNode *p_node)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    p_node->p_next  = m_p_destructors;
+    m_p_destructors = p_node;
+}
+
+} // namespace cpp
+} // namespace hebench
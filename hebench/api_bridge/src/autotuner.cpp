@@ -0,0 +1,392 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include "hebench/api_bridge/cpp/autotuner.hpp"
+
+namespace hebench {
+namespace cpp {
+
+namespace {
+
+std::string sanitize(std::string s)
+{
+    std::replace_if(
+        s.begin(), s.end(), [](char c) { return c == '\t' || c == '\r' || c == '\n'; }, ' ');
+    return s;
+}
+
+// advisory lock on a sidecar file, held while a database file is read, merged and
+// replaced, so that concurrent writers do not drop each other's entries; the
+// database itself cannot be locked because rename() replaces its inode
+class FileLock
+{
+public:
+    explicit FileLock(const std::string &filename)
+    {
+#if defined(__linux__)
+        m_fd = open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (m_fd < 0)
+            throw HEBenchError(HEBERROR_MSG("Failed to open lock file \"" + filename + "\": " + std::strerror(errno) + "."),
+                               HEBENCH_ECODE_CRITICAL_ERROR);
+        int result;
+        do
+        {
+            result = flock(m_fd, LOCK_EX);
+        } while (result != 0 && errno == EINTR);
+        if (result != 0)
+        {
+            int err = errno;
+            close(m_fd);
+            throw HEBenchError(HEBERROR_MSG("Failed to lock \"" + filename + "\": " + std::strerror(err) + "."),
+                               HEBENCH_ECODE_CRITICAL_ERROR);
+        } // end if
+#else
+        (void)filename;
+#endif
+    }
+    ~FileLock()
+    {
+#if defined(__linux__)
+        // closing the descriptor releases the lock
+        close(m_fd);
+#endif
+    }
+    FileLock(const FileLock &) = delete;
+    FileLock &operator=(const FileLock &) = delete;
+
+private:
+#if defined(__linux__)
+    int m_fd;
+#endif
+};
+
+// flushes a file, or directory, to storage; returns false on failure with errno set
+bool syncFile(const std::string &filename, bool b_directory)
+{
+#if defined(__linux__)
+    int fd = open(filename.c_str(), (b_directory ? O_RDONLY | O_DIRECTORY : O_RDONLY) | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    int result = fsync(fd);
+    int err    = errno;
+    close(fd);
+    errno = err;
+    return result == 0;
+#else
+    (void)filename;
+    (void)b_directory;
+    return true;
+#endif
+}
+
+std::string parentDirectory(const std::string &filename)
+{
+    std::string::size_type pos = filename.find_last_of('/');
+    if (pos == std::string::npos)
+        return ".";
+    return pos == 0 ? std::string("/") : filename.substr(0, pos);
+}
+
+} // namespace
+
+//----------------------
+// class TuningDatabase
+//----------------------
+
+const std::string &TuningDatabase::cpuModel()
+{
+    static const std::string model = []() {
+        std::string retval;
+        std::ifstream ifs("/proc/cpuinfo");
+        std::string line;
+        while (retval.empty() && std::getline(ifs, line))
+        {
+            // "model name" on x86, "Model" on some ARM systems
+            if (line.compare(0, 10, "model name") == 0 || line.compare(0, 5, "Model") == 0)
+            {
+                std::string::size_type pos = line.find(':');
+                if (pos != std::string::npos)
+                {
+                    pos    = line.find_first_not_of(" \t", pos + 1);
+                    retval = pos == std::string::npos ? std::string() : sanitize(line.substr(pos));
+                } // end if
+            } // end if
+        } // end while
+        return retval.empty() ? std::string("unknown") : retval;
+    }();
+    return model;
+}
+
+std::string TuningDatabase::defaultFilename()
+{
+    const char *s_value = std::getenv("HEBENCH_TUNING_DB");
+    return s_value ? std::string(s_value) : std::string();
+}
+
+TuningDatabase::TuningDatabase(std::string filename) :
+    m_filename(std::move(filename)),
+    m_b_loaded(false)
+{
+}
+
+void TuningDatabase::readFile(const std::string &filename, std::unordered_map<std::string, Entry> &entries)
+{
+    std::ifstream ifs(filename);
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        if (line.empty() || line.front() == '#')
+            continue;
+        std::string::size_type tab0 = line.find('\t');
+        std::string::size_type tab1 = tab0 == std::string::npos ? tab0 : line.find('\t', tab0 + 1);
+        if (tab1 == std::string::npos)
+            continue; // skip malformed entries
+        Entry entry;
+        entry.choice  = line.substr(tab0 + 1, tab1 - tab0 - 1);
+        entry.time_ns = std::strtoull(line.c_str() + tab1 + 1, nullptr, 10);
+
+        entries[line.substr(0, tab0)] = entry;
+    } // end while
+}
+
+void TuningDatabase::loadIfNeeded() const
+{
+    if (!m_b_loaded)
+    {
+        if (!m_filename.empty())
+            readFile(m_filename, m_entries);
+        m_b_loaded = true;
+    } // end if
+}
+
+bool TuningDatabase::find(const std::string &key, Entry &entry) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    loadIfNeeded();
+    auto it = m_entries.find(sanitize(key));
+    if (it == m_entries.end())
+        return false;
+    entry = it->second;
+    return true;
+}
+
+void TuningDatabase::store(const std::string &key, const Entry &entry)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    loadIfNeeded();
+    Entry sanitized;
+    sanitized.choice         = sanitize(entry.choice);
+    sanitized.time_ns        = entry.time_ns;
+    m_entries[sanitize(key)] = sanitized;
+    if (m_filename.empty())
+        return;
+
+    // merge entries stored by other processes since loading, ours taking precedence
+    FileLock file_lock(m_filename + ".lock");
+    std::unordered_map<std::string, Entry> merged;
+    readFile(m_filename, merged);
+    for (const auto &item : m_entries)
+        merged[item.first] = item.second;
+    m_entries = merged;
+
+    // replace the file atomically, so that readers never see a partial database
+    std::uint64_t tmp_id     = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())
+                           ^ static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(this));
+    std::string tmp_filename = m_filename + ".tmp" + std::to_string(tmp_id);
+    {
+        std::ofstream ofs(tmp_filename, std::ios_base::out | std::ios_base::trunc);
+        ofs << "# HEBench tuning database: key<TAB>choice<TAB>nanoseconds" << std::endl;
+        for (const auto &item : m_entries)
+            ofs << item.first << '\t' << item.second.choice << '\t' << item.second.time_ns << '\n';
+        ofs.close();
+        // contents must reach storage before the rename, or a crash could leave
+        // an empty or partial database in place of the previous one
+        if (!ofs || !syncFile(tmp_filename, false))
+        {
+            std::remove(tmp_filename.c_str());
+            throw HEBenchError(HEBERROR_MSG_CLASS("Error writing tuning database \"" + tmp_filename + "\"."),
+                               HEBENCH_ECODE_CRITICAL_ERROR);
+        } // end if
+    }
+    if (std::rename(tmp_filename.c_str(), m_filename.c_str()) != 0)
+    {
+        std::remove(tmp_filename.c_str());
+        throw HEBenchError(HEBERROR_MSG_CLASS("Error replacing tuning database \"" + m_filename + "\"."),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+    } // end if
+    // persist the rename itself; file systems that cannot sync directories report EINVAL
+    if (!syncFile(parentDirectory(m_filename), true) && errno != EINVAL)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Error syncing the directory of tuning database \"" + m_filename + "\": "
+                                              + std::strerror(errno) + "."),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+}
+
+std::size_t TuningDatabase::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    loadIfNeeded();
+    return m_entries.size();
+}
+
+//-----------------
+// class Autotuner
+//-----------------
+
+Autotuner::Autotuner(TuningDatabase *p_db) :
+    Autotuner(p_db, Options())
+{
+}
+
+Autotuner::Autotuner(TuningDatabase *p_db, const Options &options) :
+    m_p_db(p_db),
+    m_options(options),
+    m_b_last_from_db(false),
+    m_last_time_ns(0)
+{
+}
+
+std::string Autotuner::makeKey(const std::string &kernel,
+                               const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                               const std::vector<hebench::APIBridge::WorkloadParam> &w_params)
+{
+    std::stringstream ss;
+    ss << kernel
+       << ";workload=" << static_cast<int>(bench_desc.workload)
+       << ";data_type=" << static_cast<int>(bench_desc.data_type)
+       << ";category=" << static_cast<int>(bench_desc.category)
+       << ";cipher_mask=" << static_cast<int>(bench_desc.cipher_param_mask)
+       << ";scheme=" << bench_desc.scheme
+       << ";security=" << bench_desc.security
+       << ";other=" << bench_desc.other
+       << ";params=";
+    for (std::size_t i = 0; i < w_params.size(); ++i)
+    {
+        if (i > 0)
+            ss << ",";
+        switch (w_params[i].data_type)
+        {
+        case hebench::APIBridge::WorkloadParamType::Int64:
+            ss << w_params[i].i_param;
+            break;
+        case hebench::APIBridge::WorkloadParamType::UInt64:
+            ss << w_params[i].u_param;
+            break;
+        default:
+            ss.precision(std::numeric_limits<double>::max_digits10);
+            ss << w_params[i].f_param;
+            break;
+        } // end switch
+    } // end for
+    return ss.str();
+}
+
+std::uint64_t Autotuner::timeTrial(std::size_t index, const std::function<void(std::size_t)> &trial) const
+{
+    for (std::uint64_t i = 0; i < m_options.warmup_iterations; ++i)
+        trial(index);
+
+    const std::chrono::nanoseconds min_time = std::chrono::milliseconds(m_options.min_time_ms);
+    std::chrono::nanoseconds elapsed(0);
+    std::chrono::nanoseconds fastest = std::chrono::nanoseconds::max();
+    for (std::uint64_t i = 0;
+         i < m_options.max_iterations && (i < m_options.min_iterations || elapsed < min_time);
+         ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        trial(index);
+        std::chrono::nanoseconds run_time = std::chrono::steady_clock::now() - start;
+        if (run_time < fastest)
+            fastest = run_time;
+        elapsed += run_time;
+    } // end for
+
+    // the fastest run is the least disturbed by the rest of the system
+    return fastest == std::chrono::nanoseconds::max() ? 0 : static_cast<std::uint64_t>(fastest.count());
+}
+
+std::size_t Autotuner::tune(const std::string &key,
+                            const std::vector<std::string> &names,
+                            const std::function<void(std::size_t)> &trial)
+{
+    if (names.empty())
+        throw HEBenchError(HEBERROR_MSG_CLASS("Tuning requires, at least, one candidate."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+
+    const std::string db_key = TuningDatabase::cpuModel() + ";" + key;
+
+    m_b_last_from_db = false;
+    if (m_p_db)
+    {
+        TuningDatabase::Entry entry;
+        if (m_p_db->find(db_key, entry))
+        {
+            auto it = std::find(names.begin(), names.end(), entry.choice);
+            if (it != names.end())
+            {
+                m_b_last_from_db = true;
+                m_last_time_ns   = entry.time_ns;
+                return static_cast<std::size_t>(it - names.begin());
+            } // end if
+            // candidates changed since the choice was stored: tune again
+        } // end if
+    } // end if
+
+    std::size_t retval         = names.size();
+    std::uint64_t best_time_ns = std::numeric_limits<std::uint64_t>::max();
+    std::exception_ptr p_first_error;
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        try
+        {
+            std::uint64_t time_ns = timeTrial(i, trial);
+            if (retval >= names.size() || time_ns < best_time_ns)
+            {
+                retval       = i;
+                best_time_ns = time_ns;
+            } // end if
+        }
+        catch (...)
+        {
+            if (!p_first_error)
+                p_first_error = std::current_exception();
+        }
+    } // end for
+    if (retval >= names.size())
+        std::rethrow_exception(p_first_error);
+
+    m_last_time_ns = best_time_ns;
+    if (m_p_db)
+    {
+        try
+        {
+            m_p_db->store(db_key, TuningDatabase::Entry{ names[retval], best_time_ns });
+        }
+        catch (...)
+        {
+            // the choice is still valid for this run
+        }
+    } // end if
+
+    return retval;
+}
+
+} // namespace cpp
+} // namespace hebench
@@ -3,13 +3,51 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <cstring>
+#include <limits>
 #include <stdexcept>
 
 #include "hebench/api_bridge/cpp/benchmark.hpp"
+#include "hebench/api_bridge/cpp/engine.hpp"
 
 namespace hebench {
 namespace cpp {
 
+namespace {
+
+/**
+ * @brief Calls the specified functor translating any exception into an error code.
+ * @details Last error is set on failure.
+ */
+template <class F>
+hebench::APIBridge::ErrorCode invokeGuarded(F &&f) noexcept
+{
+    hebench::APIBridge::ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+
+    try
+    {
+        f();
+    }
+    catch (HEBenchError &hebench_err)
+    {
+        retval = hebench_err.getErrorCode();
+        BaseEngine::setLastError(hebench_err.getErrorCode(), hebench_err.what());
+    }
+    catch (std::exception &ex)
+    {
+        retval = HEBENCH_ECODE_CRITICAL_ERROR;
+        BaseEngine::setLastError(retval, ex.what());
+    }
+    catch (...)
+    {
+        retval = HEBENCH_ECODE_CRITICAL_ERROR;
+        BaseEngine::setLastError(retval);
+    }
+
+    return retval;
+}
+
+} // namespace
+
 //----------------------------
 // class BenchmarkDescription
 //----------------------------
@@ -22,7 +60,38 @@ std::string BenchmarkDescription::getBenchmarkDescription(const hebench::APIBrid
 
 std::size_t BenchmarkDescription::getWorkloadParameterCount() const
 {
-    return m_default_params.empty() ? 0 : m_default_params.front().size();
+    return m_default_params.empty() ? 0 : m_default_params.front().parameterCount();
+}
+
+std::vector<std::vector<hebench::APIBridge::WorkloadParam>> BenchmarkDescription::getWorkloadDefaultParameters() const
+{
+    std::vector<std::vector<hebench::APIBridge::WorkloadParam>> retval;
+    for (const WorkloadSweep &sweep : m_default_params)
+        for (std::uint64_t i = 0; i < sweep.size(); ++i)
+            retval.emplace_back(sweep.at(i));
+    return retval;
+}
+
+std::uint64_t BenchmarkDescription::getWorkloadDefaultParametersCount() const
+{
+    std::uint64_t retval = 0;
+    for (const WorkloadSweep &sweep : m_default_params)
+        retval += sweep.size();
+    return retval;
+}
+
+void BenchmarkDescription::getWorkloadDefaultParameters(std::uint64_t set_index, hebench::APIBridge::WorkloadParam *p_params) const
+{
+    for (const WorkloadSweep &sweep : m_default_params)
+    {
+        if (set_index < sweep.size())
+        {
+            sweep.at(set_index, p_params);
+            return;
+        } // end if
+        set_index -= sweep.size();
+    } // end for
+    throw std::out_of_range("Default set of workload parameters out of range.");
 }
 
 void BenchmarkDescription::getBenchmarkDescriptor(hebench::APIBridge::BenchmarkDescriptor &bench_desc) const
@@ -36,13 +105,20 @@ void BenchmarkDescription::addDefaultParameters(const WorkloadParams::Common &de
 }
 
 void BenchmarkDescription::addDefaultParameters(const std::vector<hebench::APIBridge::WorkloadParam> &default_params_set)
+{
+    addDefaultParameters(WorkloadSweep(default_params_set));
+}
+
+void BenchmarkDescription::addDefaultParameters(const WorkloadSweep &default_params_sweep)
 {
     if (!m_default_params.empty())
     {
-        if (m_default_params.front().size() != default_params_set.size())
+        if (m_default_params.front().parameterCount() != default_params_sweep.parameterCount())
             throw std::invalid_argument("Size of new default set of arguments differs from other existing default sets.");
+        if (getWorkloadDefaultParametersCount() > std::numeric_limits<std::uint64_t>::max() - default_params_sweep.size())
+            throw std::invalid_argument("Too many default sets of arguments.");
     } // end if
-    m_default_params.push_back(default_params_set);
+    m_default_params.push_back(default_params_sweep);
 }
 
 //---------------------
@@ -65,11 +141,89 @@ BaseBenchmark::BaseBenchmark(BaseEngine &engine,
         m_bench_params.assign(bench_params.params, bench_params.params + bench_params.count);
 }
 
+void BaseBenchmark::enableArena(std::size_t chunk_size)
+{
+    if (m_p_arena)
+        throw std::logic_error(HEBERROR_MSG_CLASS("Arena already enabled."));
+    m_p_arena.reset(new Arena(chunk_size));
+}
+
 void BaseBenchmark::initialize(const hebench::APIBridge::BenchmarkDescriptor &bench_desc_concrete)
 {
     (void)bench_desc_concrete;
 }
 
+void BaseBenchmark::markConstantOperand(std::uint64_t param_position)
+{
+    if (!m_p_constant_cache)
+        m_p_constant_cache.reset(new ConstantOperandCache(m_engine));
+    m_p_constant_cache->markConstant(param_position);
+}
+
+bool BaseBenchmark::reset()
+{
+    return false;
+}
+
+hebench::APIBridge::ErrorCode BaseBenchmark::tryInitialize(const hebench::APIBridge::BenchmarkDescriptor &bench_desc_concrete)
+{
+    return invokeGuarded([this, &bench_desc_concrete]() { initialize(bench_desc_concrete); });
+}
+
+hebench::APIBridge::ErrorCode BaseBenchmark::tryEncode(const hebench::APIBridge::DataPackCollection *p_parameters,
+                                                       hebench::APIBridge::Handle *p_h_encoded)
+{
+    return invokeGuarded([this, p_parameters, p_h_encoded]() {
+        *p_h_encoded = m_p_constant_cache && p_parameters ?
+                           m_p_constant_cache->encode(*p_parameters, [this, p_parameters]() { return encode(p_parameters); }) :
+                           encode(p_parameters);
+    });
+}
+
+hebench::APIBridge::ErrorCode BaseBenchmark::tryDecode(hebench::APIBridge::Handle encoded_data,
+                                                       hebench::APIBridge::DataPackCollection *p_native)
+{
+    return invokeGuarded([this, encoded_data, p_native]() { decode(encoded_data, p_native); });
+}
+
+hebench::APIBridge::ErrorCode BaseBenchmark::tryEncrypt(hebench::APIBridge::Handle encoded_data,
+                                                        hebench::APIBridge::Handle *p_h_encrypted)
+{
+    return invokeGuarded([this, encoded_data, p_h_encrypted]() {
+        *p_h_encrypted = m_p_constant_cache ?
+                             m_p_constant_cache->encrypt(encoded_data, [this, encoded_data]() { return encrypt(encoded_data); }) :
+                             encrypt(encoded_data);
+    });
+}
+
+hebench::APIBridge::ErrorCode BaseBenchmark::tryDecrypt(hebench::APIBridge::Handle encrypted_data,
+                                                        hebench::APIBridge::Handle *p_h_decrypted)
+{
+    return invokeGuarded([this, encrypted_data, p_h_decrypted]() { *p_h_decrypted = decrypt(encrypted_data); });
+}
+
+hebench::APIBridge::ErrorCode BaseBenchmark::tryLoad(const hebench::APIBridge::Handle *p_local_data, std::uint64_t count,
+                                                     hebench::APIBridge::Handle *p_h_remote)
+{
+    return invokeGuarded([this, p_local_data, count, p_h_remote]() { *p_h_remote = load(p_local_data, count); });
+}
+
+hebench::APIBridge::ErrorCode BaseBenchmark::tryStore(hebench::APIBridge::Handle remote_data,
+                                                      hebench::APIBridge::Handle *p_local_data, std::uint64_t count)
+{
+    return invokeGuarded([this, remote_data, p_local_data, count]() { store(remote_data, p_local_data, count); });
+}
+
+hebench::APIBridge::ErrorCode BaseBenchmark::tryOperate(hebench::APIBridge::Handle h_remote_packed,
+                                                        const hebench::APIBridge::ParameterIndexer *p_param_indexers,
+                                                        std::uint64_t indexers_count,
+                                                        hebench::APIBridge::Handle *p_h_result)
+{
+    return invokeGuarded([this, h_remote_packed, p_param_indexers, indexers_count, p_h_result]() {
+        *p_h_result = operate(h_remote_packed, p_param_indexers, indexers_count);
+    });
+}
+
 std::uint64_t BaseBenchmark::findDataPackIndex(const hebench::APIBridge::DataPackCollection &parameters,
                                                std::uint64_t param_position)
 {
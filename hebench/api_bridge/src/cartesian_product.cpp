@@ -0,0 +1,117 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include "hebench/api_bridge/cpp/cartesian_product.hpp"
+
+namespace hebench {
+namespace cpp {
+
+//------------------------
+// class CartesianProduct
+//------------------------
+
+constexpr std::uint64_t CartesianProduct::DefaultTileVolume;
+constexpr std::uint64_t CartesianProduct::DefaultCacheBytes;
+
+CartesianProduct::CartesianProduct(const hebench::APIBridge::ParameterIndexer *p_param_indexers,
+                                   std::uint64_t indexers_count) :
+    m_size(1)
+{
+    if (!p_param_indexers || indexers_count == 0)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid empty indexers 'p_param_indexers'."));
+
+    m_indexers.assign(p_param_indexers, p_param_indexers + indexers_count);
+    m_strides.resize(indexers_count);
+    for (std::size_t d = m_indexers.size(); d-- > 0;)
+    {
+        m_strides[d] = m_size;
+        if (m_indexers[d].value_index > std::numeric_limits<std::uint64_t>::max() - m_indexers[d].batch_size)
+            throw std::invalid_argument(HEBERROR_MSG_CLASS("Samples requested for operand " + std::to_string(d) + " exceed 64 bits."));
+        if (m_indexers[d].batch_size > 0
+            && m_size > std::numeric_limits<std::uint64_t>::max() / m_indexers[d].batch_size)
+            throw std::invalid_argument(HEBERROR_MSG_CLASS("Number of tuples in cartesian product exceeds 64 bits."));
+        m_size *= m_indexers[d].batch_size;
+    } // end for
+
+    // balanced default tiles
+    std::uint64_t extent = static_cast<std::uint64_t>(
+        std::ceil(std::pow(static_cast<double>(DefaultTileVolume), 1.0 / static_cast<double>(m_indexers.size()))));
+    setTileExtents(std::vector<std::uint64_t>(m_indexers.size(), extent).data());
+}
+
+void CartesianProduct::setTileExtents(const std::uint64_t *p_extents)
+{
+    if (!p_extents)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid null tile extents 'p_extents'."));
+
+    m_tile_extents.resize(m_indexers.size());
+    m_tile_grid.resize(m_indexers.size());
+    for (std::size_t d = 0; d < m_indexers.size(); ++d)
+    {
+        std::uint64_t batch_size = std::max<std::uint64_t>(m_indexers[d].batch_size, 1);
+        m_tile_extents[d]        = std::min(std::max<std::uint64_t>(p_extents[d], 1), batch_size);
+        m_tile_grid[d]           = (batch_size + m_tile_extents[d] - 1) / m_tile_extents[d];
+    } // end for
+}
+
+void CartesianProduct::fitTileToCache(const std::uint64_t *p_sample_bytes, std::uint64_t cache_bytes)
+{
+    if (!p_sample_bytes)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid null sample sizes 'p_sample_bytes'."));
+
+    // working set of a tile with extent `e` on every operand (clipped to batch sizes)
+    auto working_set = [this, p_sample_bytes](std::uint64_t e) -> std::uint64_t {
+        std::uint64_t retval = 0;
+        for (std::size_t d = 0; d < m_indexers.size(); ++d)
+            retval += std::min(e, std::max<std::uint64_t>(m_indexers[d].batch_size, 1)) * p_sample_bytes[d];
+        return retval;
+    };
+
+    std::uint64_t max_extent = 1;
+    for (const auto &indexer : m_indexers)
+        max_extent = std::max(max_extent, indexer.batch_size);
+
+    // largest balanced extent that fits (at least 1)
+    std::uint64_t lo = 1;
+    std::uint64_t hi = max_extent;
+    while (lo < hi)
+    {
+        std::uint64_t mid = lo + (hi - lo + 1) / 2;
+        if (working_set(mid) <= cache_bytes)
+            lo = mid;
+        else
+            hi = mid - 1;
+    } // end while
+
+    setTileExtents(std::vector<std::uint64_t>(m_indexers.size(), lo).data());
+}
+
+void CartesianProduct::sampleIndices(std::uint64_t result_index, std::uint64_t *p_sample_indices) const
+{
+    if (!p_sample_indices)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid null output 'p_sample_indices'."));
+    if (result_index >= m_size)
+        throw std::out_of_range(HEBERROR_MSG_CLASS("Result index out of range."));
+
+    for (std::size_t d = 0; d < m_indexers.size(); ++d)
+    {
+        p_sample_indices[d] = m_indexers[d].value_index + result_index / m_strides[d];
+        result_index %= m_strides[d];
+    } // end for
+}
+
+std::uint64_t CartesianProduct::tileCount() const
+{
+    std::uint64_t retval = 1;
+    for (auto tiles : m_tile_grid)
+        retval *= tiles;
+    return retval;
+}
+
+} // namespace cpp
+} // namespace hebench
@@ -0,0 +1,257 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cstring>
+
+#include "hebench/api_bridge/cpp/constant_operand_cache.hpp"
+#include "hebench/api_bridge/cpp/engine.hpp"
+#include "hebench/api_bridge/cpp/utilities.hpp"
+
+namespace hebench {
+namespace cpp {
+
+namespace {
+
+/**
+ * @brief Calls `fn(p, size)` on each chunk of content and layout of a collection.
+ * @details Stops and returns `false` as soon as `fn` returns `false`. Hashing, copying
+ * and comparison of content visit the same chunks, so equal content hashes equally.
+ */
+template <class Fn>
+bool visitContent(const hebench::APIBridge::DataPackCollection &parameters, Fn &&fn)
+{
+    if (!fn(&parameters.pack_count, sizeof(parameters.pack_count)))
+        return false;
+    for (std::uint64_t pack_i = 0; parameters.p_data_packs && pack_i < parameters.pack_count; ++pack_i)
+    {
+        const hebench::APIBridge::DataPack &pack = parameters.p_data_packs[pack_i];
+        std::uint64_t layout[2]                  = { pack.param_position, pack.buffer_count };
+        if (!fn(layout, sizeof(layout)))
+            return false;
+        for (std::uint64_t buffer_i = 0; pack.p_buffers && buffer_i < pack.buffer_count; ++buffer_i)
+        {
+            const hebench::APIBridge::NativeDataBuffer &buffer = pack.p_buffers[buffer_i];
+            if (!fn(&buffer.size, sizeof(buffer.size)))
+                return false;
+            if (buffer.p && !fn(buffer.p, buffer.size))
+                return false;
+        } // end for
+    } // end for
+    return true;
+}
+
+void copyContent(const hebench::APIBridge::DataPackCollection &parameters, std::vector<std::uint8_t> &content)
+{
+    content.clear();
+    visitContent(parameters, [&content](const void *p, std::uint64_t size) {
+        const std::uint8_t *p_bytes = reinterpret_cast<const std::uint8_t *>(p);
+        content.insert(content.end(), p_bytes, p_bytes + size);
+        return true;
+    });
+}
+
+bool equalContent(const hebench::APIBridge::DataPackCollection &parameters, const std::vector<std::uint8_t> &content)
+{
+    std::uint64_t offset = 0;
+    bool retval          = visitContent(parameters, [&content, &offset](const void *p, std::uint64_t size) {
+        if (size > content.size() - offset
+            || (size > 0 && std::memcmp(content.data() + offset, p, size) != 0))
+            return false;
+        offset += size;
+        return true;
+    });
+    return retval && offset == content.size();
+}
+
+} // namespace
+
+//----------------------------
+// class ConstantOperandCache
+//----------------------------
+
+constexpr std::size_t ConstantOperandCache::DefaultCapacity;
+
+ConstantOperandCache::ConstantOperandCache(const BaseEngine &engine, std::size_t capacity) :
+    m_engine(engine),
+    m_capacity(capacity)
+{
+}
+
+ConstantOperandCache::~ConstantOperandCache()
+{
+    clear();
+}
+
+void ConstantOperandCache::markConstant(std::uint64_t param_position)
+{
+    if (!isConstant(param_position))
+        m_constant_positions.push_back(param_position);
+}
+
+bool ConstantOperandCache::isConstant(std::uint64_t param_position) const
+{
+    return std::find(m_constant_positions.begin(), m_constant_positions.end(), param_position)
+           != m_constant_positions.end();
+}
+
+bool ConstantOperandCache::isConstant(const hebench::APIBridge::DataPackCollection &parameters) const
+{
+    if (parameters.pack_count == 0 || !parameters.p_data_packs)
+        return false;
+    for (std::uint64_t i = 0; i < parameters.pack_count; ++i)
+        if (!isConstant(parameters.p_data_packs[i].param_position))
+            return false;
+    return true;
+}
+
+std::uint64_t ConstantOperandCache::hash(const hebench::APIBridge::DataPackCollection &parameters)
+{
+    std::uint64_t retval = 0; // default seed of Utilities::hash64()
+    visitContent(parameters, [&retval](const void *p, std::uint64_t size) {
+        retval = Utilities::hash64(p, size, retval);
+        return true;
+    });
+    return retval;
+}
+
+bool ConstantOperandCache::isCacheable(hebench::APIBridge::Handle h)
+{
+    return h.p && (h.tag & EngineObject::tag) == EngineObject::tag;
+}
+
+hebench::APIBridge::Handle ConstantOperandCache::duplicate(hebench::APIBridge::Handle h) const
+{
+    return m_engine.duplicateHandle(h);
+}
+
+void ConstantOperandCache::destroy(hebench::APIBridge::Handle h) const
+{
+    if (h.p)
+        m_engine.template destroyObj<EngineObject>(reinterpret_cast<EngineObject *>(h.p));
+}
+
+void ConstantOperandCache::destroy(const std::vector<Entry> &entries) const
+{
+    for (const Entry &entry : entries)
+    {
+        destroy(entry.h_encoded);
+        destroy(entry.h_encrypted);
+    } // end for
+}
+
+bool ConstantOperandCache::findEncoded(const hebench::APIBridge::DataPackCollection &parameters,
+                                       std::uint64_t content_hash, hebench::APIBridge::Handle &h_encoded)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                           [&parameters, content_hash](const Entry &entry) {
+                               return entry.content_hash == content_hash
+                                      && equalContent(parameters, entry.content);
+                           });
+    if (it == m_entries.end())
+        return false;
+
+    h_encoded = duplicate(it->h_encoded);
+    // mark as most recently used
+    std::rotate(it, it + 1, m_entries.end());
+    return true;
+}
+
+void ConstantOperandCache::storeEncoded(const hebench::APIBridge::DataPackCollection &parameters,
+                                        std::uint64_t content_hash, hebench::APIBridge::Handle h_encoded) noexcept
+{
+    if (m_capacity == 0 || !isCacheable(h_encoded))
+        return;
+
+    Entry entry;
+    entry.content_hash = content_hash;
+    std::memset(&entry.h_encoded, 0, sizeof(entry.h_encoded));
+    std::memset(&entry.h_encrypted, 0, sizeof(entry.h_encrypted));
+    std::vector<Entry> evicted; // destroyed outside the lock
+    try
+    {
+        copyContent(parameters, entry.content);
+        evicted.reserve(1);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // another thread may have encoded the same content concurrently
+        for (const Entry &cached : m_entries)
+            if (cached.content_hash == content_hash && cached.content == entry.content)
+                return;
+        entry.h_encoded = duplicate(h_encoded);
+        if (m_entries.size() >= m_capacity)
+        {
+            evicted.push_back(std::move(m_entries.front()));
+            m_entries.erase(m_entries.begin());
+        } // end if
+        m_entries.push_back(std::move(entry));
+    }
+    catch (...)
+    {
+        // not cached
+        destroy(entry.h_encoded);
+    }
+    destroy(evicted);
+}
+
+bool ConstantOperandCache::findEncrypted(hebench::APIBridge::Handle h_encoded, hebench::APIBridge::Handle &h_encrypted)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry *p_entry = findEntry(h_encoded);
+    if (!p_entry || !p_entry->h_encrypted.p)
+        return false;
+    h_encrypted = duplicate(p_entry->h_encrypted);
+    return true;
+}
+
+void ConstantOperandCache::storeEncrypted(hebench::APIBridge::Handle h_encoded, hebench::APIBridge::Handle h_encrypted) noexcept
+{
+    if (!isCacheable(h_encrypted))
+        return;
+    try
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry *p_entry = findEntry(h_encoded);
+        // keep the first encryption if another thread encrypted concurrently
+        if (p_entry && !p_entry->h_encrypted.p)
+            p_entry->h_encrypted = duplicate(h_encrypted);
+    }
+    catch (...)
+    {
+        // not cached
+    }
+}
+
+ConstantOperandCache::Entry *ConstantOperandCache::findEntry(hebench::APIBridge::Handle h_encoded)
+{
+    if (!isCacheable(h_encoded))
+        return nullptr;
+
+    const EngineObject *p_obj = reinterpret_cast<const EngineObject *>(h_encoded.p);
+    for (Entry &entry : m_entries)
+        if (p_obj->sharesObjectWith(*reinterpret_cast<const EngineObject *>(entry.h_encoded.p)))
+            return &entry;
+    return nullptr;
+}
+
+void ConstantOperandCache::clear()
+{
+    std::vector<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(entries, m_entries);
+    }
+    // handles are destroyed outside the lock
+    destroy(entries);
+}
+
+std::size_t ConstantOperandCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+} // namespace cpp
+} // namespace hebench
@@ -0,0 +1,208 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <functional>
+#include <iterator>
+
+#include "hebench/api_bridge/cpp/context_cache.hpp"
+
+namespace hebench {
+namespace cpp {
+
+namespace {
+
+void hashCombine(std::size_t &seed, std::size_t value)
+{
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+} // namespace
+
+//-------------------------
+// class ContextCache::Key
+//-------------------------
+
+ContextCache::Key::Key(hebench::APIBridge::Scheme scheme, hebench::APIBridge::Security security, std::int64_t other) :
+    m_scheme(scheme),
+    m_security(security),
+    m_other(other),
+    m_type_id(nullptr)
+{
+}
+
+ContextCache::Key::Key(const hebench::APIBridge::BenchmarkDescriptor &desc) :
+    Key(desc.scheme, desc.security, desc.other)
+{
+}
+
+ContextCache::Key &ContextCache::Key::add(const hebench::APIBridge::WorkloadParam &param)
+{
+    m_values.push_back(static_cast<std::uint64_t>(param.data_type));
+    m_values.push_back(param.u_param); // raw bits of the value
+    return *this;
+}
+
+ContextCache::Key &ContextCache::Key::add(std::uint64_t value)
+{
+    m_values.push_back(value);
+    return *this;
+}
+
+bool ContextCache::Key::operator==(const Key &other) const
+{
+    return m_scheme == other.m_scheme
+           && m_security == other.m_security
+           && m_other == other.m_other
+           && m_type_id == other.m_type_id
+           && m_values == other.m_values;
+}
+
+std::size_t ContextCache::Key::hash() const
+{
+    std::size_t retval = std::hash<std::int64_t>()(m_scheme);
+    hashCombine(retval, std::hash<std::int64_t>()(m_security));
+    hashCombine(retval, std::hash<std::int64_t>()(m_other));
+    hashCombine(retval, std::hash<TypeID>()(m_type_id));
+    for (std::uint64_t value : m_values)
+        hashCombine(retval, std::hash<std::uint64_t>()(value));
+    return retval;
+}
+
+//--------------------
+// class ContextCache
+//--------------------
+
+constexpr std::size_t ContextCache::DefaultCapacity;
+
+ContextCache::ContextCache(std::size_t capacity) :
+    m_capacity(capacity),
+    m_hits(0),
+    m_misses(0)
+{
+}
+
+ContextCache::Key ContextCache::typedKey(const Key &key, TypeID type_id)
+{
+    Key retval       = key;
+    retval.m_type_id = type_id;
+    return retval;
+}
+
+std::shared_ptr<void> ContextCache::findEntry(const Key &typed_key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(typed_key);
+    if (it == m_index.end())
+    {
+        ++m_misses;
+        return std::shared_ptr<void>();
+    } // end if
+
+    ++m_hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->p_obj;
+}
+
+std::shared_ptr<void> ContextCache::insertEntry(const Key &typed_key, std::shared_ptr<void> p_obj, bool b_replace)
+{
+    // declared before the lock: evicted and replaced objects are released outside the lock
+    EntryList evicted;
+    std::shared_ptr<void> p_replaced;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_capacity == 0)
+        return p_obj;
+
+    auto it = m_index.find(typed_key);
+    if (it != m_index.end())
+    {
+        if (b_replace)
+        {
+            p_replaced        = std::move(it->second->p_obj);
+            it->second->p_obj = std::move(p_obj);
+        } // end if
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return it->second->p_obj;
+    } // end if
+
+    m_entries.push_front(Entry{ typed_key, std::move(p_obj) });
+    try
+    {
+        m_index.emplace(typed_key, m_entries.begin());
+    }
+    catch (...)
+    {
+        m_entries.pop_front();
+        throw;
+    }
+    std::shared_ptr<void> retval = m_entries.front().p_obj;
+    evictExcess(evicted);
+    return retval;
+}
+
+bool ContextCache::eraseEntry(const Key &typed_key)
+{
+    EntryList erased; // released outside the lock
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(typed_key);
+    if (it == m_index.end())
+        return false;
+    erased.splice(erased.begin(), m_entries, it->second);
+    m_index.erase(it);
+    return true;
+}
+
+void ContextCache::evictExcess(EntryList &evicted)
+{
+    while (m_entries.size() > m_capacity)
+    {
+        m_index.erase(m_entries.back().key);
+        evicted.splice(evicted.begin(), m_entries, std::prev(m_entries.end()));
+    } // end while
+}
+
+void ContextCache::clear()
+{
+    EntryList entries;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_index.clear();
+        std::swap(entries, m_entries);
+    }
+    // objects are released outside the lock
+}
+
+std::size_t ContextCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+std::size_t ContextCache::capacity() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+void ContextCache::setCapacity(std::size_t capacity)
+{
+    EntryList evicted; // released outside the lock
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    evictExcess(evicted);
+}
+
+std::uint64_t ContextCache::hits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+std::uint64_t ContextCache::misses() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+} // namespace cpp
+} // namespace hebench
@@ -0,0 +1,233 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "hebench/api_bridge/cpp/dataset_generator.hpp"
+#include "hebench/api_bridge/cpp/workload_params.hpp"
+#include "hebench/api_bridge/cpp/workload_schema.hpp"
+
+namespace hebench {
+namespace cpp {
+
+namespace {
+
+std::uint64_t dataTypeSize(hebench::APIBridge::DataType data_type)
+{
+    switch (data_type)
+    {
+    case hebench::APIBridge::DataType::Int32:
+        return sizeof(std::int32_t);
+    case hebench::APIBridge::DataType::Int64:
+        return sizeof(std::int64_t);
+    case hebench::APIBridge::DataType::Float32:
+        return sizeof(float);
+    case hebench::APIBridge::DataType::Float64:
+        return sizeof(double);
+    default:
+        return 0;
+    } // end switch
+}
+
+std::uint64_t checkedProduct(std::uint64_t a, std::uint64_t b)
+{
+    if (a > 0 && b > std::numeric_limits<std::uint64_t>::max() / a)
+        throw std::length_error(HEBERROR_MSG("Dataset too large."));
+    return a * b;
+}
+
+} // namespace
+
+//------------------------
+// class DatasetGenerator
+//------------------------
+
+constexpr std::uint64_t DatasetGenerator::ChunkElements;
+
+DatasetGenerator::DatasetGenerator(std::uint64_t seed) :
+    m_seed(seed),
+    m_b_custom_range(false),
+    m_min(0.0),
+    m_max(0.0)
+{
+}
+
+void DatasetGenerator::setValueRange(double min, double max)
+{
+    if (!std::isfinite(min) || !std::isfinite(max) || max < min)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Invalid range of values: expected finite `min <= max`."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    m_b_custom_range = true;
+    m_min            = min;
+    m_max            = max;
+}
+
+std::vector<std::uint64_t> DatasetGenerator::operandSizes(hebench::APIBridge::Workload workload,
+                                                          const hebench::APIBridge::WorkloadParams &w_params)
+{
+    std::vector<std::uint64_t> retval;
+
+    try
+    {
+        switch (workload)
+        {
+        case hebench::APIBridge::Workload::MatrixMultiply:
+        {
+            typedef WorkloadSchema<WorkloadSchemas::MatrixMultiply> Schema;
+            Schema::Values params = Schema::validate(w_params);
+            retval                = { checkedProduct(params.get<Schema::RowsM0>(), params.get<Schema::ColsM0>()),
+                                      checkedProduct(params.get<Schema::ColsM0>(), params.get<Schema::ColsM1>()) };
+        }
+        break;
+
+        case hebench::APIBridge::Workload::EltwiseAdd:
+        case hebench::APIBridge::Workload::EltwiseMultiply:
+        case hebench::APIBridge::Workload::DotProduct:
+        {
+            std::uint64_t n = WorkloadSchema<WorkloadSchemas::VectorSize>::validate(w_params).get<WorkloadSchemas::VectorSize::N>();
+            retval          = { n, n };
+        }
+        break;
+
+        case hebench::APIBridge::Workload::LogisticRegression:
+        case hebench::APIBridge::Workload::LogisticRegression_PolyD3:
+        case hebench::APIBridge::Workload::LogisticRegression_PolyD5:
+        case hebench::APIBridge::Workload::LogisticRegression_PolyD7:
+        {
+            // W, b, X
+            std::uint64_t n = WorkloadSchema<WorkloadSchemas::VectorSize>::validate(w_params).get<WorkloadSchemas::VectorSize::N>();
+            retval          = { n, 1, n };
+        }
+        break;
+
+        case hebench::APIBridge::Workload::SimpleSetIntersection:
+        {
+            typedef WorkloadSchema<WorkloadSchemas::SimpleSetIntersection> Schema;
+            Schema::Values params = Schema::validate(w_params);
+            retval                = { checkedProduct(params.get<Schema::N>(), params.get<Schema::K>()),
+                                      checkedProduct(params.get<Schema::M>(), params.get<Schema::K>()) };
+        }
+        break;
+
+        case hebench::APIBridge::Workload::Generic:
+        {
+            WorkloadParams::Generic params(w_params);
+            retval.resize(params.n());
+            for (std::size_t param_i = 0; param_i < retval.size(); ++param_i)
+                retval[param_i] = params.length_InputParam(param_i);
+        }
+        break;
+
+        default:
+            throw HEBenchError(HEBERROR_MSG_CLASS("Unsupported workload: " + std::to_string(static_cast<int>(workload)) + "."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+            break;
+        } // end switch
+    }
+    catch (HEBenchError &)
+    {
+        throw;
+    }
+    catch (std::exception &ex)
+    {
+        throw HEBenchError(HEBERROR_MSG_CLASS(std::string("Invalid workload parameters: ") + ex.what()),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    }
+
+    return retval;
+}
+
+GeneratedDataset DatasetGenerator::generate(const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                                            const hebench::APIBridge::WorkloadParams &w_params,
+                                            ThreadPool *p_pool) const
+{
+    std::vector<std::uint64_t> sample_sizes = operandSizes(bench_desc.workload, w_params);
+    std::vector<std::uint64_t> sample_counts(sample_sizes.size(), 1);
+    if (bench_desc.category == hebench::APIBridge::Category::Offline)
+    {
+        if (sample_sizes.size() > HEBENCH_MAX_OP_PARAMS)
+            throw HEBenchError(HEBERROR_MSG_CLASS("Too many operation parameters for an offline benchmark."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+        for (std::size_t param_i = 0; param_i < sample_counts.size(); ++param_i)
+        {
+            sample_counts[param_i] = bench_desc.cat_params.offline.data_count[param_i];
+            if (sample_counts[param_i] == 0)
+                throw HEBenchError(HEBERROR_MSG_CLASS("Unspecified number of samples for parameter " + std::to_string(param_i)
+                                                      + " of offline benchmark: use an explicit layout."),
+                                   HEBENCH_ECODE_INVALID_ARGS);
+        } // end for
+    } // end if
+
+    return generate(bench_desc.data_type, sample_sizes, sample_counts, p_pool);
+}
+
+GeneratedDataset DatasetGenerator::generate(hebench::APIBridge::DataType data_type,
+                                            const std::vector<std::uint64_t> &sample_sizes,
+                                            const std::vector<std::uint64_t> &sample_counts,
+                                            ThreadPool *p_pool) const
+{
+    GeneratedDataset retval;
+
+    std::uint64_t element_size = dataTypeSize(data_type);
+    if (element_size == 0)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Unsupported data type: " + std::to_string(static_cast<int>(data_type)) + "."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    if (sample_sizes.size() != sample_counts.size())
+        throw HEBenchError(HEBERROR_MSG_CLASS("Number of sample sizes and sample counts must match."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+
+    retval.m_data_type    = data_type;
+    retval.m_sample_sizes = sample_sizes;
+    retval.m_storage.reserve(sample_sizes.size());
+    retval.m_buffers.resize(sample_sizes.size());
+    retval.m_packs.resize(sample_sizes.size());
+    for (std::size_t param_i = 0; param_i < sample_sizes.size(); ++param_i)
+    {
+        std::uint64_t count       = checkedProduct(sample_sizes[param_i], sample_counts[param_i]);
+        std::uint64_t sample_size = sample_sizes[param_i] * element_size;
+        if (count > std::numeric_limits<std::size_t>::max() / element_size)
+            throw std::length_error(HEBERROR_MSG_CLASS("Dataset too large."));
+        retval.m_storage.emplace_back(allocateHugePages(count * element_size));
+        char *p_storage = static_cast<char *>(retval.m_storage.back().get());
+
+        // fill each parameter as a single array, so that chunks span samples
+        switch (data_type)
+        {
+        case hebench::APIBridge::DataType::Int32:
+            fill(reinterpret_cast<std::int32_t *>(p_storage), count, param_i, p_pool);
+            break;
+        case hebench::APIBridge::DataType::Int64:
+            fill(reinterpret_cast<std::int64_t *>(p_storage), count, param_i, p_pool);
+            break;
+        case hebench::APIBridge::DataType::Float32:
+            fill(reinterpret_cast<float *>(p_storage), count, param_i, p_pool);
+            break;
+        default:
+            fill(reinterpret_cast<double *>(p_storage), count, param_i, p_pool);
+            break;
+        } // end switch
+
+        std::vector<hebench::APIBridge::NativeDataBuffer> &buffers = retval.m_buffers[param_i];
+        buffers.resize(sample_counts[param_i]);
+        for (std::uint64_t sample_i = 0; sample_i < buffers.size(); ++sample_i)
+        {
+            buffers[sample_i].p    = p_storage + sample_i * sample_size;
+            buffers[sample_i].size = sample_size;
+            buffers[sample_i].tag  = 0;
+        } // end for
+        retval.m_packs[param_i].p_buffers      = buffers.data();
+        retval.m_packs[param_i].buffer_count   = buffers.size();
+        retval.m_packs[param_i].param_position = param_i;
+    } // end for
+    retval.m_collection.p_data_packs = retval.m_packs.data();
+    retval.m_collection.pack_count   = retval.m_packs.size();
+
+    return retval;
+}
+
+} // namespace cpp
+} // namespace hebench
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <new>
 #include <sstream>
 
@@ -14,6 +15,37 @@
 namespace hebench {
 namespace cpp {
 
+namespace {
+
+void updatePeak(std::atomic<std::uint64_t> &peak, std::uint64_t value)
+{
+    std::uint64_t prev = peak.load(std::memory_order_relaxed);
+    while (prev < value && !peak.compare_exchange_weak(prev, value, std::memory_order_relaxed))
+        ; // prev updated by failed exchange
+}
+
+} // namespace
+
+//--------------------
+// class EngineObject
+//--------------------
+
+void EngineObject::throwTypeMismatch(const char *requested_type_name) const
+{
+#ifdef NDEBUG
+    (void)requested_type_name;
+    throw HEBenchError(HEBERROR_MSG_CLASS("Type of wrapped object does not match requested type."),
+                       HEBENCH_ECODE_CRITICAL_ERROR);
+#else
+    std::stringstream ss;
+    ss << "Type of wrapped object does not match requested type. Wrapped object type is `"
+       << (m_type_name ? m_type_name : "unknown") << "`, but `"
+       << (requested_type_name ? requested_type_name : "unknown") << "` was requested.";
+    throw HEBenchError(HEBERROR_MSG_CLASS(ss.str()),
+                       HEBENCH_ECODE_CRITICAL_ERROR);
+#endif
+}
+
 //------------------
 // class BaseEngine
 //------------------
@@ -21,15 +53,37 @@ namespace cpp {
 const std::string BaseEngine::UnknownErrorMsg          = "Unknown Error";
 hebench::APIBridge::ErrorCode BaseEngine::m_last_error = HEBENCH_ECODE_SUCCESS;
 std::string BaseEngine::m_s_last_error_description;
+ErrorRecord BaseEngine::m_last_error_record;
+bool BaseEngine::m_b_last_error_pending = false;
 std::unordered_map<hebench::APIBridge::ErrorCode, std::string> BaseEngine::m_map_error_desc = {
     { HEBENCH_ECODE_SUCCESS, "Success" },
     { HEBENCH_ECODE_INVALID_ARGS, "Invalid argument." },
     { HEBENCH_ECODE_CRITICAL_ERROR, "Critical error." }
 };
 
-BaseEngine::BaseEngine()
+BaseEngine::BaseEngine() :
+    m_live_handles(0),
+    m_live_handles_size(0),
+    m_peak_handles(0),
+    m_peak_handles_size(0),
+    m_thread_pool_size(0),
+    m_b_pin_threads(false),
+    m_spill_directory(SpillStore::defaultDirectory()),
+    m_memory_budget(0),
+    m_tuning_db_filename(TuningDatabase::defaultFilename()),
+    m_benchmark_pool_size(0)
 {
-    //
+}
+
+BaseEngine::BaseEngine(const EngineConfig &config) :
+    BaseEngine()
+{
+    applyConfiguration(config);
+}
+
+BaseEngine::~BaseEngine()
+{
+    clearBenchmarkPool();
 }
 
 const std::string &BaseEngine::getErrorDesc(hebench::APIBridge::ErrorCode err_code)
@@ -41,9 +95,23 @@ const std::string &BaseEngine::getErrorDesc(hebench::APIBridge::ErrorCode err_co
         return it->second;
 }
 
+const std::string &BaseEngine::getLastErrorDesc()
+{
+    if (m_b_last_error_pending)
+    {
+        // format description of last error only when requested
+        if (m_last_error_record.getMessage())
+            m_s_last_error_description = m_last_error_record.format();
+        else
+            m_s_last_error_description = getErrorDesc(m_last_error_record.getErrorCode());
+        m_b_last_error_pending = false;
+    } // end if
+    return m_s_last_error_description;
+}
+
 void BaseEngine::setLastError(hebench::APIBridge::ErrorCode value)
 {
-    setLastError(value, getErrorDesc(value));
+    setLastError(ErrorRecord(value));
 }
 
 void BaseEngine::setLastError(hebench::APIBridge::ErrorCode value,
@@ -51,6 +119,193 @@ void BaseEngine::setLastError(hebench::APIBridge::ErrorCode value,
 {
     m_last_error               = value;
     m_s_last_error_description = err_desc;
+    m_b_last_error_pending     = false;
+}
+
+void BaseEngine::setLastError(const ErrorRecord &record)
+{
+    m_last_error           = record.getErrorCode();
+    m_last_error_record    = record;
+    m_b_last_error_pending = true;
+}
+
+ThreadPool &BaseEngine::threadPool() const
+{
+    std::lock_guard<std::mutex> lock(m_thread_pool_mutex);
+    if (!m_p_thread_pool)
+        m_p_thread_pool.reset(new ThreadPool(m_thread_pool_size, m_b_pin_threads));
+    return *m_p_thread_pool;
+}
+
+void BaseEngine::setThreadPoolSize(std::size_t thread_count)
+{
+    std::lock_guard<std::mutex> lock(m_thread_pool_mutex);
+    if (thread_count != m_thread_pool_size)
+    {
+        m_thread_pool_size = thread_count;
+        m_p_thread_pool.reset(); // recreated on next use
+    } // end if
+}
+
+void BaseEngine::setThreadPinning(bool b_pin_threads)
+{
+    std::lock_guard<std::mutex> lock(m_thread_pool_mutex);
+    if (b_pin_threads != m_b_pin_threads)
+    {
+        m_b_pin_threads = b_pin_threads;
+        m_p_thread_pool.reset(); // recreated on next use
+    } // end if
+}
+
+TuningDatabase &BaseEngine::tuningDatabase() const
+{
+    std::lock_guard<std::mutex> lock(m_tuning_db_mutex);
+    if (!m_p_tuning_db)
+        m_p_tuning_db.reset(new TuningDatabase(m_tuning_db_filename));
+    return *m_p_tuning_db;
+}
+
+void BaseEngine::setTuningDatabaseFilename(const std::string &filename)
+{
+    std::lock_guard<std::mutex> lock(m_tuning_db_mutex);
+    if (filename != m_tuning_db_filename)
+    {
+        m_tuning_db_filename = filename;
+        m_p_tuning_db.reset(); // reopened on next use
+    } // end if
+}
+
+void BaseEngine::setMemoryBudget(std::uint64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(m_spill_store_mutex);
+    m_memory_budget = bytes;
+    if (m_p_spill_store)
+        m_p_spill_store->setBudget(bytes);
+}
+
+SpillStore &BaseEngine::spillStore() const
+{
+    std::lock_guard<std::mutex> lock(m_spill_store_mutex);
+    if (!m_p_spill_store)
+        m_p_spill_store.reset(new SpillStore(m_spill_directory, m_memory_budget));
+    return *m_p_spill_store;
+}
+
+void BaseEngine::setSpillDirectory(const std::string &directory)
+{
+    std::lock_guard<std::mutex> lock(m_spill_store_mutex);
+    if (directory != m_spill_directory)
+    {
+        SpillStore::validateDirectory(directory);
+        // payloads cannot be moved while benchmarks may hold them
+        if (m_p_spill_store)
+            throw HEBenchError(HEBERROR_MSG_CLASS("Cannot move spill store from \"" + m_spill_directory + "\" to \""
+                                                  + directory + "\" once in use."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+        m_spill_directory = directory;
+    } // end if
+}
+
+void BaseEngine::applyConfiguration(const std::int8_t *p_buffer, std::uint64_t size)
+{
+    applyConfiguration(EngineConfig::parse(p_buffer, size));
+}
+
+void BaseEngine::applyConfiguration(const EngineConfig &config)
+{
+    // convert all values before applying any, so that a bad value leaves the engine untouched
+    std::size_t thread_count = config.getUInt64(EngineConfig::KeyThreads, m_thread_pool_size);
+    bool b_pin_threads       = config.getBool(EngineConfig::KeyPinThreads, m_b_pin_threads);
+    std::uint64_t budget     = config.getBytes(EngineConfig::KeyMemoryBudget, m_memory_budget);
+    std::size_t cache_size   = config.getUInt64(EngineConfig::KeyContextCacheSize, m_context_cache.capacity());
+    std::size_t pool_size    = config.getUInt64(EngineConfig::KeyBenchmarkPoolSize, m_benchmark_pool_size);
+    std::string tuning_db    = config.getString(EngineConfig::KeyTuningDatabase, m_tuning_db_filename);
+    std::string spill_dir    = config.getString(EngineConfig::KeySpillDirectory, m_spill_directory);
+
+    // first: the only setter that validates its value, so that a bad directory
+    // leaves the engine untouched
+    setSpillDirectory(spill_dir);
+    setThreadPoolSize(thread_count);
+    setThreadPinning(b_pin_threads);
+    setMemoryBudget(budget);
+    m_context_cache.setCapacity(cache_size);
+    setBenchmarkPoolSize(pool_size);
+    setTuningDatabaseFilename(tuning_db);
+    m_config = config;
+}
+
+hebench::APIBridge::HandleStats BaseEngine::getHandleStats() const
+{
+    hebench::APIBridge::HandleStats retval;
+    retval.live_count = m_live_handles.load(std::memory_order_relaxed);
+    retval.live_size  = m_live_handles_size.load(std::memory_order_relaxed);
+    retval.peak_count = m_peak_handles.load(std::memory_order_relaxed);
+    retval.peak_size  = m_peak_handles_size.load(std::memory_order_relaxed);
+    return retval;
+}
+
+void BaseEngine::resetHandleStatsPeaks()
+{
+    m_peak_handles.store(m_live_handles.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_peak_handles_size.store(m_live_handles_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void BaseEngine::onEngineObjCreated(EngineObject &obj, std::uint64_t handle_size) const
+{
+    obj.m_handle_size = handle_size;
+    if (obj.m_p_arena)
+    {
+        obj.m_p_arena->m_live_handles.fetch_add(1, std::memory_order_relaxed);
+        obj.m_p_arena->m_live_handles_size.fetch_add(handle_size, std::memory_order_relaxed);
+    } // end if
+    updatePeak(m_peak_handles, m_live_handles.fetch_add(1, std::memory_order_relaxed) + 1);
+    updatePeak(m_peak_handles_size, m_live_handles_size.fetch_add(handle_size, std::memory_order_relaxed) + handle_size);
+}
+
+void BaseEngine::onObjDestroyed(const EngineObject *p) const
+{
+    m_live_handles.fetch_sub(1, std::memory_order_relaxed);
+    m_live_handles_size.fetch_sub(p->handleSize(), std::memory_order_relaxed);
+    if (p->m_p_arena)
+    {
+        p->m_p_arena->m_live_handles.fetch_sub(1, std::memory_order_relaxed);
+        p->m_p_arena->m_live_handles_size.fetch_sub(p->handleSize(), std::memory_order_relaxed);
+    } // end if
+}
+
+bool BaseEngine::releaseArenaObj(EngineObject *p)
+{
+    if (!p->m_p_arena)
+        return false;
+    // drop the reference to the wrapped object; memory is reclaimed with the arena
+    p->~EngineObject();
+    return true;
+}
+
+void BaseEngine::onArenaReleased(Arena &arena) const
+{
+    m_live_handles.fetch_sub(arena.m_live_handles.exchange(0, std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+    m_live_handles_size.fetch_sub(arena.m_live_handles_size.exchange(0, std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+}
+
+void BaseEngine::throwInvalidExtraTags()
+{
+    throw HEBenchError(HEBERROR_MSG_CLASS("Invalid 'extra_tags' detected. Most significant 8 bits of tags are reserved."),
+                       HEBENCH_ECODE_CRITICAL_ERROR);
+}
+
+void BaseEngine::throwInvalidHandle(hebench::APIBridge::Handle h, std::int64_t extra_tags)
+{
+    if (!h.p)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Invalid null handle."),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+    if ((h.tag & EngineObject::tag) != EngineObject::tag)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected. Expected EngineObject::tag."),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+    throw HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected. Expected " + std::to_string(extra_tags) + "."),
+                       HEBENCH_ECODE_CRITICAL_ERROR);
 }
 
 std::string BaseEngine::getBenchmarkDescriptionEx(hebench::APIBridge::Handle h_bench_desc,
@@ -66,7 +321,19 @@ std::string BaseEngine::getBenchmarkDescriptionEx(hebench::APIBridge::Handle h_b
 
 void BaseEngine::addBenchmarkDescription(std::shared_ptr<BenchmarkDescription> p_desc)
 {
-    m_descriptors.push_back(p_desc);
+    DescriptionEntry entry;
+    entry.p_description = p_desc;
+    m_descriptors.push_back(std::move(entry));
+}
+
+void BaseEngine::addBenchmarkDescription(BenchmarkDescriptionFactory factory)
+{
+    if (!factory)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Invalid empty benchmark description factory."),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+    DescriptionEntry entry;
+    entry.factory = std::move(factory);
+    m_descriptors.push_back(std::move(entry));
 }
 
 void BaseEngine::addErrorCode(hebench::APIBridge::ErrorCode code, const std::string &description)
@@ -98,7 +365,20 @@ std::shared_ptr<BenchmarkDescription> BaseEngine::matchBenchmark(hebench::APIBri
     std::shared_ptr<BenchmarkDescription> p_retval;
     std::size_t index = (std::size_t)(h_desc.p);
     if (index < m_descriptors.size() && (h_desc.tag & BenchmarkDescription::tag) != 0)
-        p_retval = m_descriptors.at(index);
+    {
+        std::lock_guard<std::mutex> lock(m_descriptors_mutex);
+        DescriptionEntry &entry = m_descriptors.at(index);
+        if (!entry.p_description)
+        {
+            // first use of a description registered through a factory
+            entry.p_description = entry.factory();
+            if (!entry.p_description)
+                throw HEBenchError(HEBERROR_MSG_CLASS("Benchmark description factory returned null."),
+                                   HEBENCH_ECODE_CRITICAL_ERROR);
+            entry.factory = BenchmarkDescriptionFactory();
+        } // end if
+        p_retval = entry.p_description;
+    } // end if
 
     return p_retval;
 }
@@ -119,11 +399,15 @@ void BaseEngine::subscribeBenchmarks(hebench::APIBridge::Handle *p_h_bench_descs
 
     std::uint64_t min_size = std::min(count, static_cast<std::uint64_t>(m_descriptors.size()));
     assert(min_size == static_cast<std::uint64_t>(m_descriptors.size()));
+    std::lock_guard<std::mutex> lock(m_descriptors_mutex);
     for (std::size_t i = 0; i < min_size; ++i)
     {
         p_h_bench_descs[i].p    = (void *)(i);
         p_h_bench_descs[i].size = sizeof(BenchmarkDescription);
-        p_h_bench_descs[i].tag  = m_descriptors[i]->classTag();
+        // avoid creating descriptions that have not been requested yet
+        p_h_bench_descs[i].tag = m_descriptors[i].p_description ?
+                                     m_descriptors[i].p_description->classTag() :
+                                     BenchmarkDescription::tag;
     } // end for
 }
 
@@ -142,7 +426,7 @@ std::uint64_t BaseEngine::getDefaultWorkloadParamsCount(hebench::APIBridge::Hand
     if (!p_bd)
         throw HEBenchError(HEBERROR_MSG_CLASS("Invalid benchmark descriptor not matched."),
                            HEBENCH_ECODE_CRITICAL_ERROR);
-    return p_bd->getWorkloadDefaultParameters().size();
+    return p_bd->getWorkloadDefaultParametersCount();
 }
 
 void BaseEngine::describeBenchmark(hebench::APIBridge::Handle h_bench_desc,
@@ -163,16 +447,16 @@ void BaseEngine::describeBenchmark(hebench::APIBridge::Handle h_bench_desc,
 
     if (p_default_params)
     {
-        // return the default parameters
-        const auto &default_params      = p_bd->getWorkloadDefaultParameters();
-        std::uint64_t min_default_count = std::min<std::uint64_t>(default_count, default_params.size());
-        for (std::size_t i = 0; i < min_default_count; ++i)
+        // return the default parameters: sets in sweeps are expanded as they are copied
+        std::uint64_t param_count       = p_bd->getWorkloadParameterCount();
+        std::uint64_t min_default_count = std::min<std::uint64_t>(default_count, p_bd->getWorkloadDefaultParametersCount());
+        for (std::uint64_t i = 0; i < min_default_count; ++i)
         {
             // all WorkloadParams elements in p_default_params must be pre-allocated by caller.
-            if (p_default_params[i].count < default_params[i].size())
+            if (p_default_params[i].count < param_count)
                 throw HEBenchError(HEBERROR_MSG_CLASS("Insufficient space allocated for default set of parameters: " + std::to_string(i)),
                                    HEBENCH_ECODE_CRITICAL_ERROR);
-            std::copy(default_params[i].begin(), default_params[i].end(), p_default_params[i].params);
+            p_bd->getWorkloadDefaultParameters(i, p_default_params[i].params);
         } // end for
     } // end if
 }
@@ -185,7 +469,9 @@ hebench::APIBridge::Handle BaseEngine::createBenchmark(hebench::APIBridge::Handl
         throw HEBenchError(HEBERROR_MSG_CLASS("Invalid benchmark descriptor not matched."),
                            HEBENCH_ECODE_CRITICAL_ERROR);
 
-    BaseBenchmark *p_bench    = p_bd->createBenchmark(*this, p_params);
+    BaseBenchmark *p_bench = acquirePooledBenchmark(*p_bd, p_params);
+    if (!p_bench)
+        p_bench = p_bd->createBenchmark(*this, p_params);
     BenchmarkHandle *p_bh     = this->template createObj<BenchmarkHandle>();
     p_bh->p_benchmark         = p_bench;
     p_bh->p_bench_description = p_bd.get();
@@ -209,28 +495,156 @@ void BaseEngine::destroyBenchmark(hebench::APIBridge::Handle h_bench)
             throw HEBenchError(HEBERROR_MSG_CLASS("Invalid empty handle."),
                                HEBENCH_ECODE_CRITICAL_ERROR);
 
-        p_bh->p_bench_description->destroyBenchmark(p_bh->p_benchmark);
+        // the benchmark and its handle are destroyed even if any step throws
+        try
+        {
+            try
+            {
+                // handles left in the arena of the benchmark are released with it
+                if (p_bh->p_benchmark->arena())
+                {
+                    if (p_bh->p_benchmark->constantOperandCache())
+                        p_bh->p_benchmark->constantOperandCache()->clear();
+                    onArenaReleased(*p_bh->p_benchmark->arena());
+                } // end if
+            }
+            catch (...)
+            {
+                p_bh->p_bench_description->destroyBenchmark(p_bh->p_benchmark);
+                throw;
+            }
+            // releaseToPool() destroys the benchmark if it throws
+            if (!releaseToPool(*p_bh->p_bench_description, p_bh->p_benchmark))
+                p_bh->p_bench_description->destroyBenchmark(p_bh->p_benchmark);
+        }
+        catch (...)
+        {
+            this->template destroyObj<BenchmarkHandle>(p_bh);
+            throw;
+        }
         this->template destroyObj<BenchmarkHandle>(p_bh);
     } // end if
 }
 
+void BaseEngine::setBenchmarkPoolSize(std::size_t pool_size)
+{
+    std::vector<PooledBenchmark> evicted;
+    {
+        std::lock_guard<std::mutex> lock(m_benchmark_pool_mutex);
+        m_benchmark_pool_size = pool_size;
+        if (m_benchmark_pool.size() > pool_size)
+        {
+            std::size_t excess = m_benchmark_pool.size() - pool_size;
+            evicted.assign(m_benchmark_pool.begin(), m_benchmark_pool.begin() + excess);
+            m_benchmark_pool.erase(m_benchmark_pool.begin(), m_benchmark_pool.begin() + excess);
+        } // end if
+    }
+    for (const PooledBenchmark &pooled : evicted)
+        pooled.p_bench_description->destroyBenchmark(pooled.p_benchmark);
+}
+
+std::size_t BaseEngine::benchmarkPoolSize() const
+{
+    std::lock_guard<std::mutex> lock(m_benchmark_pool_mutex);
+    return m_benchmark_pool_size;
+}
+
+void BaseEngine::clearBenchmarkPool()
+{
+    std::vector<PooledBenchmark> evicted;
+    {
+        std::lock_guard<std::mutex> lock(m_benchmark_pool_mutex);
+        std::swap(evicted, m_benchmark_pool);
+    }
+    for (const PooledBenchmark &pooled : evicted)
+        pooled.p_bench_description->destroyBenchmark(pooled.p_benchmark);
+}
+
+BaseBenchmark *BaseEngine::acquirePooledBenchmark(BenchmarkDescription &bench_desc,
+                                                  const hebench::APIBridge::WorkloadParams *p_params)
+{
+    std::uint64_t param_count = p_params && p_params->params ? p_params->count : 0;
+
+    std::lock_guard<std::mutex> lock(m_benchmark_pool_mutex);
+    // most recently released first
+    for (auto it = m_benchmark_pool.rbegin(); it != m_benchmark_pool.rend(); ++it)
+    {
+        if (it->p_bench_description != &bench_desc)
+            continue;
+        const std::vector<hebench::APIBridge::WorkloadParam> &params = it->p_benchmark->getWorkloadParameters();
+        bool b_match                                                 = params.size() == param_count;
+        for (std::uint64_t i = 0; b_match && i < param_count; ++i)
+            b_match = params[i].data_type == p_params->params[i].data_type
+                      && params[i].u_param == p_params->params[i].u_param; // compare raw bits
+        if (b_match)
+        {
+            BaseBenchmark *retval = it->p_benchmark;
+            m_benchmark_pool.erase(std::next(it).base());
+            return retval;
+        } // end if
+    } // end for
+
+    return nullptr;
+}
+
+bool BaseEngine::releaseToPool(BenchmarkDescription &bench_desc, BaseBenchmark *p_bench)
+{
+    if (benchmarkPoolSize() == 0)
+        return false;
+
+    try
+    {
+        if (!p_bench->reset())
+            return false;
+    }
+    catch (...)
+    {
+        bench_desc.destroyBenchmark(p_bench);
+        throw;
+    }
+    if (p_bench->arena())
+        p_bench->arena()->release();
+
+    PooledBenchmark evicted = { nullptr, nullptr };
+    {
+        std::lock_guard<std::mutex> lock(m_benchmark_pool_mutex);
+        if (m_benchmark_pool_size == 0)
+            return false;
+        if (m_benchmark_pool.size() >= m_benchmark_pool_size)
+        {
+            evicted = m_benchmark_pool.front();
+            m_benchmark_pool.erase(m_benchmark_pool.begin());
+        } // end if
+        try
+        {
+            m_benchmark_pool.push_back(PooledBenchmark{ &bench_desc, p_bench });
+        }
+        catch (...)
+        {
+            // pool could not grow: caller destroys the benchmark
+            return false;
+        }
+    }
+    if (evicted.p_benchmark)
+        evicted.p_bench_description->destroyBenchmark(evicted.p_benchmark);
+
+    return true;
+}
+
 void BaseEngine::checkHandleTags(hebench::APIBridge::Handle h, std::int64_t check_tags) const
 {
-    if ((check_tags & ITaggedObject::MaskReservedBits) != 0)
+    if (HEBENCH_VALIDATE_FULL && (check_tags & ITaggedObject::MaskReservedBits) != 0)
         throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid `check_tags` detected. Most significant 8 bits of tags are reserved."),
                                          HEBENCH_ECODE_CRITICAL_ERROR);
-    if ((h.tag & hebench::cpp::EngineObject::tag) != hebench::cpp::EngineObject::tag)
-        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected. Expected EngineObject::tag."),
-                                         HEBENCH_ECODE_CRITICAL_ERROR);
-    if ((h.tag & check_tags) != check_tags)
-        throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid tag detected. Expected " + std::to_string(check_tags) + "."),
-                                         HEBENCH_ECODE_CRITICAL_ERROR);
+    std::int64_t expected_tags = hebench::cpp::EngineObject::tag | check_tags;
+    if (HEBENCH_VALIDATE_CHEAP && (!h.p || (h.tag & expected_tags) != expected_tags))
+        throwInvalidHandle(h, check_tags);
 }
 
 hebench::APIBridge::Handle BaseEngine::duplicateHandle(hebench::APIBridge::Handle h, std::int64_t new_tags, std::int64_t check_tags) const
 {
     checkHandleTags(h, check_tags);
-    if (new_tags != h.tag && (new_tags & ITaggedObject::MaskReservedBits) != 0)
+    if (HEBENCH_VALIDATE_FULL && new_tags != h.tag && (new_tags & ITaggedObject::MaskReservedBits) != 0)
         throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid `new_tags` detected. Most significant 8 bits of tags are reserved."),
                                          HEBENCH_ECODE_CRITICAL_ERROR);
 
@@ -245,21 +659,29 @@ hebench::APIBridge::Handle BaseEngine::duplicateHandle(hebench::APIBridge::Handl
 
 hebench::APIBridge::Handle BaseEngine::duplicateHandleInternal(hebench::APIBridge::Handle h, std::int64_t new_tag) const
 {
-    if (!h.p)
+    if (HEBENCH_VALIDATE_CHEAP && !h.p)
         throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid null handle."),
                                          HEBENCH_ECODE_CRITICAL_ERROR);
 
     // retrieve our internal format object from the handle
     hebench::cpp::EngineObject *p_obj = reinterpret_cast<hebench::cpp::EngineObject *>(h.p);
     assert(p_obj);
-    if (this != &p_obj->engine())
+    if (HEBENCH_VALIDATE_FULL && this != &p_obj->engine())
         throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Invalid handle. Handle was not created by invoked engine."),
                                          HEBENCH_ECODE_CRITICAL_ERROR);
-    // copy internal object
-    hebench::cpp::EngineObject *p_retval = new EngineObject(*p_obj);
+    // copy internal object, in the same arena as the original, if any
+    hebench::cpp::EngineObject *p_retval;
+    if (p_obj->m_p_arena)
+    {
+        p_retval            = p_obj->m_p_arena->createUntracked<EngineObject>(*p_obj);
+        p_retval->m_p_arena = p_obj->m_p_arena;
+    } // end if
+    else
+        p_retval = new EngineObject(*p_obj);
     if (!p_retval)
         throw hebench::cpp::HEBenchError(HEBERROR_MSG_CLASS("Allocation failed."),
                                          HEBENCH_ECODE_CRITICAL_ERROR);
+    onEngineObjCreated(*p_retval, h.size);
     hebench::APIBridge::Handle retval;
     retval.p    = p_retval;
     retval.size = h.size;
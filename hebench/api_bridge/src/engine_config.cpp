@@ -0,0 +1,391 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+
+#include "hebench/api_bridge/cpp/engine_config.hpp"
+
+namespace hebench {
+namespace cpp {
+
+namespace {
+
+constexpr const char *Separators = " \t\r\n,;";
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+std::string toLower(std::string s)
+{
+    for (char &c : s)
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+/**
+ * @brief Parser for the subset of JSON accepted by EngineConfig.
+ */
+class JsonParser
+{
+public:
+    JsonParser(const std::string &text, std::map<std::string, std::string> &values) :
+        m_text(text),
+        m_pos(0),
+        m_values(values)
+    {
+    }
+
+    void parse()
+    {
+        skipSpaces();
+        parseObject(std::string());
+        skipSpaces();
+        if (m_pos < m_text.size())
+            fail("unexpected characters after configuration object");
+    }
+
+private:
+    [[noreturn]] HEBENCH_COLD void fail(const std::string &reason) const
+    {
+        throw HEBenchError(HEBERROR_MSG("Invalid JSON engine configuration at offset " + std::to_string(m_pos) + ": " + reason + "."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    }
+
+    void skipSpaces()
+    {
+        while (m_pos < m_text.size() && isSpace(m_text[m_pos]))
+            ++m_pos;
+    }
+
+    void expect(char c)
+    {
+        skipSpaces();
+        if (m_pos >= m_text.size() || m_text[m_pos] != c)
+            fail(std::string("expected '") + c + "'");
+        ++m_pos;
+    }
+
+    bool accept(char c)
+    {
+        skipSpaces();
+        if (m_pos < m_text.size() && m_text[m_pos] == c)
+        {
+            ++m_pos;
+            return true;
+        } // end if
+        return false;
+    }
+
+    void parseObject(const std::string &prefix)
+    {
+        expect('{');
+        if (accept('}'))
+            return;
+        do
+        {
+            skipSpaces();
+            std::string key = prefix + parseString();
+            expect(':');
+            parseValue(key);
+        } while (accept(','));
+        expect('}');
+    }
+
+    void parseValue(const std::string &key)
+    {
+        skipSpaces();
+        if (m_pos >= m_text.size())
+            fail("expected value");
+        char c = m_text[m_pos];
+        if (c == '{')
+            parseObject(key + ".");
+        else if (c == '"')
+            m_values[key] = parseString();
+        else if (c == '[')
+            fail("arrays are not supported");
+        else
+        {
+            // numbers and literals are kept as text, converted by the typed getters
+            std::string::size_type end = m_text.find_first_of(" \t\r\n,}]", m_pos);
+            if (end == std::string::npos)
+                end = m_text.size();
+            std::string token = m_text.substr(m_pos, end - m_pos);
+            if (token == "null")
+                m_values.erase(key);
+            else if (token == "true" || token == "false"
+                     || (!token.empty() && token.find_first_not_of("+-.0123456789eE") == std::string::npos))
+                m_values[key] = token;
+            else
+                fail("invalid value");
+            m_pos = end;
+        } // end else
+    }
+
+    std::string parseString()
+    {
+        if (m_pos >= m_text.size() || m_text[m_pos] != '"')
+            fail("expected string");
+        ++m_pos;
+        std::string retval;
+        while (true)
+        {
+            if (m_pos >= m_text.size())
+                fail("unterminated string");
+            char c = m_text[m_pos++];
+            if (c == '"')
+                break;
+            if (c != '\\')
+                retval.push_back(c);
+            else
+            {
+                if (m_pos >= m_text.size())
+                    fail("unterminated string");
+                c = m_text[m_pos++];
+                switch (c)
+                {
+                case '"':
+                case '\\':
+                case '/':
+                    retval.push_back(c);
+                    break;
+                case 'b':
+                    retval.push_back('\b');
+                    break;
+                case 'f':
+                    retval.push_back('\f');
+                    break;
+                case 'n':
+                    retval.push_back('\n');
+                    break;
+                case 'r':
+                    retval.push_back('\r');
+                    break;
+                case 't':
+                    retval.push_back('\t');
+                    break;
+                case 'u':
+                    appendUtf8(retval, parseHex4());
+                    break;
+                default:
+                    fail("invalid escape sequence");
+                } // end switch
+            } // end else
+        } // end while
+        return retval;
+    }
+
+    unsigned int parseHex4()
+    {
+        std::string digits = m_text.substr(m_pos, 4);
+        if (digits.size() < 4 || digits.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos)
+            fail("invalid escape sequence");
+        m_pos += 4;
+        return static_cast<unsigned int>(std::strtoul(digits.c_str(), nullptr, 16));
+    }
+
+    static void appendUtf8(std::string &s, unsigned int code_point)
+    {
+        // surrogate pairs are not combined: configuration keys and values are expected in ASCII
+        if (code_point < 0x80)
+            s.push_back(static_cast<char>(code_point));
+        else if (code_point < 0x800)
+        {
+            s.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+            s.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } // end else if
+        else
+        {
+            s.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+            s.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            s.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } // end else
+    }
+
+    const std::string &m_text;
+    std::string::size_type m_pos;
+    std::map<std::string, std::string> &m_values;
+};
+
+void parseKeyValues(const std::string &text, std::map<std::string, std::string> &values)
+{
+    std::string::size_type pos = 0;
+    while (pos < text.size())
+    {
+        std::string::size_type end = text.find_first_of(Separators, pos);
+        if (end == std::string::npos)
+            end = text.size();
+        std::string::size_type eq = text.find('=', pos);
+        if (eq < end && eq > pos)
+        {
+            std::string key = text.substr(pos, eq - pos);
+            if (eq + 1 < text.size() && text[eq + 1] == '"')
+            {
+                // quoted value: runs up to the closing quote, separators included
+                std::string::size_type close = text.find('"', eq + 2);
+                if (close == std::string::npos)
+                    close = text.size();
+                values[key] = text.substr(eq + 2, close - eq - 2);
+                end         = std::min(close + 1, text.size());
+            } // end if
+            else
+                values[key] = text.substr(eq + 1, end - eq - 1);
+        } // end if
+        pos = end + 1;
+    } // end while
+}
+
+} // namespace
+
+//--------------------
+// class EngineConfig
+//--------------------
+
+constexpr const char *EngineConfig::KeyThreads;
+constexpr const char *EngineConfig::KeyPinThreads;
+constexpr const char *EngineConfig::KeyMemoryBudget;
+constexpr const char *EngineConfig::KeyContextCacheSize;
+constexpr const char *EngineConfig::KeyBenchmarkPoolSize;
+constexpr const char *EngineConfig::KeyTuningDatabase;
+constexpr const char *EngineConfig::KeySpillDirectory;
+
+EngineConfig EngineConfig::parse(const std::string &text)
+{
+    EngineConfig retval;
+    std::string::size_type first = text.find_first_not_of(" \t\r\n");
+    if (first != std::string::npos && text[first] == '{')
+        JsonParser(text, retval.m_values).parse();
+    else
+        parseKeyValues(text, retval.m_values);
+    return retval;
+}
+
+EngineConfig EngineConfig::parse(const std::int8_t *p_buffer, std::uint64_t size)
+{
+    if (!p_buffer)
+        size = 0;
+    const char *p_text = reinterpret_cast<const char *>(p_buffer);
+    while (size > 0 && p_text[size - 1] == '\0')
+        --size;
+    return size > 0 ? parse(std::string(p_text, size)) : EngineConfig();
+}
+
+std::vector<std::string> EngineConfig::keys() const
+{
+    std::vector<std::string> retval;
+    retval.reserve(m_values.size());
+    for (const auto &item : m_values)
+        retval.push_back(item.first);
+    return retval;
+}
+
+void EngineConfig::throwInvalidValue(const std::string &key, const std::string &expected) const
+{
+    throw HEBenchError(HEBERROR_MSG_CLASS("Invalid value \"" + m_values.at(key) + "\" for configuration key \""
+                                          + key + "\": expected " + expected + "."),
+                       HEBENCH_ECODE_INVALID_ARGS);
+}
+
+std::string EngineConfig::getString(const std::string &key, const std::string &default_value) const
+{
+    auto it = m_values.find(key);
+    return it == m_values.end() ? default_value : it->second;
+}
+
+std::uint64_t EngineConfig::getUInt64(const std::string &key, std::uint64_t default_value) const
+{
+    auto it = m_values.find(key);
+    if (it == m_values.end())
+        return default_value;
+    const std::string &value  = it->second;
+    char *p_end               = nullptr;
+    errno                     = 0;
+    unsigned long long retval = std::strtoull(value.c_str(), &p_end, 10);
+    if (value.empty() || !std::isdigit(static_cast<unsigned char>(value.front())) || *p_end != '\0' || errno == ERANGE)
+        throwInvalidValue(key, "unsigned integer");
+    return static_cast<std::uint64_t>(retval);
+}
+
+std::int64_t EngineConfig::getInt64(const std::string &key, std::int64_t default_value) const
+{
+    auto it = m_values.find(key);
+    if (it == m_values.end())
+        return default_value;
+    const std::string &value = it->second;
+    char *p_end              = nullptr;
+    errno                    = 0;
+    long long retval         = std::strtoll(value.c_str(), &p_end, 10);
+    if (value.empty() || isSpace(value.front()) || *p_end != '\0' || errno == ERANGE)
+        throwInvalidValue(key, "integer");
+    return static_cast<std::int64_t>(retval);
+}
+
+double EngineConfig::getDouble(const std::string &key, double default_value) const
+{
+    auto it = m_values.find(key);
+    if (it == m_values.end())
+        return default_value;
+    const std::string &value = it->second;
+    char *p_end              = nullptr;
+    double retval            = std::strtod(value.c_str(), &p_end);
+    if (value.empty() || isSpace(value.front()) || *p_end != '\0')
+        throwInvalidValue(key, "number");
+    return retval;
+}
+
+bool EngineConfig::getBool(const std::string &key, bool default_value) const
+{
+    auto it = m_values.find(key);
+    if (it == m_values.end())
+        return default_value;
+    std::string value = toLower(it->second);
+    if (value == "true" || value == "yes" || value == "on" || value == "1")
+        return true;
+    if (value == "false" || value == "no" || value == "off" || value == "0")
+        return false;
+    throwInvalidValue(key, "boolean");
+}
+
+std::uint64_t EngineConfig::getBytes(const std::string &key, std::uint64_t default_value) const
+{
+    auto it = m_values.find(key);
+    if (it == m_values.end())
+        return default_value;
+    const std::string &value = it->second;
+
+    std::string::size_type unit_pos = value.find_first_not_of("0123456789");
+    if (unit_pos == 0 || value.empty())
+        throwInvalidValue(key, "amount of bytes");
+    std::string unit = toLower(value.substr(unit_pos == std::string::npos ? value.size() : unit_pos));
+    if (unit.size() > 1 && (unit.substr(1) == "b" || unit.substr(1) == "ib"))
+        unit.resize(1);
+
+    unsigned int shift;
+    if (unit.empty() || unit == "b")
+        shift = 0;
+    else if (unit == "k")
+        shift = 10;
+    else if (unit == "m")
+        shift = 20;
+    else if (unit == "g")
+        shift = 30;
+    else if (unit == "t")
+        shift = 40;
+    else
+        throwInvalidValue(key, "amount of bytes");
+
+    errno                    = 0;
+    unsigned long long count = std::strtoull(value.c_str(), nullptr, 10);
+    if (errno == ERANGE || count > (std::numeric_limits<std::uint64_t>::max() >> shift))
+        throwInvalidValue(key, "amount of bytes that fits in 64 bits");
+    return static_cast<std::uint64_t>(count) << shift;
+}
+
+} // namespace cpp
+} // namespace hebench
@@ -40,5 +40,43 @@ std::string HEBenchError::generateMessage(const std::string &message,
     return ss_retval.str();
 }
 
+std::string ErrorRecord::format() const
+{
+    return HEBenchError::generateMessage(m_message ? m_message : std::string(),
+                                         m_function ? m_function : std::string(),
+                                         m_container ? m_container : std::string(),
+                                         m_filename ? m_filename : std::string(),
+                                         m_filename ? m_line_no : -1);
+}
+
+std::string ErrorRecord::format(std::initializer_list<std::uint64_t> values) const
+{
+    if (!m_message || values.size() == 0)
+        return format();
+
+    std::stringstream ss;
+    auto it_value = values.begin();
+    for (const char *p = m_message; *p; ++p)
+    {
+        if (p[0] == '{' && p[1] == '}' && it_value != values.end())
+        {
+            ss << *it_value++;
+            ++p;
+        } // end if
+        else
+            ss << *p;
+    } // end for
+    return HEBenchError::generateMessage(ss.str(),
+                                         m_function ? m_function : std::string(),
+                                         m_container ? m_container : std::string(),
+                                         m_filename ? m_filename : std::string(),
+                                         m_filename ? m_line_no : -1);
+}
+
+void ErrorRecord::raise(std::initializer_list<std::uint64_t> values) const
+{
+    throw HEBenchError(format(values), m_err_code);
+}
+
 } // namespace cpp
 } // namespace hebench
@@ -2,6 +2,7 @@
 // Copyright (C) 2021 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <atomic>
 #include <cstring>
 #include <stdexcept>
 
@@ -24,64 +25,121 @@ bool checkHandleBits(const Handle &h, std::int64_t tag)
     return (h.p != nullptr) && ((h.tag & tag) == tag);
 }
 
-ErrorCode destroyHandle(Handle h)
+bool checkDataPacks(const DataPackCollection &packs)
 {
-    ErrorCode retval = HEBENCH_ECODE_SUCCESS;
-
-    try
+    // every pack and buffer with content must point to it
+    if (!packs.p_data_packs)
+        return packs.pack_count == 0;
+    for (std::uint64_t pack_i = 0; pack_i < packs.pack_count; ++pack_i)
     {
-        if (h.p)
+        const DataPack &pack = packs.p_data_packs[pack_i];
+        if (!pack.p_buffers)
         {
-            if (checkHandleBits(h, BaseBenchmark::tag | BenchmarkDescription::tag))
-            {
-                BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h.p);
-                BaseEngine &engine    = p_bh->p_benchmark->getEngine();
-                engine.destroyBenchmark(h);
-            } // end if
-            else if (checkHandleBits(h, EngineObject::tag))
-            {
-                EngineObject *p_obj      = reinterpret_cast<EngineObject *>(h.p);
-                const BaseEngine &engine = p_obj->engine();
-                engine.destroyObj<EngineObject>(p_obj);
-            } // end else if
-            else
-            {
-                // check for exact matches
-                switch (h.tag)
-                {
-                case BaseEngine::tag:
-                {
-                    BaseEngine *p_engine = reinterpret_cast<BaseEngine *>(h.p);
-                    destroyEngine(p_engine);
-                }
-                break;
-                case BenchmarkDescription::tag:
-                    // A handle for BenchmarkDescription is just an index inside the
-                    // vector of descriptions, so, it does not need to be released.
-                    break;
-
-                default:
-                    throw HEBenchError(HEBERROR_MSG("Invalid tag in handle."),
-                                       HEBENCH_ECODE_CRITICAL_ERROR);
-                    break;
-                } // end switch
-            } // end else
+            if (pack.buffer_count > 0)
+                return false;
         } // end if
-    }
-    catch (HEBenchError &hebench_err)
+        else
+        {
+            for (std::uint64_t buffer_i = 0; buffer_i < pack.buffer_count; ++buffer_i)
+                if (pack.p_buffers[buffer_i].size > 0 && !pack.p_buffers[buffer_i].p)
+                    return false;
+        } // end else
+    } // end for
+    return true;
+}
+
+bool checkHandles(const Handle *p_handles, std::uint64_t count)
+{
+    for (std::uint64_t i = 0; i < count; ++i)
+        if (!p_handles[i].p)
+            return false;
+    return true;
+}
+
+void drainEnvironmentTrace() noexcept
+{
+    // deliver the trace requested through the environment, if any: the first drain
+    // of the process overwrites the file, and drains of later engines append to it
+    static std::atomic<bool> b_drained(false);
+    try
     {
-        retval = hebench_err.getErrorCode();
-        BaseEngine::setLastError(hebench_err.getErrorCode(), hebench_err.what());
+        if (Tracer::isEnabled() && !Tracer::environmentFilename().empty())
+            Tracer::drainToFile(Tracer::environmentFilename(), b_drained.exchange(true));
     }
-    catch (std::exception &ex)
+    catch (...)
     {
-        retval = HEBENCH_ECODE_CRITICAL_ERROR;
-        BaseEngine::setLastError(retval, ex.what());
+        // the trace is a diagnostic: losing it must not fail the call
     }
-    catch (...)
+}
+
+ErrorCode destroyHandle(Handle h)
+{
+    ErrorCode retval        = HEBENCH_ECODE_SUCCESS;
+    bool b_engine_destroyed = false;
     {
-        retval = HEBENCH_ECODE_CRITICAL_ERROR;
+        TraceScope trace(TraceEvent::DestroyHandle, h, retval);
+
+        try
+        {
+            if (h.p)
+            {
+                if (checkHandleBits(h, BaseBenchmark::tag | BenchmarkDescription::tag))
+                {
+                    BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h.p);
+                    BaseEngine &engine    = p_bh->p_benchmark->getEngine();
+                    engine.destroyBenchmark(h);
+                } // end if
+                else if (checkHandleBits(h, EngineObject::tag))
+                {
+                    EngineObject *p_obj      = reinterpret_cast<EngineObject *>(h.p);
+                    const BaseEngine &engine = p_obj->engine();
+                    engine.destroyObj<EngineObject>(p_obj);
+                } // end else if
+                else
+                {
+                    // check for exact matches
+                    switch (h.tag)
+                    {
+                    case BaseEngine::tag:
+                    {
+                        BaseEngine *p_engine = reinterpret_cast<BaseEngine *>(h.p);
+                        // pooled benchmarks may depend on the derived engine
+                        p_engine->clearBenchmarkPool();
+                        destroyEngine(p_engine);
+                        b_engine_destroyed = true;
+                    }
+                    break;
+                    case BenchmarkDescription::tag:
+                        // A handle for BenchmarkDescription is just an index inside the
+                        // vector of descriptions, so, it does not need to be released.
+                        break;
+
+                    default:
+                        throw HEBenchError(HEBERROR_MSG("Invalid tag in handle."),
+                                           HEBENCH_ECODE_CRITICAL_ERROR);
+                        break;
+                    } // end switch
+                } // end else
+            } // end if
+        }
+        catch (HEBenchError &hebench_err)
+        {
+            retval = hebench_err.getErrorCode();
+            BaseEngine::setLastError(hebench_err.getErrorCode(), hebench_err.what());
+        }
+        catch (std::exception &ex)
+        {
+            retval = HEBENCH_ECODE_CRITICAL_ERROR;
+            BaseEngine::setLastError(retval, ex.what());
+        }
+        catch (...)
+        {
+            retval = HEBENCH_ECODE_CRITICAL_ERROR;
+        }
     }
+    // drained once the scope above records the exit of this call
+    if (b_engine_destroyed)
+        drainEnvironmentTrace();
 
     return retval;
 }
@@ -89,14 +147,30 @@ ErrorCode destroyHandle(Handle h)
 ErrorCode initEngine(Handle *h_engine, const int8_t *p_buffer, uint64_t size)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::InitEngine, Handle(), retval, h_engine);
 
     try
     {
-        if (!h_engine)
+        if (HEBENCH_VALIDATE_CHEAP && !h_engine)
             throw HEBenchError(HEBERROR_MSG("Invalid null handle 'h_engine'."),
                                HEBENCH_ECODE_CRITICAL_ERROR);
 
+        // a malformed buffer fails before the engine exists
+        EngineConfig config  = EngineConfig::parse(p_buffer, size);
         BaseEngine *p_engine = createEngine(p_buffer, size);
+        // engines constructed without the configuration receive it now
+        if (p_engine->configuration().empty() && !config.empty())
+        {
+            try
+            {
+                p_engine->applyConfiguration(config);
+            }
+            catch (...)
+            {
+                destroyEngine(p_engine);
+                throw;
+            }
+        } // end if
         h_engine->p          = p_engine;
         h_engine->size       = sizeof(BaseEngine);
         h_engine->tag        = p_engine->classTag();
@@ -122,13 +196,14 @@ ErrorCode initEngine(Handle *h_engine, const int8_t *p_buffer, uint64_t size)
 ErrorCode subscribeBenchmarksCount(Handle h_engine, std::uint64_t *p_count)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::SubscribeBenchmarksCount, h_engine, retval);
 
     try
     {
-        if (!checkHandleBits(h_engine, BaseEngine::tag))
+        if (HEBENCH_VALIDATE_CHEAP && !checkHandleBits(h_engine, BaseEngine::tag))
             throw HEBenchError(HEBERROR_MSG("Invalid handle: h_engine"),
                                HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!p_count)
+        if (HEBENCH_VALIDATE_CHEAP && !p_count)
             throw HEBenchError(HEBERROR_MSG("Invalid null parameter: p_count"),
                                HEBENCH_ECODE_CRITICAL_ERROR);
 
@@ -156,13 +231,14 @@ ErrorCode subscribeBenchmarksCount(Handle h_engine, std::uint64_t *p_count)
 ErrorCode subscribeBenchmarks(Handle h_engine, Handle *p_h_bench_descs, std::uint64_t count)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::SubscribeBenchmarks, h_engine, retval);
 
     try
     {
-        if (!checkHandleBits(h_engine, BaseEngine::tag))
+        if (HEBENCH_VALIDATE_CHEAP && !checkHandleBits(h_engine, BaseEngine::tag))
             throw HEBenchError(HEBERROR_MSG("Invalid handle: h_engine"),
                                HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!p_h_bench_descs)
+        if (HEBENCH_VALIDATE_CHEAP && !p_h_bench_descs)
             throw HEBenchError(HEBERROR_MSG("Invalid null parameter: p_bench_descs"),
                                HEBENCH_ECODE_CRITICAL_ERROR);
 
@@ -193,16 +269,17 @@ ErrorCode getWorkloadParamsDetails(Handle h_engine,
                                    std::uint64_t *p_default_count)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::GetWorkloadParamsDetails, h_bench_desc, retval);
 
     try
     {
-        if (!checkHandleBits(h_engine, BaseEngine::tag))
+        if (HEBENCH_VALIDATE_CHEAP && !checkHandleBits(h_engine, BaseEngine::tag))
             throw HEBenchError(HEBERROR_MSG("Invalid handle: h_engine"),
                                HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!p_param_count)
+        if (HEBENCH_VALIDATE_CHEAP && !p_param_count)
             throw HEBenchError(HEBERROR_MSG("Invalid null parameter: p_param_count"),
                                HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!p_default_count)
+        if (HEBENCH_VALIDATE_CHEAP && !p_default_count)
             throw HEBenchError(HEBERROR_MSG("Invalid null parameter: p_default_count"),
                                HEBENCH_ECODE_CRITICAL_ERROR);
 
@@ -235,13 +312,14 @@ ErrorCode describeBenchmark(Handle h_engine,
                             std::uint64_t default_count)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::DescribeBenchmark, h_bench_desc, retval);
 
     try
     {
-        if (!checkHandleBits(h_engine, BaseEngine::tag))
+        if (HEBENCH_VALIDATE_CHEAP && !checkHandleBits(h_engine, BaseEngine::tag))
             throw HEBenchError(HEBERROR_MSG("Invalid handle: h_engine"),
                                HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!p_bench_desc)
+        if (HEBENCH_VALIDATE_CHEAP && !p_bench_desc)
             throw HEBenchError(HEBERROR_MSG("Invalid null parameter: p_bench_desc"),
                                HEBENCH_ECODE_CRITICAL_ERROR);
 
@@ -272,13 +350,14 @@ ErrorCode createBenchmark(Handle h_engine,
                           Handle *h_benchmark)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::CreateBenchmark, h_bench_desc, retval, h_benchmark);
 
     try
     {
-        if (!checkHandleBits(h_engine, BaseEngine::tag))
+        if (HEBENCH_VALIDATE_CHEAP && !checkHandleBits(h_engine, BaseEngine::tag))
             throw HEBenchError(HEBERROR_MSG("Invalid handle: h_engine"),
                                HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_benchmark)
+        if (HEBENCH_VALIDATE_CHEAP && !h_benchmark)
             throw HEBenchError(HEBERROR_MSG("Invalid null handle: h_benchmark"),
                                HEBENCH_ECODE_CRITICAL_ERROR);
 
@@ -307,18 +386,21 @@ ErrorCode initBenchmark(Handle h_benchmark,
                         const BenchmarkDescriptor *p_concrete_desc)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::InitBenchmark, h_benchmark, retval);
 
     try
     {
-        if (!h_benchmark.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_benchmark'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!p_concrete_desc)
-            throw HEBenchError(HEBERROR_MSG("Invalid null benchmark descriptor 'p_concrete_desc'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-
-        BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
-        p_bh->p_benchmark->initialize(*p_concrete_desc);
+        if (HEBENCH_VALIDATE_CHEAP && !h_benchmark.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_benchmark'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !p_concrete_desc)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null benchmark descriptor 'p_concrete_desc'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else
+        {
+            BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
+            retval                = p_bh->p_benchmark->tryInitialize(*p_concrete_desc);
+        } // end else
     }
     catch (HEBenchError &hebench_err)
     {
@@ -341,21 +423,27 @@ ErrorCode initBenchmark(Handle h_benchmark,
 ErrorCode encode(Handle h_benchmark, const DataPackCollection *p_parameters, Handle *h_plaintext)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::Encode, h_benchmark, retval, h_plaintext);
 
     try
     {
-        if (!h_benchmark.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_benchmark'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!p_parameters || (p_parameters->pack_count > 0 && !p_parameters->p_data_packs))
-            throw HEBenchError(HEBERROR_MSG("Invalid null packed data 'p_parameters'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_plaintext)
-            throw HEBenchError(HEBERROR_MSG("Invalid null handle 'h_plaintext'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-
-        BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
-        *h_plaintext          = p_bh->p_benchmark->encode(p_parameters);
+        if (HEBENCH_VALIDATE_CHEAP && !h_benchmark.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_benchmark'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && (!p_parameters || (p_parameters->pack_count > 0 && !p_parameters->p_data_packs)))
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null packed data 'p_parameters'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_FULL && !checkDataPacks(*p_parameters))
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null buffers in packed data 'p_parameters'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_plaintext)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null handle 'h_plaintext'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else
+        {
+            BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
+            retval                = p_bh->p_benchmark->tryEncode(p_parameters, h_plaintext);
+        } // end else
     }
     catch (HEBenchError &hebench_err)
     {
@@ -378,21 +466,27 @@ ErrorCode encode(Handle h_benchmark, const DataPackCollection *p_parameters, Han
 ErrorCode decode(Handle h_benchmark, Handle h_plaintext, DataPackCollection *p_native)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::Decode, h_plaintext, retval);
 
     try
     {
-        if (!h_benchmark.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_benchmark'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_plaintext.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_plaintext'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!p_native)
-            throw HEBenchError(HEBERROR_MSG("Invalid null argument 'p_native'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-
-        BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
-        p_bh->p_benchmark->decode(h_plaintext, p_native);
+        if (HEBENCH_VALIDATE_CHEAP && !h_benchmark.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_benchmark'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_plaintext.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_plaintext'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !p_native)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null argument 'p_native'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_FULL && !checkDataPacks(*p_native))
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null buffers in argument 'p_native'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else
+        {
+            BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
+            retval                = p_bh->p_benchmark->tryDecode(h_plaintext, p_native);
+        } // end else
     }
     catch (HEBenchError &hebench_err)
     {
@@ -415,21 +509,24 @@ ErrorCode decode(Handle h_benchmark, Handle h_plaintext, DataPackCollection *p_n
 ErrorCode encrypt(Handle h_benchmark, Handle h_plaintext, Handle *h_ciphertext)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::Encrypt, h_plaintext, retval, h_ciphertext);
 
     try
     {
-        if (!h_benchmark.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_benchmark'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_plaintext.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_plaintext'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_ciphertext)
-            throw HEBenchError(HEBERROR_MSG("Invalid null handle 'h_ciphertext'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-
-        BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
-        *h_ciphertext         = p_bh->p_benchmark->encrypt(h_plaintext);
+        if (HEBENCH_VALIDATE_CHEAP && !h_benchmark.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_benchmark'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_plaintext.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_plaintext'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_ciphertext)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null handle 'h_ciphertext'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else
+        {
+            BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
+            retval                = p_bh->p_benchmark->tryEncrypt(h_plaintext, h_ciphertext);
+        } // end else
     }
     catch (HEBenchError &hebench_err)
     {
@@ -452,21 +549,24 @@ ErrorCode encrypt(Handle h_benchmark, Handle h_plaintext, Handle *h_ciphertext)
 ErrorCode decrypt(Handle h_benchmark, Handle h_ciphertext, Handle *h_plaintext)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::Decrypt, h_ciphertext, retval, h_plaintext);
 
     try
     {
-        if (!h_benchmark.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_benchmark'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_ciphertext.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_ciphertext'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_plaintext)
-            throw HEBenchError(HEBERROR_MSG("Invalid null handle 'h_plaintext'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-
-        BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
-        *h_plaintext          = p_bh->p_benchmark->decrypt(h_ciphertext);
+        if (HEBENCH_VALIDATE_CHEAP && !h_benchmark.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_benchmark'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_ciphertext.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_ciphertext'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_plaintext)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null handle 'h_plaintext'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else
+        {
+            BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
+            retval                = p_bh->p_benchmark->tryDecrypt(h_ciphertext, h_plaintext);
+        } // end else
     }
     catch (HEBenchError &hebench_err)
     {
@@ -491,24 +591,30 @@ ErrorCode load(Handle h_benchmark,
                Handle *h_remote_packed_params)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::Load, h_benchmark, retval, h_remote_packed_params);
 
     try
     {
-        if (!h_benchmark.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_benchmark'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_local_packed_params)
-            throw HEBenchError(HEBERROR_MSG("Invalid null array 'h_locals'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (local_count <= 0)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty array 'h_locals': 'local_count' must not be zero."),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_remote_packed_params)
-            throw HEBenchError(HEBERROR_MSG("Invalid null handle 'h_remote'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-
-        BenchmarkHandle *p_bh   = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
-        *h_remote_packed_params = p_bh->p_benchmark->load(h_local_packed_params, local_count);
+        if (HEBENCH_VALIDATE_CHEAP && !h_benchmark.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_benchmark'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_local_packed_params)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null array 'h_locals'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && local_count <= 0)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty array 'h_locals': 'local_count' must not be zero.",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_FULL && !checkHandles(h_local_packed_params, local_count))
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle in array 'h_locals'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_remote_packed_params)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null handle 'h_remote'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else
+        {
+            BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
+            retval                = p_bh->p_benchmark->tryLoad(h_local_packed_params, local_count, h_remote_packed_params);
+        } // end else
     }
     catch (HEBenchError &hebench_err)
     {
@@ -533,21 +639,24 @@ ErrorCode store(Handle h_benchmark,
                 Handle *h_local_packed_params, std::uint64_t local_count)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::Store, h_remote, retval);
 
     try
     {
-        if (!h_benchmark.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_benchmark'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_remote.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_remote'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_local_packed_params)
-            throw HEBenchError(HEBERROR_MSG("Invalid null argument 'h_local_packed_params'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-
-        BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
-        p_bh->p_benchmark->store(h_remote, h_local_packed_params, local_count);
+        if (HEBENCH_VALIDATE_CHEAP && !h_benchmark.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_benchmark'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_remote.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_remote'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_local_packed_params)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null argument 'h_local_packed_params'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else
+        {
+            BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
+            retval                = p_bh->p_benchmark->tryStore(h_remote, h_local_packed_params, local_count);
+        } // end else
     }
     catch (HEBenchError &hebench_err)
     {
@@ -574,24 +683,27 @@ ErrorCode operate(Handle h_benchmark,
                   Handle *h_remote_output)
 {
     ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::Operate, h_remote_packed_params, retval, h_remote_output);
 
     try
     {
-        if (!h_benchmark.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_benchmark'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_remote_packed_params.p)
-            throw HEBenchError(HEBERROR_MSG("Invalid empty handle 'h_remote_packed_params'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!p_param_indexers)
-            throw HEBenchError(HEBERROR_MSG("Invalid null argument 'p_param_indexers'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-        if (!h_remote_output)
-            throw HEBenchError(HEBERROR_MSG("Invalid null argument 'h_remote_output'"),
-                               HEBENCH_ECODE_CRITICAL_ERROR);
-
-        BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
-        *h_remote_output      = p_bh->p_benchmark->operate(h_remote_packed_params, p_param_indexers, indexers_count);
+        if (HEBENCH_VALIDATE_CHEAP && !h_benchmark.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_benchmark'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_remote_packed_params.p)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid empty handle 'h_remote_packed_params'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !p_param_indexers)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null argument 'p_param_indexers'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else if (HEBENCH_VALIDATE_CHEAP && !h_remote_output)
+            retval = BaseEngine::reportError(HEBERROR_RECORD("Invalid null argument 'h_remote_output'",
+                                                             HEBENCH_ECODE_CRITICAL_ERROR));
+        else
+        {
+            BenchmarkHandle *p_bh = reinterpret_cast<BenchmarkHandle *>(h_benchmark.p);
+            retval                = p_bh->p_benchmark->tryOperate(h_remote_packed_params, p_param_indexers, indexers_count, h_remote_output);
+        } // end else
     }
     catch (HEBenchError &hebench_err)
     {
@@ -614,10 +726,11 @@ ErrorCode operate(Handle h_benchmark,
 std::uint64_t getSchemeName(Handle h_engine, Scheme s, char *p_name, std::uint64_t size)
 {
     std::uint64_t retval = 0;
+    TraceScope trace(TraceEvent::GetSchemeName, h_engine);
 
     try
     {
-        if (!checkHandleBits(h_engine, BaseEngine::tag))
+        if (HEBENCH_VALIDATE_CHEAP && !checkHandleBits(h_engine, BaseEngine::tag))
             throw std::invalid_argument("h_engine");
 
         BaseEngine *p_engine = reinterpret_cast<BaseEngine *>(h_engine.p);
@@ -648,10 +761,11 @@ std::uint64_t getSchemeSecurityName(Handle h_engine, Scheme s, Security sec,
 {
     (void)s;
     std::uint64_t retval = 0;
+    TraceScope trace(TraceEvent::GetSchemeSecurityName, h_engine);
 
     try
     {
-        if (!checkHandleBits(h_engine, BaseEngine::tag))
+        if (HEBENCH_VALIDATE_CHEAP && !checkHandleBits(h_engine, BaseEngine::tag))
             throw std::invalid_argument("h_engine");
 
         BaseEngine *p_engine = reinterpret_cast<BaseEngine *>(h_engine.p);
@@ -683,10 +797,11 @@ std::uint64_t getBenchmarkDescriptionEx(Handle h_engine,
                                         char *p_description, std::uint64_t size)
 {
     std::uint64_t retval = 0;
+    TraceScope trace(TraceEvent::GetBenchmarkDescriptionEx, h_bench_desc);
 
     try
     {
-        if (!checkHandleBits(h_engine, BaseEngine::tag))
+        if (HEBENCH_VALIDATE_CHEAP && !checkHandleBits(h_engine, BaseEngine::tag))
             throw std::invalid_argument("h_engine");
 
         BaseEngine *p_engine = reinterpret_cast<BaseEngine *>(h_engine.p);
@@ -714,8 +829,8 @@ std::uint64_t getBenchmarkDescriptionEx(Handle h_engine,
 
 std::uint64_t getErrorDescription(Handle h_engine, ErrorCode code, char *p_description, std::uint64_t size)
 {
-    (void)h_engine; // not needed
     std::uint64_t retval = 0;
+    TraceScope trace(TraceEvent::GetErrorDescription, h_engine);
 
     try
     {
@@ -741,6 +856,7 @@ std::uint64_t getErrorDescription(Handle h_engine, ErrorCode code, char *p_descr
 std::uint64_t getLastErrorDescription(Handle h_engine, char *p_description, std::uint64_t size)
 {
     std::uint64_t retval = 0;
+    TraceScope trace(TraceEvent::GetLastErrorDescription, h_engine);
 
     try
     {
@@ -765,5 +881,40 @@ std::uint64_t getLastErrorDescription(Handle h_engine, char *p_description, std:
     return retval;
 }
 
+ErrorCode getHandleStats(Handle h_engine, HandleStats *p_stats)
+{
+    ErrorCode retval = HEBENCH_ECODE_SUCCESS;
+    TraceScope trace(TraceEvent::GetHandleStats, h_engine, retval);
+
+    try
+    {
+        if (HEBENCH_VALIDATE_CHEAP && !checkHandleBits(h_engine, BaseEngine::tag))
+            throw HEBenchError(HEBERROR_MSG("Invalid handle: h_engine"),
+                               HEBENCH_ECODE_CRITICAL_ERROR);
+        if (HEBENCH_VALIDATE_CHEAP && !p_stats)
+            throw HEBenchError(HEBERROR_MSG("Invalid null parameter: p_stats"),
+                               HEBENCH_ECODE_CRITICAL_ERROR);
+
+        BaseEngine *p_engine = reinterpret_cast<BaseEngine *>(h_engine.p);
+        *p_stats             = p_engine->getHandleStats();
+    }
+    catch (HEBenchError &hebench_err)
+    {
+        retval = hebench_err.getErrorCode();
+        BaseEngine::setLastError(hebench_err.getErrorCode(), hebench_err.what());
+    }
+    catch (std::exception &ex)
+    {
+        retval = HEBENCH_ECODE_CRITICAL_ERROR;
+        BaseEngine::setLastError(retval, ex.what());
+    }
+    catch (...)
+    {
+        retval = HEBENCH_ECODE_CRITICAL_ERROR;
+    }
+
+    return retval;
+}
+
 } // namespace APIBridge
 } // namespace hebench
@@ -0,0 +1,422 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "hebench/api_bridge/cpp/parameter_sweep.hpp"
+
+namespace hebench {
+namespace cpp {
+
+namespace {
+
+// relative tolerance for the last value of floating point progressions, so that
+// `0.1:0.3:0.1` includes 0.3
+constexpr double FloatTolerance = 1e-9;
+
+std::string trim(const std::string &s)
+{
+    static const char *whitespace = " \t\r\n";
+    std::size_t first             = s.find_first_not_of(whitespace);
+    if (first == std::string::npos)
+        return std::string();
+    return s.substr(first, s.find_last_not_of(whitespace) - first + 1);
+}
+
+std::vector<std::string> split(const std::string &s, char delimiter)
+{
+    std::vector<std::string> retval;
+    std::stringstream ss(s);
+    std::string token;
+    while (std::getline(ss, token, delimiter))
+        retval.push_back(trim(token));
+    if (!s.empty() && s.back() == delimiter)
+        retval.push_back(std::string());
+    return retval;
+}
+
+} // namespace
+
+//----------------------
+// class ParameterSweep
+//----------------------
+
+ParameterSweep::ParameterSweep(hebench::APIBridge::WorkloadParamType::WorkloadParamType type, std::vector<Value> values) :
+    m_kind(Kind::Values),
+    m_type(type),
+    m_count(values.size()),
+    m_values(std::move(values))
+{
+    if (m_values.empty())
+        throw HEBenchError(HEBERROR_MSG_CLASS("Sweep requires, at least, one value."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    m_first  = m_values.front();
+    m_step.u = 0;
+}
+
+ParameterSweep::ParameterSweep(Kind kind, hebench::APIBridge::WorkloadParamType::WorkloadParamType type,
+                               Value first, Value last, Value step) :
+    m_kind(kind),
+    m_type(type),
+    m_first(first),
+    m_step(step),
+    m_count(0)
+{
+    bool b_valid = false;
+    if (kind == Kind::Range)
+    {
+        switch (type)
+        {
+        case hebench::APIBridge::WorkloadParamType::Int64:
+            b_valid = step.i > 0 && first.i <= last.i;
+            if (b_valid)
+                m_count = (static_cast<std::uint64_t>(last.i) - static_cast<std::uint64_t>(first.i)) / static_cast<std::uint64_t>(step.i);
+            break;
+        case hebench::APIBridge::WorkloadParamType::UInt64:
+            b_valid = step.u > 0 && first.u <= last.u;
+            if (b_valid)
+                m_count = (last.u - first.u) / step.u;
+            break;
+        default:
+            b_valid = std::isfinite(first.f) && std::isfinite(last.f) && std::isfinite(step.f)
+                      && step.f > 0.0 && first.f <= last.f;
+            if (b_valid)
+            {
+                double count = std::floor((last.f - first.f) / step.f + FloatTolerance) + 1.0;
+                b_valid      = count < static_cast<double>(std::numeric_limits<std::uint32_t>::max());
+                m_count      = static_cast<std::uint64_t>(count);
+            } // end if
+            break;
+        } // end switch
+        if (!b_valid)
+            throw HEBenchError(HEBERROR_MSG_CLASS("Invalid range: expected `step > 0` and `first <= last`."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+        if (type != hebench::APIBridge::WorkloadParamType::Float64)
+        {
+            // m_count holds the number of steps so far: a full 64-bit range with step 1
+            // has one value more than the count can represent
+            if (m_count == std::numeric_limits<std::uint64_t>::max())
+                throw HEBenchError(HEBERROR_MSG_CLASS("Invalid range: too many values in sweep."),
+                                   HEBENCH_ECODE_INVALID_ARGS);
+            ++m_count;
+        } // end if
+    } // end if
+    else
+    {
+        switch (type)
+        {
+        case hebench::APIBridge::WorkloadParamType::Int64:
+            b_valid = first.i > 0 && step.i > 1 && first.i <= last.i;
+            if (b_valid)
+                for (std::int64_t v = first.i; v <= last.i; v *= step.i)
+                {
+                    ++m_count;
+                    if (v > last.i / step.i)
+                        break;
+                } // end for
+            break;
+        case hebench::APIBridge::WorkloadParamType::UInt64:
+            b_valid = first.u > 0 && step.u > 1 && first.u <= last.u;
+            if (b_valid)
+                for (std::uint64_t v = first.u; v <= last.u; v *= step.u)
+                {
+                    ++m_count;
+                    if (v > last.u / step.u)
+                        break;
+                } // end for
+            break;
+        default:
+            b_valid = std::isfinite(first.f) && std::isfinite(last.f) && std::isfinite(step.f)
+                      && first.f > 0.0 && step.f > 1.0 && first.f <= last.f;
+            if (b_valid)
+                while (first.f * std::pow(step.f, static_cast<double>(m_count)) <= last.f * (1.0 + FloatTolerance))
+                    ++m_count;
+            break;
+        } // end switch
+        if (!b_valid)
+            throw HEBenchError(HEBERROR_MSG_CLASS("Invalid geometric progression: expected `first > 0`, `ratio > 1` and `first <= last`."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+    } // end else
+}
+
+ParameterSweep ParameterSweep::parse(const std::string &spec, hebench::APIBridge::WorkloadParamType::WorkloadParamType type)
+{
+    auto parse_value = [&spec, type](std::string token) -> Value {
+        Value retval;
+        std::size_t pos = 0;
+        bool b_valid    = !token.empty();
+        if (b_valid)
+        {
+            try
+            {
+                switch (type)
+                {
+                case hebench::APIBridge::WorkloadParamType::Int64:
+                    retval.i = std::stoll(token, &pos);
+                    break;
+                case hebench::APIBridge::WorkloadParamType::UInt64:
+                    // stoull silently negates values starting with '-'
+                    b_valid  = token.front() != '-';
+                    retval.u = std::stoull(token, &pos);
+                    break;
+                case hebench::APIBridge::WorkloadParamType::Float64:
+                    retval.f = std::stod(token, &pos);
+                    break;
+                default:
+                    b_valid = false;
+                    break;
+                } // end switch
+            }
+            catch (std::exception &)
+            {
+                b_valid = false;
+            }
+        } // end if
+        if (!b_valid || pos != token.size())
+            throw HEBenchError(HEBERROR_MSG_CLASS("Invalid value \"" + token + "\" in sweep \"" + spec + "\"."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+        return retval;
+    };
+
+    std::vector<std::string> tokens = split(spec, ':');
+    if (tokens.size() <= 1)
+    {
+        std::vector<Value> values;
+        for (const std::string &token : split(spec, ','))
+            values.push_back(parse_value(token));
+        return ParameterSweep(type, std::move(values));
+    } // end if
+
+    if (tokens.size() > 3)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Invalid sweep \"" + spec + "\": expected `first:last[:step]` or `first:last:*ratio`."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    Kind kind = Kind::Range;
+    Value step;
+    if (tokens.size() < 3)
+        step = parse_value("1");
+    else if (!tokens[2].empty() && tokens[2].front() == '*')
+    {
+        kind = Kind::Geometric;
+        step = parse_value(trim(tokens[2].substr(1)));
+    } // end else if
+    else
+        step = parse_value(tokens[2]);
+    return ParameterSweep(kind, type, parse_value(tokens[0]), parse_value(tokens[1]), step);
+}
+
+ParameterSweep::Value ParameterSweep::valueAt(std::uint64_t index) const
+{
+    Value retval;
+    switch (m_kind)
+    {
+    case Kind::Values:
+        retval = m_values[index];
+        break;
+
+    case Kind::Range:
+        if (m_type == hebench::APIBridge::WorkloadParamType::Int64)
+            retval.i = static_cast<std::int64_t>(static_cast<std::uint64_t>(m_first.i) + index * static_cast<std::uint64_t>(m_step.i));
+        else if (m_type == hebench::APIBridge::WorkloadParamType::UInt64)
+            retval.u = m_first.u + index * m_step.u;
+        else
+            retval.f = m_first.f + static_cast<double>(index) * m_step.f;
+        break;
+
+    default:
+        if (m_type == hebench::APIBridge::WorkloadParamType::Int64)
+        {
+            retval.i = m_first.i;
+            for (std::uint64_t i = 0; i < index; ++i)
+                retval.i *= m_step.i;
+        } // end if
+        else if (m_type == hebench::APIBridge::WorkloadParamType::UInt64)
+        {
+            retval.u = m_first.u;
+            for (std::uint64_t i = 0; i < index; ++i)
+                retval.u *= m_step.u;
+        } // end else if
+        else
+            retval.f = m_first.f * std::pow(m_step.f, static_cast<double>(index));
+        break;
+    } // end switch
+    return retval;
+}
+
+void ParameterSweep::get(std::uint64_t index, hebench::APIBridge::WorkloadParam &w_param) const
+{
+    if (index >= m_count)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Sweep index " + std::to_string(index) + " out of range: sweep has "
+                                              + std::to_string(m_count) + " values."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    Value value       = valueAt(index);
+    w_param.data_type = m_type;
+    switch (m_type)
+    {
+    case hebench::APIBridge::WorkloadParamType::Int64:
+        w_param.i_param = value.i;
+        break;
+    case hebench::APIBridge::WorkloadParamType::UInt64:
+        w_param.u_param = value.u;
+        break;
+    default:
+        w_param.f_param = value.f;
+        break;
+    } // end switch
+}
+
+ParameterSweep ParameterSweep::as(hebench::APIBridge::WorkloadParamType::WorkloadParamType type) const
+{
+    if (type == m_type)
+        return *this;
+
+    auto convert = [this, type](Value v) -> Value {
+        Value retval;
+        bool b_valid = true;
+        switch (type)
+        {
+        case hebench::APIBridge::WorkloadParamType::Int64:
+            b_valid  = m_type == hebench::APIBridge::WorkloadParamType::UInt64
+                      && v.u <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+            retval.i = static_cast<std::int64_t>(v.u);
+            break;
+        case hebench::APIBridge::WorkloadParamType::UInt64:
+            b_valid  = m_type == hebench::APIBridge::WorkloadParamType::Int64 && v.i >= 0;
+            retval.u = static_cast<std::uint64_t>(v.i);
+            break;
+        case hebench::APIBridge::WorkloadParamType::Float64:
+            retval.f = m_type == hebench::APIBridge::WorkloadParamType::Int64 ? static_cast<double>(v.i) : static_cast<double>(v.u);
+            break;
+        default:
+            b_valid = false;
+            break;
+        } // end switch
+        if (!b_valid)
+            throw HEBenchError(HEBERROR_MSG_CLASS("Sweep values do not fit the type of the workload parameter."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+        return retval;
+    };
+
+    ParameterSweep retval(*this);
+    retval.m_type = type;
+    if (m_kind == Kind::Values)
+    {
+        for (std::size_t i = 0; i < m_values.size(); ++i)
+            retval.m_values[i] = convert(m_values[i]);
+        retval.m_first = retval.m_values.front();
+    } // end if
+    else
+    {
+        // progressions are increasing: checking both ends checks all values
+        convert(valueAt(m_count - 1));
+        retval.m_first = convert(m_first);
+        retval.m_step  = convert(m_step);
+    } // end else
+    return retval;
+}
+
+//---------------------
+// class WorkloadSweep
+//---------------------
+
+WorkloadSweep::WorkloadSweep(std::vector<hebench::APIBridge::WorkloadParam> base_params) :
+    m_base_params(std::move(base_params)),
+    m_size(1)
+{
+}
+
+WorkloadSweep &WorkloadSweep::vary(const std::vector<std::size_t> &param_indices, const ParameterSweep &sweep)
+{
+    if (param_indices.empty())
+        throw HEBenchError(HEBERROR_MSG_CLASS("Sweep dimension requires, at least, one workload parameter."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    if (sweep.size() > std::numeric_limits<std::uint64_t>::max() / m_size)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Too many sets of workload parameters in sweep."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+
+    Dimension dimension;
+    for (std::size_t param_index : param_indices)
+    {
+        if (param_index >= m_base_params.size())
+            throw HEBenchError(HEBERROR_MSG_CLASS("Workload parameter index " + std::to_string(param_index) + " out of range."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+        bool b_varied = std::find(dimension.param_indices.begin(), dimension.param_indices.end(), param_index) != dimension.param_indices.end();
+        for (std::size_t i = 0; !b_varied && i < m_dimensions.size(); ++i)
+            b_varied = std::find(m_dimensions[i].param_indices.begin(), m_dimensions[i].param_indices.end(), param_index) != m_dimensions[i].param_indices.end();
+        if (b_varied)
+            throw HEBenchError(HEBERROR_MSG_CLASS("Workload parameter " + std::to_string(param_index) + " is already varied in sweep."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+        dimension.param_indices.push_back(param_index);
+        dimension.sweeps.push_back(sweep.as(m_base_params[param_index].data_type));
+    } // end for
+
+    m_dimensions.emplace_back(std::move(dimension));
+    m_size *= sweep.size();
+
+    return *this;
+}
+
+WorkloadSweep &WorkloadSweep::vary(const std::string &spec)
+{
+    for (const std::string &dimension_spec : split(spec, ';'))
+    {
+        if (dimension_spec.empty())
+            continue;
+        std::size_t pos = dimension_spec.find('=');
+        if (pos == std::string::npos)
+            throw HEBenchError(HEBERROR_MSG_CLASS("Invalid sweep dimension \"" + dimension_spec + "\": expected `name[,name...]=sequence`."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+        std::vector<std::size_t> param_indices;
+        for (const std::string &name : split(dimension_spec.substr(0, pos), ','))
+            param_indices.push_back(findParam(name));
+        vary(param_indices, ParameterSweep::parse(trim(dimension_spec.substr(pos + 1)), m_base_params[param_indices.front()].data_type));
+    } // end for
+
+    return *this;
+}
+
+std::size_t WorkloadSweep::findParam(const std::string &name) const
+{
+    for (std::size_t i = 0; i < m_base_params.size(); ++i)
+        if (name == m_base_params[i].name)
+            return i;
+    throw HEBenchError(HEBERROR_MSG_CLASS("Unknown workload parameter \"" + name + "\" in sweep."),
+                       HEBENCH_ECODE_INVALID_ARGS);
+}
+
+void WorkloadSweep::at(std::uint64_t index, hebench::APIBridge::WorkloadParam *p_params) const
+{
+    if (index >= m_size)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Sweep index " + std::to_string(index) + " out of range: sweep has "
+                                              + std::to_string(m_size) + " sets."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    if (!m_base_params.empty() && !p_params)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Invalid null parameter: p_params."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+
+    std::copy(m_base_params.begin(), m_base_params.end(), p_params);
+    // last dimension varies fastest
+    for (std::size_t d = m_dimensions.size(); d-- > 0;)
+    {
+        const Dimension &dimension = m_dimensions[d];
+        std::uint64_t dim_size     = dimension.sweeps.front().size();
+        std::uint64_t value_index  = index % dim_size;
+        index /= dim_size;
+        for (std::size_t i = 0; i < dimension.param_indices.size(); ++i)
+            dimension.sweeps[i].get(value_index, p_params[dimension.param_indices[i]]);
+    } // end for
+}
+
+std::vector<hebench::APIBridge::WorkloadParam> WorkloadSweep::at(std::uint64_t index) const
+{
+    std::vector<hebench::APIBridge::WorkloadParam> retval(m_base_params.size());
+    at(index, retval.data());
+    return retval;
+}
+
+} // namespace cpp
+} // namespace hebench
@@ -0,0 +1,585 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+
+#include "hebench/api_bridge/cpp/cartesian_product.hpp"
+#include "hebench/api_bridge/cpp/data_view.hpp"
+#include "hebench/api_bridge/cpp/dataset_generator.hpp"
+#include "hebench/api_bridge/cpp/result_validator.hpp"
+#include "hebench/api_bridge/cpp/workload_schema.hpp"
+
+namespace hebench {
+namespace cpp {
+
+namespace {
+
+/**
+ * @brief Buffers reused by the validation of the tuples executed by a thread.
+ */
+struct Scratch
+{
+    std::vector<hebench::APIBridge::NativeDataBuffer> inputs;
+    std::vector<hebench::APIBridge::NativeDataBuffer> results;
+    std::vector<std::uint64_t> expected; // 64 bits words keep every data type aligned
+    std::vector<std::uint64_t> sorted;
+    std::vector<std::uint64_t> order;
+};
+
+thread_local Scratch t_scratch;
+
+std::uint64_t dataTypeSize(hebench::APIBridge::DataType data_type)
+{
+    switch (data_type)
+    {
+    case hebench::APIBridge::DataType::Int32:
+        return sizeof(std::int32_t);
+    case hebench::APIBridge::DataType::Int64:
+        return sizeof(std::int64_t);
+    case hebench::APIBridge::DataType::Float32:
+        return sizeof(float);
+    case hebench::APIBridge::DataType::Float64:
+        return sizeof(double);
+    default:
+        return 0;
+    } // end switch
+}
+
+std::uint64_t wordCount(std::uint64_t bytes)
+{
+    return (bytes + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+}
+
+template <class T>
+using Accumulator = typename std::conditional<std::is_floating_point<T>::value, double, std::int64_t>::type;
+
+//---------------------------
+// Reference implementations
+//---------------------------
+
+template <class T>
+void referenceMatrixMultiply(std::uint64_t rows0, std::uint64_t cols0, std::uint64_t cols1,
+                             const T *p_m0, const T *p_m1, T *p_result)
+{
+    // i-k-j order: inner loop streams rows of M1 and the result
+    std::vector<Accumulator<T>> row(cols1);
+    for (std::uint64_t i = 0; i < rows0; ++i)
+    {
+        std::fill(row.begin(), row.end(), Accumulator<T>(0));
+        for (std::uint64_t k = 0; k < cols0; ++k)
+        {
+            Accumulator<T> a = p_m0[i * cols0 + k];
+            const T *p_row1  = p_m1 + k * cols1;
+            for (std::uint64_t j = 0; j < cols1; ++j)
+                row[j] += a * p_row1[j];
+        } // end for
+        for (std::uint64_t j = 0; j < cols1; ++j)
+            p_result[i * cols1 + j] = static_cast<T>(row[j]);
+    } // end for
+}
+
+template <class T>
+Accumulator<T> referenceDotProduct(std::uint64_t n, const T *p_a, const T *p_b)
+{
+    Accumulator<T> retval = 0;
+    for (std::uint64_t i = 0; i < n; ++i)
+        retval += static_cast<Accumulator<T>>(p_a[i]) * p_b[i];
+    return retval;
+}
+
+double sigmoid(hebench::APIBridge::Workload workload, double x)
+{
+    // polynomial approximations around `x = 0` specified by the workloads
+    double x2 = x * x;
+    switch (workload)
+    {
+    case hebench::APIBridge::Workload::LogisticRegression_PolyD3:
+        return 0.5 + x * (0.15012 + x2 * -0.001593);
+    case hebench::APIBridge::Workload::LogisticRegression_PolyD5:
+        return 0.5 + x * (0.19131 + x2 * (-0.0045963 + x2 * 0.0000412332));
+    case hebench::APIBridge::Workload::LogisticRegression_PolyD7:
+        return 0.5 + x * (0.216884 + x2 * (-0.00819276 + x2 * (0.000165861 + x2 * -0.00000119581)));
+    default:
+        return 1.0 / (1.0 + std::exp(-x));
+    } // end switch
+}
+
+template <class T>
+void referenceSetIntersection(std::uint64_t n, std::uint64_t m, std::uint64_t k,
+                              const T *p_x, const T *p_y, T *p_result)
+{
+    auto item_less = [k](const T *p_a, const T *p_b) { return std::lexicographical_compare(p_a, p_a + k, p_b, p_b + k); };
+
+    // sort Y once, then look up each item of X, keeping the order of X
+    std::vector<const T *> sorted_y(m);
+    for (std::uint64_t i = 0; i < m; ++i)
+        sorted_y[i] = p_y + i * k;
+    std::sort(sorted_y.begin(), sorted_y.end(), item_less);
+
+    std::uint64_t capacity = std::min(n, m);
+    std::uint64_t count    = 0;
+    for (std::uint64_t i = 0; i < n && count < capacity; ++i)
+    {
+        const T *p_item = p_x + i * k;
+        if (std::binary_search(sorted_y.begin(), sorted_y.end(), p_item, item_less))
+            std::copy(p_item, p_item + k, p_result + (count++) * k);
+    } // end for
+    std::fill(p_result + count * k, p_result + capacity * k, T(0));
+}
+
+template <class T>
+ResultValidator::Reference makeReference(hebench::APIBridge::Workload workload,
+                                         const hebench::APIBridge::WorkloadParams &w_params)
+{
+    using hebench::APIBridge::NativeDataBuffer;
+
+    switch (workload)
+    {
+    case hebench::APIBridge::Workload::MatrixMultiply:
+    {
+        typedef WorkloadSchema<WorkloadSchemas::MatrixMultiply> Schema;
+        Schema::Values params = Schema::validate(w_params);
+        std::uint64_t rows0   = params.get<Schema::RowsM0>();
+        std::uint64_t cols0   = params.get<Schema::ColsM0>();
+        std::uint64_t cols1   = params.get<Schema::ColsM1>();
+        return [rows0, cols0, cols1](const NativeDataBuffer *p_inputs, NativeDataBuffer *p_results) {
+            referenceMatrixMultiply(rows0, cols0, cols1,
+                                    static_cast<const T *>(p_inputs[0].p), static_cast<const T *>(p_inputs[1].p),
+                                    static_cast<T *>(p_results[0].p));
+        };
+    }
+
+    case hebench::APIBridge::Workload::EltwiseAdd:
+    case hebench::APIBridge::Workload::EltwiseMultiply:
+    {
+        std::uint64_t n = WorkloadSchema<WorkloadSchemas::VectorSize>::validate(w_params).get<WorkloadSchemas::VectorSize::N>();
+        bool b_add      = workload == hebench::APIBridge::Workload::EltwiseAdd;
+        return [n, b_add](const NativeDataBuffer *p_inputs, NativeDataBuffer *p_results) {
+            const T *p_a = static_cast<const T *>(p_inputs[0].p);
+            const T *p_b = static_cast<const T *>(p_inputs[1].p);
+            T *p_c       = static_cast<T *>(p_results[0].p);
+            for (std::uint64_t i = 0; i < n; ++i)
+                p_c[i] = static_cast<T>(b_add ? static_cast<Accumulator<T>>(p_a[i]) + p_b[i] :
+                                                static_cast<Accumulator<T>>(p_a[i]) * p_b[i]);
+        };
+    }
+
+    case hebench::APIBridge::Workload::DotProduct:
+    {
+        std::uint64_t n = WorkloadSchema<WorkloadSchemas::VectorSize>::validate(w_params).get<WorkloadSchemas::VectorSize::N>();
+        return [n](const NativeDataBuffer *p_inputs, NativeDataBuffer *p_results) {
+            *static_cast<T *>(p_results[0].p) =
+                static_cast<T>(referenceDotProduct(n, static_cast<const T *>(p_inputs[0].p), static_cast<const T *>(p_inputs[1].p)));
+        };
+    }
+
+    case hebench::APIBridge::Workload::LogisticRegression:
+    case hebench::APIBridge::Workload::LogisticRegression_PolyD3:
+    case hebench::APIBridge::Workload::LogisticRegression_PolyD5:
+    case hebench::APIBridge::Workload::LogisticRegression_PolyD7:
+    {
+        // W, b, X
+        std::uint64_t n = WorkloadSchema<WorkloadSchemas::VectorSize>::validate(w_params).get<WorkloadSchemas::VectorSize::N>();
+        return [workload, n](const NativeDataBuffer *p_inputs, NativeDataBuffer *p_results) {
+            double x = static_cast<double>(referenceDotProduct(n, static_cast<const T *>(p_inputs[0].p), static_cast<const T *>(p_inputs[2].p)))
+                       + static_cast<double>(*static_cast<const T *>(p_inputs[1].p));
+            *static_cast<T *>(p_results[0].p) = static_cast<T>(sigmoid(workload, x));
+        };
+    }
+
+    case hebench::APIBridge::Workload::SimpleSetIntersection:
+    {
+        typedef WorkloadSchema<WorkloadSchemas::SimpleSetIntersection> Schema;
+        Schema::Values params = Schema::validate(w_params);
+        std::uint64_t n       = params.get<Schema::N>();
+        std::uint64_t m       = params.get<Schema::M>();
+        std::uint64_t k       = params.get<Schema::K>();
+        return [n, m, k](const NativeDataBuffer *p_inputs, NativeDataBuffer *p_results) {
+            referenceSetIntersection(n, m, k,
+                                     static_cast<const T *>(p_inputs[0].p), static_cast<const T *>(p_inputs[1].p),
+                                     static_cast<T *>(p_results[0].p));
+        };
+    }
+
+    default:
+        // user defined operation
+        return ResultValidator::Reference();
+    } // end switch
+}
+
+//------------
+// Comparison
+//------------
+
+/**
+ * @brief Mismatch found while validating a result.
+ */
+struct Mismatch
+{
+    std::uint64_t count;
+    std::uint64_t element;
+    double actual;
+    double expected;
+};
+
+template <class T>
+Mismatch compareResult(const T *p_actual, const T *p_expected, std::uint64_t count, const Tolerance &tolerance)
+{
+    Mismatch retval = { 0, 0, 0.0, 0.0 };
+    retval.count    = countMismatches(p_actual, p_expected, count, tolerance);
+    if (retval.count > 0)
+    {
+        // rare: locate the first mismatch
+        const internal::ToleranceCheck<T> check(tolerance);
+        std::uint64_t i = 0;
+        while (check(p_actual[i], p_expected[i]))
+            ++i;
+        retval.element  = i;
+        retval.actual   = static_cast<double>(p_actual[i]);
+        retval.expected = static_cast<double>(p_expected[i]);
+    } // end if
+    return retval;
+}
+
+template <class T>
+void sortItems(const T *p_items, std::uint64_t item_count, std::uint64_t item_size, T *p_sorted, std::vector<std::uint64_t> &order)
+{
+    order.resize(item_count);
+    std::iota(order.begin(), order.end(), std::uint64_t(0));
+    std::sort(order.begin(), order.end(), [p_items, item_size](std::uint64_t a, std::uint64_t b) {
+        return std::lexicographical_compare(p_items + a * item_size, p_items + (a + 1) * item_size,
+                                            p_items + b * item_size, p_items + (b + 1) * item_size);
+    });
+    for (std::uint64_t i = 0; i < item_count; ++i)
+        std::copy(p_items + order[i] * item_size, p_items + (order[i] + 1) * item_size, p_sorted + i * item_size);
+}
+
+template <class T>
+Mismatch compareSetResult(const T *p_actual, T *p_expected, std::uint64_t count, std::uint64_t item_size,
+                          const Tolerance &tolerance, Scratch &scratch)
+{
+    // order of the items does not matter: compare both sorted
+    std::uint64_t item_count = count / item_size;
+    scratch.sorted.resize(wordCount(count * sizeof(T)) * 2);
+    T *p_sorted_actual   = reinterpret_cast<T *>(scratch.sorted.data());
+    T *p_sorted_expected = p_sorted_actual + count;
+    sortItems(p_actual, item_count, item_size, p_sorted_actual, scratch.order);
+    sortItems(p_expected, item_count, item_size, p_sorted_expected, scratch.order);
+    return compareResult(p_sorted_actual, p_sorted_expected, count, tolerance);
+}
+
+template <class T>
+Mismatch compareComponent(const void *p_actual, void *p_expected, std::uint64_t count, std::uint64_t set_item_size,
+                          const Tolerance &tolerance, Scratch &scratch)
+{
+    return set_item_size > 0 ?
+               compareSetResult(static_cast<const T *>(p_actual), static_cast<T *>(p_expected), count, set_item_size, tolerance, scratch) :
+               compareResult(static_cast<const T *>(p_actual), static_cast<const T *>(p_expected), count, tolerance);
+}
+
+} // namespace
+
+//-----------------
+// class Tolerance
+//-----------------
+
+Tolerance Tolerance::defaults(hebench::APIBridge::DataType data_type)
+{
+    Tolerance retval;
+    switch (data_type)
+    {
+    case hebench::APIBridge::DataType::Float32:
+        retval.relative = 1e-4;
+        retval.absolute = 1e-6;
+        retval.ulps     = 4;
+        break;
+    case hebench::APIBridge::DataType::Float64:
+        retval.relative = 1e-9;
+        retval.absolute = 1e-12;
+        retval.ulps     = 4;
+        break;
+    default:
+        break;
+    } // end switch
+    return retval;
+}
+
+//------------------------
+// class ValidationReport
+//------------------------
+
+std::string ValidationReport::summary() const
+{
+    std::stringstream ss;
+    if (passed())
+        ss << "Validation passed: " << result_count << " results.";
+    else
+    {
+        ss.precision(std::numeric_limits<double>::max_digits10);
+        ss << "Validation failed: " << failed_count << " of " << result_count << " results with "
+           << mismatch_count << " elements out of tolerance. First mismatch in result " << first_result
+           << ", component " << first_component << ", element " << first_element
+           << ": " << first_actual << ", expected " << first_expected << ".";
+    } // end else
+    return ss.str();
+}
+
+//-----------------------
+// class ResultValidator
+//-----------------------
+
+std::vector<std::uint64_t> ResultValidator::resultSizes(hebench::APIBridge::Workload workload,
+                                                        const hebench::APIBridge::WorkloadParams &w_params)
+{
+    std::vector<std::uint64_t> retval;
+
+    try
+    {
+        switch (workload)
+        {
+        case hebench::APIBridge::Workload::MatrixMultiply:
+        {
+            typedef WorkloadSchema<WorkloadSchemas::MatrixMultiply> Schema;
+            Schema::Values params = Schema::validate(w_params);
+            retval                = { params.get<Schema::RowsM0>() * params.get<Schema::ColsM1>() };
+        }
+        break;
+
+        case hebench::APIBridge::Workload::EltwiseAdd:
+        case hebench::APIBridge::Workload::EltwiseMultiply:
+            retval = { WorkloadSchema<WorkloadSchemas::VectorSize>::validate(w_params).get<WorkloadSchemas::VectorSize::N>() };
+            break;
+
+        case hebench::APIBridge::Workload::DotProduct:
+        case hebench::APIBridge::Workload::LogisticRegression:
+        case hebench::APIBridge::Workload::LogisticRegression_PolyD3:
+        case hebench::APIBridge::Workload::LogisticRegression_PolyD5:
+        case hebench::APIBridge::Workload::LogisticRegression_PolyD7:
+            WorkloadSchema<WorkloadSchemas::VectorSize>::validate(w_params);
+            retval = { 1 };
+            break;
+
+        case hebench::APIBridge::Workload::SimpleSetIntersection:
+        {
+            typedef WorkloadSchema<WorkloadSchemas::SimpleSetIntersection> Schema;
+            Schema::Values params = Schema::validate(w_params);
+            retval                = { std::min(params.get<Schema::N>(), params.get<Schema::M>()) * params.get<Schema::K>() };
+        }
+        break;
+
+        case hebench::APIBridge::Workload::Generic:
+        {
+            GenericWorkloadSchema::Values params = GenericWorkloadSchema::validate(w_params);
+            retval.resize(params.m());
+            for (std::size_t result_i = 0; result_i < retval.size(); ++result_i)
+                retval[result_i] = params.resultLength(result_i);
+        }
+        break;
+
+        default:
+            throw HEBenchError(HEBERROR_MSG_CLASS("Unsupported workload: " + std::to_string(static_cast<int>(workload)) + "."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+            break;
+        } // end switch
+    }
+    catch (HEBenchError &)
+    {
+        throw;
+    }
+    catch (std::exception &ex)
+    {
+        throw HEBenchError(HEBERROR_MSG_CLASS(std::string("Invalid workload parameters: ") + ex.what()),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    }
+
+    return retval;
+}
+
+ResultValidator::ResultValidator(const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                                 const hebench::APIBridge::WorkloadParams &w_params) :
+    ResultValidator(bench_desc, w_params, Tolerance::defaults(bench_desc.data_type))
+{
+}
+
+ResultValidator::ResultValidator(const hebench::APIBridge::BenchmarkDescriptor &bench_desc,
+                                 const hebench::APIBridge::WorkloadParams &w_params,
+                                 const Tolerance &tolerance) :
+    m_workload(bench_desc.workload),
+    m_data_type(bench_desc.data_type),
+    m_operand_sizes(DatasetGenerator::operandSizes(bench_desc.workload, w_params)),
+    m_result_sizes(resultSizes(bench_desc.workload, w_params)),
+    m_set_item_size(0),
+    m_tolerance(tolerance)
+{
+    switch (m_data_type)
+    {
+    case hebench::APIBridge::DataType::Int32:
+        m_reference = makeReference<std::int32_t>(m_workload, w_params);
+        break;
+    case hebench::APIBridge::DataType::Int64:
+        m_reference = makeReference<std::int64_t>(m_workload, w_params);
+        break;
+    case hebench::APIBridge::DataType::Float32:
+        m_reference = makeReference<float>(m_workload, w_params);
+        break;
+    case hebench::APIBridge::DataType::Float64:
+        m_reference = makeReference<double>(m_workload, w_params);
+        break;
+    default:
+        throw HEBenchError(HEBERROR_MSG_CLASS("Unsupported data type: " + std::to_string(static_cast<int>(m_data_type)) + "."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    } // end switch
+
+    if (m_workload == hebench::APIBridge::Workload::SimpleSetIntersection)
+        m_set_item_size = WorkloadSchema<WorkloadSchemas::SimpleSetIntersection>::validate(w_params).get<WorkloadSchemas::SimpleSetIntersection::K>();
+}
+
+void ResultValidator::computeReference(const hebench::APIBridge::NativeDataBuffer *p_inputs,
+                                       hebench::APIBridge::NativeDataBuffer *p_results) const
+{
+    if (!m_reference)
+        throw HEBenchError(HEBERROR_MSG_CLASS("No reference implementation for workload "
+                                              + std::to_string(static_cast<int>(m_workload)) + ": use setReference()."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    m_reference(p_inputs, p_results);
+}
+
+ValidationReport ResultValidator::validate(const hebench::APIBridge::DataPackCollection &inputs,
+                                           const hebench::APIBridge::DataPackCollection &results,
+                                           ThreadPool *p_pool) const
+{
+    if (!m_reference)
+        computeReference(nullptr, nullptr); // reports the missing reference
+
+    const std::uint64_t element_size = dataTypeSize(m_data_type);
+
+    auto check_pack = [element_size](const DataPackView<const char> &pack, const char *s_kind,
+                                     std::uint64_t position, std::uint64_t sample_size) {
+        if (!pack.valid() || (pack.sampleCount() > 0 && !pack.pack().p_buffers))
+            throw HEBenchError(HEBERROR_MSG_CLASS(std::string("Missing ") + s_kind + " " + std::to_string(position) + "."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+        for (std::uint64_t sample_i = 0; sample_i < pack.sampleCount(); ++sample_i)
+        {
+            const hebench::APIBridge::NativeDataBuffer &buffer = pack.pack().p_buffers[sample_i];
+            if ((sample_size > 0 && !buffer.p) || buffer.size < sample_size * element_size)
+                throw HEBenchError(HEBERROR_MSG_CLASS(std::string("Sample ") + std::to_string(sample_i) + " of " + s_kind + " "
+                                                      + std::to_string(position) + " is smaller than required by the workload."),
+                                   HEBENCH_ECODE_INVALID_ARGS);
+        } // end for
+    };
+
+    DataPackCollectionView<const char> input_view(inputs);
+    std::vector<DataPackView<const char>> input_packs(m_operand_sizes.size());
+    std::vector<hebench::APIBridge::ParameterIndexer> indexers(m_operand_sizes.size());
+    for (std::size_t param_i = 0; param_i < input_packs.size(); ++param_i)
+    {
+        input_packs[param_i] = input_view.find(param_i);
+        check_pack(input_packs[param_i], "operation parameter", param_i, m_operand_sizes[param_i]);
+        indexers[param_i].value_index = 0;
+        indexers[param_i].batch_size  = input_packs[param_i].sampleCount();
+    } // end for
+
+    ValidationReport report;
+    if (std::find_if(indexers.begin(), indexers.end(),
+                     [](const hebench::APIBridge::ParameterIndexer &indexer) { return indexer.batch_size == 0; })
+        != indexers.end())
+        return report; // no tuples to validate
+    CartesianProduct product(indexers.data(), indexers.size());
+    report.result_count = product.size();
+
+    DataPackCollectionView<const char> result_view(results);
+    std::vector<DataPackView<const char>> result_packs(m_result_sizes.size());
+    for (std::size_t result_i = 0; result_i < result_packs.size(); ++result_i)
+    {
+        result_packs[result_i] = result_view.find(result_i);
+        check_pack(result_packs[result_i], "result component", result_i, m_result_sizes[result_i]);
+        if (result_packs[result_i].sampleCount() < product.size())
+            throw HEBenchError(HEBERROR_MSG_CLASS("Result component " + std::to_string(result_i) + " has "
+                                                  + std::to_string(result_packs[result_i].sampleCount()) + " samples, but "
+                                                  + std::to_string(product.size()) + " expected."),
+                               HEBENCH_ECODE_INVALID_ARGS);
+    } // end for
+
+    std::mutex report_mutex;
+    auto validate_tuple = [&](const std::uint64_t *sample_indices, std::uint64_t result_index) {
+        Scratch &scratch = t_scratch;
+
+        scratch.inputs.resize(input_packs.size());
+        for (std::size_t param_i = 0; param_i < input_packs.size(); ++param_i)
+            scratch.inputs[param_i] = input_packs[param_i].pack().p_buffers[sample_indices[param_i]];
+        std::uint64_t words = 0;
+        for (std::uint64_t result_size : m_result_sizes)
+            words += wordCount(result_size * element_size);
+        scratch.expected.resize(words);
+        scratch.results.resize(m_result_sizes.size());
+        words = 0;
+        for (std::size_t result_i = 0; result_i < m_result_sizes.size(); ++result_i)
+        {
+            scratch.results[result_i].p    = scratch.expected.data() + words;
+            scratch.results[result_i].size = m_result_sizes[result_i] * element_size;
+            scratch.results[result_i].tag  = 0;
+            words += wordCount(scratch.results[result_i].size);
+        } // end for
+        m_reference(scratch.inputs.data(), scratch.results.data());
+
+        Mismatch first                = { 0, 0, 0.0, 0.0 };
+        std::uint64_t first_component = 0;
+        std::uint64_t mismatch_count  = 0;
+        for (std::size_t result_i = 0; result_i < m_result_sizes.size(); ++result_i)
+        {
+            const void *p_actual = result_packs[result_i].pack().p_buffers[result_index].p;
+            void *p_expected     = scratch.results[result_i].p;
+            std::uint64_t count  = m_result_sizes[result_i];
+            Mismatch mismatch    = { 0, 0, 0.0, 0.0 };
+            switch (m_data_type)
+            {
+            case hebench::APIBridge::DataType::Int32:
+                mismatch = compareComponent<std::int32_t>(p_actual, p_expected, count, m_set_item_size, m_tolerance, scratch);
+                break;
+            case hebench::APIBridge::DataType::Int64:
+                mismatch = compareComponent<std::int64_t>(p_actual, p_expected, count, m_set_item_size, m_tolerance, scratch);
+                break;
+            case hebench::APIBridge::DataType::Float32:
+                mismatch = compareComponent<float>(p_actual, p_expected, count, m_set_item_size, m_tolerance, scratch);
+                break;
+            default:
+                mismatch = compareComponent<double>(p_actual, p_expected, count, m_set_item_size, m_tolerance, scratch);
+                break;
+            } // end switch
+            if (mismatch.count > 0 && mismatch_count == 0)
+            {
+                first           = mismatch;
+                first_component = result_i;
+            } // end if
+            mismatch_count += mismatch.count;
+        } // end for
+
+        if (mismatch_count > 0)
+        {
+            std::lock_guard<std::mutex> lock(report_mutex);
+            if (report.failed_count == 0 || result_index < report.first_result)
+            {
+                report.first_result    = result_index;
+                report.first_component = first_component;
+                report.first_element   = first.element;
+                report.first_actual    = first.actual;
+                report.first_expected  = first.expected;
+            } // end if
+            ++report.failed_count;
+            report.mismatch_count += mismatch_count;
+        } // end if
+    };
+    if (p_pool)
+        product.forEach(*p_pool, validate_tuple);
+    else
+        product.forEach(validate_tuple);
+
+    return report;
+}
+
+} // namespace cpp
+} // namespace hebench
@@ -0,0 +1,537 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "hebench/api_bridge/cpp/aligned_allocator.hpp"
+#include "hebench/api_bridge/cpp/spill_store.hpp"
+
+namespace hebench {
+namespace cpp {
+
+namespace internal {
+
+struct SpillChunk
+{
+    SpillChunk() :
+        fd(-1), p_base(nullptr), size(0), used(0), live(0) {}
+    ~SpillChunk()
+    {
+        if (p_base)
+        {
+#if defined(__linux__)
+            munmap(p_base, size);
+#else
+            freeAligned(p_base);
+#endif
+        } // end if
+        if (fd >= 0)
+            close(fd);
+    }
+    SpillChunk(const SpillChunk &) = delete;
+    SpillChunk &operator=(const SpillChunk &) = delete;
+
+    int fd;
+    std::uint8_t *p_base;
+    std::uint64_t size;
+    std::uint64_t used; // bytes allocated so far, payloads are never moved
+    std::uint64_t live; // payloads not yet released
+};
+
+struct SpillEntry
+{
+    SpillChunk *p_chunk;
+    std::uint64_t offset;
+    std::uint64_t size; // whole pages
+    std::uint64_t pins;
+    bool resident;
+    bool in_lru;
+    bool paging_out; // selected for page out: its I/O runs outside the lock of the store
+    bool written;    // result of the last page out
+    std::list<SpillEntry *>::iterator lru_it;
+};
+
+} // namespace internal
+
+//---------------------
+// class SpilledBuffer
+//---------------------
+
+SpilledBuffer::Pin::Pin(SpillStore *p_store, internal::SpillEntry *p_entry, void *p_data, std::uint64_t size) noexcept :
+    m_p_store(p_store),
+    m_p_entry(p_entry),
+    m_p_data(p_data),
+    m_size(size)
+{
+}
+
+SpilledBuffer::Pin::Pin(Pin &&src) noexcept :
+    m_p_store(src.m_p_store),
+    m_p_entry(src.m_p_entry),
+    m_p_data(src.m_p_data),
+    m_size(src.m_size)
+{
+    src.m_p_entry = nullptr;
+    src.m_p_data  = nullptr;
+    src.m_size    = 0;
+}
+
+SpilledBuffer::Pin &SpilledBuffer::Pin::operator=(Pin &&src) noexcept
+{
+    if (&src != this)
+    {
+        release();
+        std::swap(m_p_store, src.m_p_store);
+        std::swap(m_p_entry, src.m_p_entry);
+        std::swap(m_p_data, src.m_p_data);
+        std::swap(m_size, src.m_size);
+    } // end if
+    return *this;
+}
+
+SpilledBuffer::Pin::~Pin()
+{
+    release();
+}
+
+void SpilledBuffer::Pin::release() noexcept
+{
+    if (m_p_entry)
+        m_p_store->unpin(m_p_entry);
+    m_p_entry = nullptr;
+    m_p_data  = nullptr;
+    m_size    = 0;
+}
+
+SpilledBuffer::SpilledBuffer() noexcept :
+    m_p_store(nullptr),
+    m_p_entry(nullptr),
+    m_size(0)
+{
+}
+
+SpilledBuffer::SpilledBuffer(SpillStore *p_store, internal::SpillEntry *p_entry, std::uint64_t size) noexcept :
+    m_p_store(p_store),
+    m_p_entry(p_entry),
+    m_size(size)
+{
+}
+
+SpilledBuffer::SpilledBuffer(SpilledBuffer &&src) noexcept :
+    m_p_store(src.m_p_store),
+    m_p_entry(src.m_p_entry),
+    m_size(src.m_size)
+{
+    src.m_p_store = nullptr;
+    src.m_p_entry = nullptr;
+    src.m_size    = 0;
+}
+
+SpilledBuffer &SpilledBuffer::operator=(SpilledBuffer &&src) noexcept
+{
+    if (&src != this)
+    {
+        reset();
+        std::swap(m_p_store, src.m_p_store);
+        std::swap(m_p_entry, src.m_p_entry);
+        std::swap(m_size, src.m_size);
+    } // end if
+    return *this;
+}
+
+SpilledBuffer::~SpilledBuffer()
+{
+    reset();
+}
+
+void SpilledBuffer::reset() noexcept
+{
+    if (m_p_entry)
+        m_p_store->release(m_p_entry);
+    m_p_store = nullptr;
+    m_p_entry = nullptr;
+    m_size    = 0;
+}
+
+bool SpilledBuffer::resident() const
+{
+    return m_p_entry && m_p_store->isResident(m_p_entry);
+}
+
+SpilledBuffer::Pin SpilledBuffer::pin() const
+{
+    if (!m_p_entry)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Cannot pin an empty buffer."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    m_p_store->pin(m_p_entry);
+    return Pin(m_p_store, m_p_entry, m_p_entry->p_chunk->p_base + m_p_entry->offset, m_size);
+}
+
+//------------------
+// class SpillStore
+//------------------
+
+constexpr std::uint64_t SpillStore::DefaultChunkSize;
+
+std::string SpillStore::defaultDirectory()
+{
+    const char *p_dir = std::getenv("HEBENCH_SPILL_DIR");
+    return p_dir && *p_dir ? std::string(p_dir) : std::string("/var/tmp");
+}
+
+void SpillStore::validateDirectory(const std::string &directory)
+{
+#if defined(__linux__)
+    const std::string &resolved = directory.empty() ? defaultDirectory() : directory;
+    struct stat dir_stat;
+    if (stat(resolved.c_str(), &dir_stat) != 0 || !S_ISDIR(dir_stat.st_mode))
+        throw HEBenchError(HEBERROR_MSG_CLASS("Spill directory \"" + resolved + "\" does not exist or is not a directory."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    if (access(resolved.c_str(), W_OK | X_OK) != 0)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Spill directory \"" + resolved + "\" is not writable: " + std::strerror(errno) + "."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+#else
+    (void)directory;
+#endif
+}
+
+SpillStore::SpillStore(const std::string &directory, std::uint64_t budget, std::uint64_t chunk_size) :
+    m_directory(directory.empty() ? defaultDirectory() : directory),
+    m_budget(budget),
+    m_p_current(nullptr),
+    m_stored_bytes(0),
+    m_resident_bytes(0),
+    m_paging_out_bytes(0),
+    m_page_out_count(0)
+{
+#if defined(__linux__)
+    long page_size = sysconf(_SC_PAGESIZE);
+    m_page_size    = page_size > 0 ? static_cast<std::uint64_t>(page_size) : 4096;
+#else
+    m_page_size = 4096;
+#endif
+    // whole pages, and room for, at least, two small payloads
+    m_chunk_size = (std::max(chunk_size, 2 * m_page_size) + m_page_size - 1) / m_page_size * m_page_size;
+}
+
+SpillStore::~SpillStore()
+{
+    while (!m_chunks.empty())
+        releaseChunk(m_chunks.back().get());
+}
+
+std::uint64_t SpillStore::budget() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget;
+}
+
+void SpillStore::setBudget(std::uint64_t budget)
+{
+    std::list<internal::SpillEntry *> victims;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_budget = budget;
+        selectVictims(false, victims);
+    }
+    pageOut(victims);
+}
+
+std::uint64_t SpillStore::storedBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stored_bytes;
+}
+
+std::uint64_t SpillStore::residentBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_resident_bytes;
+}
+
+std::uint64_t SpillStore::pageOutCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_page_out_count;
+}
+
+SpilledBuffer SpillStore::allocate(std::uint64_t size)
+{
+    if (size > std::numeric_limits<std::uint64_t>::max() - m_page_size)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Invalid buffer size " + std::to_string(size) + "."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+    std::uint64_t rounded = (std::max<std::uint64_t>(size, 1) + m_page_size - 1) / m_page_size * m_page_size;
+    std::unique_ptr<internal::SpillEntry> p_entry(new internal::SpillEntry());
+
+    // chunks are created without the lock: creating the file and reserving its blocks
+    // may take long; unused chunks are released after the lock
+    std::unique_ptr<internal::SpillChunk> p_new_chunk;
+    if (rounded > m_chunk_size / 2)
+        p_new_chunk = createChunk(rounded);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    internal::SpillChunk *p_chunk = nullptr;
+    if (p_new_chunk)
+    {
+        m_chunks.emplace_back(std::move(p_new_chunk));
+        p_chunk = m_chunks.back().get();
+    } // end if
+    while (!p_chunk)
+    {
+        if (m_p_current && m_p_current->size - m_p_current->used >= rounded)
+            p_chunk = m_p_current;
+        else if (p_new_chunk)
+        {
+            // previous chunk is released with its last payload
+            m_chunks.emplace_back(std::move(p_new_chunk));
+            m_p_current = m_chunks.back().get();
+            p_chunk     = m_p_current;
+        } // end else if
+        else
+        {
+            // another thread may publish a chunk meanwhile, so the current one is checked again
+            lock.unlock();
+            p_new_chunk = createChunk(m_chunk_size);
+            lock.lock();
+        } // end else
+    } // end while
+
+    p_entry->p_chunk    = p_chunk;
+    p_entry->offset     = p_chunk->used;
+    p_entry->size       = rounded;
+    p_entry->pins       = 0;
+    p_entry->resident   = false;
+    p_entry->in_lru     = false;
+    p_entry->paging_out = false;
+    p_entry->written    = false;
+    p_chunk->used += rounded;
+    ++p_chunk->live;
+    m_stored_bytes += rounded;
+    return SpilledBuffer(this, p_entry.release(), size);
+}
+
+void SpillStore::pageOutAll()
+{
+    std::list<internal::SpillEntry *> victims;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        selectVictims(true, victims);
+    }
+    pageOut(victims);
+}
+
+void SpillStore::pin(internal::SpillEntry *p_entry)
+{
+    bool b_page_in = false;
+    std::list<internal::SpillEntry *> victims;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // the payload must not be touched while being written back
+        m_page_out_done.wait(lock, [p_entry]() { return !p_entry->paging_out; });
+        if (p_entry->in_lru)
+        {
+            m_lru.erase(p_entry->lru_it);
+            p_entry->in_lru = false;
+        } // end if
+        if (!p_entry->resident)
+        {
+            p_entry->resident = true;
+            m_resident_bytes += p_entry->size;
+            b_page_in = true;
+        } // end if
+        ++p_entry->pins;
+        selectVictims(false, victims);
+    }
+#if defined(__linux__)
+    // read ahead the whole payload instead of faulting it in page by page
+    if (b_page_in)
+        madvise(p_entry->p_chunk->p_base + p_entry->offset, p_entry->size, MADV_WILLNEED);
+#else
+    (void)b_page_in;
+#endif
+    pageOut(victims);
+}
+
+void SpillStore::unpin(internal::SpillEntry *p_entry) noexcept
+{
+    std::list<internal::SpillEntry *> victims;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--p_entry->pins == 0)
+        {
+            m_lru.push_front(p_entry);
+            p_entry->lru_it = m_lru.begin();
+            p_entry->in_lru = true;
+            selectVictims(false, victims);
+        } // end if
+    }
+    pageOut(victims);
+}
+
+void SpillStore::release(internal::SpillEntry *p_entry) noexcept
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_page_out_done.wait(lock, [p_entry]() { return !p_entry->paging_out; });
+    if (p_entry->in_lru)
+        m_lru.erase(p_entry->lru_it);
+    if (p_entry->resident)
+        m_resident_bytes -= p_entry->size;
+    m_stored_bytes -= p_entry->size;
+
+    internal::SpillChunk *p_chunk = p_entry->p_chunk;
+    if (--p_chunk->live == 0)
+    {
+        if (p_chunk == m_p_current)
+            m_p_current = nullptr;
+        releaseChunk(p_chunk);
+    } // end if
+    else
+    {
+#if defined(__linux__)
+        // punch the payload out of the file; fall back to, at least, dropping the memory
+        void *p = p_chunk->p_base + p_entry->offset;
+        if (madvise(p, p_entry->size, MADV_REMOVE) != 0)
+            madvise(p, p_entry->size, MADV_DONTNEED);
+#endif
+    } // end else
+    delete p_entry;
+}
+
+bool SpillStore::isResident(const internal::SpillEntry *p_entry) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return p_entry->resident;
+}
+
+std::unique_ptr<internal::SpillChunk> SpillStore::createChunk(std::uint64_t size) const
+{
+    std::unique_ptr<internal::SpillChunk> p_chunk(new internal::SpillChunk());
+#if defined(__linux__)
+    std::string path_template = m_directory + "/hebench_spill_XXXXXX";
+    std::vector<char> path(path_template.begin(), path_template.end());
+    path.push_back('\0');
+    p_chunk->fd = mkstemp(path.data());
+    if (p_chunk->fd < 0)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Failed to create spill file in \"" + m_directory + "\": "
+                                              + std::strerror(errno) + "."),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+    // the file lives only as long as its descriptor and mapping
+    unlink(path.data());
+    // reserve the blocks of the file up front: writing back a sparse mapping on a full
+    // disk would fail with SIGBUS on access, or lose the data of a page out
+    int err = posix_fallocate(p_chunk->fd, 0, static_cast<off_t>(size));
+    if (err != 0)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Failed to reserve " + std::to_string(size) + " bytes of spill file in \""
+                                              + m_directory + "\": " + std::strerror(err) + "."),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+    void *p_base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, p_chunk->fd, 0);
+    if (p_base == MAP_FAILED)
+    {
+        err = errno;
+        throw HEBenchError(HEBERROR_MSG_CLASS("Failed to map " + std::to_string(size) + " bytes of spill file in \""
+                                              + m_directory + "\": " + std::strerror(err) + "."),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+    } // end if
+    p_chunk->p_base = static_cast<std::uint8_t *>(p_base);
+#else
+    // no memory mapped files: payloads stay in memory
+    p_chunk->p_base = static_cast<std::uint8_t *>(allocateAligned(size, static_cast<std::size_t>(m_page_size)));
+    std::memset(p_chunk->p_base, 0, size);
+#endif
+    p_chunk->size = size;
+    return p_chunk;
+}
+
+void SpillStore::releaseChunk(internal::SpillChunk *p_chunk) noexcept
+{
+    // the chunk unmaps its memory when destroyed
+    auto it = std::find_if(m_chunks.begin(), m_chunks.end(),
+                           [p_chunk](const std::unique_ptr<internal::SpillChunk> &p) { return p.get() == p_chunk; });
+    if (it != m_chunks.end())
+        m_chunks.erase(it);
+}
+
+void SpillStore::selectVictims(bool b_all, std::list<internal::SpillEntry *> &victims) noexcept
+{
+#if defined(__linux__)
+    // payloads already being paged out count as gone, so that concurrent callers do
+    // not page out more than needed
+    while (!m_lru.empty()
+           && (b_all || (m_budget > 0 && m_resident_bytes - m_paging_out_bytes > m_budget)))
+    {
+        internal::SpillEntry *p_entry = m_lru.back();
+        // splicing keeps the node, and lru_it, valid without allocating
+        victims.splice(victims.begin(), m_lru, p_entry->lru_it);
+        p_entry->in_lru     = false;
+        p_entry->paging_out = true;
+        m_paging_out_bytes += p_entry->size;
+    } // end while
+#else
+    (void)b_all;
+    (void)victims;
+#endif
+}
+
+void SpillStore::pageOut(std::list<internal::SpillEntry *> &victims) noexcept
+{
+    if (victims.empty())
+        return;
+
+#if defined(__linux__)
+    // victims can be neither pinned nor released until marked done below, so their
+    // memory is accessed without the lock
+    for (internal::SpillEntry *p_entry : victims)
+    {
+        // write the payload back so that its pages are clean, then drop them from the
+        // mapping and from the page cache: dirty pages would stay in memory until written
+        void *p          = p_entry->p_chunk->p_base + p_entry->offset;
+        p_entry->written = msync(p, p_entry->size, MS_SYNC) == 0;
+        if (p_entry->written)
+        {
+            madvise(p, p_entry->size, MADV_DONTNEED);
+            posix_fadvise(p_entry->p_chunk->fd, static_cast<off_t>(p_entry->offset), static_cast<off_t>(p_entry->size),
+                          POSIX_FADV_DONTNEED);
+        } // end if
+    } // end for
+#endif
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = victims.begin(); it != victims.end();)
+        {
+            internal::SpillEntry *p_entry = *it++;
+            p_entry->paging_out           = false;
+            m_paging_out_bytes -= p_entry->size;
+            if (p_entry->written)
+            {
+                p_entry->resident = false;
+                m_resident_bytes -= p_entry->size;
+                ++m_page_out_count;
+            } // end if
+            else
+            {
+                // the only copy of the payload is in memory: keep it resident, as the
+                // least recently used, so that it is tried again on next page out
+                m_lru.splice(m_lru.end(), victims, p_entry->lru_it);
+                p_entry->in_lru = true;
+            } // end else
+        } // end for
+    }
+    m_page_out_done.notify_all();
+}
+
+} // namespace cpp
+} // namespace hebench
@@ -0,0 +1,268 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "hebench/api_bridge/cpp/thread_pool.hpp"
+
+namespace hebench {
+namespace cpp {
+
+namespace {
+
+// identifies the pool and queue of the calling worker thread
+thread_local const ThreadPool *t_p_worker_pool     = nullptr;
+thread_local std::size_t t_worker_index            = 0;
+constexpr std::size_t TasksPerWorker               = 4;
+constexpr std::chrono::microseconds WaitHelpPeriod = std::chrono::microseconds(500);
+
+} // namespace
+
+//------------------
+// class ThreadPool
+//------------------
+
+ThreadPool::ThreadPool(std::size_t thread_count, bool b_pin_threads) :
+    m_queued(0),
+    m_next_queue(0),
+    m_b_stop(false),
+    m_b_pin_threads(b_pin_threads)
+{
+    if (thread_count == 0)
+        thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+    m_queues.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i)
+        m_queues.emplace_back(new WorkerQueue());
+
+    m_workers.reserve(thread_count);
+    try
+    {
+        for (std::size_t i = 0; i < thread_count; ++i)
+            m_workers.emplace_back(&ThreadPool::workerMain, this, i);
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_b_stop = true;
+        }
+        m_sleep_cv.notify_all();
+        for (auto &worker : m_workers)
+            worker.join();
+        throw;
+    }
+
+    if (m_b_pin_threads)
+        pinWorkers();
+}
+
+void ThreadPool::pinWorkers()
+{
+#ifdef __linux__
+    cpu_set_t available;
+    CPU_ZERO(&available);
+    if (sched_getaffinity(0, sizeof(available), &available) != 0)
+        return;
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &available))
+            cpus.push_back(cpu);
+    if (cpus.empty())
+        return;
+
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpus[i % cpus.size()], &cpu_set);
+        // best effort: an unpinned worker is still a valid worker
+        pthread_setaffinity_np(m_workers[i].native_handle(), sizeof(cpu_set), &cpu_set);
+    } // end for
+#endif
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_b_stop = true;
+    }
+    m_sleep_cv.notify_all();
+    for (auto &worker : m_workers)
+        if (worker.joinable())
+            worker.join();
+}
+
+bool ThreadPool::isWorkerThread() const
+{
+    return t_p_worker_pool == this;
+}
+
+void ThreadPool::submit(Task task)
+{
+    if (!task)
+        throw std::invalid_argument(HEBERROR_MSG_CLASS("Invalid empty task."));
+
+    // workers keep their own tasks local; others spread the load
+    std::size_t queue_index = isWorkerThread() ?
+                                  t_worker_index :
+                                  m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    // count before pushing so that the counter never underflows
+    m_queued.fetch_add(1, std::memory_order_release);
+    try
+    {
+        std::lock_guard<std::mutex> lock(m_queues[queue_index]->mutex);
+        m_queues[queue_index]->tasks.emplace_back(std::move(task));
+    }
+    catch (...)
+    {
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+
+    {
+        // synchronize with sleeping workers to avoid missing the wake up
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    }
+    m_sleep_cv.notify_one();
+}
+
+bool ThreadPool::runPendingTask()
+{
+    Task task;
+    bool b_found = isWorkerThread() ?
+                       popTask(t_worker_index, task) || stealTask(t_worker_index, task) :
+                       stealTask(m_next_queue.load(std::memory_order_relaxed) % m_queues.size(), task);
+    if (b_found)
+    {
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            // discard: see submit()
+        }
+    } // end if
+    return b_found;
+}
+
+bool ThreadPool::popTask(std::size_t queue_index, Task &task)
+{
+    WorkerQueue &queue = *m_queues[queue_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ThreadPool::stealTask(std::size_t thief_index, Task &task)
+{
+    if (m_queued.load(std::memory_order_acquire) == 0)
+        return false;
+
+    for (std::size_t i = 0; i < m_queues.size(); ++i)
+    {
+        WorkerQueue &queue = *m_queues[(thief_index + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        } // end if
+    } // end for
+
+    return false;
+}
+
+void ThreadPool::workerMain(std::size_t worker_index)
+{
+    t_p_worker_pool = this;
+    t_worker_index  = worker_index;
+
+    while (true)
+    {
+        if (!runPendingTask())
+        {
+            std::unique_lock<std::mutex> lock(m_sleep_mutex);
+            if (m_b_stop && m_queued.load(std::memory_order_acquire) == 0)
+                break;
+            m_sleep_cv.wait(lock, [this]() {
+                return m_b_stop || m_queued.load(std::memory_order_acquire) > 0;
+            });
+        } // end if
+    } // end while
+
+    t_p_worker_pool = nullptr;
+}
+
+std::size_t ThreadPool::defaultGrain(std::size_t count) const
+{
+    std::size_t tasks = threadCount() * TasksPerWorker;
+    return std::max<std::size_t>((count + tasks - 1) / tasks, 1);
+}
+
+//-----------------
+// class TaskGroup
+//-----------------
+
+TaskGroup::~TaskGroup()
+{
+    waitAll();
+}
+
+void TaskGroup::onTaskDone(std::exception_ptr p_ex)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (p_ex && !m_p_exception)
+        m_p_exception = p_ex;
+    if (--m_pending == 0)
+        m_cv.notify_all();
+}
+
+void TaskGroup::waitAll()
+{
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_pending == 0)
+                break;
+        }
+        if (!m_pool.runPendingTask())
+        {
+            // nothing to help with: block until a task completes or new work may be available
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait_for(lock, WaitHelpPeriod, [this]() { return m_pending == 0; });
+        } // end if
+    } // end while
+}
+
+void TaskGroup::wait()
+{
+    waitAll();
+
+    std::exception_ptr p_ex;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(p_ex, m_p_exception);
+    }
+    if (p_ex)
+        std::rethrow_exception(p_ex);
+}
+
+} // namespace cpp
+} // namespace hebench
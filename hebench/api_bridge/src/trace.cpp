@@ -0,0 +1,379 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "hebench/api_bridge/cpp/trace.hpp"
+
+namespace hebench {
+namespace cpp {
+
+namespace {
+
+constexpr char TraceFileMagic[8]         = { 'H', 'E', 'B', 'T', 'R', 'A', 'C', 'E' };
+constexpr std::uint32_t TraceFileVersion = 1;
+
+static_assert((Tracer::RingCapacity & (Tracer::RingCapacity - 1)) == 0, "Tracer::RingCapacity must be a power of 2.");
+
+/**
+ * @brief Single-producer ring of trace records, drained by any thread.
+ * @details Records are stored as relaxed atomic words, so that draining while
+ * the owner thread records is well defined. The owner claims a slot before
+ * overwriting it, and the drainer discards any record whose slot was claimed
+ * while copying it, as in a sequence lock.
+ */
+class TraceRing
+{
+public:
+    static constexpr std::size_t WordsPerRecord = sizeof(TraceRecord) / sizeof(std::uint64_t);
+
+    explicit TraceRing(std::uint64_t thread_id) :
+        m_thread_id(thread_id),
+        m_words(new std::atomic<std::uint64_t>[Tracer::RingCapacity * WordsPerRecord]),
+        m_claimed(0),
+        m_head(0),
+        m_tail(0),
+        m_b_retired(false)
+    {
+    }
+
+    std::uint64_t threadID() const { return m_thread_id; }
+    bool retired() const { return m_b_retired.load(std::memory_order_acquire); }
+    void retire() { m_b_retired.store(true, std::memory_order_release); }
+
+    void push(const TraceRecord &rec) noexcept
+    {
+        std::uint64_t words[WordsPerRecord];
+        std::memcpy(words, &rec, sizeof(rec));
+
+        // only the owner thread writes
+        std::uint64_t head = m_head.load(std::memory_order_relaxed);
+        m_claimed.store(head + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::atomic<std::uint64_t> *p_slot = slot(head);
+        for (std::size_t i = 0; i < WordsPerRecord; ++i)
+            p_slot[i].store(words[i], std::memory_order_relaxed);
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copies the records pushed since the last call into \p records.
+     * @return Number of records lost to overwriting since the last call.
+     * @details Only one thread may drain a ring at a time.
+     */
+    std::uint64_t drain(std::vector<TraceRecord> &records)
+    {
+        std::uint64_t retval = 0;
+        std::uint64_t head   = m_head.load(std::memory_order_acquire);
+        std::uint64_t first  = m_tail;
+        if (head - first > Tracer::RingCapacity)
+        {
+            retval += head - Tracer::RingCapacity - first;
+            first = head - Tracer::RingCapacity;
+        } // end if
+
+        records.resize(head - first);
+        for (std::uint64_t rec_i = first; rec_i < head; ++rec_i)
+        {
+            std::uint64_t words[WordsPerRecord];
+            const std::atomic<std::uint64_t> *p_slot = slot(rec_i);
+            for (std::size_t i = 0; i < WordsPerRecord; ++i)
+                words[i] = p_slot[i].load(std::memory_order_relaxed);
+            std::memcpy(&records[rec_i - first], words, sizeof(TraceRecord));
+        } // end for
+
+        // discard the records whose slots were claimed again while copying
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::uint64_t claimed = m_claimed.load(std::memory_order_relaxed);
+        if (claimed > first + Tracer::RingCapacity)
+        {
+            std::uint64_t overwritten = std::min(claimed - Tracer::RingCapacity - first, head - first);
+            records.erase(records.begin(), records.begin() + overwritten);
+            retval += overwritten;
+        } // end if
+
+        m_tail = head;
+        return retval;
+    }
+
+private:
+    std::atomic<std::uint64_t> *slot(std::uint64_t rec_i) const noexcept
+    {
+        return m_words.get() + (rec_i & (Tracer::RingCapacity - 1)) * WordsPerRecord;
+    }
+
+    std::uint64_t m_thread_id;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> m_words;
+    std::atomic<std::uint64_t> m_claimed;
+    std::atomic<std::uint64_t> m_head;
+    std::uint64_t m_tail; // only accessed by the drainer
+    std::atomic<bool> m_b_retired;
+};
+
+struct TraceRegistry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceRing>> rings;
+    std::uint64_t next_thread_id = 1;
+};
+
+TraceRegistry &traceRegistry()
+{
+    // never destroyed: threads may record while the process exits
+    static TraceRegistry *p_registry = new TraceRegistry();
+    return *p_registry;
+}
+
+// ring of the calling thread, kept by the registry after the thread exits until drained
+struct ThreadTraceRing
+{
+    std::shared_ptr<TraceRing> p_ring;
+    ~ThreadTraceRing()
+    {
+        if (p_ring)
+            p_ring->retire();
+    }
+};
+
+thread_local ThreadTraceRing t_trace_ring;
+
+TraceRing *registerThreadTraceRing()
+{
+    TraceRegistry &registry = traceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::shared_ptr<TraceRing> p_ring = std::make_shared<TraceRing>(registry.next_thread_id++);
+    registry.rings.push_back(p_ring);
+    t_trace_ring.p_ring = std::move(p_ring);
+    return t_trace_ring.p_ring.get();
+}
+
+template <class T>
+void writeBinary(std::ostream &os, const T &value)
+{
+    os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <class T>
+bool readBinary(std::istream &is, T &value)
+{
+    return static_cast<bool>(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+} // namespace
+
+const char *traceEventName(TraceEvent event) noexcept
+{
+    static const char *const names[] = {
+        "destroyHandle",
+        "initEngine",
+        "subscribeBenchmarksCount",
+        "subscribeBenchmarks",
+        "getWorkloadParamsDetails",
+        "describeBenchmark",
+        "createBenchmark",
+        "initBenchmark",
+        "encode",
+        "decode",
+        "encrypt",
+        "decrypt",
+        "load",
+        "store",
+        "operate",
+        "getSchemeName",
+        "getSchemeSecurityName",
+        "getBenchmarkDescriptionEx",
+        "getErrorDescription",
+        "getLastErrorDescription",
+        "getHandleStats"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == static_cast<std::size_t>(TraceEvent::Count),
+                  "Every trace event must have a name.");
+    std::size_t event_i = static_cast<std::size_t>(event);
+    return event_i < static_cast<std::size_t>(TraceEvent::Count) ? names[event_i] : "unknown";
+}
+
+//--------------
+// class Tracer
+//--------------
+
+std::atomic<bool> Tracer::m_b_enabled(!Tracer::environmentFilename().empty());
+
+const std::string &Tracer::environmentFilename()
+{
+    static const std::string filename = []() {
+        const char *s_value = std::getenv("HEBENCH_TRACE");
+        return std::string(s_value ? s_value : "");
+    }();
+    return filename;
+}
+
+std::uint64_t Tracer::now() noexcept
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+}
+
+void Tracer::record(const TraceRecord &rec) noexcept
+{
+    TraceRing *p_ring = t_trace_ring.p_ring.get();
+    if (!p_ring)
+    {
+        try
+        {
+            p_ring = registerThreadTraceRing();
+        }
+        catch (...)
+        {
+            return; // tracing must never fail the traced call
+        }
+    } // end if
+    p_ring->push(rec);
+}
+
+std::uint64_t Tracer::drainToFile(const std::string &filename, bool b_append)
+{
+    std::uint64_t retval = 0;
+
+    std::ofstream ofs(filename, std::ios_base::out | std::ios_base::binary
+                                    | (b_append ? std::ios_base::app : std::ios_base::trunc));
+    if (!ofs)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Unable to open trace file for writing: " + filename),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+    // thread blocks follow the header: appending only needs a header for empty files
+    ofs.seekp(0, std::ios_base::end);
+    if (ofs.tellp() == std::streampos(0))
+    {
+        ofs.write(TraceFileMagic, sizeof(TraceFileMagic));
+        writeBinary(ofs, TraceFileVersion);
+        writeBinary(ofs, static_cast<std::uint32_t>(sizeof(TraceRecord)));
+    } // end if
+
+    TraceRegistry &registry = traceRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<TraceRecord> records;
+    for (auto it = registry.rings.begin(); it != registry.rings.end();)
+    {
+        TraceRing &ring = **it;
+        // check before draining: a ring retired afterwards may still receive records
+        bool b_retired              = ring.retired();
+        std::uint64_t dropped_count = ring.drain(records);
+        if (!records.empty() || dropped_count > 0)
+        {
+            writeBinary(ofs, ring.threadID());
+            writeBinary(ofs, static_cast<std::uint64_t>(records.size()));
+            writeBinary(ofs, dropped_count);
+            ofs.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(TraceRecord));
+            retval += records.size();
+        } // end if
+        // rings of exited threads are released once drained
+        it = b_retired ? registry.rings.erase(it) : it + 1;
+    } // end for
+
+    ofs.flush();
+    if (!ofs)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Error writing trace file: " + filename),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+
+    return retval;
+}
+
+void Tracer::convertToChromeTrace(const std::string &trace_filename, const std::string &json_filename)
+{
+    struct ThreadRecords
+    {
+        std::uint64_t thread_id;
+        std::uint64_t dropped_count;
+        std::vector<TraceRecord> records;
+    };
+
+    std::ifstream ifs(trace_filename, std::ios_base::in | std::ios_base::binary);
+    if (!ifs)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Unable to open trace file for reading: " + trace_filename),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+
+    char magic[sizeof(TraceFileMagic)];
+    std::uint32_t version     = 0;
+    std::uint32_t record_size = 0;
+    if (!ifs.read(magic, sizeof(magic))
+        || std::memcmp(magic, TraceFileMagic, sizeof(magic)) != 0
+        || !readBinary(ifs, version) || version != TraceFileVersion
+        || !readBinary(ifs, record_size) || record_size != sizeof(TraceRecord))
+        throw HEBenchError(HEBERROR_MSG_CLASS("Invalid or unsupported trace file: " + trace_filename),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+
+    std::vector<ThreadRecords> threads;
+    std::uint64_t min_timestamp = std::numeric_limits<std::uint64_t>::max();
+    ThreadRecords block;
+    while (readBinary(ifs, block.thread_id))
+    {
+        std::uint64_t record_count = 0;
+        if (!readBinary(ifs, record_count) || !readBinary(ifs, block.dropped_count)
+            || record_count > std::numeric_limits<std::size_t>::max() / sizeof(TraceRecord))
+            throw HEBenchError(HEBERROR_MSG_CLASS("Truncated trace file: " + trace_filename),
+                               HEBENCH_ECODE_CRITICAL_ERROR);
+        block.records.resize(record_count);
+        if (!ifs.read(reinterpret_cast<char *>(block.records.data()), record_count * sizeof(TraceRecord)))
+            throw HEBenchError(HEBERROR_MSG_CLASS("Truncated trace file: " + trace_filename),
+                               HEBENCH_ECODE_CRITICAL_ERROR);
+        for (const TraceRecord &rec : block.records)
+            min_timestamp = std::min(min_timestamp, rec.timestamp);
+        threads.emplace_back(std::move(block));
+        block = ThreadRecords();
+    } // end while
+
+    std::ofstream ofs(json_filename, std::ios_base::out | std::ios_base::trunc);
+    if (!ofs)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Unable to open file for writing: " + json_filename),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+
+    // timestamps are in microseconds, relative to the earliest record
+    ofs << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" << std::fixed << std::setprecision(3);
+    bool b_first = true;
+    for (const ThreadRecords &thread : threads)
+    {
+        if (thread.dropped_count > 0)
+        {
+            // mark lost records at the start of the thread timeline
+            ofs << (b_first ? "\n" : ",\n")
+                << "{\"name\":\"dropped records\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":" << thread.thread_id
+                << ",\"ts\":" << (thread.records.empty() ? 0.0 : (thread.records.front().timestamp - min_timestamp) / 1000.0)
+                << ",\"args\":{\"count\":" << thread.dropped_count << "}}";
+            b_first = false;
+        } // end if
+        for (const TraceRecord &rec : thread.records)
+        {
+            bool b_begin = rec.phase == static_cast<std::uint8_t>(TracePhase::Begin);
+            ofs << (b_first ? "\n" : ",\n")
+                << "{\"name\":\"" << traceEventName(static_cast<TraceEvent>(rec.event))
+                << "\",\"cat\":\"hebench\",\"ph\":\"" << (b_begin ? 'B' : 'E')
+                << "\",\"pid\":0,\"tid\":" << thread.thread_id
+                << ",\"ts\":" << (rec.timestamp - min_timestamp) / 1000.0
+                << ",\"args\":{\"tag\":\"0x" << std::hex << static_cast<std::uint64_t>(rec.tag) << std::dec
+                << "\",\"size\":" << rec.size;
+            if (!b_begin)
+                ofs << ",\"error_code\":" << rec.error_code;
+            ofs << "}}";
+            b_first = false;
+        } // end for
+    } // end for
+    ofs << "\n]}\n";
+
+    ofs.flush();
+    if (!ofs)
+        throw HEBenchError(HEBERROR_MSG_CLASS("Error writing file: " + json_filename),
+                           HEBENCH_ECODE_CRITICAL_ERROR);
+}
+
+} // namespace cpp
+} // namespace hebench
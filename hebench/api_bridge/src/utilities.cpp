@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <algorithm>
+#include <cstring>
 
 #include "hebench/api_bridge/cpp/utilities.hpp"
 
@@ -25,6 +26,42 @@ std::uint64_t copyString(char *dst, std::uint64_t size, const std::string &src)
     return retval;
 }
 
+std::uint64_t hash64(const void *p, std::uint64_t size, std::uint64_t seed)
+{
+    // MurmurHash64A
+    constexpr std::uint64_t m = 0xc6a4a7935bd1e995ULL;
+    constexpr int r           = 47;
+
+    const unsigned char *p_bytes = reinterpret_cast<const unsigned char *>(p);
+    std::uint64_t retval         = seed ^ (size * m);
+
+    std::uint64_t block_count = size / sizeof(std::uint64_t);
+    for (std::uint64_t i = 0; i < block_count; ++i)
+    {
+        std::uint64_t k;
+        std::memcpy(&k, p_bytes + i * sizeof(std::uint64_t), sizeof(k)); // unaligned load
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        retval ^= k;
+        retval *= m;
+    } // end for
+
+    std::uint64_t tail_size = size % sizeof(std::uint64_t);
+    if (tail_size > 0)
+    {
+        const unsigned char *p_tail = p_bytes + block_count * sizeof(std::uint64_t);
+        for (std::uint64_t i = tail_size; i-- > 0;)
+            retval ^= static_cast<std::uint64_t>(p_tail[i]) << (8 * i);
+        retval *= m;
+    } // end if
+
+    retval ^= retval >> r;
+    retval *= m;
+    retval ^= retval >> r;
+    return retval;
+}
+
 } // namespace Utilities
 } // namespace cpp
 } // namespace hebench
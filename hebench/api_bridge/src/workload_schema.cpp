@@ -0,0 +1,235 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include "hebench/api_bridge/cpp/workload_schema.hpp"
+
+namespace hebench {
+namespace cpp {
+
+namespace {
+
+const char *paramTypeName(hebench::APIBridge::WorkloadParamType::WorkloadParamType data_type)
+{
+    switch (data_type)
+    {
+    case hebench::APIBridge::WorkloadParamType::Int64:
+        return "Int64";
+    case hebench::APIBridge::WorkloadParamType::UInt64:
+        return "UInt64";
+    case hebench::APIBridge::WorkloadParamType::Float64:
+        return "Float64";
+    default:
+        return "Unknown";
+    } // end switch
+}
+
+void printBound(std::ostream &os, double value)
+{
+    if (std::isinf(value))
+        os << (value < 0.0 ? "-inf" : "inf");
+    else
+        os << value;
+}
+
+[[noreturn]] HEBENCH_COLD void throwInvalidParam(const WorkloadParamSpec &spec, std::uint64_t index, const std::string &reason)
+{
+    throw HEBenchError(HEBERROR_MSG("Invalid workload parameter " + std::to_string(index) + " (\"" + spec.name + "\"): " + reason),
+                       HEBENCH_ECODE_INVALID_ARGS);
+}
+
+void validateWorkloadParam(const WorkloadParamSpec &spec, std::uint64_t index, const hebench::APIBridge::WorkloadParam &param)
+{
+    if (param.data_type != spec.data_type)
+        throwInvalidParam(spec, index, std::string("expected type WorkloadParamType::") + paramTypeName(spec.data_type) + ".");
+
+    bool b_in_range;
+    switch (spec.data_type)
+    {
+    case hebench::APIBridge::WorkloadParamType::Int64:
+        b_in_range = param.i_param >= spec.i_min && param.i_param <= spec.i_max;
+        break;
+    case hebench::APIBridge::WorkloadParamType::UInt64:
+        b_in_range = param.u_param >= spec.u_min && param.u_param <= spec.u_max;
+        break;
+    default:
+        // also rejects NaN
+        b_in_range = param.f_param >= spec.f_min && param.f_param <= spec.f_max;
+        break;
+    } // end switch
+    if (!b_in_range)
+    {
+        std::stringstream ss;
+        ss << "value out of range ";
+        switch (spec.data_type)
+        {
+        case hebench::APIBridge::WorkloadParamType::Int64:
+            ss << param.i_param << " not in [" << spec.i_min << ", " << spec.i_max << "].";
+            break;
+        case hebench::APIBridge::WorkloadParamType::UInt64:
+            ss << param.u_param << " not in [" << spec.u_min << ", " << spec.u_max << "].";
+            break;
+        default:
+            ss << param.f_param << " not in [";
+            printBound(ss, spec.f_min);
+            ss << ", ";
+            printBound(ss, spec.f_max);
+            ss << "].";
+            break;
+        } // end switch
+        throwInvalidParam(spec, index, ss.str());
+    } // end if
+}
+
+// name of the length parameter with the specified index for an input or result component
+std::string lengthParamName(const WorkloadParamSpec &spec, std::uint64_t index)
+{
+    return spec.name + std::to_string(index);
+}
+
+void setParamName(hebench::APIBridge::WorkloadParam &w_param, const std::string &name)
+{
+    std::strncpy(w_param.name, name.c_str(), HEBENCH_MAX_BUFFER_SIZE - 1);
+    w_param.name[HEBENCH_MAX_BUFFER_SIZE - 1] = '\0';
+}
+
+} // namespace
+
+constexpr WorkloadParamSpec WorkloadSchemas::MatrixMultiply::Params[];
+constexpr WorkloadParamSpec WorkloadSchemas::VectorSize::Params[];
+constexpr WorkloadParamSpec WorkloadSchemas::SimpleSetIntersection::Params[];
+constexpr WorkloadParamSpec WorkloadSchemas::Generic::Params[];
+constexpr WorkloadParamSpec WorkloadSchemas::Generic::InputLength;
+constexpr WorkloadParamSpec WorkloadSchemas::Generic::ResultLength;
+
+namespace internal {
+
+void validateWorkloadParams(const WorkloadParamSpec *specs, std::size_t spec_count,
+                            const hebench::APIBridge::WorkloadParam *p_params, std::uint64_t param_count)
+{
+    if (param_count < spec_count || (spec_count > 0 && !p_params))
+        throw HEBenchError(HEBERROR_MSG("Workload requires, at least, " + std::to_string(spec_count) + " parameters, but "
+                                        + std::to_string(p_params ? param_count : 0) + " received."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+
+    for (std::size_t i = 0; i < spec_count; ++i)
+        validateWorkloadParam(specs[i], i, p_params[i]);
+}
+
+void initializeWorkloadParams(const WorkloadParamSpec *specs, std::size_t spec_count,
+                              hebench::APIBridge::WorkloadParam *p_params)
+{
+    for (std::size_t i = 0; i < spec_count; ++i)
+    {
+        // schema names are checked at compile time to fit, terminator included
+        p_params[i].data_type = specs[i].data_type;
+        std::memcpy(p_params[i].name, specs[i].name, std::strlen(specs[i].name) + 1);
+    } // end for
+}
+
+std::string describeWorkloadParams(const WorkloadParamSpec *specs, std::size_t spec_count)
+{
+    std::stringstream ss;
+    for (std::size_t i = 0; i < spec_count; ++i)
+    {
+        const WorkloadParamSpec &spec = specs[i];
+        if (i > 0)
+            ss << ";";
+        ss << spec.name << ":" << paramTypeName(spec.data_type) << "[";
+        switch (spec.data_type)
+        {
+        case hebench::APIBridge::WorkloadParamType::Int64:
+            ss << spec.i_min << "," << spec.i_max;
+            break;
+        case hebench::APIBridge::WorkloadParamType::UInt64:
+            ss << spec.u_min << "," << spec.u_max;
+            break;
+        default:
+            printBound(ss, spec.f_min);
+            ss << ",";
+            printBound(ss, spec.f_max);
+            break;
+        } // end switch
+        ss << "]";
+    } // end for
+    return ss.str();
+}
+
+} // namespace internal
+
+//-----------------------------
+// class GenericWorkloadSchema
+//-----------------------------
+
+GenericWorkloadSchema::Values GenericWorkloadSchema::validate(const hebench::APIBridge::WorkloadParam *p_params, std::uint64_t param_count)
+{
+    constexpr std::size_t FixedCount = sizeof(Schema::Params) / sizeof(Schema::Params[0]);
+    internal::validateWorkloadParams(Schema::Params, FixedCount, p_params, param_count);
+
+    // compared without adding, so that no value of n and m overflows
+    const std::uint64_t n = p_params[Schema::N].u_param;
+    const std::uint64_t m = p_params[Schema::M].u_param;
+    if (param_count - FixedCount < n || param_count - FixedCount - n < m)
+        throw HEBenchError(HEBERROR_MSG("Workload requires, at least, n + m + 2 parameters with n = " + std::to_string(n)
+                                        + " and m = " + std::to_string(m) + ", but " + std::to_string(param_count) + " received."),
+                           HEBENCH_ECODE_INVALID_ARGS);
+
+    for (std::uint64_t i = 0; i < n + m; ++i)
+    {
+        const bool b_input     = i < n;
+        std::string name       = lengthParamName(b_input ? Schema::InputLength : Schema::ResultLength, b_input ? i : i - n);
+        WorkloadParamSpec spec = b_input ? Schema::InputLength : Schema::ResultLength;
+        spec.name              = name.c_str();
+        validateWorkloadParam(spec, FixedCount + i, p_params[FixedCount + i]);
+    } // end for
+
+    return Values(p_params);
+}
+
+std::vector<hebench::APIBridge::WorkloadParam> GenericWorkloadSchema::makeDefault(const std::vector<std::uint64_t> &input_lengths,
+                                                                                  const std::vector<std::uint64_t> &result_lengths)
+{
+    constexpr std::size_t FixedCount = sizeof(Schema::Params) / sizeof(Schema::Params[0]);
+    std::vector<hebench::APIBridge::WorkloadParam> retval(FixedCount + input_lengths.size() + result_lengths.size());
+    internal::initializeWorkloadParams(Schema::Params, FixedCount, retval.data());
+    retval[Schema::N].u_param = input_lengths.size();
+    retval[Schema::M].u_param = result_lengths.size();
+    for (std::size_t i = 0; i < input_lengths.size(); ++i)
+    {
+        hebench::APIBridge::WorkloadParam &w_param = retval[FixedCount + i];
+        w_param.data_type                          = Schema::InputLength.data_type;
+        w_param.u_param                            = input_lengths[i];
+        setParamName(w_param, lengthParamName(Schema::InputLength, i));
+    } // end for
+    for (std::size_t i = 0; i < result_lengths.size(); ++i)
+    {
+        hebench::APIBridge::WorkloadParam &w_param = retval[FixedCount + input_lengths.size() + i];
+        w_param.data_type                          = Schema::ResultLength.data_type;
+        w_param.u_param                            = result_lengths[i];
+        setParamName(w_param, lengthParamName(Schema::ResultLength, i));
+    } // end for
+    validate(retval.data(), retval.size());
+    return retval;
+}
+
+const std::string &GenericWorkloadSchema::descriptor()
+{
+    static const std::string retval = [] {
+        constexpr std::size_t FixedCount = sizeof(Schema::Params) / sizeof(Schema::Params[0]);
+        std::string input_name           = std::string(Schema::InputLength.name) + "[n]";
+        std::string result_name          = std::string(Schema::ResultLength.name) + "[m]";
+        WorkloadParamSpec lengths[]      = { Schema::InputLength, Schema::ResultLength };
+        lengths[0].name                  = input_name.c_str();
+        lengths[1].name                  = result_name.c_str();
+        return internal::describeWorkloadParams(Schema::Params, FixedCount) + ";"
+               + internal::describeWorkloadParams(lengths, 2);
+    }();
+    return retval;
+}
+
+} // namespace cpp
+} // namespace hebench
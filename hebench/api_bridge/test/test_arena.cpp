@@ -0,0 +1,105 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/arena.hpp"
+#include "test_engine.hpp"
+
+using hebench::cpp::Arena;
+using hebench::cpp::ArenaAllocator;
+
+namespace {
+
+struct Tracked
+{
+    Tracked(std::vector<int> &log, int id) :
+        m_log(log), m_id(id) {}
+    ~Tracked() { m_log.push_back(m_id); }
+
+    std::vector<int> &m_log;
+    int m_id;
+};
+
+} // namespace
+
+TEST_CASE("Arena: allocations are aligned and accounted", "[arena]")
+{
+    Arena arena(4096);
+    CHECK(arena.capacity() == 0u);
+
+    void *p0 = arena.allocate(3, 1);
+    void *p1 = arena.allocate(8, 64);
+    void *p2 = arena.allocate(16);
+    CHECK(reinterpret_cast<std::uintptr_t>(p1) % 64 == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(p2) % alignof(std::max_align_t) == 0);
+    CHECK(p0 != p2);
+    CHECK(arena.used() >= 3u + 8u + 16u);
+    CHECK(arena.capacity() >= arena.used());
+
+    // larger than half a chunk: gets a chunk of its own
+    std::size_t capacity = arena.capacity();
+    arena.allocate(4000);
+    CHECK(arena.capacity() >= capacity + 4000u);
+
+    CHECK_THROWS_AS(arena.allocate(8, 3), std::invalid_argument);
+
+    arena.release();
+    CHECK(arena.capacity() == 0u);
+    CHECK(arena.used() == 0u);
+}
+
+TEST_CASE("Arena: destroys tracked objects in reverse order", "[arena]")
+{
+    std::vector<int> log;
+    {
+        Arena arena(256);
+        for (int i = 0; i < 100; ++i)
+            arena.create<Tracked>(log, i);
+        arena.createUntracked<Tracked>(log, -1);
+        CHECK(arena.create<int>(42) != nullptr);
+        CHECK(log.empty());
+    }
+    REQUIRE(log.size() == 100u);
+    for (int i = 0; i < 100; ++i)
+        CHECK(log[i] == 99 - i);
+}
+
+TEST_CASE("Arena: allocator serves standard containers", "[arena]")
+{
+    Arena arena(1024);
+    std::vector<std::uint64_t, ArenaAllocator<std::uint64_t>> values{ ArenaAllocator<std::uint64_t>(arena) };
+    for (std::uint64_t i = 0; i < 1000; ++i)
+        values.push_back(i);
+    CHECK(values[999] == 999u);
+    CHECK(arena.used() >= 1000u * sizeof(std::uint64_t));
+    CHECK(ArenaAllocator<int>(arena) == values.get_allocator());
+}
+
+TEST_CASE("Arena: engine handles release their payload with the arena", "[arena]")
+{
+    std::vector<int> log;
+    hebench::test::TestEngine engine;
+    {
+        Arena arena;
+        hebench::APIBridge::Handle h0 = engine.createHandle<Tracked>(arena, 10, 0, log, 0);
+        hebench::APIBridge::Handle h1 = engine.createHandle<Tracked>(arena, 20, 0, log, 1);
+        CHECK(engine.retrieveFromHandle<Tracked>(h1).m_id == 1);
+        CHECK(engine.getHandleStats().live_count == 2u);
+        CHECK(engine.getHandleStats().live_size == 30u);
+
+        // destroying an arena handle only updates accounting
+        hebench::test::destroyObjectHandle(h0);
+        CHECK(engine.getHandleStats().live_count == 1u);
+        CHECK(log.empty());
+
+        hebench::test::destroyObjectHandle(h1);
+        CHECK(engine.getHandleStats().live_count == 0u);
+    }
+    CHECK(log.size() == 2u);
+}
@@ -0,0 +1,129 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/async_benchmark.hpp"
+#include "test_engine.hpp"
+
+using namespace hebench::cpp;
+using hebench::test::destroyObjectHandle;
+using hebench::test::NativeData;
+using hebench::test::TestEngine;
+namespace APIBridge = hebench::APIBridge;
+
+namespace {
+
+typedef std::vector<double> Vector;
+
+Task<double> sumAsync(ThreadPool &pool, const Vector &values)
+{
+    co_await resumeOn(pool);
+    double retval = 0;
+    for (double value : values)
+        retval += value;
+    co_return retval;
+}
+
+Task<> failAsync(ThreadPool &pool)
+{
+    co_await resumeOn(pool);
+    throw std::runtime_error("failed");
+}
+
+// remote operation: sums the elements of the first sample, off the calling thread
+class SumBenchmark : public AsyncBenchmark
+{
+public:
+    SumBenchmark(BaseEngine &engine, const APIBridge::BenchmarkDescriptor &bench_desc) :
+        AsyncBenchmark(engine, bench_desc) {}
+
+    APIBridge::Handle encode(const APIBridge::DataPackCollection *p_parameters) override
+    {
+        const APIBridge::NativeDataBuffer &buffer = p_parameters->p_data_packs[0].p_buffers[0];
+        const double *p_data                      = reinterpret_cast<const double *>(buffer.p);
+        return getEngine().createHandle<Vector>(buffer.size, 0, p_data, p_data + buffer.size / sizeof(double));
+    }
+    void decode(APIBridge::Handle encoded_data, APIBridge::DataPackCollection *p_native) override
+    {
+        const Vector &values = getEngine().retrieveConstFromHandle<Vector>(encoded_data);
+        *reinterpret_cast<double *>(p_native->p_data_packs[0].p_buffers[0].p) = values.front();
+    }
+    APIBridge::Handle encrypt(APIBridge::Handle encoded_data) override { return getEngine().duplicateHandle(encoded_data); }
+    APIBridge::Handle decrypt(APIBridge::Handle encrypted_data) override { return getEngine().duplicateHandle(encrypted_data); }
+
+    Task<APIBridge::Handle> loadAsync(const APIBridge::Handle *p_local_data, std::uint64_t count) override
+    {
+        if (count != 1)
+            throw std::invalid_argument("count");
+        co_await resumeOn(getEngine().threadPool());
+        load_thread = std::this_thread::get_id();
+        co_return getEngine().duplicateHandle(p_local_data[0]);
+    }
+    Task<> storeAsync(APIBridge::Handle remote_data, APIBridge::Handle *p_local_data, std::uint64_t count) override
+    {
+        if (count > 0)
+            p_local_data[0] = getEngine().duplicateHandle(remote_data);
+        co_return;
+    }
+    Task<APIBridge::Handle> operateAsync(APIBridge::Handle h_remote_packed,
+                                         const APIBridge::ParameterIndexer *p_param_indexers,
+                                         std::uint64_t indexers_count) override
+    {
+        (void)p_param_indexers;
+        if (indexers_count == 0)
+            co_await failAsync(getEngine().threadPool());
+        const Vector &values = getEngine().retrieveConstFromHandle<Vector>(h_remote_packed);
+        double sum           = co_await sumAsync(getEngine().threadPool(), values);
+        co_return getEngine().createHandle<Vector>(sizeof(double), 0, 1, sum);
+    }
+
+    std::thread::id load_thread;
+};
+
+} // namespace
+
+TEST_CASE("AsyncBenchmark: runs coroutines to completion through syncWait", "[async_benchmark]")
+{
+    TestEngine engine;
+    engine.setThreadPoolSize(2);
+    APIBridge::BenchmarkDescriptor desc =
+        hebench::test::makeDescriptor(APIBridge::Workload::EltwiseAdd, APIBridge::DataType::Float64);
+    SumBenchmark bench(engine, desc);
+
+    NativeData<double> inputs;
+    inputs.addOperand({ { 1, 2, 3, 4 } });
+    APIBridge::Handle h_encoded = bench.encode(&inputs.collection());
+    APIBridge::Handle h_remote  = bench.load(&h_encoded, 1);
+    CHECK(bench.load_thread != std::this_thread::get_id());
+
+    APIBridge::ParameterIndexer indexer = { 0, 1 };
+    APIBridge::Handle h_result          = bench.operate(h_remote, &indexer, 1);
+    APIBridge::Handle h_local;
+    bench.store(h_result, &h_local, 1);
+
+    NativeData<double> result;
+    result.addOperand({ { 0 } });
+    bench.decode(h_local, &result.collection());
+    CHECK(result.sample(0, 0)[0] == 10.0);
+
+    // exceptions escaping the coroutines reach the synchronous caller
+    CHECK_THROWS_AS(bench.load(&h_encoded, 2), std::invalid_argument);
+    CHECK_THROWS_AS(bench.operate(h_remote, &indexer, 0), std::runtime_error);
+
+    for (APIBridge::Handle h : { h_encoded, h_remote, h_result, h_local })
+        destroyObjectHandle(h);
+    CHECK(engine.getHandleStats().live_count == 0u);
+}
+
+TEST_CASE("Task: syncWait returns values and propagates exceptions", "[async_benchmark]")
+{
+    ThreadPool pool(1);
+    CHECK(syncWait(sumAsync(pool, Vector{ 0.5, 1.5 })) == 2.0);
+    CHECK_THROWS_AS(syncWait(failAsync(pool)), std::runtime_error);
+}
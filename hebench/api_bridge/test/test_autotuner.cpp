@@ -0,0 +1,97 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/autotuner.hpp"
+
+using hebench::cpp::Autotuner;
+using hebench::cpp::TuningDatabase;
+
+TEST_CASE("TuningDatabase: concurrent writers to the same file keep all entries", "[autotuner]")
+{
+    const std::string filename = "hebench_test_tuning.db";
+    std::remove(filename.c_str());
+
+    // one database object per writer, as if they were separate processes
+    constexpr std::size_t WriterCount = 4;
+    constexpr std::size_t EntryCount  = 25;
+    std::vector<std::unique_ptr<TuningDatabase>> dbs;
+    std::vector<std::thread> writers;
+    for (std::size_t i = 0; i < WriterCount; ++i)
+        dbs.emplace_back(new TuningDatabase(filename));
+    for (std::size_t i = 0; i < WriterCount; ++i)
+        writers.emplace_back([&dbs, i]() {
+            for (std::size_t j = 0; j < EntryCount; ++j)
+            {
+                TuningDatabase::Entry entry;
+                entry.choice  = "choice" + std::to_string(j);
+                entry.time_ns = j;
+                dbs[i]->store("writer" + std::to_string(i) + "_" + std::to_string(j), entry);
+            } // end for
+        });
+    for (std::thread &writer : writers)
+        writer.join();
+
+    TuningDatabase db(filename);
+    CHECK(db.size() == WriterCount * EntryCount);
+    TuningDatabase::Entry entry;
+    REQUIRE(db.find("writer3_7", entry));
+    CHECK(entry.choice == "choice7");
+    CHECK(entry.time_ns == 7u);
+
+    std::remove(filename.c_str());
+    std::remove((filename + ".lock").c_str());
+}
+
+TEST_CASE("Autotuner: selects the fastest candidate and reuses the stored choice", "[autotuner]")
+{
+    TuningDatabase db("");
+    Autotuner::Options options;
+    options.min_time_ms = 0;
+    Autotuner tuner(&db, options);
+
+    std::vector<std::size_t> runs(2, 0);
+    auto trial = [&runs](std::size_t index) {
+        ++runs[index];
+        if (index == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    };
+    CHECK(tuner.tune("kernel", { "slow", "fast" }, trial) == 1u);
+    CHECK_FALSE(tuner.lastFromDatabase());
+    CHECK(db.size() == 1u);
+
+    runs.assign(2, 0);
+    CHECK(tuner.tune("kernel", { "slow", "fast" }, trial) == 1u);
+    CHECK(tuner.lastFromDatabase());
+    CHECK(runs == std::vector<std::size_t>{ 0, 0 });
+}
+
+TEST_CASE("TuningDatabase: persists only where configured", "[autotuner]")
+{
+    if (!std::getenv("HEBENCH_TUNING_DB"))
+        CHECK(TuningDatabase::defaultFilename().empty());
+
+    const std::string filename = "hebench_test_tuning_persist.db";
+    std::remove(filename.c_str());
+    {
+        TuningDatabase db(filename);
+        db.store("key", TuningDatabase::Entry{ "choice", 42 });
+    }
+    TuningDatabase db(filename);
+    TuningDatabase::Entry entry;
+    REQUIRE(db.find("key", entry));
+    CHECK(entry.choice == "choice");
+    CHECK(entry.time_ns == 42u);
+    std::remove(filename.c_str());
+    std::remove((filename + ".lock").c_str());
+}
@@ -0,0 +1,97 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/bounded_queue.hpp"
+
+using hebench::cpp::BoundedQueue;
+
+TEST_CASE("BoundedQueue: capacity is rounded up to a power of 2", "[bounded_queue]")
+{
+    CHECK_THROWS_AS(BoundedQueue<int>(0), std::invalid_argument);
+    CHECK(BoundedQueue<int>(1).capacity() == 2u);
+    CHECK(BoundedQueue<int>(5).capacity() == 8u);
+    CHECK(BoundedQueue<int>(64).capacity() == 64u);
+    // no power of 2 above this capacity fits, so rounding up would never end
+    const std::size_t max_capacity = (std::numeric_limits<std::size_t>::max() >> 1) + 1;
+    CHECK_THROWS_AS(BoundedQueue<int>(max_capacity + 1), std::invalid_argument);
+    CHECK_THROWS_AS(BoundedQueue<int>(std::numeric_limits<std::size_t>::max()), std::invalid_argument);
+}
+
+TEST_CASE("BoundedQueue: first in, first out until full", "[bounded_queue]")
+{
+    BoundedQueue<int> queue(4);
+    CHECK(queue.empty());
+    int value = 0;
+    CHECK_FALSE(queue.tryPop(value));
+
+    for (int round = 0; round < 3; ++round)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            value = round * 10 + i;
+            REQUIRE(queue.tryPush(value));
+        } // end for
+        value = -1;
+        CHECK_FALSE(queue.tryPush(value));
+        CHECK(value == -1); // not moved from on failure
+        CHECK_FALSE(queue.empty());
+
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(queue.tryPop(value));
+            CHECK(value == round * 10 + i);
+        } // end for
+        CHECK(queue.empty());
+    } // end for
+}
+
+TEST_CASE("BoundedQueue: concurrent producers and consumers", "[bounded_queue]")
+{
+    constexpr std::uint64_t per_producer = 20000;
+    constexpr std::size_t producers      = 3;
+    constexpr std::size_t consumers      = 3;
+    BoundedQueue<std::uint64_t> queue(16);
+    std::atomic<std::uint64_t> sum(0);
+    std::atomic<std::uint64_t> popped(0);
+
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < producers; ++p)
+        threads.emplace_back([&queue]() {
+            for (std::uint64_t i = 1; i <= per_producer; ++i)
+            {
+                std::uint64_t value = i;
+                while (!queue.tryPush(value))
+                    std::this_thread::yield();
+            } // end for
+        });
+    for (std::size_t c = 0; c < consumers; ++c)
+        threads.emplace_back([&]() {
+            std::uint64_t value;
+            while (popped.load() < producers * per_producer)
+            {
+                if (queue.tryPop(value))
+                {
+                    sum += value;
+                    ++popped;
+                } // end if
+                else
+                    std::this_thread::yield();
+            } // end while
+        });
+    for (auto &t : threads)
+        t.join();
+
+    CHECK(popped.load() == producers * per_producer);
+    CHECK(sum.load() == producers * per_producer * (per_producer + 1) / 2);
+    CHECK(queue.empty());
+}
@@ -0,0 +1,127 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/cartesian_product.hpp"
+
+using hebench::cpp::CartesianProduct;
+using hebench::cpp::ThreadPool;
+namespace APIBridge = hebench::APIBridge;
+
+namespace {
+
+struct Visit
+{
+    std::uint64_t result_index;
+    std::vector<std::uint64_t> sample_indices;
+};
+
+} // namespace
+
+TEST_CASE("CartesianProduct: enumerates tuples in row-major order", "[cartesian_product]")
+{
+    APIBridge::ParameterIndexer indexers[3] = { { 1, 3 }, { 0, 2 }, { 4, 5 } };
+    CartesianProduct product(indexers, 3);
+    REQUIRE(product.operandCount() == 3u);
+    REQUIRE(product.size() == 30u);
+
+    std::uint64_t sample_indices[3];
+    product.sampleIndices(0, sample_indices);
+    CHECK(std::vector<std::uint64_t>(sample_indices, sample_indices + 3) == std::vector<std::uint64_t>{ 1, 0, 4 });
+    // ((2 * 2) + 1) * 5 + 3
+    product.sampleIndices(28, sample_indices);
+    CHECK(std::vector<std::uint64_t>(sample_indices, sample_indices + 3) == std::vector<std::uint64_t>{ 3, 1, 7 });
+    CHECK_THROWS_AS(product.sampleIndices(30, sample_indices), std::out_of_range);
+}
+
+TEST_CASE("CartesianProduct: visits tiles with an odometer, last operand fastest", "[cartesian_product]")
+{
+    APIBridge::ParameterIndexer indexers[3] = { { 1, 3 }, { 0, 2 }, { 4, 5 } };
+    CartesianProduct product(indexers, 3);
+    const std::uint64_t extents[3] = { 2, 1, 3 };
+    product.setTileExtents(extents);
+    CHECK(product.tileExtents() == std::vector<std::uint64_t>{ 2, 1, 3 });
+
+    std::vector<Visit> visits;
+    product.forEach([&visits](const std::uint64_t *sample_indices, std::uint64_t result_index) {
+        visits.push_back(Visit{ result_index, std::vector<std::uint64_t>(sample_indices, sample_indices + 3) });
+    });
+    REQUIRE(visits.size() == product.size());
+
+    // first tile: samples [1, 3) x [0, 1) x [4, 7)
+    const std::vector<std::vector<std::uint64_t>> first_tile = {
+        { 1, 0, 4 }, { 1, 0, 5 }, { 1, 0, 6 }, { 2, 0, 4 }, { 2, 0, 5 }, { 2, 0, 6 }
+    };
+    for (std::size_t i = 0; i < first_tile.size(); ++i)
+        CHECK(visits[i].sample_indices == first_tile[i]);
+    // second tile clips the last operand to its batch: [1, 3) x [0, 1) x [7, 9)
+    CHECK(visits[6].sample_indices == std::vector<std::uint64_t>{ 1, 0, 7 });
+    CHECK(visits[7].sample_indices == std::vector<std::uint64_t>{ 1, 0, 8 });
+    CHECK(visits[8].sample_indices == std::vector<std::uint64_t>{ 2, 0, 7 });
+
+    // every tuple exactly once, at its row-major result index
+    std::vector<int> counts(product.size(), 0);
+    std::uint64_t expected[3];
+    for (const Visit &visit : visits)
+    {
+        ++counts[visit.result_index];
+        product.sampleIndices(visit.result_index, expected);
+        REQUIRE(visit.sample_indices == std::vector<std::uint64_t>(expected, expected + 3));
+    } // end for
+    for (int count : counts)
+        REQUIRE(count == 1);
+}
+
+TEST_CASE("CartesianProduct: transforms in parallel for any tiling", "[cartesian_product]")
+{
+    ThreadPool pool(4);
+    APIBridge::ParameterIndexer indexers[2] = { { 3, 17 }, { 0, 29 } };
+    CartesianProduct product(indexers, 2);
+    for (std::uint64_t extent : { 1, 4, 64 })
+    {
+        const std::uint64_t extents[2] = { extent, extent };
+        product.setTileExtents(extents);
+        std::vector<std::uint64_t> results(product.size(), 0);
+        product.transform(pool, results.data(), [](const std::uint64_t *sample_indices) {
+            return sample_indices[0] * 100 + sample_indices[1];
+        });
+        for (std::uint64_t i0 = 0; i0 < 17; ++i0)
+            for (std::uint64_t i1 = 0; i1 < 29; ++i1)
+                REQUIRE(results[i0 * 29 + i1] == (i0 + 3) * 100 + i1);
+    } // end for
+
+    // tiles fit the cache budget: 8 samples of each operand
+    const std::uint64_t sample_bytes[2] = { 64, 64 };
+    product.fitTileToCache(sample_bytes, 1024);
+    CHECK(product.tileExtents() == std::vector<std::uint64_t>{ 8, 8 });
+
+    // empty batches visit nothing
+    APIBridge::ParameterIndexer empty[2] = { { 0, 4 }, { 0, 0 } };
+    CartesianProduct empty_product(empty, 2);
+    CHECK(empty_product.size() == 0u);
+    std::atomic<int> calls(0);
+    empty_product.forEach(pool, [&calls](const std::uint64_t *, std::uint64_t) { ++calls; });
+    CHECK(calls.load() == 0);
+}
+
+TEST_CASE("CartesianProduct: rejects products that do not fit in 64 bits", "[cartesian_product]")
+{
+    const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    CHECK_THROWS_AS(CartesianProduct(nullptr, 2), std::invalid_argument);
+
+    APIBridge::ParameterIndexer too_many[2] = { { 0, max }, { 0, 2 } };
+    CHECK_THROWS_AS(CartesianProduct(too_many, 2), std::invalid_argument);
+
+    APIBridge::ParameterIndexer overflowing[2] = { { 0, 2 }, { max - 1, 2 } };
+    CHECK_THROWS_AS(CartesianProduct(overflowing, 2), std::invalid_argument);
+    APIBridge::ParameterIndexer last_sample[2] = { { 0, 2 }, { max - 2, 2 } };
+    CHECK_NOTHROW(CartesianProduct(last_sample, 2));
+}
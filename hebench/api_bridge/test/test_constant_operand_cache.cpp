@@ -0,0 +1,179 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/constant_operand_cache.hpp"
+#include "test_engine.hpp"
+
+using hebench::cpp::ConstantOperandCache;
+using hebench::cpp::EngineObject;
+using hebench::test::destroyObjectHandle;
+using hebench::test::NativeData;
+using hebench::test::TestEngine;
+namespace APIBridge = hebench::APIBridge;
+
+namespace {
+
+bool sameObject(APIBridge::Handle h0, APIBridge::Handle h1)
+{
+    return reinterpret_cast<EngineObject *>(h0.p)->sharesObjectWith(*reinterpret_cast<EngineObject *>(h1.p));
+}
+
+// encodes by copying the first sample of the first operand
+class Encoder
+{
+public:
+    Encoder(const TestEngine &engine, APIBridge::DataPackCollection &parameters) :
+        m_engine(engine), m_parameters(parameters) {}
+
+    APIBridge::Handle operator()() const
+    {
+        ++calls;
+        const APIBridge::NativeDataBuffer &buffer = m_parameters.p_data_packs[0].p_buffers[0];
+        const double *p_data                      = reinterpret_cast<const double *>(buffer.p);
+        return m_engine.createHandle<std::vector<double>>(buffer.size, 0,
+                                                          p_data, p_data + buffer.size / sizeof(double));
+    }
+
+    mutable std::atomic<int> calls{ 0 };
+
+private:
+    const TestEngine &m_engine;
+    APIBridge::DataPackCollection &m_parameters;
+};
+
+} // namespace
+
+TEST_CASE("ConstantOperandCache: encodes and encrypts constant content once", "[constant_operand_cache]")
+{
+    TestEngine engine;
+    {
+        ConstantOperandCache cache(engine);
+        cache.markConstant(1);
+        CHECK(cache.isConstant(1));
+        CHECK_FALSE(cache.isConstant(0));
+
+        NativeData<double> weights;
+        weights.addOperand({});
+        weights.addOperand({ { 1, 2, 3 } });
+        APIBridge::DataPackCollection &parameters = weights.collection();
+        parameters.p_data_packs                   = parameters.p_data_packs + 1; // only position 1
+        parameters.pack_count                     = 1;
+        REQUIRE(cache.isConstant(parameters));
+
+        Encoder encoder(engine, parameters);
+        APIBridge::Handle h0 = cache.encode(parameters, encoder);
+        APIBridge::Handle h1 = cache.encode(parameters, encoder);
+        CHECK(encoder.calls == 1);
+        CHECK(sameObject(h0, h1));
+        CHECK(cache.size() == 1u);
+
+        int encryptions = 0;
+        auto encrypt_fn = [&]() {
+            ++encryptions;
+            return engine.duplicateHandle(h0);
+        };
+        APIBridge::Handle h_enc0 = cache.encrypt(h0, encrypt_fn);
+        APIBridge::Handle h_enc1 = cache.encrypt(h1, encrypt_fn);
+        CHECK(encryptions == 1);
+        CHECK(sameObject(h_enc0, h_enc1));
+
+        // different content with the same layout is encoded again
+        weights.sample(1, 0)[2] = 4;
+        APIBridge::Handle h2    = cache.encode(parameters, encoder);
+        CHECK(encoder.calls == 2);
+        CHECK_FALSE(sameObject(h0, h2));
+        CHECK(engine.retrieveFromHandle<std::vector<double>>(h2)[2] == 4);
+        CHECK(cache.size() == 2u);
+
+        for (APIBridge::Handle h : { h0, h1, h2, h_enc0, h_enc1 })
+            destroyObjectHandle(h);
+        CHECK(engine.getHandleStats().live_count > 0u); // held by the cache
+    }
+    CHECK(engine.getHandleStats().live_count == 0u);
+}
+
+TEST_CASE("ConstantOperandCache: bypasses non-constant operands", "[constant_operand_cache]")
+{
+    TestEngine engine;
+    ConstantOperandCache cache(engine);
+    cache.markConstant(1);
+
+    NativeData<double> inputs;
+    inputs.addOperand({ { 1, 2 } });
+    inputs.addOperand({ { 3, 4 } });
+    APIBridge::DataPackCollection &parameters = inputs.collection();
+    CHECK_FALSE(cache.isConstant(parameters));
+
+    Encoder encoder(engine, parameters);
+    APIBridge::Handle h0 = cache.encode(parameters, encoder);
+    APIBridge::Handle h1 = cache.encode(parameters, encoder);
+    CHECK(encoder.calls == 2);
+    CHECK(cache.size() == 0u);
+    destroyObjectHandle(h0);
+    destroyObjectHandle(h1);
+}
+
+TEST_CASE("ConstantOperandCache: evicts least recently used content", "[constant_operand_cache]")
+{
+    TestEngine engine;
+    ConstantOperandCache cache(engine, 1);
+    cache.markConstant(0);
+
+    NativeData<double> weights;
+    weights.addOperand({ { 1 } });
+    APIBridge::DataPackCollection &parameters = weights.collection();
+    Encoder encoder(engine, parameters);
+
+    destroyObjectHandle(cache.encode(parameters, encoder));
+    weights.sample(0, 0)[0] = 2;
+    destroyObjectHandle(cache.encode(parameters, encoder));
+    weights.sample(0, 0)[0] = 1;
+    destroyObjectHandle(cache.encode(parameters, encoder));
+    CHECK(encoder.calls == 3);
+    CHECK(cache.size() == 1u);
+
+    cache.clear();
+    CHECK(cache.size() == 0u);
+    CHECK(engine.getHandleStats().live_count == 0u);
+}
+
+TEST_CASE("ConstantOperandCache: concurrent encodes share one entry", "[constant_operand_cache]")
+{
+    TestEngine engine;
+    ConstantOperandCache cache(engine);
+    cache.markConstant(0);
+
+    NativeData<double> weights;
+    weights.addOperand({ std::vector<double>(1024, 0.5) });
+    APIBridge::DataPackCollection &parameters = weights.collection();
+    Encoder encoder(engine, parameters);
+
+    std::vector<APIBridge::Handle> handles(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < handles.size(); ++i)
+        threads.emplace_back([&, i]() {
+            for (int j = 0; j < 100; ++j)
+            {
+                APIBridge::Handle h = cache.encode(parameters, encoder);
+                if (j == 0)
+                    handles[i] = h;
+                else
+                    destroyObjectHandle(h);
+            } // end for
+        });
+    for (auto &t : threads)
+        t.join();
+
+    CHECK(cache.size() == 1u);
+    CHECK(encoder.calls >= 1);
+    CHECK(encoder.calls <= static_cast<int>(handles.size()));
+    for (APIBridge::Handle h : handles)
+        destroyObjectHandle(h);
+}
@@ -0,0 +1,135 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/context_cache.hpp"
+
+using hebench::cpp::ContextCache;
+
+namespace {
+
+ContextCache::Key makeKey(std::uint64_t value)
+{
+    return ContextCache::Key(HEBENCH_HE_SCHEME_CKKS, 128, 0).add(value);
+}
+
+// queries the cache from its destructor: deadlocks if destroyed under the cache lock
+struct Reentrant
+{
+    Reentrant(ContextCache &cache, std::atomic<int> &destroyed) :
+        m_cache(cache), m_destroyed(destroyed) {}
+    ~Reentrant()
+    {
+        m_cache.size();
+        ++m_destroyed;
+    }
+
+    ContextCache &m_cache;
+    std::atomic<int> &m_destroyed;
+};
+
+} // namespace
+
+TEST_CASE("ContextCache: keys compare scheme, security, values and type", "[context_cache]")
+{
+    CHECK(makeKey(1) == makeKey(1));
+    CHECK(makeKey(1).hash() == makeKey(1).hash());
+    CHECK(makeKey(1) != makeKey(2));
+    CHECK(ContextCache::Key(HEBENCH_HE_SCHEME_BFV, 128, 0).add(1) != makeKey(1));
+
+    // same key, different types: cached separately
+    ContextCache cache;
+    cache.insert(makeKey(1), std::make_shared<int>(5));
+    CHECK(cache.find<double>(makeKey(1)) == nullptr);
+    REQUIRE(cache.find<int>(makeKey(1)) != nullptr);
+    CHECK(*cache.find<int>(makeKey(1)) == 5);
+}
+
+TEST_CASE("ContextCache: creates once and counts hits", "[context_cache]")
+{
+    ContextCache cache;
+    int created = 0;
+    auto factory = [&]() {
+        ++created;
+        return std::make_shared<int>(created);
+    };
+    std::shared_ptr<int> p0 = cache.getOrCreate<int>(makeKey(7), factory);
+    std::shared_ptr<int> p1 = cache.getOrCreate<int>(makeKey(7), factory);
+    CHECK(p0 == p1);
+    CHECK(created == 1);
+    CHECK(cache.hits() == 1u);
+    CHECK(cache.misses() == 1u);
+
+    // null objects are returned, not cached
+    CHECK(cache.getOrCreate<double>(makeKey(7), []() { return std::shared_ptr<double>(); }) == nullptr);
+    CHECK(cache.size() == 1u);
+
+    CHECK(cache.erase<int>(makeKey(7)));
+    CHECK_FALSE(cache.erase<int>(makeKey(7)));
+    CHECK(cache.size() == 0u);
+}
+
+TEST_CASE("ContextCache: evicts least recently used", "[context_cache]")
+{
+    ContextCache cache(2);
+    cache.insert(makeKey(0), std::make_shared<int>(0));
+    cache.insert(makeKey(1), std::make_shared<int>(1));
+    cache.find<int>(makeKey(0)); // 1 becomes least recently used
+    cache.insert(makeKey(2), std::make_shared<int>(2));
+    CHECK(cache.size() == 2u);
+    CHECK(cache.find<int>(makeKey(0)) != nullptr);
+    CHECK(cache.find<int>(makeKey(1)) == nullptr);
+    CHECK(cache.find<int>(makeKey(2)) != nullptr);
+
+    cache.setCapacity(0);
+    CHECK(cache.size() == 0u);
+    cache.insert(makeKey(3), std::make_shared<int>(3));
+    CHECK(cache.size() == 0u);
+}
+
+TEST_CASE("ContextCache: releases objects outside the lock", "[context_cache]")
+{
+    std::atomic<int> destroyed(0);
+    ContextCache cache(1);
+    cache.insert(makeKey(0), std::make_shared<Reentrant>(cache, destroyed));
+    // eviction
+    cache.insert(makeKey(1), std::make_shared<Reentrant>(cache, destroyed));
+    CHECK(destroyed.load() == 1);
+    // replacement
+    cache.insert(makeKey(1), std::make_shared<Reentrant>(cache, destroyed));
+    CHECK(destroyed.load() == 2);
+    // erase
+    cache.erase<Reentrant>(makeKey(1));
+    CHECK(destroyed.load() == 3);
+    // capacity change and clear
+    cache.insert(makeKey(2), std::make_shared<Reentrant>(cache, destroyed));
+    cache.setCapacity(0);
+    CHECK(destroyed.load() == 4);
+    cache.setCapacity(1);
+    cache.insert(makeKey(3), std::make_shared<Reentrant>(cache, destroyed));
+    cache.clear();
+    CHECK(destroyed.load() == 5);
+}
+
+TEST_CASE("ContextCache: concurrent lookups share one object", "[context_cache]")
+{
+    ContextCache cache;
+    std::vector<std::shared_ptr<int>> results(8);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < results.size(); ++i)
+        threads.emplace_back([&cache, &results, i]() {
+            results[i] = cache.getOrCreate<int>(makeKey(9), []() { return std::make_shared<int>(9); });
+        });
+    for (auto &t : threads)
+        t.join();
+    for (auto &p : results)
+        CHECK(p == results.front());
+    CHECK(cache.size() == 1u);
+}
@@ -0,0 +1,120 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/data_view.hpp"
+
+using hebench::cpp::DataPackCollectionView;
+using hebench::cpp::DataPackView;
+using hebench::cpp::MatrixView;
+using hebench::cpp::SampleView;
+namespace APIBridge = hebench::APIBridge;
+
+namespace {
+
+APIBridge::NativeDataBuffer makeBuffer(std::vector<float> &samples)
+{
+    APIBridge::NativeDataBuffer retval;
+    retval.p    = samples.data();
+    retval.size = samples.size() * sizeof(float);
+    retval.tag  = 0;
+    return retval;
+}
+
+APIBridge::DataPack makePack(std::vector<APIBridge::NativeDataBuffer> &buffers, std::uint64_t param_position)
+{
+    APIBridge::DataPack retval;
+    retval.p_buffers      = buffers.data();
+    retval.buffer_count   = buffers.size();
+    retval.param_position = param_position;
+    return retval;
+}
+
+} // namespace
+
+TEST_CASE("SampleView: views memory in place", "[data_view]")
+{
+    std::vector<float> values = { 1, 2, 3, 4, 5, 6 };
+    SampleView<float> view(values.data(), values.size());
+    CHECK(view.size() == 6u);
+    CHECK_FALSE(view.empty());
+    view[2] = 30;
+    CHECK(values[2] == 30);
+    CHECK(std::accumulate(view.begin(), view.end(), 0.0f) == 48);
+
+    SampleView<const float> const_view = view;
+    CHECK(const_view.data() == values.data());
+    CHECK(SampleView<float>().empty());
+
+    // 2 x 3 row-major matrix over the same elements
+    MatrixView<float> matrix(view, 2, 3);
+    CHECK(matrix.size() == 6u);
+    CHECK(matrix(1, 0) == 4);
+    CHECK(matrix.row(1).data() == values.data() + 3);
+    CHECK(matrix.row(1).size() == 3u);
+    CHECK(matrix.elements().data() == values.data());
+}
+
+TEST_CASE("DataPackView: views each buffer as a sample", "[data_view]")
+{
+    std::vector<float> sample0                       = { 1, 2, 3, 4 };
+    std::vector<float> sample1                       = { 5, 6, 7, 8 };
+    std::vector<APIBridge::NativeDataBuffer> buffers = { makeBuffer(sample0), makeBuffer(sample1) };
+    APIBridge::DataPack pack                         = makePack(buffers, 3);
+
+    DataPackView<const float> view(pack);
+    REQUIRE(view.valid());
+    CHECK(view.paramPosition() == 3u);
+    CHECK(view.sampleCount() == 2u);
+    CHECK(view[1].data() == sample1.data());
+    CHECK(view.sample(0).size() == 4u);
+    CHECK(view.matrix(1, 2, 2)(1, 1) == 8);
+
+    // writes go to the native buffers
+    DataPackView<float> mutable_view(pack);
+    mutable_view[0][0] = 10;
+    CHECK(sample0[0] == 10);
+
+    CHECK_FALSE(DataPackView<float>().valid());
+}
+
+TEST_CASE("DataPackCollectionView: finds packs by parameter position", "[data_view]")
+{
+    std::vector<float> a                               = { 1 };
+    std::vector<float> b                               = { 2 };
+    std::vector<float> c                               = { 3 };
+    std::vector<float> d                               = { 4 };
+    std::vector<APIBridge::NativeDataBuffer> buffers_a = { makeBuffer(a) };
+    std::vector<APIBridge::NativeDataBuffer> buffers_b = { makeBuffer(b) };
+    std::vector<APIBridge::NativeDataBuffer> buffers_c = { makeBuffer(c) };
+    std::vector<APIBridge::NativeDataBuffer> buffers_d = { makeBuffer(d) };
+    // out of order, a repeated position and a position past the lookup table
+    std::vector<APIBridge::DataPack> packs = { makePack(buffers_a, 2), makePack(buffers_b, 0),
+                                               makePack(buffers_c, 2), makePack(buffers_d, 1000) };
+    APIBridge::DataPackCollection collection;
+    collection.p_data_packs = packs.data();
+    collection.pack_count   = packs.size();
+
+    DataPackCollectionView<const float> view(collection);
+    CHECK(view.contains(0));
+    CHECK_FALSE(view.contains(1));
+    CHECK(view[0][0][0] == 2);
+    // first match wins
+    CHECK(view[2][0][0] == 1);
+    CHECK(view.find(1000).valid());
+    CHECK(view.find(1000)[0][0] == 4);
+    CHECK_FALSE(view.find(1).valid());
+    CHECK_FALSE(view.find(999).valid());
+
+    APIBridge::DataPackCollection empty;
+    empty.p_data_packs = nullptr;
+    empty.pack_count   = 0;
+    CHECK_FALSE(DataPackCollectionView<float>(empty).contains(0));
+    CHECK_FALSE(DataPackCollectionView<float>().contains(0));
+}
@@ -0,0 +1,93 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/dataset_generator.hpp"
+
+using hebench::cpp::DatasetGenerator;
+using hebench::cpp::HEBenchError;
+using hebench::cpp::ThreadPool;
+
+TEST_CASE("DatasetGenerator: values depend on seed and stream, not on threads", "[dataset_generator]")
+{
+    const std::uint64_t count = 3 * DatasetGenerator::ChunkElements + 5;
+    DatasetGenerator generator(42);
+    std::vector<double> serial(count);
+    std::vector<double> parallel(count);
+    ThreadPool pool(4);
+    generator.fill(serial.data(), serial.size());
+    generator.fill(parallel.data(), parallel.size(), 0, &pool);
+    CHECK(serial == parallel);
+
+    std::vector<double> other_stream(count);
+    generator.fill(other_stream.data(), other_stream.size(), 1);
+    CHECK(serial != other_stream);
+
+    std::vector<double> other_seed(count);
+    DatasetGenerator(43).fill(other_seed.data(), other_seed.size());
+    CHECK(serial != other_seed);
+
+    for (double value : serial)
+    {
+        REQUIRE(value >= -1.0);
+        REQUIRE(value < 1.0);
+    } // end for
+}
+
+TEST_CASE("DatasetGenerator: custom ranges are honored per type", "[dataset_generator]")
+{
+    DatasetGenerator generator(7);
+    generator.setValueRange(-3, 5);
+    std::vector<std::int32_t> ints(10000);
+    generator.fill(ints.data(), ints.size());
+    bool b_min = false;
+    bool b_max = false;
+    for (std::int32_t value : ints)
+    {
+        REQUIRE(value >= -3);
+        REQUIRE(value <= 5);
+        b_min = b_min || value == -3;
+        b_max = b_max || value == 5;
+    } // end for
+    CHECK(b_min);
+    CHECK(b_max);
+
+    generator.resetValueRange();
+    generator.fill(ints.data(), ints.size());
+    for (std::int32_t value : ints)
+        REQUIRE((value >= -100 && value <= 100));
+}
+
+TEST_CASE("DatasetGenerator: rejects ranges the data type cannot represent", "[dataset_generator]")
+{
+    DatasetGenerator generator(1);
+    CHECK_THROWS_AS(generator.setValueRange(1, 0), HEBenchError);
+    CHECK_THROWS_AS(generator.setValueRange(0, 1.0 / 0.0), HEBenchError);
+
+    std::vector<std::int32_t> ints(4);
+    std::vector<std::int64_t> longs(4);
+    std::vector<float> floats(4);
+
+    generator.setValueRange(0, 1e10);
+    CHECK_THROWS_AS(generator.fill(ints.data(), ints.size()), HEBenchError);
+    CHECK_NOTHROW(generator.fill(longs.data(), longs.size()));
+
+    // 2^31 is one past the largest Int32
+    generator.setValueRange(-2147483648.0, 2147483648.0);
+    CHECK_THROWS_AS(generator.fill(ints.data(), ints.size()), HEBenchError);
+    generator.setValueRange(-2147483648.0, 2147483647.0);
+    CHECK_NOTHROW(generator.fill(ints.data(), ints.size()));
+
+    // 2^63 rounds from the largest Int64, but is out of range
+    generator.setValueRange(0, 9223372036854775808.0);
+    CHECK_THROWS_AS(generator.fill(longs.data(), longs.size()), HEBenchError);
+
+    generator.setValueRange(-1e300, 1e300);
+    CHECK_THROWS_AS(generator.fill(floats.data(), floats.size()), HEBenchError);
+    CHECK_THROWS_AS(generator.generate(hebench::APIBridge::DataType::Float32, { 4 }, { 1 }), HEBenchError);
+}
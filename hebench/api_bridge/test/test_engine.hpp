@@ -0,0 +1,104 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_TestEngine_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_TestEngine_H_7e5fa8c2415240ea93eff148ed73539b
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "hebench/api_bridge/cpp/hebench.hpp"
+
+namespace hebench {
+namespace test {
+
+/**
+ * @brief Minimal engine without benchmark descriptions, for unit tests that need
+ * handles, thread pool or caches of an engine.
+ */
+class TestEngine : public hebench::cpp::BaseEngine
+{
+public:
+    TestEngine() { init(); }
+
+protected:
+    void init() override {}
+};
+
+/**
+ * @brief Destroys a handle to an EngineObject as `hebench::APIBridge::destroyHandle()` does.
+ */
+inline void destroyObjectHandle(hebench::APIBridge::Handle h)
+{
+    if (h.p)
+    {
+        hebench::cpp::EngineObject *p_obj = reinterpret_cast<hebench::cpp::EngineObject *>(h.p);
+        p_obj->engine().destroyObj<hebench::cpp::EngineObject>(p_obj);
+    } // end if
+}
+
+/**
+ * @brief Plain native buffers for a DataPackCollection, owning their samples.
+ */
+template <class T>
+class NativeData
+{
+public:
+    /**
+     * @brief Adds an operand with the specified samples at the next position.
+     */
+    void addOperand(const std::vector<std::vector<T>> &samples)
+    {
+        m_samples.push_back(samples);
+    }
+
+    hebench::APIBridge::DataPackCollection &collection()
+    {
+        m_buffers.assign(m_samples.size(), std::vector<hebench::APIBridge::NativeDataBuffer>());
+        m_packs.resize(m_samples.size());
+        for (std::size_t op_i = 0; op_i < m_samples.size(); ++op_i)
+        {
+            for (auto &sample : m_samples[op_i])
+            {
+                hebench::APIBridge::NativeDataBuffer buffer;
+                buffer.p    = sample.data();
+                buffer.size = sample.size() * sizeof(T);
+                buffer.tag  = 0;
+                m_buffers[op_i].push_back(buffer);
+            } // end for
+            m_packs[op_i].p_buffers      = m_buffers[op_i].data();
+            m_packs[op_i].buffer_count   = m_buffers[op_i].size();
+            m_packs[op_i].param_position = op_i;
+        } // end for
+        m_collection.p_data_packs = m_packs.data();
+        m_collection.pack_count   = m_packs.size();
+        return m_collection;
+    }
+
+    std::vector<T> &sample(std::size_t operand, std::size_t index) { return m_samples.at(operand).at(index); }
+
+private:
+    std::vector<std::vector<std::vector<T>>> m_samples;
+    std::vector<std::vector<hebench::APIBridge::NativeDataBuffer>> m_buffers;
+    std::vector<hebench::APIBridge::DataPack> m_packs;
+    hebench::APIBridge::DataPackCollection m_collection;
+};
+
+inline hebench::APIBridge::BenchmarkDescriptor makeDescriptor(hebench::APIBridge::Workload workload,
+                                                              hebench::APIBridge::DataType data_type,
+                                                              hebench::APIBridge::Category category = hebench::APIBridge::Category::Offline)
+{
+    hebench::APIBridge::BenchmarkDescriptor retval;
+    std::memset(&retval, 0, sizeof(retval));
+    retval.workload  = workload;
+    retval.data_type = data_type;
+    retval.category  = category;
+    return retval;
+}
+
+} // namespace test
+} // namespace hebench
+
+#endif // defined _HEBench_API_Bridge_TestEngine_H_7e5fa8c2415240ea93eff148ed73539b
@@ -0,0 +1,202 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/hebench.hpp"
+#include "test_engine.hpp"
+
+using namespace hebench::cpp;
+namespace APIBridge = hebench::APIBridge;
+
+namespace {
+
+struct Counters
+{
+    int created   = 0;
+    int destroyed = 0;
+    int resets    = 0;
+    int factories = 0; // descriptions created by factories
+};
+
+class CountedBenchmark : public BaseBenchmark
+{
+public:
+    CountedBenchmark(BaseEngine &engine, const APIBridge::BenchmarkDescriptor &bench_desc,
+                     const APIBridge::WorkloadParams &bench_params, Counters &counters, bool b_reusable) :
+        BaseBenchmark(engine, bench_desc, bench_params), m_counters(counters), m_b_reusable(b_reusable)
+    {
+        ++m_counters.created;
+    }
+    ~CountedBenchmark() override { ++m_counters.destroyed; }
+
+    bool reset() override
+    {
+        ++m_counters.resets;
+        return m_b_reusable;
+    }
+
+    // operations are never called by these tests
+    APIBridge::Handle encode(const APIBridge::DataPackCollection *) override { throw std::logic_error("Not implemented."); }
+    void decode(APIBridge::Handle, APIBridge::DataPackCollection *) override { throw std::logic_error("Not implemented."); }
+    APIBridge::Handle encrypt(APIBridge::Handle) override { throw std::logic_error("Not implemented."); }
+    APIBridge::Handle decrypt(APIBridge::Handle) override { throw std::logic_error("Not implemented."); }
+    APIBridge::Handle load(const APIBridge::Handle *, std::uint64_t) override { throw std::logic_error("Not implemented."); }
+    void store(APIBridge::Handle, APIBridge::Handle *, std::uint64_t) override { throw std::logic_error("Not implemented."); }
+    APIBridge::Handle operate(APIBridge::Handle, const APIBridge::ParameterIndexer *, std::uint64_t) override
+    {
+        throw std::logic_error("Not implemented.");
+    }
+
+private:
+    Counters &m_counters;
+    bool m_b_reusable;
+};
+
+class CountedDescription : public BenchmarkDescription
+{
+public:
+    CountedDescription(Counters &counters, bool b_reusable) :
+        m_counters(counters), m_b_reusable(b_reusable)
+    {
+        m_descriptor = hebench::test::makeDescriptor(APIBridge::Workload::EltwiseAdd, APIBridge::DataType::Float64);
+    }
+
+    BaseBenchmark *createBenchmark(BaseEngine &engine, const APIBridge::WorkloadParams *p_params) override
+    {
+        return new CountedBenchmark(engine, m_descriptor, *p_params, m_counters, m_b_reusable);
+    }
+    void destroyBenchmark(BaseBenchmark *p_bench) override { delete static_cast<CountedBenchmark *>(p_bench); }
+
+private:
+    Counters &m_counters;
+    bool m_b_reusable;
+};
+
+// description 0 is reusable, description 1 is not, description 2 is created on demand
+class CountedEngine : public BaseEngine
+{
+public:
+    explicit CountedEngine(Counters &counters) :
+        m_counters(counters)
+    {
+        init();
+    }
+    ~CountedEngine() override { clearBenchmarkPool(); }
+
+    using BaseEngine::addBenchmarkDescription;
+
+    std::vector<APIBridge::Handle> descriptions()
+    {
+        std::vector<APIBridge::Handle> retval(subscribeBenchmarkCount());
+        subscribeBenchmarks(retval.data(), retval.size());
+        return retval;
+    }
+
+protected:
+    void init() override
+    {
+        addBenchmarkDescription(std::make_shared<CountedDescription>(m_counters, true));
+        addBenchmarkDescription(std::make_shared<CountedDescription>(m_counters, false));
+        addBenchmarkDescription([this]() -> std::shared_ptr<BenchmarkDescription> {
+            ++m_counters.factories;
+            return std::make_shared<CountedDescription>(m_counters, true);
+        });
+    }
+
+private:
+    Counters &m_counters;
+};
+
+struct VectorSizeParams
+{
+    explicit VectorSizeParams(std::uint64_t n) :
+        params(WorkloadParams::VectorSize(n).getParams())
+    {
+        w_params.params = params.data();
+        w_params.count  = params.size();
+    }
+
+    std::vector<APIBridge::WorkloadParam> params;
+    APIBridge::WorkloadParams w_params;
+};
+
+} // namespace
+
+TEST_CASE("BaseEngine: pools released benchmarks for the same workload parameters", "[benchmark_pool]")
+{
+    Counters counters;
+    {
+        CountedEngine engine(counters);
+        std::vector<APIBridge::Handle> descs = engine.descriptions();
+        REQUIRE(descs.size() == 3u);
+        VectorSizeParams n4(4);
+        VectorSizeParams n8(8);
+
+        // no pooling by default
+        engine.destroyBenchmark(engine.createBenchmark(descs[0], &n4.w_params));
+        CHECK(counters.created == 1);
+        CHECK(counters.destroyed == 1);
+        CHECK(counters.resets == 0);
+
+        engine.setBenchmarkPoolSize(1);
+        engine.destroyBenchmark(engine.createBenchmark(descs[0], &n4.w_params));
+        CHECK(counters.created == 2);
+        CHECK(counters.resets == 1);
+        CHECK(counters.destroyed == 1);
+
+        // same description and parameters reuse the pooled benchmark
+        APIBridge::Handle h_reused = engine.createBenchmark(descs[0], &n4.w_params);
+        CHECK(counters.created == 2);
+        APIBridge::Handle h_other = engine.createBenchmark(descs[0], &n8.w_params);
+        CHECK(counters.created == 3);
+        // a full pool evicts its oldest benchmark
+        engine.destroyBenchmark(h_reused);
+        engine.destroyBenchmark(h_other);
+        CHECK(counters.destroyed == 2);
+
+        // benchmarks that cannot be reset are destroyed
+        engine.destroyBenchmark(engine.createBenchmark(descs[1], &n4.w_params));
+        CHECK(counters.destroyed == 3);
+
+        engine.setBenchmarkPoolSize(0);
+        CHECK(counters.destroyed == 4);
+        CHECK(engine.getHandleStats().live_count == 0u);
+
+        // pooled benchmarks are destroyed with the engine
+        engine.setBenchmarkPoolSize(4);
+        engine.destroyBenchmark(engine.createBenchmark(descs[0], &n4.w_params));
+    }
+    CHECK(counters.destroyed == counters.created);
+}
+
+TEST_CASE("BaseEngine: creates descriptions from factories on first use", "[benchmark_pool]")
+{
+    // copied: the class constant has no definition to bind to
+    const std::int64_t description_tag = BenchmarkDescription::tag;
+
+    Counters counters;
+    CountedEngine engine(counters);
+    std::vector<APIBridge::Handle> descs = engine.descriptions();
+    REQUIRE(descs.size() == 3u);
+    CHECK(counters.factories == 0);
+    CHECK(descs[2].tag == description_tag);
+
+    APIBridge::BenchmarkDescriptor descriptor;
+    engine.describeBenchmark(descs[2], &descriptor, nullptr, 0);
+    CHECK(counters.factories == 1);
+    CHECK(descriptor.workload == APIBridge::Workload::EltwiseAdd);
+    // kept once created
+    engine.describeBenchmark(descs[2], &descriptor, nullptr, 0);
+    VectorSizeParams n4(4);
+    engine.destroyBenchmark(engine.createBenchmark(descs[2], &n4.w_params));
+    CHECK(counters.factories == 1);
+    CHECK(engine.descriptions()[2].tag == description_tag);
+
+    CHECK_THROWS_AS(engine.addBenchmarkDescription(BaseEngine::BenchmarkDescriptionFactory()), HEBenchError);
+}
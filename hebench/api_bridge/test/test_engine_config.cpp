@@ -0,0 +1,198 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/api.h"
+#include "hebench/api_bridge/cpp/hebench.hpp"
+
+using hebench::cpp::BaseEngine;
+using hebench::cpp::EngineConfig;
+using hebench::cpp::HEBenchError;
+namespace APIBridge = hebench::APIBridge;
+
+namespace {
+
+// records what init() sees of the configuration
+class ConfigEngine : public BaseEngine
+{
+public:
+    static int live_count;
+    // whether createEngine() constructs engines with their configuration
+    static bool b_construct_with_config;
+
+    ConfigEngine() :
+        init_budget(0),
+        init_pool_size(0)
+    {
+        ++live_count;
+        init();
+    }
+    explicit ConfigEngine(const EngineConfig &config) :
+        BaseEngine(config),
+        init_budget(0),
+        init_pool_size(0)
+    {
+        ++live_count;
+        init();
+    }
+    ~ConfigEngine() override { --live_count; }
+
+    std::string init_option;
+    std::uint64_t init_budget;
+    std::size_t init_pool_size;
+
+protected:
+    void init() override
+    {
+        init_option    = configuration().getString("backend.option");
+        init_budget    = memoryBudget();
+        init_pool_size = benchmarkPoolSize();
+    }
+};
+
+int ConfigEngine::live_count               = 0;
+bool ConfigEngine::b_construct_with_config = true;
+
+const std::int8_t *toBuffer(const std::string &s)
+{
+    return reinterpret_cast<const std::int8_t *>(s.c_str());
+}
+
+} // namespace
+
+namespace hebench {
+namespace cpp {
+
+BaseEngine *createEngine(const std::int8_t *p_buffer, std::uint64_t size)
+{
+    if (ConfigEngine::b_construct_with_config)
+        return new ConfigEngine(EngineConfig::parse(p_buffer, size));
+    return new ConfigEngine();
+}
+
+void destroyEngine(BaseEngine *p)
+{
+    delete p;
+}
+
+} // namespace cpp
+} // namespace hebench
+
+TEST_CASE("EngineConfig: parses key=value entries", "[engine_config]")
+{
+    EngineConfig config = EngineConfig::parse("threads=8, pin_threads=yes;memory_budget=4GiB  path=\"a b;c\" flag");
+    CHECK(config.keys() == std::vector<std::string>{ "memory_budget", "path", "pin_threads", "threads" });
+    CHECK(config.getUInt64(EngineConfig::KeyThreads) == 8u);
+    CHECK(config.getBool(EngineConfig::KeyPinThreads));
+    CHECK(config.getBytes(EngineConfig::KeyMemoryBudget) == (std::uint64_t(4) << 30));
+    CHECK(config.getString("path") == "a b;c");
+    CHECK_FALSE(config.has("flag"));
+    CHECK(config.getInt64("missing", -3) == -3);
+
+    // trailing null characters of the buffer are ignored
+    const char buffer[] = "threads=2\0\0";
+    CHECK(EngineConfig::parse(reinterpret_cast<const std::int8_t *>(buffer), sizeof(buffer)).getString("threads") == "2");
+    CHECK(EngineConfig::parse(nullptr, 10).empty());
+}
+
+TEST_CASE("EngineConfig: parses JSON objects", "[engine_config]")
+{
+    EngineConfig config = EngineConfig::parse(R"( {"threads": 4, "pool": {"size": 2, "name": "a\"bA"}, "skip": null, "on": true} )");
+    CHECK(config.getUInt64("threads") == 4u);
+    CHECK(config.getUInt64("pool.size") == 2u);
+    CHECK(config.getString("pool.name") == "a\"bA");
+    CHECK_FALSE(config.has("skip"));
+    CHECK(config.getBool("on"));
+
+    CHECK_THROWS_AS(EngineConfig::parse(R"({"a": [1, 2]})"), HEBenchError);
+    CHECK_THROWS_AS(EngineConfig::parse(R"({"a": 1)"), HEBenchError);
+    CHECK_THROWS_AS(EngineConfig::parse(R"({"a": bad})"), HEBenchError);
+    CHECK_THROWS_AS(EngineConfig::parse(R"({"a": 1} extra)"), HEBenchError);
+}
+
+TEST_CASE("EngineConfig: typed getters reject invalid values", "[engine_config]")
+{
+    EngineConfig config;
+    config.set("value", "-1");
+    CHECK(config.getInt64("value") == -1);
+    CHECK(config.getDouble("value") == -1.0);
+    CHECK_THROWS_AS(config.getUInt64("value"), HEBenchError);
+    CHECK_THROWS_AS(config.getBool("value"), HEBenchError);
+    CHECK_THROWS_AS(config.getBytes("value"), HEBenchError);
+
+    config.set("value", "512MB");
+    CHECK(config.getBytes("value") == (std::uint64_t(512) << 20));
+    config.set("value", "16777216T");
+    CHECK_THROWS_AS(config.getBytes("value"), HEBenchError);
+    config.set("value", "3X");
+    CHECK_THROWS_AS(config.getBytes("value"), HEBenchError);
+    config.set("value", "99999999999999999999");
+    CHECK_THROWS_AS(config.getUInt64("value"), HEBenchError);
+    config.set("value", "Off");
+    CHECK_FALSE(config.getBool("value", true));
+}
+
+TEST_CASE("BaseEngine: configuration is applied before init", "[engine_config]")
+{
+    ConfigEngine engine(EngineConfig::parse("memory_budget=1M benchmark_pool_size=3 backend.option=x"));
+    CHECK(engine.init_option == "x");
+    CHECK(engine.init_budget == (std::uint64_t(1) << 20));
+    CHECK(engine.init_pool_size == 3u);
+
+    // a bad value leaves the engine untouched
+    CHECK_THROWS_AS(engine.applyConfiguration(EngineConfig::parse("memory_budget=2M threads=-1")), HEBenchError);
+    CHECK(engine.memoryBudget() == (std::uint64_t(1) << 20));
+    CHECK(engine.configuration().getString("backend.option") == "x");
+}
+
+TEST_CASE("initEngine: applies the buffer and creates no engine on failure", "[engine_config]")
+{
+    const std::string good = R"({"backend": {"option": "y"}, "memory_budget": "2K"})";
+    APIBridge::Handle h_engine;
+    REQUIRE(APIBridge::initEngine(&h_engine, toBuffer(good), good.size()) == HEBENCH_ECODE_SUCCESS);
+    CHECK(ConfigEngine::live_count == 1);
+    const ConfigEngine *p_engine = dynamic_cast<const ConfigEngine *>(reinterpret_cast<BaseEngine *>(h_engine.p));
+    REQUIRE(p_engine);
+    CHECK(p_engine->init_option == "y");
+    CHECK(p_engine->init_budget == 2048u);
+    CHECK(APIBridge::destroyHandle(h_engine) == HEBENCH_ECODE_SUCCESS);
+    CHECK(ConfigEngine::live_count == 0);
+
+    for (const std::string &bad : { std::string("threads=many"), std::string("{\"threads\": ") })
+    {
+        CHECK(APIBridge::initEngine(&h_engine, toBuffer(bad), bad.size()) == HEBENCH_ECODE_INVALID_ARGS);
+        CHECK(ConfigEngine::live_count == 0);
+    } // end for
+
+    REQUIRE(APIBridge::initEngine(&h_engine, nullptr, 0) == HEBENCH_ECODE_SUCCESS);
+    p_engine = dynamic_cast<const ConfigEngine *>(reinterpret_cast<BaseEngine *>(h_engine.p));
+    REQUIRE(p_engine);
+    CHECK(p_engine->init_option.empty());
+    CHECK(APIBridge::destroyHandle(h_engine) == HEBENCH_ECODE_SUCCESS);
+}
+
+TEST_CASE("initEngine: configures engines constructed without configuration", "[engine_config]")
+{
+    ConfigEngine::b_construct_with_config = false;
+    const std::string good = "backend.option=z memory_budget=4K";
+    APIBridge::Handle h_engine;
+    REQUIRE(APIBridge::initEngine(&h_engine, toBuffer(good), good.size()) == HEBENCH_ECODE_SUCCESS);
+    const ConfigEngine *p_engine = dynamic_cast<const ConfigEngine *>(reinterpret_cast<BaseEngine *>(h_engine.p));
+    REQUIRE(p_engine);
+    // applied once created: too late for init()
+    CHECK(p_engine->init_option.empty());
+    CHECK(p_engine->configuration().getString("backend.option") == "z");
+    CHECK(p_engine->memoryBudget() == 4096u);
+    CHECK(APIBridge::destroyHandle(h_engine) == HEBENCH_ECODE_SUCCESS);
+
+    // the engine is destroyed if its configuration cannot be applied
+    const std::string bad = "threads=-1";
+    CHECK(APIBridge::initEngine(&h_engine, toBuffer(bad), bad.size()) == HEBENCH_ECODE_INVALID_ARGS);
+    CHECK(ConfigEngine::live_count == 0);
+    ConfigEngine::b_construct_with_config = true;
+}
@@ -0,0 +1,63 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/hebench.hpp"
+#include "test_engine.hpp"
+
+using hebench::cpp::HEBenchError;
+using hebench::test::destroyObjectHandle;
+using hebench::test::TestEngine;
+namespace APIBridge = hebench::APIBridge;
+
+TEST_CASE("EngineObject: retrieves payloads by their type", "[engine_object]")
+{
+    TestEngine engine;
+    APIBridge::Handle h = engine.createHandle<std::vector<int>>(3 * sizeof(int), 0, 3, 7);
+    CHECK(engine.retrieveConstFromHandle<std::vector<int>>(h) == std::vector<int>(3, 7));
+
+#if HEBENCH_VALIDATE_CHEAP
+    // a single comparison of type IDs, kept in release validation levels
+    try
+    {
+        engine.retrieveConstFromHandle<std::string>(h);
+        FAIL("Retrieving a handle as the wrong type did not throw.");
+    }
+    catch (HEBenchError &err)
+    {
+        CHECK(err.getErrorCode() == HEBENCH_ECODE_CRITICAL_ERROR);
+    }
+#endif
+
+    destroyObjectHandle(h);
+    CHECK(engine.getHandleStats().live_count == 0u);
+}
+
+
+TEST_CASE("EngineObject: copy-on-write detaches shared payloads", "[engine_object]")
+{
+    TestEngine engine;
+    APIBridge::Handle h         = engine.createHandle<std::vector<int>>(sizeof(int), 0, 1, 1);
+    APIBridge::Handle h_shared  = engine.duplicateHandle(h);
+    APIBridge::Handle h_private = engine.duplicateHandle(h);
+
+    engine.retrieveFromHandle<std::vector<int>>(h_shared)[0] = 2;
+    CHECK(engine.retrieveConstFromHandle<std::vector<int>>(h)[0] == 2);
+
+    engine.retrieveMutableFromHandle<std::vector<int>>(h_private)[0] = 3;
+    CHECK(engine.retrieveConstFromHandle<std::vector<int>>(h_private)[0] == 3);
+    CHECK(engine.retrieveConstFromHandle<std::vector<int>>(h)[0] == 2);
+    CHECK(engine.retrieveConstFromHandle<std::vector<int>>(h_shared)[0] == 2);
+    // detached payloads are no longer shared, so they are not copied again
+    CHECK(&engine.retrieveMutableFromHandle<std::vector<int>>(h_private) == &engine.retrieveConstFromHandle<std::vector<int>>(h_private));
+
+    for (APIBridge::Handle handle : { h, h_shared, h_private })
+        destroyObjectHandle(handle);
+    CHECK(engine.getHandleStats().live_count == 0u);
+}
@@ -0,0 +1,87 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/api.h"
+#include "hebench/api_bridge/cpp/hebench.hpp"
+
+using hebench::cpp::BaseEngine;
+using hebench::cpp::ErrorRecord;
+using hebench::cpp::HEBenchError;
+namespace APIBridge = hebench::APIBridge;
+
+namespace {
+
+class RecordOwner
+{
+private:
+    HEBERROR_DECLARE_CLASS_NAME(RecordOwner)
+
+public:
+    static ErrorRecord record() { return HEBERROR_RECORD_CLASS("Invalid sample {} for operand {}.", HEBENCH_ECODE_INVALID_ARGS); }
+};
+
+bool contains(const std::string &s, const std::string &part)
+{
+    return s.find(part) != std::string::npos;
+}
+
+} // namespace
+
+TEST_CASE("ErrorRecord: formats messages only when requested", "[error_handling]")
+{
+    ErrorRecord record = RecordOwner::record();
+    CHECK(record.getErrorCode() == HEBENCH_ECODE_INVALID_ARGS);
+    CHECK(std::string(record.getMessage()) == "Invalid sample {} for operand {}.");
+    CHECK(contains(record.format(), "RecordOwner"));
+    CHECK(contains(record.format(), "Invalid sample {} for operand {}."));
+    CHECK(contains(record.format({ 3, 1 }), "Invalid sample 3 for operand 1."));
+    // missing values leave their placeholders
+    CHECK(contains(record.format({ 3 }), "Invalid sample 3 for operand {}."));
+
+    try
+    {
+        record.raise({ 7, 0 });
+        FAIL("Raising an error record did not throw.");
+    }
+    catch (HEBenchError &err)
+    {
+        CHECK(err.getErrorCode() == HEBENCH_ECODE_INVALID_ARGS);
+        CHECK(contains(err.what(), "Invalid sample 7 for operand 0."));
+    }
+}
+
+TEST_CASE("BaseEngine: last error from a record is formatted lazily", "[error_handling]")
+{
+    CHECK(BaseEngine::reportError(RecordOwner::record()) == HEBENCH_ECODE_INVALID_ARGS);
+    CHECK(BaseEngine::getLastError() == HEBENCH_ECODE_INVALID_ARGS);
+    CHECK(contains(BaseEngine::getLastErrorDesc(), "Invalid sample {} for operand {}."));
+
+    // records without message describe their error code
+    BaseEngine::setLastError(ErrorRecord(HEBENCH_ECODE_CRITICAL_ERROR));
+    CHECK(BaseEngine::getLastError() == HEBENCH_ECODE_CRITICAL_ERROR);
+    CHECK(BaseEngine::getLastErrorDesc() == BaseEngine::getErrorDesc(HEBENCH_ECODE_CRITICAL_ERROR));
+
+    // descriptions set directly replace pending records
+    BaseEngine::setLastError(RecordOwner::record());
+    BaseEngine::setLastError(HEBENCH_ECODE_INVALID_ARGS, "Direct description.");
+    CHECK(BaseEngine::getLastErrorDesc() == "Direct description.");
+}
+
+#if HEBENCH_VALIDATE_CHEAP
+TEST_CASE("API Bridge: entry points report invalid arguments without throwing", "[error_handling]")
+{
+    APIBridge::Handle h_benchmark = NULL_HANDLE;
+    APIBridge::Handle h_encoded;
+    APIBridge::DataPackCollection parameters;
+    parameters.p_data_packs = nullptr;
+    parameters.pack_count   = 0;
+    CHECK(APIBridge::encode(h_benchmark, &parameters, &h_encoded) == HEBENCH_ECODE_CRITICAL_ERROR);
+    CHECK(BaseEngine::getLastError() == HEBENCH_ECODE_CRITICAL_ERROR);
+    CHECK(contains(BaseEngine::getLastErrorDesc(), "h_benchmark"));
+}
+#endif
@@ -0,0 +1,105 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/parameter_sweep.hpp"
+#include "hebench/api_bridge/cpp/workload_schema.hpp"
+
+using hebench::cpp::HEBenchError;
+using hebench::cpp::ParameterSweep;
+using hebench::cpp::WorkloadSchema;
+using hebench::cpp::WorkloadSweep;
+namespace APIBridge = hebench::APIBridge;
+
+namespace {
+
+typedef WorkloadSchema<hebench::cpp::WorkloadSchemas::MatrixMultiply> MatMul;
+
+std::vector<std::uint64_t> uintValues(const ParameterSweep &sweep)
+{
+    std::vector<std::uint64_t> retval;
+    APIBridge::WorkloadParam w_param;
+    for (std::uint64_t i = 0; i < sweep.size(); ++i)
+    {
+        sweep.get(i, w_param);
+        retval.push_back(w_param.u_param);
+    } // end for
+    return retval;
+}
+
+} // namespace
+
+TEST_CASE("ParameterSweep: ranges, progressions and lists", "[parameter_sweep]")
+{
+    CHECK(uintValues(ParameterSweep::range<std::uint64_t>(2, 10, 4)) == std::vector<std::uint64_t>{ 2, 6, 10 });
+    CHECK(uintValues(ParameterSweep::geometric<std::uint64_t>(16, 100, 2)) == std::vector<std::uint64_t>{ 16, 32, 64 });
+    CHECK(uintValues(ParameterSweep::parse("3, 1, 2", APIBridge::WorkloadParamType::UInt64)) == std::vector<std::uint64_t>{ 3, 1, 2 });
+    CHECK(uintValues(ParameterSweep::parse("1:4", APIBridge::WorkloadParamType::UInt64)) == std::vector<std::uint64_t>{ 1, 2, 3, 4 });
+    CHECK(uintValues(ParameterSweep::parse("1:8:*2", APIBridge::WorkloadParamType::UInt64)) == std::vector<std::uint64_t>{ 1, 2, 4, 8 });
+    CHECK(ParameterSweep::parse("0.1:0.3:0.1", APIBridge::WorkloadParamType::Float64).size() == 3u);
+
+    APIBridge::WorkloadParam w_param;
+    ParameterSweep sweep = ParameterSweep::range<std::int64_t>(-5, 5, 5);
+    REQUIRE(sweep.size() == 3u);
+    sweep.get(0, w_param);
+    CHECK(w_param.i_param == -5);
+    sweep.get(2, w_param);
+    CHECK(w_param.i_param == 5);
+    CHECK_THROWS_AS(sweep.get(3, w_param), HEBenchError);
+}
+
+TEST_CASE("ParameterSweep: rejects invalid and overflowing sequences", "[parameter_sweep]")
+{
+    CHECK_THROWS_AS(ParameterSweep::range(5, 1), HEBenchError);
+    CHECK_THROWS_AS(ParameterSweep::range(1, 5, 0), HEBenchError);
+    CHECK_THROWS_AS(ParameterSweep::geometric(1, 5, 1), HEBenchError);
+    CHECK_THROWS_AS(ParameterSweep::parse("-1", APIBridge::WorkloadParamType::UInt64), HEBenchError);
+    CHECK_THROWS_AS(ParameterSweep::parse("1:2:3:4", APIBridge::WorkloadParamType::UInt64), HEBenchError);
+
+    // full 64-bit ranges have 2^64 values
+    CHECK_THROWS_AS(ParameterSweep::range(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()),
+                    HEBenchError);
+    CHECK_THROWS_AS(ParameterSweep::range<std::uint64_t>(0, std::numeric_limits<std::uint64_t>::max()), HEBenchError);
+
+    // one value less fits
+    ParameterSweep sweep = ParameterSweep::range<std::uint64_t>(1, std::numeric_limits<std::uint64_t>::max());
+    CHECK(sweep.size() == std::numeric_limits<std::uint64_t>::max());
+    APIBridge::WorkloadParam w_param;
+    sweep.get(sweep.size() - 1, w_param);
+    CHECK(w_param.u_param == std::numeric_limits<std::uint64_t>::max());
+    CHECK(ParameterSweep::range(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max(), std::int64_t(2)).size()
+          == std::uint64_t(1) << 63);
+}
+
+TEST_CASE("WorkloadSweep: cartesian product with the last dimension fastest", "[parameter_sweep]")
+{
+    WorkloadSweep sweep(MatMul::makeDefault(1, 4096, 1));
+    sweep.vary("rows_M0=64:192:64; cols_M1=1,16");
+    REQUIRE(sweep.size() == 6u);
+
+    std::vector<APIBridge::WorkloadParam> w_params = sweep.at(3);
+    MatMul::Values values                          = MatMul::validate(w_params);
+    CHECK(values.get<MatMul::RowsM0>() == 128u);
+    CHECK(values.get<MatMul::ColsM0>() == 4096u);
+    CHECK(values.get<MatMul::ColsM1>() == 16u);
+
+    WorkloadSweep square(MatMul::makeDefault(1, 1, 1));
+    square.vary({ MatMul::RowsM0, MatMul::ColsM0, MatMul::ColsM1 }, ParameterSweep::geometric(16, 64));
+    REQUIRE(square.size() == 3u);
+    values = MatMul::validate(w_params = square.at(2));
+    CHECK(values.get<MatMul::RowsM0>() == 64u);
+    CHECK(values.get<MatMul::ColsM0>() == 64u);
+    CHECK(values.get<MatMul::ColsM1>() == 64u);
+
+    CHECK_THROWS_AS(square.vary(MatMul::RowsM0, ParameterSweep::value(1)), HEBenchError);
+    CHECK_THROWS_AS(sweep.vary("unknown=1"), HEBenchError);
+    CHECK_THROWS_AS(sweep.at(6), HEBenchError);
+    // negative values do not fit unsigned parameters
+    CHECK_THROWS_AS(WorkloadSweep(MatMul::makeDefault(1, 1, 1)).vary(MatMul::ColsM0, ParameterSweep::range(-1, 1)), HEBenchError);
+}
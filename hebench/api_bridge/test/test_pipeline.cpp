@@ -0,0 +1,126 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/pipeline.hpp"
+
+using hebench::cpp::Pipeline;
+using hebench::cpp::ThreadPool;
+
+namespace {
+
+struct Item
+{
+    std::uint64_t index = 0;
+    std::uint64_t value = 0;
+};
+
+} // namespace
+
+TEST_CASE("Pipeline: items go through all stages in order", "[pipeline]")
+{
+    ThreadPool pool(3);
+    std::vector<std::uint64_t> results;
+    Pipeline<Item> pipeline(pool, 4);
+    pipeline.addStage([](Item &item) { item.value = item.index * 2; })
+        .addStage([](Item &item) { item.value += 1; })
+        .addStage([&results](Item &item) { results.push_back(item.value); });
+
+    for (std::uint64_t i = 0; i < 1000; ++i)
+        pipeline.push(Item{ i, 0 });
+    pipeline.finish();
+    CHECK_THROWS_AS(pipeline.addStage([](Item &) {}), std::logic_error);
+
+    REQUIRE(results.size() == 1000u);
+    for (std::uint64_t i = 0; i < results.size(); ++i)
+        REQUIRE(results[i] == i * 2 + 1);
+
+    // reusable after finish
+    pipeline.push(Item{ 1000, 0 });
+    pipeline.finish();
+    CHECK(results.back() == 2001u);
+}
+
+TEST_CASE("Pipeline: concurrent stages process every item", "[pipeline]")
+{
+    ThreadPool pool(4);
+    std::atomic<std::uint64_t> sum(0);
+    Pipeline<Item> pipeline(pool, 2);
+    pipeline.addStage([](Item &item) { item.value = item.index; }, 4)
+        .addStage([&sum](Item &item) { sum += item.value; }, 2);
+    for (std::uint64_t i = 1; i <= 500; ++i)
+        pipeline.push(Item{ i, 0 });
+    pipeline.finish();
+    CHECK(sum.load() == 500u * 501u / 2);
+}
+
+TEST_CASE("Pipeline: stages calling parallel for do not deadlock", "[pipeline]")
+{
+    // threads waiting in parallelFor run pending pipeline tasks, which then find the
+    // queue of the next stage full while its only runner is suspended lower in
+    // their own stack
+    for (std::size_t thread_count : { 1, 2, 4 })
+    {
+        ThreadPool pool(thread_count);
+        std::vector<std::uint64_t> results;
+        Pipeline<Item> pipeline(pool, 1);
+        pipeline.addStage([](Item &item) { item.value = item.index; })
+            .addStage([&pool](Item &item) {
+                std::atomic<std::uint64_t> count(0);
+                pool.parallelFor(
+                    0, 8, [&count](std::size_t) { ++count; }, 1);
+                item.value += count.load();
+            })
+            .addStage([&pool](Item &item) {
+                pool.parallelFor(
+                    0, 4, [](std::size_t) {}, 1);
+                item.value *= 2;
+            })
+            .addStage([&results](Item &item) { results.push_back(item.value); });
+
+        for (std::uint64_t i = 0; i < 300; ++i)
+            pipeline.push(Item{ i, 0 });
+        pipeline.finish();
+
+        REQUIRE(results.size() == 300u);
+        for (std::uint64_t i = 0; i < results.size(); ++i)
+            REQUIRE(results[i] == (i + 8) * 2);
+    } // end for
+}
+
+TEST_CASE("Pipeline: finish rethrows the first stage exception", "[pipeline]")
+{
+    ThreadPool pool(2);
+    std::atomic<int> consumed(0);
+    Pipeline<Item> pipeline(pool, 2);
+    pipeline.addStage([](Item &item) {
+                if (item.index == 7)
+                    throw std::runtime_error("failed");
+            })
+        .addStage([&consumed](Item &) { ++consumed; });
+    for (std::uint64_t i = 0; i < 50; ++i)
+        pipeline.push(Item{ i, 0 });
+    CHECK_THROWS_AS(pipeline.finish(), std::runtime_error);
+    // the failed item is discarded, the rest are processed
+    CHECK(consumed.load() == 49);
+
+    // the exception is consumed by finish()
+    pipeline.push(Item{ 0, 0 });
+    CHECK_NOTHROW(pipeline.finish());
+}
+
+TEST_CASE("Pipeline: rejects invalid configurations", "[pipeline]")
+{
+    ThreadPool pool(1);
+    CHECK_THROWS_AS(Pipeline<Item>(pool, 0), std::invalid_argument);
+    Pipeline<Item> pipeline(pool);
+    CHECK_THROWS_AS(pipeline.push(Item()), std::logic_error);
+    CHECK_THROWS_AS(pipeline.addStage(Pipeline<Item>::Stage()), std::invalid_argument);
+}
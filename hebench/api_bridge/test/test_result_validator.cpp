@@ -0,0 +1,169 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/result_validator.hpp"
+#include "hebench/api_bridge/cpp/workload_schema.hpp"
+#include "test_engine.hpp"
+
+using hebench::cpp::HEBenchError;
+using hebench::cpp::ResultValidator;
+using hebench::cpp::ThreadPool;
+using hebench::cpp::Tolerance;
+using hebench::cpp::ValidationReport;
+using hebench::cpp::WorkloadSchema;
+using hebench::test::NativeData;
+namespace APIBridge = hebench::APIBridge;
+namespace Schemas   = hebench::cpp::WorkloadSchemas;
+
+namespace {
+
+APIBridge::WorkloadParams toParams(std::vector<APIBridge::WorkloadParam> &w_params)
+{
+    APIBridge::WorkloadParams retval;
+    retval.params = w_params.data();
+    retval.count  = w_params.size();
+    return retval;
+}
+
+} // namespace
+
+TEST_CASE("Tolerance: absolute, relative and ulps criteria", "[result_validator]")
+{
+    using hebench::cpp::withinTolerance;
+
+    CHECK(withinTolerance(1.0, 1.0, Tolerance::exact()));
+    CHECK_FALSE(withinTolerance(1.0, std::nextafter(1.0, 2.0), Tolerance::exact()));
+
+    Tolerance tol;
+    tol.ulps = 1;
+    CHECK(withinTolerance(1.0, std::nextafter(1.0, 2.0), tol));
+    CHECK(withinTolerance(-0.0, 0.0, tol));
+    CHECK_FALSE(withinTolerance(1.0, std::nextafter(std::nextafter(1.0, 2.0), 2.0), tol));
+    CHECK_FALSE(withinTolerance(std::nan(""), std::nan(""), tol));
+    // the NaN with the smallest payload is 1 ulp away from infinity
+    const std::uint64_t nan_bits = 0x7ff0000000000001ull;
+    double nan_min;
+    std::memcpy(&nan_min, &nan_bits, sizeof(nan_min));
+    REQUIRE(std::isnan(nan_min));
+    CHECK_FALSE(withinTolerance(std::numeric_limits<double>::infinity(), nan_min, tol));
+    CHECK_FALSE(withinTolerance(nan_min, std::numeric_limits<double>::infinity(), tol));
+
+    tol          = Tolerance();
+    tol.relative = 0.01;
+    CHECK(withinTolerance(101.0f, 100.0f, tol));
+    CHECK_FALSE(withinTolerance(102.0f, 100.0f, tol));
+
+    tol          = Tolerance();
+    tol.absolute = 2;
+    CHECK(withinTolerance<std::int32_t>(-1, 1, tol));
+    CHECK_FALSE(withinTolerance<std::int32_t>(-2, 1, tol));
+    CHECK_FALSE(withinTolerance(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max(), tol));
+
+    const std::vector<double> actual   = { 1.0, 2.0, 3.5, 4.0 };
+    const std::vector<double> expected = { 1.0, 2.5, 3.0, 4.0 };
+    CHECK(hebench::cpp::countMismatches(actual.data(), expected.data(), actual.size(), Tolerance::exact()) == 2u);
+}
+
+TEST_CASE("ResultValidator: validates every tuple of the cartesian product", "[result_validator]")
+{
+    typedef WorkloadSchema<Schemas::VectorSize> Params;
+    std::vector<APIBridge::WorkloadParam> w_params = Params::makeDefault(2);
+    APIBridge::BenchmarkDescriptor desc =
+        hebench::test::makeDescriptor(APIBridge::Workload::EltwiseAdd, APIBridge::DataType::Float64);
+    ResultValidator validator(desc, toParams(w_params));
+
+    NativeData<double> inputs;
+    inputs.addOperand({ { 1, 2 }, { 3, 4 } });
+    inputs.addOperand({ { 10, 20 }, { 30, 40 }, { 50, 60 } });
+    // row-major: the last operand varies fastest
+    std::vector<std::vector<double>> expected;
+    for (const std::vector<double> &a : { std::vector<double>{ 1, 2 }, std::vector<double>{ 3, 4 } })
+        for (const std::vector<double> &b : { std::vector<double>{ 10, 20 }, std::vector<double>{ 30, 40 }, std::vector<double>{ 50, 60 } })
+            expected.push_back({ a[0] + b[0], a[1] + b[1] });
+    NativeData<double> results;
+    results.addOperand(expected);
+
+    ThreadPool pool(3);
+    ValidationReport report = validator.validate(inputs.collection(), results.collection(), &pool);
+    CHECK(report.passed());
+    CHECK(report.result_count == 6u);
+
+    results.sample(0, 5)[0] += 1.0;
+    results.sample(0, 4)[1] += 1.0;
+    for (ThreadPool *p_pool : { static_cast<ThreadPool *>(nullptr), &pool })
+    {
+        report = validator.validate(inputs.collection(), results.collection(), p_pool);
+        CHECK_FALSE(report.passed());
+        CHECK(report.failed_count == 2u);
+        CHECK(report.mismatch_count == 2u);
+        CHECK(report.first_result == 4u);
+        CHECK(report.first_component == 0u);
+        CHECK(report.first_element == 1u);
+        CHECK(report.first_actual == 45.0);
+        CHECK(report.first_expected == 44.0);
+        CHECK(report.summary().find("First mismatch in result 4") != std::string::npos);
+    } // end for
+
+    Tolerance tol;
+    tol.absolute = 1.0;
+    validator.setTolerance(tol);
+    CHECK(validator.validate(inputs.collection(), results.collection()).passed());
+}
+
+TEST_CASE("ResultValidator: compares set intersections as sets", "[result_validator]")
+{
+    typedef WorkloadSchema<Schemas::SimpleSetIntersection> Params;
+    std::vector<APIBridge::WorkloadParam> w_params = Params::makeDefault(3, 3, 1);
+    APIBridge::BenchmarkDescriptor desc =
+        hebench::test::makeDescriptor(APIBridge::Workload::SimpleSetIntersection, APIBridge::DataType::Int32);
+    ResultValidator validator(desc, toParams(w_params));
+
+    NativeData<std::int32_t> inputs;
+    inputs.addOperand({ { 1, 2, 3 } });
+    inputs.addOperand({ { 3, 1, 7 } });
+    NativeData<std::int32_t> results;
+    results.addOperand({ { 3, 1, 0 } });
+    CHECK(validator.validate(inputs.collection(), results.collection()).passed());
+
+    results.sample(0, 0) = { 3, 2, 0 };
+    CHECK_FALSE(validator.validate(inputs.collection(), results.collection()).passed());
+}
+
+TEST_CASE("ResultValidator: rejects unsupported workloads and short samples", "[result_validator]")
+{
+    typedef WorkloadSchema<Schemas::MatrixMultiply> Params;
+    std::vector<APIBridge::WorkloadParam> w_params = Params::makeDefault(2, 3, 4);
+    CHECK(ResultValidator::resultSizes(APIBridge::Workload::MatrixMultiply, toParams(w_params)) == std::vector<std::uint64_t>{ 8 });
+    std::vector<APIBridge::WorkloadParam> no_params;
+    CHECK_THROWS_AS(ResultValidator::resultSizes(APIBridge::Workload::EltwiseAdd, toParams(no_params)), HEBenchError);
+    CHECK_THROWS_AS(ResultValidator::resultSizes(static_cast<APIBridge::Workload>(-1), toParams(w_params)), HEBenchError);
+
+    std::vector<APIBridge::WorkloadParam> v_params = WorkloadSchema<Schemas::VectorSize>::makeDefault(2);
+    APIBridge::BenchmarkDescriptor desc =
+        hebench::test::makeDescriptor(APIBridge::Workload::DotProduct, APIBridge::DataType::Int64);
+    ResultValidator validator(desc, toParams(v_params));
+
+    NativeData<std::int64_t> inputs;
+    inputs.addOperand({ { 1, 2 }, { 3, 4 } });
+    inputs.addOperand({ { 5, 6 } });
+    NativeData<std::int64_t> results;
+    results.addOperand({ { 17 } });
+    // two tuples, one result
+    CHECK_THROWS_AS(validator.validate(inputs.collection(), results.collection()), HEBenchError);
+    NativeData<std::int64_t> complete;
+    complete.addOperand({ { 17 }, { 39 } });
+    CHECK(validator.validate(inputs.collection(), complete.collection()).passed());
+
+    inputs.sample(1, 0).pop_back();
+    CHECK_THROWS_AS(validator.validate(inputs.collection(), complete.collection()), HEBenchError);
+}
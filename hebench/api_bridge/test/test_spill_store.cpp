@@ -0,0 +1,187 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/spill_store.hpp"
+#include "test_engine.hpp"
+
+using hebench::cpp::HEBenchError;
+using hebench::cpp::SpilledBuffer;
+using hebench::cpp::SpillStore;
+using hebench::test::TestEngine;
+
+namespace {
+
+const std::uint64_t PageSize = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+
+void fill(const SpilledBuffer &buffer, std::uint32_t seed)
+{
+    SpilledBuffer::Pin pin = buffer.pin();
+    std::uint32_t *p_data  = pin.data<std::uint32_t>();
+    for (std::uint64_t i = 0; i < pin.size() / sizeof(std::uint32_t); ++i)
+        p_data[i] = seed * 2654435761u + static_cast<std::uint32_t>(i);
+}
+
+bool check(const SpilledBuffer &buffer, std::uint32_t seed)
+{
+    SpilledBuffer::Pin pin      = buffer.pin();
+    const std::uint32_t *p_data = pin.data<std::uint32_t>();
+    for (std::uint64_t i = 0; i < pin.size() / sizeof(std::uint32_t); ++i)
+        if (p_data[i] != seed * 2654435761u + static_cast<std::uint32_t>(i))
+            return false;
+    return true;
+}
+
+// reads its spilled payload when destroyed: the store must still exist
+struct SpilledContext
+{
+    SpilledContext(SpilledBuffer &&buffer, bool &b_checked) :
+        m_buffer(std::move(buffer)), m_b_checked(b_checked) {}
+    ~SpilledContext() { m_b_checked = check(m_buffer, 5); }
+
+    SpilledBuffer m_buffer;
+    bool &m_b_checked;
+};
+
+} // namespace
+
+TEST_CASE("SpillStore: pages out over budget and contents round-trip", "[spill_store]")
+{
+    // in the build directory: memory backed file systems would not exercise write back
+    SpillStore store(".", 4 * PageSize, 16 * PageSize);
+    std::vector<SpilledBuffer> buffers;
+    for (std::uint32_t i = 0; i < 12; ++i)
+    {
+        buffers.push_back(store.allocate(2 * PageSize - 100));
+        CHECK_FALSE(buffers.back().resident());
+        fill(buffers.back(), i);
+    } // end for
+    CHECK(store.storedBytes() >= 12 * 2 * PageSize);
+    CHECK(store.residentBytes() <= 4 * PageSize);
+    CHECK(store.pageOutCount() >= 10u);
+    CHECK_FALSE(buffers.front().resident());
+    CHECK(buffers.back().resident());
+
+    for (std::uint32_t i = 0; i < buffers.size(); ++i)
+        REQUIRE(check(buffers[i], i));
+
+    {
+        // pinned payloads are never paged out, even over budget
+        std::vector<SpilledBuffer::Pin> pins;
+        for (const SpilledBuffer &buffer : buffers)
+            pins.push_back(buffer.pin());
+        CHECK(store.residentBytes() == store.storedBytes());
+        store.pageOutAll();
+        CHECK(store.residentBytes() == store.storedBytes());
+    }
+    CHECK(store.residentBytes() <= 4 * PageSize);
+    store.pageOutAll();
+    CHECK(store.residentBytes() == 0u);
+
+    buffers.erase(buffers.begin(), buffers.begin() + 6);
+    for (std::uint32_t i = 0; i < buffers.size(); ++i)
+        REQUIRE(check(buffers[i], i + 6));
+    buffers.clear();
+    CHECK(store.storedBytes() == 0u);
+    CHECK(store.residentBytes() == 0u);
+
+    SpilledBuffer empty;
+    CHECK_THROWS_AS(empty.pin(), HEBenchError);
+}
+
+TEST_CASE("SpillStore: concurrent pins wait for page outs in progress", "[spill_store]")
+{
+    SpillStore store(".", 2 * PageSize, 16 * PageSize);
+    constexpr std::uint32_t BufferCount = 8;
+    std::vector<SpilledBuffer> buffers;
+    for (std::uint32_t i = 0; i < BufferCount; ++i)
+    {
+        buffers.push_back(store.allocate(PageSize));
+        fill(buffers.back(), i);
+    } // end for
+
+    std::atomic<bool> b_ok(true);
+    std::vector<std::thread> threads;
+    for (std::uint32_t t = 0; t < 4; ++t)
+        threads.emplace_back([&buffers, &b_ok, t]() {
+            for (std::uint32_t i = 0; i < 200; ++i)
+            {
+                std::uint32_t index = (i * 3 + t) % BufferCount;
+                if (!check(buffers[index], index))
+                    b_ok = false;
+            } // end for
+        });
+    for (std::thread &thread : threads)
+        thread.join();
+    CHECK(b_ok.load());
+    CHECK(store.residentBytes() <= 2 * PageSize);
+}
+
+TEST_CASE("SpillStore: spill directory must exist and be writable", "[spill_store]")
+{
+    CHECK_NOTHROW(SpillStore::validateDirectory("."));
+    CHECK_THROWS_AS(SpillStore::validateDirectory("./hebench_missing_spill_dir"), HEBenchError);
+    const char *filename = "hebench_spill_not_a_dir";
+    std::ofstream(filename) << "file";
+    CHECK_THROWS_AS(SpillStore::validateDirectory(filename), HEBenchError);
+    std::remove(filename);
+
+    TestEngine engine;
+    CHECK_THROWS_AS(engine.setSpillDirectory("./hebench_missing_spill_dir"), HEBenchError);
+    CHECK_THROWS_AS(engine.applyConfiguration(hebench::cpp::EngineConfig::parse("memory_budget=1M spill_dir=./hebench_missing_spill_dir")),
+                    HEBenchError);
+    CHECK(engine.memoryBudget() == 0u);
+    CHECK_NOTHROW(engine.setSpillDirectory("."));
+    CHECK(engine.spillStore().directory() == ".");
+}
+
+TEST_CASE("SpillStore: outlives the payloads cached by its engine", "[spill_store]")
+{
+    bool b_checked = false;
+    {
+        TestEngine engine;
+        engine.setSpillDirectory(".");
+        SpilledBuffer buffer = engine.spillStore().allocate(PageSize);
+        fill(buffer, 5);
+        engine.contextCache().insert(hebench::cpp::ContextCache::Key(HEBENCH_HE_SCHEME_CKKS, 128, 0),
+                                     std::make_shared<SpilledContext>(std::move(buffer), b_checked));
+    }
+    CHECK(b_checked);
+}
+
+TEST_CASE("SpillStore: concurrent allocations share chunks", "[spill_store]")
+{
+    SpillStore store(".", 0, 4 * PageSize);
+    constexpr std::uint32_t ThreadCount = 4;
+    constexpr std::uint32_t BufferCount = 16;
+    std::vector<std::vector<SpilledBuffer>> buffers(ThreadCount);
+    std::vector<std::thread> threads;
+    for (std::uint32_t t = 0; t < ThreadCount; ++t)
+        threads.emplace_back([&store, &buffers, t]() {
+            for (std::uint32_t i = 0; i < BufferCount; ++i)
+            {
+                buffers[t].push_back(store.allocate(i % 3 == 0 ? 3 * PageSize : PageSize));
+                fill(buffers[t].back(), t * BufferCount + i);
+            } // end for
+        });
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (std::uint32_t t = 0; t < ThreadCount; ++t)
+        for (std::uint32_t i = 0; i < BufferCount; ++i)
+            REQUIRE(check(buffers[t][i], t * BufferCount + i));
+    buffers.clear();
+    CHECK(store.storedBytes() == 0u);
+}
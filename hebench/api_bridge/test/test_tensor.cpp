@@ -0,0 +1,102 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/tensor.hpp"
+
+using namespace hebench::cpp;
+
+namespace {
+
+bool isAligned(const void *p, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+} // namespace
+
+TEST_CASE("AlignedAllocator: aligns every allocation", "[tensor]")
+{
+    for (std::size_t size : { 0, 1, 3, 17, 1000 })
+    {
+        void *p = allocateAligned(size);
+        CHECK(p);
+        CHECK(isAligned(p, DefaultAlignment));
+        freeAligned(p);
+    } // end for
+
+    AlignedVector<char> bytes(5);
+    CHECK(isAligned(bytes.data(), DefaultAlignment));
+    std::vector<double, AlignedAllocator<double, 4096>> page_aligned(3);
+    CHECK(isAligned(page_aligned.data(), 4096));
+    // the pointer alignment is the minimum
+    std::vector<char, AlignedAllocator<char, 1>> byte_aligned(3);
+    CHECK(isAligned(byte_aligned.data(), sizeof(void *)));
+
+    CHECK_THROWS_AS(AlignedAllocator<double>().allocate(std::numeric_limits<std::size_t>::max()), std::bad_alloc);
+}
+
+TEST_CASE("AlignedAllocator: huge page allocations are aligned to whole huge pages", "[tensor]")
+{
+    void *p_small = allocateHugePages(100);
+    CHECK(isAligned(p_small, DefaultAlignment));
+    freeAligned(p_small);
+
+    void *p_large = allocateHugePages(HugePageSize + 1);
+    CHECK(isAligned(p_large, HugePageSize));
+    freeAligned(p_large);
+
+    HugePageTensor<std::uint8_t, 1> tensor({ HugePageSize });
+    CHECK(isAligned(tensor.data(), HugePageSize));
+}
+
+TEST_CASE("Tensor: stores elements in row-major order", "[tensor]")
+{
+    Tensor<int, 3> tensor({ 2, 3, 4 });
+    REQUIRE(tensor.size() == 24u);
+    CHECK(isAligned(tensor.data(), DefaultAlignment));
+    CHECK(tensor.stride(0) == 12u);
+    CHECK(tensor.stride(1) == 4u);
+    CHECK(tensor.stride(2) == 1u);
+    for (int value : tensor)
+        REQUIRE(value == 0);
+
+    tensor(1, 2, 3) = 7;
+    CHECK(tensor.data()[1 * 12 + 2 * 4 + 3] == 7);
+    CHECK(tensor.slice(1).size() == 12u);
+    CHECK(tensor.slice(1)[2 * 4 + 3] == 7);
+    SampleView<const int> elements = tensor;
+    CHECK(elements.size() == 24u);
+    CHECK(elements[23] == 7);
+
+    Tensor<double, 2> matrix({ 2, 3 }, 1.5);
+    MatrixView<const double> view = static_cast<const Tensor<double, 2> &>(matrix).matrix();
+    CHECK(view.rows() == 2u);
+    CHECK(view.cols() == 3u);
+    CHECK(view(1, 2) == 1.5);
+}
+
+TEST_CASE("Tensor: resizes in row-major order", "[tensor]")
+{
+    Tensor<int, 2> tensor({ 2, 2 });
+    int value = 0;
+    for (int &element : tensor)
+        element = ++value;
+    tensor.resize({ 3, 2 }, -1);
+    CHECK(tensor.extent(0) == 3u);
+    CHECK(tensor(0, 1) == 2);
+    CHECK(tensor(1, 1) == 4);
+    CHECK(tensor(2, 0) == -1);
+    CHECK(isAligned(tensor.data(), DefaultAlignment));
+
+    Tensor<int, 2> empty;
+    CHECK(empty.empty());
+    CHECK_THROWS_AS(tensor.resize({ std::numeric_limits<std::uint64_t>::max(), 2 }), std::length_error);
+    CHECK(tensor.size() == 6u);
+}
@@ -0,0 +1,153 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/thread_pool.hpp"
+
+using hebench::cpp::TaskGroup;
+using hebench::cpp::ThreadPool;
+
+TEST_CASE("ThreadPool: creates requested workers", "[threadpool]")
+{
+    ThreadPool pool(3);
+    CHECK(pool.threadCount() == 3u);
+    CHECK_FALSE(pool.isWorkerThread());
+
+    ThreadPool default_pool;
+    CHECK(default_pool.threadCount() >= 1u);
+}
+
+TEST_CASE("ThreadPool: parallel for visits every index once", "[threadpool]")
+{
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(10007);
+    for (auto &v : visits)
+        v = 0;
+    pool.parallelFor(0, visits.size(), [&](std::size_t i) { ++visits[i]; });
+    for (std::size_t i = 0; i < visits.size(); ++i)
+        REQUIRE(visits[i].load() == 1);
+
+    // explicit grain and empty range
+    pool.parallelFor(0, visits.size(), [&](std::size_t i) { ++visits[i]; }, 1);
+    pool.parallelFor(5, 5, [&](std::size_t i) { ++visits[i]; });
+    for (std::size_t i = 0; i < visits.size(); ++i)
+        REQUIRE(visits[i].load() == 2);
+}
+
+TEST_CASE("ThreadPool: parallel for blocked covers range", "[threadpool]")
+{
+    ThreadPool pool(2);
+    std::atomic<std::size_t> total(0);
+    pool.parallelForBlocked(
+        10, 1010,
+        [&](std::size_t begin, std::size_t end) {
+            CHECK(end - begin <= 7u);
+            total += end - begin;
+        },
+        7);
+    CHECK(total.load() == 1000u);
+}
+
+TEST_CASE("ThreadPool: nested parallel for completes", "[threadpool]")
+{
+    // waiting threads execute pending tasks, so nesting must not deadlock even
+    // with a single worker
+    for (std::size_t thread_count : { 1, 4 })
+    {
+        ThreadPool pool(thread_count);
+        std::atomic<std::size_t> count(0);
+        pool.parallelFor(
+            0, 16,
+            [&](std::size_t) {
+                pool.parallelFor(
+                    0, 64, [&](std::size_t) { ++count; }, 4);
+            },
+            1);
+        CHECK(count.load() == 16u * 64u);
+    } // end for
+}
+
+TEST_CASE("ThreadPool: parallel for rethrows", "[threadpool]")
+{
+    ThreadPool pool(4);
+    std::atomic<std::size_t> count(0);
+    auto body = [&](std::size_t i) {
+        ++count;
+        if (i == 42)
+            throw std::runtime_error("failed");
+    };
+    CHECK_THROWS_AS(pool.parallelFor(0, 100, body, 1), std::runtime_error);
+    // all other tasks still run
+    CHECK(count.load() == 100u);
+}
+
+TEST_CASE("ThreadPool: destructor completes submitted tasks", "[threadpool]")
+{
+    std::atomic<int> count(0);
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 1000; ++i)
+            pool.submit([&count]() { ++count; });
+    }
+    CHECK(count.load() == 1000);
+}
+
+TEST_CASE("ThreadPool: submitted exceptions are discarded", "[threadpool]")
+{
+    std::atomic<int> count(0);
+    {
+        ThreadPool pool(2);
+        pool.submit([]() { throw std::runtime_error("discarded"); });
+        pool.submit([&count]() { ++count; });
+    }
+    CHECK(count.load() == 1);
+}
+
+TEST_CASE("TaskGroup: waits for all tasks", "[taskgroup]")
+{
+    ThreadPool pool(3);
+    std::atomic<int> count(0);
+    TaskGroup group(pool);
+    for (int i = 0; i < 500; ++i)
+        group.run([&count]() { ++count; });
+    group.wait();
+    CHECK(count.load() == 500);
+
+    // reusable after wait
+    group.run([&count]() { ++count; });
+    group.wait();
+    CHECK(count.load() == 501);
+}
+
+TEST_CASE("TaskGroup: rethrows first exception", "[taskgroup]")
+{
+    ThreadPool pool(2);
+    TaskGroup group(pool);
+    group.run([]() { throw std::invalid_argument("first"); });
+    CHECK_THROWS_AS(group.wait(), std::invalid_argument);
+    // the exception is consumed by wait()
+    group.run([]() {});
+    CHECK_NOTHROW(group.wait());
+}
+
+TEST_CASE("TaskGroup: nested groups complete", "[taskgroup]")
+{
+    ThreadPool pool(2);
+    std::atomic<int> count(0);
+    TaskGroup group(pool);
+    for (int i = 0; i < 50; ++i)
+        group.run([&]() {
+            TaskGroup inner(pool);
+            inner.run([&count]() { ++count; });
+            inner.run([&count]() { ++count; });
+            inner.wait();
+        });
+    group.wait();
+    CHECK(count.load() == 100);
+}
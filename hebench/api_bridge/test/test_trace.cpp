@@ -0,0 +1,86 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/trace.hpp"
+
+using hebench::cpp::TraceEvent;
+using hebench::cpp::Tracer;
+using hebench::cpp::TraceRecord;
+using hebench::cpp::TraceScope;
+
+namespace {
+
+std::string readFile(const std::string &filename)
+{
+    std::ifstream ifs(filename, std::ios_base::in | std::ios_base::binary);
+    return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+TEST_CASE("Tracer: drains scopes to a file, overwriting or appending", "[trace]")
+{
+    const std::string filename      = "hebench_test_trace.bin";
+    const std::string json_filename = "hebench_test_trace.json";
+    const std::size_t header_size   = 8 + 2 * sizeof(std::uint32_t);
+    const std::size_t block_size    = 3 * sizeof(std::uint64_t);
+
+    Tracer::setEnabled(true);
+    Tracer::drainToFile(filename); // discard records from before this test
+
+    hebench::APIBridge::Handle h = {};
+    {
+        TraceScope trace(TraceEvent::Encrypt, h);
+    }
+    CHECK(Tracer::drainToFile(filename) == 2u);
+    CHECK(readFile(filename).size() == header_size + block_size + 2 * sizeof(TraceRecord));
+
+    // overwrite
+    {
+        TraceScope trace(TraceEvent::Encrypt, h);
+    }
+    CHECK(Tracer::drainToFile(filename) == 2u);
+    CHECK(readFile(filename).size() == header_size + block_size + 2 * sizeof(TraceRecord));
+
+    // append
+    {
+        TraceScope trace(TraceEvent::Decrypt, h);
+    }
+    CHECK(Tracer::drainToFile(filename, true) == 2u);
+    CHECK(readFile(filename).size() == header_size + 2 * (block_size + 2 * sizeof(TraceRecord)));
+    Tracer::setEnabled(false);
+
+    Tracer::convertToChromeTrace(filename, json_filename);
+    std::string json = readFile(json_filename);
+    CHECK(json.find("\"encrypt\"") != std::string::npos);
+    CHECK(json.find("\"decrypt\"") != std::string::npos);
+
+    std::remove(filename.c_str());
+    std::remove(json_filename.c_str());
+}
+
+TEST_CASE("Tracer: appending to a missing file writes the header", "[trace]")
+{
+    const std::string filename = "hebench_test_trace_append.bin";
+    std::remove(filename.c_str());
+
+    Tracer::setEnabled(true);
+    {
+        TraceScope trace(TraceEvent::Load, hebench::APIBridge::Handle{});
+    }
+    Tracer::setEnabled(false);
+    CHECK(Tracer::drainToFile(filename, true) >= 2u);
+    CHECK(readFile(filename).compare(0, 8, "HEBTRACE") == 0);
+    CHECK_NOTHROW(Tracer::convertToChromeTrace(filename, filename + ".json"));
+
+    std::remove(filename.c_str());
+    std::remove((filename + ".json").c_str());
+}
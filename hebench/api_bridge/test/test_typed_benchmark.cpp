@@ -0,0 +1,157 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <limits>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/typed_benchmark.hpp"
+#include "test_engine.hpp"
+
+using namespace hebench::cpp;
+using hebench::test::destroyObjectHandle;
+using hebench::test::NativeData;
+using hebench::test::TestEngine;
+namespace APIBridge = hebench::APIBridge;
+
+namespace {
+
+class AddBenchmark : public TypedBenchmark<AddBenchmark, APIBridge::Workload::EltwiseAdd, APIBridge::DataType::Float64>
+{
+public:
+    using TypedBenchmark::TypedBenchmark;
+
+    void compute(const SampleView<const double> *p_operands,
+                 const SampleView<double> *p_results) const
+    {
+        for (std::uint64_t i = 0; i < p_results[0].size(); ++i)
+            p_results[0][i] = p_operands[0][i] + p_operands[1][i];
+    }
+};
+
+} // namespace
+
+TEST_CASE("TypedBenchmark: encode, operate and decode an offline element-wise addition", "[typed_benchmark]")
+{
+    constexpr std::uint64_t n = 5;
+    TestEngine engine;
+    std::vector<APIBridge::WorkloadParam> params = WorkloadParams::VectorSize(n).getParams();
+    APIBridge::WorkloadParams w_params;
+    w_params.params = params.data();
+    w_params.count  = params.size();
+    APIBridge::BenchmarkDescriptor desc =
+        hebench::test::makeDescriptor(APIBridge::Workload::EltwiseAdd, APIBridge::DataType::Float64);
+
+    AddBenchmark bench(engine, desc, w_params);
+    REQUIRE(bench.operandCount() == 2);
+    REQUIRE(bench.resultComponentCount() == 1);
+    REQUIRE(bench.operandSampleSize(0) == n);
+
+    // 3 samples for operand 0, 2 samples for operand 1
+    NativeData<double> inputs;
+    inputs.addOperand({ { 1, 2, 3, 4, 5 }, { 10, 20, 30, 40, 50 }, { -1, -2, -3, -4, -5 } });
+    inputs.addOperand({ { 0.5, 0.5, 0.5, 0.5, 0.5 }, { 100, 200, 300, 400, 500 } });
+
+    APIBridge::Handle h_encoded   = bench.encode(&inputs.collection());
+    APIBridge::Handle h_encrypted = bench.encrypt(h_encoded);
+    APIBridge::Handle h_remote    = bench.load(&h_encrypted, 1);
+
+    APIBridge::ParameterIndexer indexers[2] = { { 0, 3 }, { 0, 2 } };
+    APIBridge::Handle h_result              = bench.operate(h_remote, indexers, 2);
+
+    APIBridge::Handle h_local;
+    bench.store(h_result, &h_local, 1);
+    APIBridge::Handle h_decrypted = bench.decrypt(h_local);
+
+    // one result per tuple, in row-major order of the cartesian product
+    NativeData<double> results;
+    results.addOperand(std::vector<std::vector<double>>(6, std::vector<double>(n, 0.0)));
+    bench.decode(h_decrypted, &results.collection());
+    for (std::size_t i0 = 0; i0 < 3; ++i0)
+        for (std::size_t i1 = 0; i1 < 2; ++i1)
+            for (std::size_t j = 0; j < n; ++j)
+                CHECK(results.sample(0, i0 * 2 + i1)[j] == inputs.sample(0, i0)[j] + inputs.sample(1, i1)[j]);
+
+    // decode of the encoded operands round-trips the inputs
+    NativeData<double> decoded;
+    decoded.addOperand(std::vector<std::vector<double>>(3, std::vector<double>(n, 0.0)));
+    decoded.addOperand(std::vector<std::vector<double>>(2, std::vector<double>(n, 0.0)));
+    bench.decode(h_encoded, &decoded.collection());
+    CHECK(decoded.sample(0, 2) == inputs.sample(0, 2));
+    CHECK(decoded.sample(1, 1) == inputs.sample(1, 1));
+
+    for (APIBridge::Handle h : { h_encoded, h_encrypted, h_remote, h_result, h_local, h_decrypted })
+        destroyObjectHandle(h);
+    CHECK(engine.getHandleStats().live_count == 0);
+}
+
+TEST_CASE("TypedBenchmark: rejects mismatching descriptors and indexers", "[typed_benchmark]")
+{
+    TestEngine engine;
+    std::vector<APIBridge::WorkloadParam> params = WorkloadParams::VectorSize(4).getParams();
+    APIBridge::WorkloadParams w_params;
+    w_params.params = params.data();
+    w_params.count  = params.size();
+
+    APIBridge::BenchmarkDescriptor wrong_type =
+        hebench::test::makeDescriptor(APIBridge::Workload::EltwiseAdd, APIBridge::DataType::Float32);
+    CHECK_THROWS_AS(AddBenchmark(engine, wrong_type, w_params), HEBenchError);
+
+    APIBridge::BenchmarkDescriptor desc =
+        hebench::test::makeDescriptor(APIBridge::Workload::EltwiseAdd, APIBridge::DataType::Float64);
+    AddBenchmark bench(engine, desc, w_params);
+    NativeData<double> inputs;
+    inputs.addOperand({ { 1, 2, 3, 4 } });
+    inputs.addOperand({ { 1, 2, 3, 4 } });
+    APIBridge::Handle h_encoded = bench.encode(&inputs.collection());
+    APIBridge::Handle h_remote  = bench.load(&h_encoded, 1);
+
+#if HEBENCH_VALIDATE_CHEAP
+    // indexers are trusted when validation is compiled out
+    APIBridge::ParameterIndexer out_of_range[2] = { { 0, 2 }, { 0, 1 } };
+    CHECK_THROWS_AS(bench.operate(h_remote, out_of_range, 2), HEBenchError);
+    APIBridge::ParameterIndexer too_few[1] = { { 0, 1 } };
+    CHECK_THROWS_AS(bench.operate(h_remote, too_few, 1), HEBenchError);
+    // non-throwing variants report the same errors as codes
+    APIBridge::Handle h_result;
+    CHECK(bench.tryOperate(h_remote, too_few, 1, &h_result) == HEBENCH_ECODE_INVALID_ARGS);
+    CHECK(BaseEngine::getLastError() == HEBENCH_ECODE_INVALID_ARGS);
+    APIBridge::ParameterIndexer overflowing[2] = { { 1, std::numeric_limits<std::uint64_t>::max() }, { 0, 1 } };
+    try
+    {
+        bench.operate(h_remote, overflowing, 2);
+        FAIL("Overflowing indexer did not throw.");
+    }
+    catch (HEBenchError &err)
+    {
+        CHECK(err.getErrorCode() == HEBENCH_ECODE_INVALID_ARGS);
+    }
+
+    // a third pack for operand 0 makes the operand ambiguous
+    NativeData<double> duplicated;
+    duplicated.addOperand({ { 1, 2, 3, 4 } });
+    duplicated.addOperand({ { 1, 2, 3, 4 } });
+    duplicated.addOperand({ { 5, 6, 7, 8 } });
+    APIBridge::DataPackCollection &packs    = duplicated.collection();
+    packs.p_data_packs[2].param_position    = 0;
+    APIBridge::Handle h_duplicated          = bench.encode(&packs);
+    APIBridge::Handle h_duplicated_remote   = bench.load(&h_duplicated, 1);
+    APIBridge::ParameterIndexer indexers[2] = { { 0, 1 }, { 0, 1 } };
+    try
+    {
+        bench.operate(h_duplicated_remote, indexers, 2);
+        FAIL("Duplicated operand position did not throw.");
+    }
+    catch (HEBenchError &err)
+    {
+        CHECK(err.getErrorCode() == HEBENCH_ECODE_INVALID_ARGS);
+    }
+    destroyObjectHandle(h_duplicated);
+    destroyObjectHandle(h_duplicated_remote);
+#endif
+
+    destroyObjectHandle(h_encoded);
+    destroyObjectHandle(h_remote);
+}
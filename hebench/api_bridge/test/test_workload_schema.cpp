@@ -0,0 +1,135 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "hebench/api_bridge/cpp/workload_schema.hpp"
+
+using hebench::cpp::HEBenchError;
+using hebench::cpp::WorkloadParamSpec;
+using hebench::cpp::WorkloadSchema;
+namespace APIBridge = hebench::APIBridge;
+
+namespace {
+
+struct TestSchema
+{
+    enum : std::size_t
+    {
+        N,
+        Offset,
+        Scale
+    };
+    static constexpr WorkloadParamSpec Params[] = { WorkloadParamSpec::UInt64("n", 1, 4096),
+                                                    WorkloadParamSpec::Int64("offset", -10, 10),
+                                                    WorkloadParamSpec::Float64("scale", 0.0) };
+};
+
+constexpr WorkloadParamSpec TestSchema::Params[];
+
+typedef WorkloadSchema<TestSchema> TestParams;
+
+} // namespace
+
+TEST_CASE("WorkloadSchema: makeDefault fills names, types and values", "[workload_schema]")
+{
+    STATIC_REQUIRE(TestParams::ParamCount == 3u);
+
+    std::vector<APIBridge::WorkloadParam> w_params = TestParams::makeDefault(1024, -3, 0.5);
+    REQUIRE(w_params.size() == 3u);
+    CHECK(std::strcmp(w_params[TestParams::N].name, "n") == 0);
+    CHECK(w_params[TestParams::N].data_type == APIBridge::WorkloadParamType::UInt64);
+    CHECK(std::strcmp(w_params[TestParams::Offset].name, "offset") == 0);
+    CHECK(w_params[TestParams::Offset].data_type == APIBridge::WorkloadParamType::Int64);
+    CHECK(std::strcmp(w_params[TestParams::Scale].name, "scale") == 0);
+    CHECK(w_params[TestParams::Scale].data_type == APIBridge::WorkloadParamType::Float64);
+
+    TestParams::Values values = TestParams::validate(w_params);
+    CHECK(values.get<TestParams::N>() == 1024u);
+    CHECK(values.get<TestParams::Offset>() == -3);
+    CHECK(values.get<TestParams::Scale>() == 0.5);
+
+    // extra parameters are ignored
+    w_params.push_back(w_params.front());
+    APIBridge::WorkloadParams c_params;
+    c_params.params = w_params.data();
+    c_params.count  = w_params.size();
+    CHECK(TestParams::validate(c_params).get<TestParams::N>() == 1024u);
+
+    CHECK_THROWS_AS(TestParams::makeDefault(0, 0, 0.0), HEBenchError);
+}
+
+TEST_CASE("WorkloadSchema: validate rejects count, type and range mismatches", "[workload_schema]")
+{
+    const std::vector<APIBridge::WorkloadParam> valid = TestParams::makeDefault(16, 0, 1.0);
+
+    std::vector<APIBridge::WorkloadParam> w_params(valid.begin(), valid.end() - 1);
+    CHECK_THROWS_AS(TestParams::validate(w_params), HEBenchError);
+    APIBridge::WorkloadParams c_params = { nullptr, 3 };
+    CHECK_THROWS_AS(TestParams::validate(c_params), HEBenchError);
+
+    w_params                          = valid;
+    w_params[TestParams::N].data_type = APIBridge::WorkloadParamType::Int64;
+    CHECK_THROWS_AS(TestParams::validate(w_params), HEBenchError);
+
+    w_params                        = valid;
+    w_params[TestParams::N].u_param = 4097;
+    CHECK_THROWS_AS(TestParams::validate(w_params), HEBenchError);
+
+    w_params                             = valid;
+    w_params[TestParams::Offset].i_param = -11;
+    CHECK_THROWS_AS(TestParams::validate(w_params), HEBenchError);
+
+    w_params                            = valid;
+    w_params[TestParams::Scale].f_param = -0.5;
+    CHECK_THROWS_AS(TestParams::validate(w_params), HEBenchError);
+    w_params[TestParams::Scale].f_param = std::nan("");
+    CHECK_THROWS_AS(TestParams::validate(w_params), HEBenchError);
+    w_params[TestParams::Scale].f_param = std::numeric_limits<double>::infinity();
+    CHECK_NOTHROW(TestParams::validate(w_params));
+}
+
+TEST_CASE("WorkloadSchema: descriptor serializes the schema", "[workload_schema]")
+{
+    CHECK(TestParams::descriptor() == "n:UInt64[1,4096];offset:Int64[-10,10];scale:Float64[0,inf]");
+    CHECK(WorkloadSchema<hebench::cpp::WorkloadSchemas::MatrixMultiply>::descriptor()
+          == "rows_M0:UInt64[1,18446744073709551615];cols_M0:UInt64[1,18446744073709551615];cols_M1:UInt64[1,18446744073709551615]");
+}
+
+TEST_CASE("GenericWorkloadSchema: parameters depend on the number of inputs and results", "[workload_schema]")
+{
+    using hebench::cpp::GenericWorkloadSchema;
+
+    std::vector<APIBridge::WorkloadParam> w_params = GenericWorkloadSchema::makeDefault({ 4, 8, 2 }, { 5 });
+    REQUIRE(w_params.size() == 6u);
+    CHECK(std::strcmp(w_params[0].name, "n") == 0);
+    CHECK(std::strcmp(w_params[3].name, "length_InputParam1") == 0);
+    CHECK(std::strcmp(w_params[5].name, "length_ResultComponent0") == 0);
+
+    GenericWorkloadSchema::Values values = GenericWorkloadSchema::validate(w_params);
+    CHECK(values.n() == 3u);
+    CHECK(values.m() == 1u);
+    CHECK(values.inputLength(1) == 8u);
+    CHECK(values.resultLength(0) == 5u);
+
+    CHECK_THROWS_AS(GenericWorkloadSchema::makeDefault({}, { 1 }), HEBenchError);
+    CHECK_THROWS_AS(GenericWorkloadSchema::makeDefault({ 1 }, { 0 }), HEBenchError);
+
+    // too few lengths for n and m, even when n + m overflows
+    std::vector<APIBridge::WorkloadParam> short_params(w_params.begin(), w_params.end() - 1);
+    CHECK_THROWS_AS(GenericWorkloadSchema::validate(short_params), HEBenchError);
+    short_params[0].u_param = std::numeric_limits<std::uint64_t>::max();
+    short_params[1].u_param = 2;
+    CHECK_THROWS_AS(GenericWorkloadSchema::validate(short_params), HEBenchError);
+
+    CHECK(GenericWorkloadSchema::descriptor()
+          == "n:UInt64[1,18446744073709551615];m:UInt64[1,18446744073709551615];"
+             "length_InputParam[n]:UInt64[1,18446744073709551615];length_ResultComponent[m]:UInt64[1,18446744073709551615]");
+}
@@ -652,6 +652,27 @@ struct ParameterIndexer
     std::uint64_t batch_size; //!< Number of values to use, starting from index.
 };
 
+//=============
+// Diagnostics
+//=============
+
+/**
+ * @brief Reports accounting of the handles to backend data held by an engine.
+ * @details Handles to the engine itself, benchmark descriptions and benchmarks
+ * are not accounted for. Sizes are the sum of the sizes of the accounted objects,
+ * and thus, their meaning is backend specific (usually bytes): usually the `size`
+ * field of their handles, or, for backend objects without a handle size, a size
+ * chosen by the backend, such as the size of the object itself.
+ * @sa getHandleStats()
+ */
+struct HandleStats
+{
+    std::uint64_t live_count; //!< Number of handles currently alive.
+    std::uint64_t live_size; //!< Sum of the sizes of all objects currently alive.
+    std::uint64_t peak_count; //!< Highest value reached by `live_count` since the peaks were last reset.
+    std::uint64_t peak_size; //!< Highest value reached by `live_size` since the peaks were last reset.
+};
+
 } // namespace APIBridge
 } // namespace hebench
 
@@ -0,0 +1,37 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_API_Bridge_Version_H_7e5fa8c2415240ea93eff148ed73539b
+#define _HEBench_API_Bridge_Version_H_7e5fa8c2415240ea93eff148ed73539b
+
+namespace hebench {
+namespace APIBridge {
+
+//============
+// Versioning
+//============
+
+/*!
+Specifies a version major.
+
+API complete version is of the form major.minor.revision.build
+
+In general, Major and minor changes are NOT backwards compatible.
+Revision changes should be backwards compatible.
+Build changes should not affect compatibility.
+*/
+#define HEBENCH_API_VERSION_MAJOR 0
+//! Specifies a version minor.
+#define HEBENCH_API_VERSION_MINOR 9
+//! Specifies a version release.
+#define HEBENCH_API_VERSION_REVISION 0
+#ifndef HEBENCH_API_VERSION_BUILD
+//! Specifies a version build. Can be overriden by compiler flags.
+#define HEBENCH_API_VERSION_BUILD "beta"
+#endif
+
+}
+}
+
+#endif // defined _HEBench_API_Bridge_Version_H_7e5fa8c2415240ea93eff148ed73539b